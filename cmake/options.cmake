@@ -11,7 +11,7 @@
 option(SERVERS          "Build worldserver and authserver"                            1)
 option(SCRIPTS          "Build core with scripts included"                            1)
 option(CROSS            "Build crossrealm core"                                       0)
-option(TOOLS            "Build map/vmap extraction/assembler tools"                   0)
+option(TOOLS            "Build map/vmap extraction/assembler, auth stress, chat filter, loot roll and achievement criteria benchmark tools"   0)
 option(USE_SCRIPTPCH    "Use precompiled headers when compiling scripts"              1)
 option(USE_COREPCH      "Use precompiled headers when compiling servers"              1)
 option(WITH_WARNINGS    "Show all warnings during compile"                            1)
@@ -44,15 +44,15 @@ namespace BNet2 {
 
     /// Constructor
     Session::Session(RealmSocket& p_Socket)
-        : m_SRP(0), m_Platform(BNet2::BATTLENET2_PLATFORM_BASE), m_Socket(p_Socket), m_CurrentPacket(NULL), m_State(BATTLENET2_SESSION_STATE_NONE)
+        : m_Platform(BNet2::BATTLENET2_PLATFORM_BASE), m_Socket(p_Socket), m_CurrentPacket(NULL), m_State(BATTLENET2_SESSION_STATE_NONE),
+        m_LifeToken(std::make_shared<bool>(true)), m_PendingRequests(0)
     {
 
     }
     /// Destructor
     Session::~Session()
     {
-        if (m_SRP)
-            delete m_SRP;
+
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -60,6 +60,10 @@ namespace BNet2 {
     /// On read
     void Session::OnRead(void)
     {
+        /// The data is kept in the socket buffer until the pending logon step completes
+        if (m_PendingRequests)
+            return;
+
         while (1)
         {
             uint32_t l_Size = GetSocket().recv_len();
@@ -123,6 +127,13 @@ namespace BNet2 {
                             m_CurrentPacket = NULL;
                             return;
                         }
+
+                        /// The handler went asynchronous, the next packets wait for its continuation
+                        if (m_PendingRequests)
+                        {
+                            m_CurrentPacket = NULL;
+                            return;
+                        }
                         break;
                     }
                 }
@@ -187,10 +198,7 @@ namespace BNet2 {
     /// Set SRP params
     void Session::SetSRPParams(const std::string & p_Salt, const std::string & p_AccountName, const std::string & p_PasswordHash)
     {
-        if (m_SRP)
-            delete m_SRP;
-
-        m_SRP = new SRP6a(p_Salt, p_AccountName, p_PasswordHash);
+        m_SRP = std::make_shared<SRP6a>(p_Salt, p_AccountName, p_PasswordHash);
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -208,7 +216,7 @@ namespace BNet2 {
     /// Get secure remote password computation helper
     SRP6a * Session::GetSRP()
     {
-        return m_SRP;
+        return m_SRP.get();
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -231,6 +239,39 @@ namespace BNet2 {
 
     //////////////////////////////////////////////////////////////////////////
 
+    /// Run p_Callback once the query result is ready, reads are suspended meanwhile
+    void Session::AsyncQuery(PreparedStatement * p_Statement, AuthLoginQueryCallback const& p_Callback)
+    {
+        ++m_PendingRequests;
+
+        sAuthLoginPipeline->AsyncQuery(p_Statement, m_LifeToken, [this, p_Callback](PreparedQueryResult p_Result) -> void
+        {
+            --m_PendingRequests;
+            p_Callback(p_Result);
+            ResumeRead();
+        });
+    }
+    /// Run p_Work on the login pipeline workers then p_Callback, reads are suspended meanwhile
+    void Session::Schedule(std::function<void()> const& p_Work, AuthLoginCallback const& p_Callback)
+    {
+        ++m_PendingRequests;
+
+        sAuthLoginPipeline->Schedule(p_Work, m_LifeToken, [this, p_Callback]() -> void
+        {
+            --m_PendingRequests;
+            p_Callback();
+            ResumeRead();
+        });
+    }
+    /// Handle the data received while a request was pending
+    void Session::ResumeRead()
+    {
+        if (!m_PendingRequests && GetSocket().recv_len())
+            OnRead();
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
     RealmSocket & Session::GetSocket(void)
     {
         return m_Socket;
@@ -327,121 +368,142 @@ namespace BNet2 {
         /// Have login
         if (p_Packet->ReadBits<bool>(1))
         {
-            std::string const & l_IPAddress = GetSocket().getRemoteAddress();
+            /// Read now, the packet doesn't outlive this handler
+            m_PendingLogon.AccountName  = p_Packet->ReadString(p_Packet->ReadBits<uint32_t>(9) + 3);
+            m_PendingLogon.Locale       = l_Locale;
 
             PreparedStatement* l_Stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_IP_BANNED);
-            l_Stmt->setString(0, l_IPAddress);
+            l_Stmt->setString(0, GetSocket().getRemoteAddress());
 
-            PreparedQueryResult l_Result = LoginDatabase.Query(l_Stmt);
-
-            if (l_Result)
-            {
-                SendAuthResult(BNet2::BATTLENET2_AUTH_ACCOUNT_TEMP_BANNED);
-                sLog->outDebug(LOG_FILTER_AUTHSERVER, "BNet2::Session::None_Handle_InformationRequest '%s:%d' Banned ip tries to login!", GetSocket().getRemoteAddress().c_str(), GetSocket().getRemotePort());
-                return true;
-            }
+            AsyncQuery(l_Stmt, std::bind(&Session::HandleIPBanResult, this, std::placeholders::_1));
+        }
 
-            std::string l_AccountName = p_Packet->ReadString(p_Packet->ReadBits<uint32_t>(9) + 3);
+        return true;
+    }
+    /// IP ban lookup of the logon
+    void Session::HandleIPBanResult(PreparedQueryResult p_Result)
+    {
+        if (p_Result)
+        {
+            SendAuthResult(BNet2::BATTLENET2_AUTH_ACCOUNT_TEMP_BANNED);
+            sLog->outDebug(LOG_FILTER_AUTHSERVER, "BNet2::Session::None_Handle_InformationRequest '%s:%d' Banned ip tries to login!", GetSocket().getRemoteAddress().c_str(), GetSocket().getRemotePort());
+            return;
+        }
 
-            l_Stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LOGONCHALLENGE);
-            l_Stmt->setString(0, l_AccountName);
+        PreparedStatement* l_Stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LOGONCHALLENGE);
+        l_Stmt->setString(0, m_PendingLogon.AccountName);
 
-            PreparedQueryResult l_Result_2 = LoginDatabase.Query(l_Stmt);
+        AsyncQuery(l_Stmt, std::bind(&Session::HandleAccountResult, this, std::placeholders::_1));
+    }
+    /// Account lookup of the logon
+    void Session::HandleAccountResult(PreparedQueryResult p_Result)
+    {
+        if (!p_Result)
+        {
+            SendAuthResult(BNet2::BATTLENET2_AUTH_BAD_INFOS);
+            return;
+        }
 
-            if (l_Result_2)
-            {
-                Field* l_Fields = l_Result_2->Fetch();
+        Field* l_Fields = p_Result->Fetch();
+        std::string const& l_IPAddress = GetSocket().getRemoteAddress();
 
-                // If the IP is 'locked', check that the player comes indeed from the correct IP address
-                bool l_Locked = false;
-                if (l_Fields[2].GetUInt16() == 1)                  // if ip is locked
-                {
-                    sLog->outDebug(LOG_FILTER_AUTHSERVER, "BNet2::Session::None_Handle_InformationRequest Account '%s' is locked to IP - '%s'", l_AccountName.c_str(), l_Fields[3].GetCString());
-                    sLog->outDebug(LOG_FILTER_AUTHSERVER, "BNet2::Session::None_Handle_InformationRequest Player address is '%s'", l_IPAddress.c_str());
+        // If the IP is 'locked', check that the player comes indeed from the correct IP address
+        if (l_Fields[2].GetUInt16() == 1)                  // if ip is locked
+        {
+            sLog->outDebug(LOG_FILTER_AUTHSERVER, "BNet2::Session::None_Handle_InformationRequest Account '%s' is locked to IP - '%s'", m_PendingLogon.AccountName.c_str(), l_Fields[3].GetCString());
+            sLog->outDebug(LOG_FILTER_AUTHSERVER, "BNet2::Session::None_Handle_InformationRequest Player address is '%s'", l_IPAddress.c_str());
 
-                    if (strcmp(l_Fields[4].GetCString(), l_IPAddress.c_str()) != 0)
-                    {
-                        sLog->outDebug(LOG_FILTER_AUTHSERVER, "[AuthChallenge] Account IP differs");
-                        SendAuthResult(BNet2::BATTLENET2_AUTH_CONNECT_METHOD_CHANGED);
-                        l_Locked = true;
-                    }
-                    else
-                        sLog->outDebug(LOG_FILTER_AUTHSERVER, "BNet2::Session::None_Handle_InformationRequest Account IP matches");
-                }
+            if (strcmp(l_Fields[4].GetCString(), l_IPAddress.c_str()) != 0)
+            {
+                sLog->outDebug(LOG_FILTER_AUTHSERVER, "[AuthChallenge] Account IP differs");
+                SendAuthResult(BNet2::BATTLENET2_AUTH_CONNECT_METHOD_CHANGED);
+                return;
+            }
+            else
+                sLog->outDebug(LOG_FILTER_AUTHSERVER, "BNet2::Session::None_Handle_InformationRequest Account IP matches");
+        }
 
-                if (!l_Locked)
-                {
-                    //set expired bans to inactive
-                    LoginDatabase.Execute(LoginDatabase.GetPreparedStatement(LOGIN_UPD_EXPIRED_ACCOUNT_BANS));
+        m_PendingLogon.AccountID        = l_Fields[1].GetUInt32();
+        m_PendingLogon.SecurityLevel    = l_Fields[4].GetUInt8();
+        m_PendingLogon.Verifier         = l_Fields[8].GetString();
+        m_PendingLogon.Salt             = l_Fields[9].GetString();
 
-                    // If the account is banned, reject the logon attempt
-                    l_Stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_ACCOUNT_BANNED);
-                    l_Stmt->setUInt32(0, l_Fields[1].GetUInt32());
+        //set expired bans to inactive
+        LoginDatabase.Execute(LoginDatabase.GetPreparedStatement(LOGIN_UPD_EXPIRED_ACCOUNT_BANS));
 
-                    PreparedQueryResult l_BanResult = LoginDatabase.Query(l_Stmt);
+        // If the account is banned, reject the logon attempt
+        PreparedStatement* l_Stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_ACCOUNT_BANNED);
+        l_Stmt->setUInt32(0, m_PendingLogon.AccountID);
 
-                    if (l_BanResult)
-                    {
-                        if ((*l_BanResult)[0].GetUInt32() == (*l_BanResult)[1].GetUInt32())
-                        {
-                            SendAuthResult(BNet2::BATTLENET2_AUTH_ACCOUNT_TEMP_BANNED);
-                            sLog->outDebug(LOG_FILTER_AUTHSERVER, "'%s:%d' BNet2::Session::None_Handle_InformationRequest Banned account %s tried to login!", GetSocket().getRemoteAddress().c_str(), GetSocket().getRemotePort(), l_AccountName.c_str());
-                        }
-                        else
-                        {
-                            SendAuthResult(BNet2::BATTLENET2_AUTH_ACCOUNT_TEMP_BANNED);
-                            sLog->outDebug(LOG_FILTER_AUTHSERVER, "'%s:%d' BNet2::Session::None_Handle_InformationRequest Temporarily banned account %s tried to login!", GetSocket().getRemoteAddress().c_str(), GetSocket().getRemotePort(), l_AccountName.c_str());
-                        }
-                    }
-                    else
-                    {
-                        SetSRPParams(l_Fields[9].GetString(), l_AccountName, l_Fields[8].GetString());
-                        GetSRP()->ComputePublicB();
+        AsyncQuery(l_Stmt, std::bind(&Session::HandleAccountBanResult, this, std::placeholders::_1));
+    }
+    /// Account ban lookup of the logon
+    void Session::HandleAccountBanResult(PreparedQueryResult p_Result)
+    {
+        if (p_Result)
+        {
+            if ((*p_Result)[0].GetUInt32() == (*p_Result)[1].GetUInt32())
+            {
+                SendAuthResult(BNet2::BATTLENET2_AUTH_ACCOUNT_TEMP_BANNED);
+                sLog->outDebug(LOG_FILTER_AUTHSERVER, "'%s:%d' BNet2::Session::None_Handle_InformationRequest Banned account %s tried to login!", GetSocket().getRemoteAddress().c_str(), GetSocket().getRemotePort(), m_PendingLogon.AccountName.c_str());
+            }
+            else
+            {
+                SendAuthResult(BNet2::BATTLENET2_AUTH_ACCOUNT_TEMP_BANNED);
+                sLog->outDebug(LOG_FILTER_AUTHSERVER, "'%s:%d' BNet2::Session::None_Handle_InformationRequest Temporarily banned account %s tried to login!", GetSocket().getRemoteAddress().c_str(), GetSocket().getRemotePort(), m_PendingLogon.AccountName.c_str());
+            }
 
-                        std::list<BNet2::Module::Ptr> l_Modules = BNet2::ModuleManager::GetSingleton()->GetPlatformModules(GetClientPlatform());
+            return;
+        }
 
-                        BNet2::Packet l_ProofRequest(BNet2::SMSG_PROOF_REQUEST);
+        /// The modular exponentiation of B is the expensive part of the challenge, done by the pipeline workers
+        std::shared_ptr<SRP6a> l_SRP = std::make_shared<SRP6a>(m_PendingLogon.Salt, m_PendingLogon.AccountName, m_PendingLogon.Verifier);
 
-                        l_ProofRequest.WriteBits(2, 3); ///< Modules count
+        Schedule([l_SRP]() -> void
+        {
+            l_SRP->ComputePublicB();
+        },
+        std::bind(&Session::HandlePublicBComputed, this, l_SRP));
+    }
+    /// SRP6 challenge computed, send the proof request
+    void Session::HandlePublicBComputed(std::shared_ptr<SRP6a> const& p_SRP)
+    {
+        m_SRP = p_SRP;
 
-                        for (std::list<BNet2::Module::Ptr>::iterator l_It = l_Modules.begin(); l_It != l_Modules.end(); l_It++)
-                        {
-                            switch ((*l_It)->GetID())
-                            {
-                                case WOW_PASSWORD_AUTH_MODULE_ID:
-                                case WOW_THUMBPRINT_AUTH_MODULE_ID:
-                                    l_ProofRequest.WriteFourCC((*l_It)->GetTypeStr());
-                                    l_ProofRequest.WriteFourCC_BattleGroup("XX");
-                                    l_ProofRequest.AppendByteArray((*l_It)->GetHashData(), (*l_It)->GetHashDataSize());
-                                    l_ProofRequest.WriteBits((*l_It)->GetSize(this), 10);
-
-                                    (*l_It)->Write(this, &l_ProofRequest);
-                                    break;
-
-                                default:
-                                    break;
-                            }
-                        }
+        std::list<BNet2::Module::Ptr> l_Modules = BNet2::ModuleManager::GetSingleton()->GetPlatformModules(GetClientPlatform());
 
-                        Send(&l_ProofRequest);
+        BNet2::Packet l_ProofRequest(BNet2::SMSG_PROOF_REQUEST);
 
-                        m_AccountName           = l_AccountName;
-                        m_AccountID             = l_Fields[1].GetUInt32();
-                        m_AccountSecurityLevel  = l_Fields[4].GetUInt8() <= SEC_ADMINISTRATOR ? AccountTypes(l_Fields[4].GetUInt8()) : SEC_ADMINISTRATOR;
-                        m_Locale                = l_Locale;
+        l_ProofRequest.WriteBits(2, 3); ///< Modules count
 
-                        sLog->outDebug(LOG_FILTER_AUTHSERVER, "'%s:%d' BNet2::Session::None_Handle_InformationRequest account %s is using '%s' locale (%u)", GetSocket().getRemoteAddress().c_str(), GetSocket().getRemotePort(),
-                            l_AccountName.c_str(), l_Locale.c_str(), GetLocaleByName(l_Locale));
-                    }
-                }
-            }
-            else
+        for (std::list<BNet2::Module::Ptr>::iterator l_It = l_Modules.begin(); l_It != l_Modules.end(); l_It++)
+        {
+            switch ((*l_It)->GetID())
             {
-                SendAuthResult(BNet2::BATTLENET2_AUTH_BAD_INFOS);
+                case WOW_PASSWORD_AUTH_MODULE_ID:
+                case WOW_THUMBPRINT_AUTH_MODULE_ID:
+                    l_ProofRequest.WriteFourCC((*l_It)->GetTypeStr());
+                    l_ProofRequest.WriteFourCC_BattleGroup("XX");
+                    l_ProofRequest.AppendByteArray((*l_It)->GetHashData(), (*l_It)->GetHashDataSize());
+                    l_ProofRequest.WriteBits((*l_It)->GetSize(this), 10);
+
+                    (*l_It)->Write(this, &l_ProofRequest);
+                    break;
+
+                default:
+                    break;
             }
         }
 
-        return true;
+        Send(&l_ProofRequest);
+
+        m_AccountName           = m_PendingLogon.AccountName;
+        m_AccountID             = m_PendingLogon.AccountID;
+        m_AccountSecurityLevel  = m_PendingLogon.SecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(m_PendingLogon.SecurityLevel) : SEC_ADMINISTRATOR;
+        m_Locale                = m_PendingLogon.Locale;
+
+        sLog->outDebug(LOG_FILTER_AUTHSERVER, "'%s:%d' BNet2::Session::None_Handle_InformationRequest account %s is using '%s' locale (%u)", GetSocket().getRemoteAddress().c_str(), GetSocket().getRemotePort(),
+            m_AccountName.c_str(), m_Locale.c_str(), GetLocaleByName(m_Locale));
     }
     /// Authentication client request
     bool Session::None_Handle_ProofResponse(BNet2::Packet * p_Packet)
@@ -472,47 +534,32 @@ namespace BNet2 {
                     p_Packet->ReadBytes(l_M1,                   SHA256_DIGEST_LENGTH);
                     p_Packet->ReadBytes(l_ClientChallenge,  4 * SHA256_DIGEST_LENGTH);
 
-                    GetSRP()->ComputeU(         l_A,    4 * SHA256_DIGEST_LENGTH);
-                    GetSRP()->ComputeClientM(   l_A,    4 * SHA256_DIGEST_LENGTH);
-
-                    if (GetSRP()->Compare(GetSRP()->ClientM, l_M1, SHA256_DIGEST_LENGTH))
-                    {
-                        GetSRP()->ComputeServerM(l_M1, SHA256_DIGEST_LENGTH);
-
-                        m_State = BATTLENET2_SESSION_STATE_PROOF_VERIFICATION;
+                    if (!m_SRP)
+                        return false;
 
-                        std::list<BNet2::Module::Ptr> l_Modules = BNet2::ModuleManager::GetSingleton()->GetPlatformModules(GetClientPlatform());
+                    std::shared_ptr<SRP6a> l_SRP = m_SRP;
+                    std::shared_ptr<std::vector<uint8_t>> l_Proof = std::make_shared<std::vector<uint8_t>>(l_A, l_A + sizeof(l_A));
+                    l_Proof->insert(l_Proof->end(), l_M1, l_M1 + sizeof(l_M1));
+                    std::shared_ptr<bool> l_Valid = std::make_shared<bool>(false);
 
-                        BNet2::Packet l_ProofVerification(BNet2::SMSG_PROOF_REQUEST);
+                    /// S = (A * v^u)^b is the expensive part of the proof, done by the pipeline workers
+                    Schedule([l_SRP, l_Proof, l_Valid]() -> void
+                    {
+                        uint8_t* l_ClientA  = l_Proof->data();
+                        uint8_t* l_ClientM1 = l_Proof->data() + 4 * SHA256_DIGEST_LENGTH;
 
-                        l_ProofVerification.WriteBits(2, 3); ///< Modules count
+                        l_SRP->ComputeU(        l_ClientA,  4 * SHA256_DIGEST_LENGTH);
+                        l_SRP->ComputeClientM(  l_ClientA,  4 * SHA256_DIGEST_LENGTH);
 
-                        for (std::list<BNet2::Module::Ptr>::iterator l_It = l_Modules.begin(); l_It != l_Modules.end(); l_It++)
-                        {
-                            switch ((*l_It)->GetID())
-                            {
-                                case WOW_PASSWORD_AUTH_MODULE_ID:
-                                case WOW_RISKFINGERPRINT_AUTH_MODULE_ID:
-                                    l_ProofVerification.WriteFourCC((*l_It)->GetTypeStr());
-                                    l_ProofVerification.WriteFourCC_BattleGroup("XX");
-                                    l_ProofVerification.AppendByteArray((*l_It)->GetHashData(), (*l_It)->GetHashDataSize());
-                                    l_ProofVerification.WriteBits((*l_It)->GetSize(this), 10);
-
-                                    (*l_It)->Write(this, &l_ProofVerification);
-                                    break;
-
-                                default:
-                                    break;
-                            }
-                        }
+                        *l_Valid = l_SRP->Compare(l_SRP->ClientM, l_ClientM1, SHA256_DIGEST_LENGTH);
 
-                        Send(&l_ProofVerification);
-                    }
-                    else
+                        if (*l_Valid)
+                            l_SRP->ComputeServerM(l_ClientM1, SHA256_DIGEST_LENGTH);
+                    },
+                    [this, l_Valid]() -> void
                     {
-                        SendAuthResult(BNet2::BATTLENET2_AUTH_BAD_INFOS);
-                        return false;
-                    }
+                        HandleProofComputed(*l_Valid);
+                    });
 
                     break;
                 }
@@ -525,6 +572,45 @@ namespace BNet2 {
 
         return true;
     }
+    /// SRP6 proof checked, send the proof verification
+    void Session::HandleProofComputed(bool p_Valid)
+    {
+        if (!p_Valid)
+        {
+            SendAuthResult(BNet2::BATTLENET2_AUTH_BAD_INFOS);
+            GetSocket().shutdown();
+            return;
+        }
+
+        m_State = BATTLENET2_SESSION_STATE_PROOF_VERIFICATION;
+
+        std::list<BNet2::Module::Ptr> l_Modules = BNet2::ModuleManager::GetSingleton()->GetPlatformModules(GetClientPlatform());
+
+        BNet2::Packet l_ProofVerification(BNet2::SMSG_PROOF_REQUEST);
+
+        l_ProofVerification.WriteBits(2, 3); ///< Modules count
+
+        for (std::list<BNet2::Module::Ptr>::iterator l_It = l_Modules.begin(); l_It != l_Modules.end(); l_It++)
+        {
+            switch ((*l_It)->GetID())
+            {
+                case WOW_PASSWORD_AUTH_MODULE_ID:
+                case WOW_RISKFINGERPRINT_AUTH_MODULE_ID:
+                    l_ProofVerification.WriteFourCC((*l_It)->GetTypeStr());
+                    l_ProofVerification.WriteFourCC_BattleGroup("XX");
+                    l_ProofVerification.AppendByteArray((*l_It)->GetHashData(), (*l_It)->GetHashDataSize());
+                    l_ProofVerification.WriteBits((*l_It)->GetSize(this), 10);
+
+                    (*l_It)->Write(this, &l_ProofVerification);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        Send(&l_ProofVerification);
+    }
 
     //////////////////////////////////////////////////////////////////////////
 
@@ -565,7 +651,7 @@ namespace BNet2 {
 
         l_Stmt->setString(4, m_AccountName);
 
-        LoginDatabase.Query(l_Stmt);
+        LoginDatabase.Execute(l_Stmt);
 
         return true;
     }
@@ -755,14 +841,19 @@ namespace BNet2 {
         l_Stmt->setString(3, l_PlateformName);
         l_Stmt->setString(4, m_AccountName);
 
-        LoginDatabase.Query(l_Stmt);
-
+        /// The world server reads the session key as soon as the client connects, answer once it's saved
+        AsyncQuery(l_Stmt, std::bind(&Session::HandleSessionKeySaved, this, *(uint32_t*)l_ServerSalt, l_Index));
+        return true;
+    }
+    /// Session key saved, send the realm address
+    void Session::HandleSessionKeySaved(uint32_t p_ServerSalt, uint32_t p_RealmIndex)
+    {
         Realm const* l_RealmRequested   = nullptr;
         uint32_t     l_RealmCounter     = 0;
 
         for (RealmList::RealmMap::const_iterator l_It = sRealmList->begin(); l_It != sRealmList->end(); ++l_It)
         {
-            if (l_Index == l_It->second.m_ID)
+            if (p_RealmIndex == l_It->second.m_ID)
             {
                 l_RealmCounter      = 1;
                 l_RealmRequested    = &l_It->second;
@@ -771,7 +862,10 @@ namespace BNet2 {
         }
 
         if (!l_RealmRequested)
-            return false;
+        {
+            GetSocket().shutdown();
+            return;
+        }
 
 //         sReporter->Report(MS::Reporting::MakeReport<MS::Reporting::Opcodes::AuthChooseRealm>::Craft
 //         (
@@ -798,7 +892,7 @@ namespace BNet2 {
 
         BNet2::Packet l_Buffer(BNet2::SMSG_JOIN_RESPONSE);
         l_Buffer.WriteBits(l_LockStatus, 1);                        ///< Response code
-        l_Buffer.WriteBits(*(uint32_t*)l_ServerSalt, 32);           ///< ServerSalt
+        l_Buffer.WriteBits(p_ServerSalt, 32);                       ///< ServerSalt
         l_Buffer.WriteBits(l_LockStatus ? 0 : l_RealmCounter, 5);   ///< RealmCounter
         l_Buffer.FlushBits();
 
@@ -822,6 +916,5 @@ namespace BNet2 {
         l_Buffer.WriteBits(0, 5);
 
         Send(&l_Buffer);
-        return true;
     }
 }
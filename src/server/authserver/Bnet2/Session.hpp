@@ -6,6 +6,7 @@
 #include "Packet.hpp"
 #include "BNet2Crypt.hpp"
 #include "../Server/RealmSocket.h"
+#include "../Server/AuthLoginPipeline.h"
 
 namespace BNet2 {
 
@@ -19,6 +20,19 @@ namespace BNet2 {
 
     static std::map<uint16, std::string> g_VersionStrByBuild;
 
+    /// Account row kept between the asynchronous logon queries
+    struct PendingLogon
+    {
+        PendingLogon() : AccountID(0), SecurityLevel(0) { }
+
+        std::string AccountName;
+        uint32_t AccountID;
+        uint8_t SecurityLevel;
+        std::string Salt;
+        std::string Verifier;
+        std::string Locale;
+    };
+
     /// Battle net 2 session
     class Session : public RealmSocket::Session
     {
@@ -54,6 +68,21 @@ namespace BNet2 {
             /// Wait N bytes and append it to the current packet
             void WaitBytes(uint32_t p_Count);
 
+            /// Run p_Callback once the query result is ready, reads are suspended meanwhile
+            void AsyncQuery(PreparedStatement * p_Statement, AuthLoginQueryCallback const& p_Callback);
+            /// Run p_Work on the login pipeline workers then p_Callback, reads are suspended meanwhile
+            void Schedule(std::function<void()> const& p_Work, AuthLoginCallback const& p_Callback);
+            /// Handle the data received while a request was pending
+            void ResumeRead();
+
+            /// Logon continuations, run on the reactor thread
+            void HandleIPBanResult(PreparedQueryResult p_Result);
+            void HandleAccountResult(PreparedQueryResult p_Result);
+            void HandleAccountBanResult(PreparedQueryResult p_Result);
+            void HandlePublicBComputed(std::shared_ptr<SRP6a> const& p_SRP);
+            void HandleProofComputed(bool p_Valid);
+            void HandleSessionKeySaved(uint32_t p_ServerSalt, uint32_t p_RealmIndex);
+
             /// Get socket
             RealmSocket & GetSocket(void);
 
@@ -80,7 +109,7 @@ namespace BNet2 {
 
         private:
             SessionState    m_State;            ///< Session state
-            SRP6a       *   m_SRP;              ///< Secure remote password
+            std::shared_ptr<SRP6a> m_SRP;       ///< Secure remote password, shared with the login pipeline workers
             Platforms       m_Platform;         ///< Client platform
             BNet2Crypt      m_BNet2Crypt;       ///< Battle Net 2 crypt system
 
@@ -93,6 +122,10 @@ namespace BNet2 {
             int32_t m_AccountSecurityLevel;
             std::string m_Locale;
 
+            PendingLogon m_PendingLogon;
+            std::shared_ptr<bool> m_LifeToken;  ///< Expires with the session, drops its pending continuations
+            uint32_t m_PendingRequests;         ///< Asynchronous queries / SRP6 jobs in flight
+
     };
 
 }
\ No newline at end of file
@@ -35,6 +35,7 @@
 #include "SignalHandler.h"
 #include "RealmList.h"
 #include "RealmAcceptor.h"
+#include "AuthLoginPipeline.h"
 #include "Bnet2/WoWModules/PasswordAuth.hpp"
 #include "Bnet2/WoWModules/RiskFingerprintAuth.hpp"
 #include "Bnet2/WoWModules/ThumbprintAuth.hpp"
@@ -210,6 +211,16 @@ extern int main(int argc, char **argv)
         return 1;
     }
 
+    // Logon database lookups and SRP6 math are kept off the reactor thread
+    int32 loginWorkers = ConfigMgr::GetIntDefault("LoginPipeline.WorkerThreads", 2);
+    if (loginWorkers < 0)
+    {
+        sLog->outError(LOG_FILTER_AUTHSERVER, "Improper value specified for LoginPipeline.WorkerThreads, defaulting to 0.");
+        loginWorkers = 0;
+    }
+
+    sAuthLoginPipeline->Initialize(ACE_Reactor::instance(), uint32(loginWorkers));
+
     ///- Initializing the Reporter.
     //sLog->outInfo(LOG_FILTER_WORLDSERVER, "REPORTER: Creating instance.");
     //sReporter->SetAddresses({ ConfigMgr::GetStringDefault("ReporterAddress", "localhost:3000") });
@@ -281,6 +292,8 @@ extern int main(int argc, char **argv)
         }
     }
 
+    sAuthLoginPipeline->Shutdown();
+
     // Close the Database Pool and library
     StopDB();
 
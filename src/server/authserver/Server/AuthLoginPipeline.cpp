@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AuthLoginPipeline.h"
+#include "Log.h"
+
+#include <openssl/crypto.h>
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+/// OpenSSL < 1.1 is only thread safe once the locking callbacks are set (BN_rand, RAND_bytes...)
+namespace
+{
+    std::vector<std::mutex*> g_CryptoLocks;
+
+    void CryptoLockingCallback(int p_Mode, int p_Type, char const* /*p_File*/, int /*p_Line*/)
+    {
+        if (p_Mode & CRYPTO_LOCK)
+            g_CryptoLocks[p_Type]->lock();
+        else
+            g_CryptoLocks[p_Type]->unlock();
+    }
+
+    void CryptoThreadIdCallback(CRYPTO_THREADID* p_Id)
+    {
+        CRYPTO_THREADID_set_numeric(p_Id, (unsigned long)std::hash<std::thread::id>()(std::this_thread::get_id()));
+    }
+
+    void CryptoThreadsSetup()
+    {
+        for (int l_I = 0; l_I < CRYPTO_num_locks(); ++l_I)
+            g_CryptoLocks.push_back(new std::mutex());
+
+        CRYPTO_THREADID_set_callback(CryptoThreadIdCallback);
+        CRYPTO_set_locking_callback(CryptoLockingCallback);
+    }
+
+    void CryptoThreadsCleanup()
+    {
+        CRYPTO_set_locking_callback(NULL);
+        CRYPTO_THREADID_set_callback(NULL);
+
+        for (std::mutex* l_Lock : g_CryptoLocks)
+            delete l_Lock;
+
+        g_CryptoLocks.clear();
+    }
+}
+#endif
+
+void AuthLoginQuery::update(ACE_Future<PreparedQueryResult> const& p_Future)
+{
+    /// Database worker thread, the value is set so get() doesn't block
+    p_Future.get(m_Result);
+    m_Pipeline->PostQuery(this);
+}
+
+AuthLoginPipeline::AuthLoginPipeline()
+    : m_Reactor(NULL), m_Stopped(false), m_NotifyPending(false), m_Pending(0), m_Completed(0)
+{
+}
+
+AuthLoginPipeline::~AuthLoginPipeline()
+{
+    Shutdown();
+}
+
+void AuthLoginPipeline::Initialize(ACE_Reactor* p_Reactor, uint32 p_WorkerCount)
+{
+    m_Reactor = p_Reactor;
+    reactor(p_Reactor);
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+    if (p_WorkerCount)
+        CryptoThreadsSetup();
+#endif
+
+    for (uint32 l_I = 0; l_I < p_WorkerCount; ++l_I)
+        m_WorkerThreads.push_back(std::thread(&AuthLoginPipeline::WorkerThread, this));
+
+    sLog->outInfo(LOG_FILTER_AUTHSERVER, "Login pipeline started with %u SRP6 worker threads", p_WorkerCount);
+}
+
+void AuthLoginPipeline::Shutdown()
+{
+    if (m_Stopped.exchange(true))
+        return;
+
+    m_JobQueue.Cancel();
+
+    for (std::thread& l_Thread : m_WorkerThreads)
+        l_Thread.join();
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+    if (!m_WorkerThreads.empty())
+        CryptoThreadsCleanup();
+#endif
+
+    m_WorkerThreads.clear();
+
+    /// Continuations that never ran, the sockets are gone with the reactor
+    std::lock_guard<std::mutex> l_Guard(m_ReadyLock);
+
+    for (AuthLoginJob* l_Job : m_ReadyJobs)
+        delete l_Job;
+
+    m_ReadyJobs.clear();
+    m_ReadyQueries.clear();
+}
+
+void AuthLoginPipeline::AsyncQuery(PreparedStatement* p_Statement, AuthLoginOwner const& p_Owner, AuthLoginQueryCallback const& p_Callback)
+{
+    AuthLoginQuery* l_Query = new AuthLoginQuery(this, p_Owner, p_Callback);
+    ++m_Pending;
+
+    /// update() is called right away if the result is already there
+    l_Query->Future = LoginDatabase.AsyncQuery(p_Statement);
+    l_Query->Future.attach(l_Query);
+}
+
+void AuthLoginPipeline::Schedule(std::function<void()> const& p_Work, AuthLoginOwner const& p_Owner, AuthLoginCallback const& p_Callback)
+{
+    AuthLoginJob* l_Job = new AuthLoginJob(p_Work, p_Owner, p_Callback);
+    ++m_Pending;
+
+    if (m_WorkerThreads.empty())
+    {
+        l_Job->Work();
+        PostJob(l_Job);
+        return;
+    }
+
+    m_JobQueue.Push(l_Job);
+}
+
+void AuthLoginPipeline::PostQuery(AuthLoginQuery* p_Query)
+{
+    {
+        std::lock_guard<std::mutex> l_Guard(m_ReadyLock);
+        m_ReadyQueries.push_back(p_Query);
+    }
+
+    WakeUp();
+}
+
+void AuthLoginPipeline::PostJob(AuthLoginJob* p_Job)
+{
+    {
+        std::lock_guard<std::mutex> l_Guard(m_ReadyLock);
+        m_ReadyJobs.push_back(p_Job);
+    }
+
+    WakeUp();
+}
+
+void AuthLoginPipeline::WakeUp()
+{
+    if (m_Stopped || !m_Reactor)
+        return;
+
+    if (m_NotifyPending.exchange(true))
+        return;
+
+    if (m_Reactor->notify(this, ACE_Event_Handler::EXCEPT_MASK) == -1)
+    {
+        m_NotifyPending = false;
+        sLog->outError(LOG_FILTER_AUTHSERVER, "AuthLoginPipeline::WakeUp: reactor notification failed");
+    }
+}
+
+int AuthLoginPipeline::handle_exception(ACE_HANDLE /*p_Handle*/)
+{
+    /// Cleared first, anything posted while we run the continuations gets its own notification
+    m_NotifyPending = false;
+
+    std::vector<AuthLoginQuery*> l_Queries;
+    std::vector<AuthLoginJob*> l_Jobs;
+
+    {
+        std::lock_guard<std::mutex> l_Guard(m_ReadyLock);
+        l_Queries.swap(m_ReadyQueries);
+        l_Jobs.swap(m_ReadyJobs);
+    }
+
+    for (AuthLoginQuery* l_Query : l_Queries)
+    {
+        --m_Pending;
+        ++m_Completed;
+
+        /// Expired owner, the socket has been closed while the query was running
+        if (std::shared_ptr<void> l_Owner = l_Query->m_Owner.lock())
+            l_Query->m_Callback(l_Query->m_Result);
+
+        delete l_Query;
+    }
+
+    for (AuthLoginJob* l_Job : l_Jobs)
+    {
+        --m_Pending;
+        ++m_Completed;
+
+        if (std::shared_ptr<void> l_Owner = l_Job->Owner.lock())
+            l_Job->Callback();
+
+        delete l_Job;
+    }
+
+    return 0;
+}
+
+void AuthLoginPipeline::WorkerThread()
+{
+    while (true)
+    {
+        AuthLoginJob* l_Job = NULL;
+
+        m_JobQueue.WaitAndPop(l_Job);
+
+        if (m_Stopped)
+        {
+            delete l_Job;
+            return;
+        }
+
+        if (!l_Job)
+            continue;
+
+        /// Nobody is waiting for the result anymore
+        if (!l_Job->Owner.expired())
+            l_Job->Work();
+
+        PostJob(l_Job);
+    }
+}
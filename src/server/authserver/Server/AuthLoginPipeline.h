@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _AUTH_LOGIN_PIPELINE_H
+#define _AUTH_LOGIN_PIPELINE_H
+
+#include "Common.h"
+#include "Database/DatabaseEnv.h"
+#include "Threading/ProducerConsumerQueue.h"
+
+#include <ace/Event_Handler.h>
+#include <ace/Future.h>
+#include <ace/Reactor.h>
+
+#include <functional>
+#include <memory>
+#include <thread>
+
+/// Continuation run on the reactor thread
+typedef std::function<void()> AuthLoginCallback;
+/// Continuation of an asynchronous query, run on the reactor thread
+typedef std::function<void(PreparedQueryResult)> AuthLoginQueryCallback;
+/// Continuations are dropped once the owner token expired (socket closed), the owner keeps the shared_ptr
+typedef std::weak_ptr<void> AuthLoginOwner;
+
+class AuthLoginPipeline;
+
+/// One asynchronous login query waiting for its result
+/// Notified by the database worker thread, then consumed and deleted by the reactor thread
+class AuthLoginQuery : public ACE_Future_Observer<PreparedQueryResult>
+{
+    public:
+        AuthLoginQuery(AuthLoginPipeline* p_Pipeline, AuthLoginOwner const& p_Owner, AuthLoginQueryCallback const& p_Callback)
+            : m_Pipeline(p_Pipeline), m_Owner(p_Owner), m_Callback(p_Callback) { }
+
+        void update(ACE_Future<PreparedQueryResult> const& p_Future) override;
+
+        PreparedQueryResultFuture Future;
+
+    private:
+        friend class AuthLoginPipeline;
+
+        AuthLoginPipeline* m_Pipeline;
+        AuthLoginOwner m_Owner;
+        AuthLoginQueryCallback m_Callback;
+        PreparedQueryResult m_Result;
+};
+
+/// CPU bound job (SRP6 math) run by the pipeline workers, its callback is then run on the reactor thread
+struct AuthLoginJob
+{
+    AuthLoginJob(std::function<void()> const& p_Work, AuthLoginOwner const& p_Owner, AuthLoginCallback const& p_Callback)
+        : Work(p_Work), Owner(p_Owner), Callback(p_Callback) { }
+
+    std::function<void()> Work;         ///< Must only touch data it owns, the session can be destroyed meanwhile
+    AuthLoginOwner Owner;
+    AuthLoginCallback Callback;
+};
+
+/// Keeps the reactor thread free of blocking work during the logon handshake
+/// - Login database lookups are issued as asynchronous queries and continued when the database worker sets the result
+/// - SRP6 modular exponentiations run on a small worker pool
+/// Every continuation is handed back to the reactor thread through a reactor notification, so sessions
+/// and sockets are still only touched by the reactor thread
+class AuthLoginPipeline : public ACE_Event_Handler
+{
+    public:
+        AuthLoginPipeline();
+        ~AuthLoginPipeline();
+
+        /// p_WorkerCount 0 runs the jobs inline on the reactor thread
+        void Initialize(ACE_Reactor* p_Reactor, uint32 p_WorkerCount);
+        void Shutdown();
+
+        /// Reactor thread only, p_Statement is owned by the pipeline from now on
+        void AsyncQuery(PreparedStatement* p_Statement, AuthLoginOwner const& p_Owner, AuthLoginQueryCallback const& p_Callback);
+        /// Reactor thread only
+        void Schedule(std::function<void()> const& p_Work, AuthLoginOwner const& p_Owner, AuthLoginCallback const& p_Callback);
+
+        /// Any thread, queue a finished query / job and wake the reactor up
+        void PostQuery(AuthLoginQuery* p_Query);
+        void PostJob(AuthLoginJob* p_Job);
+
+        /// Reactor notification, runs the pending continuations
+        int handle_exception(ACE_HANDLE p_Handle) override;
+
+        uint32 GetWorkerCount() const { return uint32(m_WorkerThreads.size()); }
+        uint64 GetPendingCount() const { return m_Pending; }
+        uint64 GetCompletedCount() const { return m_Completed; }
+
+    private:
+        void WorkerThread();
+        void WakeUp();
+
+        ACE_Reactor* m_Reactor;
+        std::atomic<bool> m_Stopped;
+        std::atomic<bool> m_NotifyPending;      ///< One reactor notification in flight at most, avoids filling the notify pipe
+
+        ProducerConsumerQueue<AuthLoginJob*> m_JobQueue;
+        std::vector<std::thread> m_WorkerThreads;
+
+        std::mutex m_ReadyLock;
+        std::vector<AuthLoginQuery*> m_ReadyQueries;
+        std::vector<AuthLoginJob*> m_ReadyJobs;
+
+        std::atomic<uint64> m_Pending;
+        std::atomic<uint64> m_Completed;
+};
+
+#define sAuthLoginPipeline ACE_Singleton<AuthLoginPipeline, ACE_Null_Mutex>::instance()
+
+#endif
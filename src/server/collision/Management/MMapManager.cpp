@@ -119,67 +119,53 @@ namespace MMAP
 
     bool MMapManager::loadMap(const std::string& /*basePath*/, uint32 mapId, int32 x, int32 y)
     {
-        // make sure the mmap is loaded and ready to load tiles
-        if (!loadMapData(mapId))
-            return false;
+        return loadMap(mapId, x, y, nullptr);
+    }
 
-        // get this mmap data
-        MMapData* mmap = loadedMMaps[mapId];
-        ASSERT(mmap->navMesh);
+    bool MMapManager::loadMap(uint32 mapId, int32 x, int32 y, PhasedTile* p_Tile)
+    {
+        ACE_Write_Guard<ACE_RW_Thread_Mutex> l_Guard(m_NavMeshLock);
 
+        // make sure the mmap is loaded and ready to load tiles
         // check if we already have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
-        if (mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end())
-            return false;
-
-        // load this tile :: mmaps/MMMMXXYY.mmtile
-        char l_Buffer[4096];
-        sprintf(l_Buffer, TILE_FILE_NAME_FORMAT, ConfigMgr::GetStringDefault("DataDir", ".").c_str(), mapId, x, y);
-        std::string fileName = l_Buffer;
-        FILE* file = fopen(fileName.c_str(), "rb");
-        if (!file)
+        if (!loadMapData(mapId) || loadedMMaps[mapId]->loadedTileRefs.find(packedGridPos) != loadedMMaps[mapId]->loadedTileRefs.end())
         {
-            sLog->outDebug(LOG_FILTER_GENERAL, "MMAP:loadMap: Could not open mmtile file '%s'", fileName.c_str());
-            return false;
-        }
+            if (p_Tile)
+            {
+                dtFree(p_Tile->data);
+                delete p_Tile;
+            }
 
-        // read header
-        MmapTileHeader fileHeader;
-        if (fread(&fileHeader, sizeof(MmapTileHeader), 1, file) != 1 || fileHeader.mmapMagic != MMAP_MAGIC)
-        {
-            sLog->outError(LOG_FILTER_GENERAL, "MMAP:loadMap: Bad header in mmap %04u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
             return false;
         }
 
-        if (fileHeader.mmapVersion != MMAP_VERSION)
-        {
-            sLog->outError(LOG_FILTER_GENERAL, "MMAP:loadMap: %04u%02i%02i.mmtile was built with generator v%i, expected v%i",
-                mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
-            fclose(file);
-            return false;
-        }
+        // get this mmap data
+        MMapData* mmap = loadedMMaps[mapId];
+        ASSERT(mmap->navMesh);
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
-        ASSERT(data);
+        // load this tile :: mmaps/MMMMXXYY.mmtile, unless the grid preloader already read it
+        if (!p_Tile)
+            p_Tile = LoadTile(mapId, x, y);
 
-        size_t result = fread(data, fileHeader.size, 1, file);
-        if (!result)
+        if (!p_Tile)
         {
-            sLog->outError(LOG_FILTER_GENERAL, "MMAP:loadMap: Bad header or data in mmap %04u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
+            sLog->outDebug(LOG_FILTER_GENERAL, "MMAP:loadMap: Could not load mmtile %04u%02i%02i.mmtile", mapId, x, y);
             return false;
         }
 
-        fclose(file);
+        unsigned char* data = p_Tile->data;
+        int32 dataSize = p_Tile->fileHeader.size;
+        delete p_Tile;
 
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
+        if (dtStatusSucceed(mmap->navMesh->addTile(data, dataSize, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            mmap->tileGeneration = ++m_TileGenerationCounter;
             ++loadedTiles;
             sLog->outDebug(LOG_FILTER_GENERAL, "MMAP:loadMap: Loaded mmtile %04i[%02i, %02i] into %04i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
 
@@ -238,6 +224,7 @@ namespace MMAP
         {
             sLog->outError(LOG_FILTER_GENERAL, "MMAP:LoadTile: Bad header or data in mmap %04u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
+            dtFree(pTile->data);
             delete pTile;
             return nullptr;
         }
@@ -289,6 +276,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
+        ACE_Write_Guard<ACE_RW_Thread_Mutex> l_Guard(m_NavMeshLock);
+
         // check if we have this map loaded
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
@@ -323,6 +312,7 @@ namespace MMAP
         else
         {
             mmap->loadedTileRefs.erase(packedGridPos);
+            mmap->tileGeneration = ++m_TileGenerationCounter;
             --loadedTiles;
             sLog->outDebug(LOG_FILTER_GENERAL, "MMAP:unloadMap: Unloaded mmtile %03i[%02i, %02i] from %04i", mapId, x, y, mapId);
 
@@ -337,6 +327,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId)
     {
+        ACE_Write_Guard<ACE_RW_Thread_Mutex> l_Guard(m_NavMeshLock);
+
         MMapDataSet::iterator itr = loadedMMaps.find(mapId);
         if (itr == loadedMMaps.end() || !itr->second)
         {
@@ -432,10 +424,48 @@ namespace MMAP
         return mmap->navMeshQueries[instanceId];
     }
 
+    dtNavMeshQuery const* MMapManager::GetWorkerNavMeshQuery(uint32 p_MapId, uint32 p_WorkerId)
+    {
+        MMapDataSet::const_iterator l_Itr = GetMMapData(p_MapId);
+        if (l_Itr == loadedMMaps.end())
+            return nullptr;
+
+        MMapData* l_MMap = l_Itr->second;
+
+        std::lock_guard<std::mutex> l_Lock(m_WorkerQueryLock);
+
+        NavMeshQuerySet::const_iterator l_QueryItr = l_MMap->workerQueries.find(p_WorkerId);
+        if (l_QueryItr != l_MMap->workerQueries.end())
+            return l_QueryItr->second;
+
+        // workers always query the base navmesh, terrain swaps are applied by the map threads only
+        dtNavMeshQuery* l_Query = dtAllocNavMeshQuery();
+        ASSERT(l_Query);
+        if (dtStatusFailed(l_Query->init(l_MMap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(l_Query);
+            sLog->outError(LOG_FILTER_GENERAL, "MMAP:GetWorkerNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %04u worker %u", p_MapId, p_WorkerId);
+            return nullptr;
+        }
+
+        l_MMap->workerQueries.insert(std::make_pair(p_WorkerId, l_Query));
+        return l_Query;
+    }
+
+    uint32 MMapManager::GetTileGeneration(uint32 p_MapId) const
+    {
+        MMapDataSet::const_iterator l_Itr = GetMMapData(p_MapId);
+        if (l_Itr == loadedMMaps.end())
+            return 0;
+
+        return l_Itr->second->tileGeneration;
+    }
+
     MMapData::MMapData(dtNavMesh* mesh, uint32 mapId)
     {
         navMesh = mesh;
         _mapId = mapId;
+        tileGeneration = 0;
     }
 
     MMapData::~MMapData()
@@ -443,6 +473,9 @@ namespace MMAP
         for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
             dtFreeNavMeshQuery(i->second);
 
+        for (NavMeshQuerySet::iterator i = workerQueries.begin(); i != workerQueries.end(); ++i)
+            dtFreeNavMeshQuery(i->second);
+
         dtFreeNavMesh(navMesh);
 
         for (PhaseTileContainer::iterator i = _baseTiles.begin(); i != _baseTiles.end(); ++i)
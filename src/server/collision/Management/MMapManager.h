@@ -59,6 +59,10 @@ namespace MMAP
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
+        NavMeshQuerySet workerQueries;      // pathfinding worker id to query
+
+        // changed every time a tile is added or removed, used to invalidate cached poly paths
+        uint32 tileGeneration;
 
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;
@@ -80,11 +84,13 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager() : loadedTiles(0), thread_safe_environment(true), m_TileGenerationCounter(0) {}
             ~MMapManager();
 
             void InitializeThreadUnsafe(std::unordered_map<uint32, std::vector<uint32>> const& mapData);
             bool loadMap(const std::string& basePath, uint32 mapId, int32 x, int32 y);
+            /// Adds a tile read beforehand by LoadTile, takes ownership of p_Tile
+            bool loadMap(uint32 mapId, int32 x, int32 y, PhasedTile* p_Tile);
             bool unloadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
@@ -93,6 +99,17 @@ namespace MMAP
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId, TerrainSet swaps);
             dtNavMesh const* GetNavMesh(uint32 mapId, TerrainSet swaps);
 
+            /// Query owned by a pathfinding worker thread, must be called with GetNavMeshLock() held for reading
+            dtNavMeshQuery const* GetWorkerNavMeshQuery(uint32 p_MapId, uint32 p_WorkerId);
+            /// Generation of the loaded tile set of a map, 0 if the map has no navmesh loaded
+            uint32 GetTileGeneration(uint32 p_MapId) const;
+
+            /// Held for reading by pathfinding workers while they query a navmesh, held for writing while tiles are (un)loaded
+            ACE_RW_Thread_Mutex& GetNavMeshLock() { return m_NavMeshLock; }
+
+            /// Reads a mmtile file without touching the navmesh, can be called from any thread
+            PhasedTile* LoadTile(uint32 mapId, int32 x, int32 y);
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
 
@@ -117,8 +134,11 @@ namespace MMAP
             uint32 loadedTiles;
             bool thread_safe_environment;
 
-            PhasedTile* LoadTile(uint32 mapId, int32 x, int32 y);
             PhaseTileMap _phaseTiles;
+
+            ACE_RW_Thread_Mutex m_NavMeshLock;
+            std::mutex m_WorkerQueryLock;
+            std::atomic<uint32> m_TileGenerationCounter;
     };
 }
 
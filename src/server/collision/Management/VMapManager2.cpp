@@ -122,6 +122,20 @@ namespace VMAP
         }
     }
 
+    void VMapManager2::unloadMapKeepModels(unsigned int mapId, int x, int y, std::vector<std::string>& releasedModels)
+    {
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+        if (instanceTree != iInstanceMapTrees.end())
+        {
+            instanceTree->second->UnloadMapTile(x, y, this, &releasedModels);
+            if (instanceTree->second->numLoadedTiles() == 0)
+            {
+                delete instanceTree->second;
+                iInstanceMapTrees.erase(mapId);
+            }
+        }
+    }
+
     bool VMapManager2::isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2)
     {
         /// Optimization, vmaps are always enable
@@ -286,6 +300,28 @@ namespace VMAP
         }
     }
 
+    void VMapManager2::preloadTileModels(const std::string& basePath, unsigned int mapId, int x, int y, std::vector<std::string>& acquiredModels)
+    {
+        std::string vmapPath = basePath;
+        if (vmapPath.length() > 0 && vmapPath[vmapPath.length()-1] != '/' && vmapPath[vmapPath.length()-1] != '\\')
+            vmapPath.push_back('/');
+
+        std::vector<std::string> names;
+        StaticMapTree::getTileModelNames(vmapPath, mapId, x, y, names);
+
+        for (std::string const& name : names)
+        {
+            if (acquireModelInstance(vmapPath, name))
+                acquiredModels.push_back(name);
+        }
+    }
+
+    void VMapManager2::releaseTileModels(std::vector<std::string> const& acquiredModels)
+    {
+        for (std::string const& name : acquiredModels)
+            releaseModelInstance(name);
+    }
+
     bool VMapManager2::existsMap(const char* basePath, unsigned int mapId, int x, int y)
     {
         return StaticMapTree::CanLoadMap(std::string(basePath), mapId, x, y);
@@ -106,6 +106,15 @@ namespace VMAP
             WorldModel* acquireModelInstance(const std::string& basepath, const std::string& filename);
             void releaseModelInstance(const std::string& filename);
 
+            // loads the models of a tile in the model cache ahead of loadMap, thread safe
+            // the acquired names must be given back to releaseTileModels once the tile is loaded
+            void preloadTileModels(const std::string& basePath, unsigned int mapId, int x, int y, std::vector<std::string>& acquiredModels);
+            void releaseTileModels(std::vector<std::string> const& acquiredModels);
+
+            // unloads a tile but keeps its models in the model cache, the names must be given back to releaseTileModels
+            // lets the caller free the models which aren't used anymore on another thread
+            void unloadMapKeepModels(unsigned int mapId, int x, int y, std::vector<std::string>& releasedModels);
+
             // what's the use of this? o.O
             virtual std::string getDirFileName(unsigned int mapId, int /*x*/, int /*y*/) const override
             {
@@ -226,6 +226,35 @@ namespace VMAP
 
     //=========================================================
 
+    bool StaticMapTree::getTileModelNames(const std::string &vmapPath, uint32 mapID, uint32 tileX, uint32 tileY, std::vector<std::string> &names)
+    {
+        std::string basePath = vmapPath;
+        if (basePath.length() > 0 && basePath[basePath.length()-1] != '/' && basePath[basePath.length()-1] != '\\')
+            basePath.push_back('/');
+        std::string tilefile = basePath + getTileFileName(mapID, tileX, tileY);
+        FILE* tf = fopen(tilefile.c_str(), "rb");
+        if (!tf)
+            return false;
+
+        bool result = true;
+        char chunk[8];
+        uint32 numSpawns = 0;
+        if (!readChunk(tf, chunk, VMAP_MAGIC, 8) || fread(&numSpawns, sizeof(uint32), 1, tf) != 1)
+            result = false;
+        for (uint32 i=0; i<numSpawns && result; ++i)
+        {
+            ModelSpawn spawn;
+            uint32 referencedVal;
+            result = ModelSpawn::readFromFile(tf, spawn) && fread(&referencedVal, sizeof(uint32), 1, tf) == 1;
+            if (result)
+                names.push_back(spawn.name);
+        }
+        fclose(tf);
+        return result;
+    }
+
+    //=========================================================
+
     bool StaticMapTree::CanLoadMap(const std::string &vmapPath, uint32 mapID, uint32 tileX, uint32 tileY)
     {
         std::string basePath = vmapPath;
@@ -408,7 +437,7 @@ namespace VMAP
 
     //=========================================================
 
-    void StaticMapTree::UnloadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm)
+    void StaticMapTree::UnloadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm, std::vector<std::string>* releasedModels)
     {
         uint32 tileID = packTileID(tileX, tileY);
         loadedTileMap::iterator tile = iLoadedTiles.find(tileID);
@@ -437,8 +466,11 @@ namespace VMAP
                     result = ModelSpawn::readFromFile(tf, spawn);
                     if (result)
                     {
-                        // release model instance
-                        vm->releaseModelInstance(spawn.name);
+                        // release model instance, or let the caller do it later
+                        if (releasedModels)
+                            releasedModels->push_back(spawn.name);
+                        else
+                            vm->releaseModelInstance(spawn.name);
 
                         // update tree
                         uint32 referencedNode;
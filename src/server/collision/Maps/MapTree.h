@@ -54,6 +54,8 @@ namespace VMAP
             static uint32 packTileID(uint32 tileX, uint32 tileY) { return tileX<<16 | tileY; }
             static void unpackTileID(uint32 ID, uint32 &tileX, uint32 &tileY) { tileX = ID>>16; tileY = ID&0xFF; }
             static bool CanLoadMap(const std::string &basePath, uint32 mapID, uint32 tileX, uint32 tileY);
+            // model file names referenced by a tile, reads the tile file only
+            static bool getTileModelNames(const std::string &basePath, uint32 mapID, uint32 tileX, uint32 tileY, std::vector<std::string> &names);
 
             StaticMapTree(uint32 mapID, const std::string &basePath);
             ~StaticMapTree();
@@ -67,7 +69,7 @@ namespace VMAP
             bool InitMap(const std::string &fname, VMapManager2* vm);
             void UnloadMap(VMapManager2* vm);
             bool LoadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm);
-            void UnloadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm);
+            void UnloadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm, std::vector<std::string>* releasedModels = nullptr);
             bool isTiled() const { return iIsTiled; }
             uint32 numLoadedTiles() const { return uint32(iLoadedTiles.size()); }
             void getModelInstances(ModelInstance* &models, uint32 &count);
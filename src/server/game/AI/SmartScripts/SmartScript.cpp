@@ -74,6 +74,9 @@ SmartScript::SmartScript()
     goOrigGUID = 0;
     mLastInvoker = 0;
     mScriptType = SMART_SCRIPT_TYPE_CREATURE;
+    mEntryOrGuid = 0;
+    mProfileDepth = 0;
+    memset(mEventTypeOffsets, 0, sizeof(mEventTypeOffsets));
 }
 
 SmartScript::~SmartScript()
@@ -82,6 +85,29 @@ SmartScript::~SmartScript()
         delete itr->second;
 
     delete mTargetStorage;
+
+    for (ObjectList* targets : mFreeTargetLists)
+        delete targets;
+}
+
+SmartScript::ProfileScope::ProfileScope(SmartScript* p_Script)
+    : m_Script(p_Script), m_Active(sSmartScriptMgr->IsProfiling() && p_Script->mProfileDepth == 0 && p_Script->mEntryOrGuid)
+{
+    ++m_Script->mProfileDepth;
+
+    if (m_Active)
+        m_Start = std::chrono::steady_clock::now();
+}
+
+SmartScript::ProfileScope::~ProfileScope()
+{
+    --m_Script->mProfileDepth;
+
+    if (m_Active)
+    {
+        uint32 l_Time = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_Start).count());
+        sSmartScriptMgr->AddScriptTime(m_Script->mScriptType, m_Script->mEntryOrGuid, l_Time);
+    }
 }
 
 void SmartScript::OnReset()
@@ -102,20 +128,43 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-    {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+    if (e == SMART_EVENT_LINK || e >= SMART_EVENT_END)//special handling
+        return;
 
-        if (eventType == e/* && (!(*i).event.event_phase_mask || IsInPhase((*i).event.event_phase_mask)) && !((*i).event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE && (*i).runOnce)*/)
-        {
-            if (sConditionMgr->IsObjectMeetingSmartEventConditions(i->entryOrGuid, i->event_id, i->source_type, unit, GetBaseObject()))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
-        }
+    if (mEventTypeOffsets[e] == mEventTypeOffsets[e + 1])
+        return;
+
+    ProfileScope profile(this);
+
+    // offsets are read again on each step, an action may install new events
+    for (uint32 i = mEventTypeOffsets[e]; i < mEventTypeOffsets[e + 1]; ++i)
+    {
+        SmartScriptHolder& holder = mEvents[mEventIndexes[i]];
+        if (sConditionMgr->IsObjectMeetingSmartEventConditions(holder.entryOrGuid, holder.event_id, holder.source_type, unit, GetBaseObject()))
+            ProcessEvent(holder, unit, var0, var1, bvar, spell, gob);
     }
 }
 
+void SmartScript::IndexEvents()
+{
+    memset(mEventTypeOffsets, 0, sizeof(mEventTypeOffsets));
+
+    for (SmartAIEventList::const_iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+        if (i->GetEventType() < SMART_EVENT_END)
+            ++mEventTypeOffsets[i->GetEventType() + 1];
+
+    for (uint32 type = 1; type <= SMART_EVENT_END; ++type)
+        mEventTypeOffsets[type] += mEventTypeOffsets[type - 1];
+
+    uint32 next[SMART_EVENT_END];
+    memcpy(next, mEventTypeOffsets, sizeof(next));
+
+    mEventIndexes.resize(mEventTypeOffsets[SMART_EVENT_END]);
+    for (uint32 index = 0; index < mEvents.size(); ++index)
+        if (mEvents[index].GetEventType() < SMART_EVENT_END)
+            mEventIndexes[next[mEvents[index].GetEventType()]++] = index;
+}
+
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
     //calc random
@@ -156,7 +205,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (!talker)
@@ -196,7 +245,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetName(), (*itr)->GetGUIDLow(), uint8(e.action.talk.textGroupID));
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -215,7 +264,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -234,7 +283,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -268,7 +317,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -312,7 +361,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_FAIL_QUEST:
@@ -331,7 +380,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_QUEST:
@@ -353,7 +402,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_REACT_STATE:
@@ -392,7 +441,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
             if (count == 0)
             {
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
 
@@ -407,7 +456,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_THREAT_ALL_PCT:
@@ -446,7 +495,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CALL_AREAEXPLOREDOREVENTHAPPENS:
@@ -472,7 +521,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_CASTCREATUREORGO:
@@ -494,7 +543,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CAST:
@@ -522,7 +571,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_INVOKER_CAST:
@@ -556,7 +605,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_AURA:
@@ -575,7 +624,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ACTIVATE_GOBJECT:
@@ -596,7 +645,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RESET_GOBJECT:
@@ -615,7 +664,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_EMOTE_STATE:
@@ -634,7 +683,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_UNIT_FLAG:
@@ -653,7 +702,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_UNIT_FLAG:
@@ -672,7 +721,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_AUTO_ATTACK:
@@ -776,7 +825,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVEAURASFROMSPELL:
@@ -799,7 +848,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->GetGUIDLow(), e.action.removeAura.spell);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_FOLLOW:
@@ -822,7 +871,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RANDOM_PHASE:
@@ -899,7 +948,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), e.action.killedMonster.creature);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             else if (trigger && IsPlayer(unit))
             {
@@ -954,7 +1003,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             sLog->outDebug(LOG_FILTER_DATABASE_AI, "SmartScript::ProcessAction: SMART_ACTION_SET_INST_DATA64: Field: %u, data: " UI64FMTD,
                 e.action.setInstanceData64.field, targets->front()->GetGUID());
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_UPDATE_TEMPLATE:
@@ -1055,7 +1104,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToUnit()->Dismount();
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_INVINCIBILITY_HP_LEVEL:
@@ -1088,7 +1137,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToGameObject()->AI()->SetData(e.action.setData.field, e.action.setData.data);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_MOVE_FORWARD:
@@ -1139,7 +1188,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SUMMON_CREATURE:
@@ -1160,7 +1209,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             summon->AI()->AttackStart((*itr)->ToUnit());
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1193,7 +1242,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     GetBaseObject()->SummonGameObject(e.action.summonGO.entry, x, y, z, o, 0, 0, 0, 0, e.action.summonGO.despawnTime);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1216,7 +1265,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToUnit()->Kill((*itr)->ToUnit());
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_INSTALL_AI_TEMPLATE:
@@ -1238,7 +1287,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->AddItem(e.action.item.entry, e.action.item.count);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_ITEM:
@@ -1255,7 +1304,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->DestroyItemCount(e.action.item.entry, e.action.item.count, true);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_STORE_VARIABLE_DECIMAL:
@@ -1285,7 +1334,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->TeleportTo(e.action.teleport.mapID, e.target.x, e.target.y, e.target.z, e.target.o);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_FLY:
@@ -1373,7 +1422,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             else if (targets && !targets->empty())
                 me->SetFacingToObject(*targets->begin());
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_PLAYMOVIE:
@@ -1390,7 +1439,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->SendMovieStart(e.action.movie.entry);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_MOVE_TO_POS:
@@ -1412,7 +1461,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     break;
 
                 target = targets->front();
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (!target)
@@ -1443,7 +1492,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToGameObject()->SetRespawnTime(e.action.RespawnTarget.goRespawnTime);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CLOSE_GOSSIP:
@@ -1456,7 +1505,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsPlayer(*itr))
                     (*itr)->ToPlayer()->PlayerTalkClass->SendCloseGossip();
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_EQUIP:
@@ -1478,7 +1527,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         if (!einfo)
                         {
                             sLog->outError(LOG_FILTER_SQL, "SmartScript: SMART_ACTION_EQUIP uses non-existent equipment info entry %u", e.action.equip.entry);
-                            delete targets;
+                            ReleaseTargetList(targets);
                             hasDelete = true;
                             break;
                         }
@@ -1505,7 +1554,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (hasDelete)
                 break;
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CREATE_TIMED_EVENT:
@@ -1573,7 +1622,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RESET_SCRIPT_BASE_OBJECT:
@@ -1599,7 +1648,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             if (CAST_AI(SmartAI, target->AI())->CanCombatMove())
                                 target->GetMotionMaster()->MoveChase(target->getVictim(), attackDistance, attackAngle);
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1628,7 +1677,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1642,7 +1691,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetUInt32Value(UNIT_FIELD_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_NPC_FLAG:
@@ -1655,7 +1704,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetFlag(UNIT_FIELD_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_NPC_FLAG:
@@ -1668,7 +1717,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveFlag(UNIT_FIELD_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CROSS_CAST:
@@ -1680,7 +1729,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             ObjectList* targets = GetTargets(e, unit);
             if (!targets)
             {
-                delete casters; // casters already validated, delete now
+                ReleaseTargetList(casters); // casters already validated, release now
                 break;
             }
 
@@ -1704,8 +1753,8 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
-            delete casters;
+            ReleaseTargetList(targets);
+            ReleaseTargetList(casters);
             break;
         }
         case SMART_ACTION_CALL_RANDOM_TIMED_ACTIONLIST:
@@ -1755,7 +1804,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1785,7 +1834,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1799,7 +1848,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsPlayer(*itr))
                     (*itr)->ToPlayer()->ActivateTaxiPathTo(e.action.taxi.id);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RANDOM_MOVE:
@@ -1831,7 +1880,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     me->GetMotionMaster()->MoveIdle();
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_UNIT_FIELD_BYTES_1:
@@ -1843,7 +1892,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetByteFlag(UNIT_FIELD_ANIM_TIER, e.action.setunitByte.type, e.action.setunitByte.byte1);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_UNIT_FIELD_BYTES_1:
@@ -1856,7 +1905,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveByteFlag(UNIT_FIELD_ANIM_TIER, e.action.delunitByte.type, e.action.delunitByte.byte1);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_INTERRUPT_SPELL:
@@ -1869,7 +1918,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->InterruptNonMeleeSpells(e.action.interruptSpellCasting.withDelayed, e.action.interruptSpellCasting.spell_id, e.action.interruptSpellCasting.withInstant);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_GO_CUSTOM_ANIM:
@@ -1882,7 +1931,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SendCustomAnim(e.action.sendGoCustomAnim.anim);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_DYNAMIC_FLAG:
@@ -1895,7 +1944,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetUInt32Value(OBJECT_FIELD_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_DYNAMIC_FLAG:
@@ -1908,7 +1957,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetFlag(OBJECT_FIELD_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_DYNAMIC_FLAG:
@@ -1921,7 +1970,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveFlag(OBJECT_FIELD_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_JUMP_TO_POS:
@@ -1945,7 +1994,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SetLootState((LootState)e.action.setGoLootState.state);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_TARGET_TO_TARGET:
@@ -1957,7 +2006,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             ObjectList* storedTargets = GetTargetList(e.action.sendTargetToTarget.id);
             if (!storedTargets)
             {
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
 
@@ -1979,7 +2028,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_GOSSIP_MENU:
@@ -2005,7 +2054,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     player->SEND_GOSSIP_MENU(e.action.sendGossipMenu.gossipNpcTextId, GetBaseObject()->GetGUID());
                 }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
 
@@ -2039,7 +2088,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
 
             break;
         }
@@ -2069,7 +2118,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SetUInt32Value(GAMEOBJECT_FIELD_FLAGS, e.action.goFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
 
@@ -2083,7 +2132,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SetFlag(GAMEOBJECT_FIELD_FLAGS, e.action.goFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
 
@@ -2096,7 +2145,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->RemoveFlag(GAMEOBJECT_FIELD_FLAGS, e.action.goFlag.flag);
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
 
@@ -2119,7 +2168,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), e.action.power.newPower);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_POWER:
@@ -2131,7 +2180,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), (*itr)->ToUnit()->GetPower(Powers(e.action.power.powerType)) + e.action.power.newPower);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_POWER:
@@ -2143,7 +2192,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), (*itr)->ToUnit()->GetPower(Powers(e.action.power.powerType)) - e.action.power.newPower);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
 
@@ -2224,7 +2273,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             break;
@@ -2250,7 +2299,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         }
@@ -2266,7 +2315,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToCreature()->SetCorpseDelay(e.action.corpseDelay.timer);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_SCENARIO_PROGRESS_UPDATE:
@@ -2495,7 +2544,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
     else if (Unit* tempLastInvoker = GetLastInvoker())
         trigger = tempLastInvoker;
 
-    ObjectList* l = new ObjectList();
+    ObjectList* l = AcquireTargetList();
     switch (e.GetTargetType())
     {
         case SMART_TARGET_SELF:
@@ -2571,7 +2620,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_CREATURE_DISTANCE:
@@ -2590,7 +2639,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_GAMEOBJECT_DISTANCE:
@@ -2609,7 +2658,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_GAMEOBJECT_RANGE:
@@ -2628,7 +2677,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_CREATURE_GUID:
@@ -2686,7 +2735,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     if (IsPlayer(*itr) && GetBaseObject()->IsInRange(*itr, (float)e.target.playerRange.minDist, (float)e.target.playerRange.maxDist))
                         l->push_back(*itr);
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_PLAYER_DISTANCE:
@@ -2697,7 +2746,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                 if (IsPlayer(*itr))
                     l->push_back(*itr);
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_STORED:
@@ -2778,7 +2827,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
 
     if (l->empty())
     {
-        delete l;
+        ReleaseTargetList(l);
         l = NULL;
     }
 
@@ -2787,7 +2836,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
 
 ObjectList* SmartScript::GetWorldObjectsInDist(float dist)
 {
-    ObjectList* targets = new ObjectList();
+    ObjectList* targets = AcquireTargetList();
     WorldObject* obj = GetBaseObject();
     if (obj)
     {
@@ -3264,7 +3313,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 }
             }
 
-            delete _targets;
+            ReleaseTargetList(_targets);
 
             if (!target)
                 return;
@@ -3454,6 +3503,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        IndexEvents();
     }
 }
 
@@ -3462,6 +3512,8 @@ void SmartScript::OnUpdate(uint32 const diff)
     if ((mScriptType == SMART_SCRIPT_TYPE_CREATURE || mScriptType == SMART_SCRIPT_TYPE_GAMEOBJECT) && !GetBaseObject())
         return;
 
+    ProfileScope profile(this);
+
     InstallEvents();//before UpdateTimers
 
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
@@ -3540,6 +3592,9 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         }
         mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+
+    mEntryOrGuid = e.front().entryOrGuid;
+    IndexEvents();
     if (mEvents.empty() && obj)
         sLog->outDebug(LOG_FILTER_SQL, "SmartScript: Entry %u has events but no events added to list because of instance flags.", obj->GetEntry());
     if (mEvents.empty() && at)
@@ -18,8 +18,13 @@
 #include "GridNotifiers.h"
 
 #include "SmartScriptMgr.h"
+
+#include <chrono>
 //#include "SmartAI.h"
 
+/// Recycled target lists kept per script, more are only needed by nested actions
+#define SMART_SCRIPT_MAX_FREE_TARGET_LISTS 4
+
 class SmartScript
 {
     public:
@@ -38,6 +43,7 @@ class SmartScript
         void InitTimer(SmartScriptHolder& e);
         void ProcessAction(SmartScriptHolder& e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
         void ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
+        /// Returned lists are given back with ReleaseTargetList, or kept with StoreTargetList
         ObjectList* GetTargets(SmartScriptHolder const& e, Unit* invoker = NULL);
         ObjectList* GetWorldObjectsInDist(float dist);
         void InstallTemplate(SmartScriptHolder const& e);
@@ -94,12 +100,38 @@ class SmartScript
                 if ((*mTargetStorage)[id] == targets)
                     return;
 
-                delete (*mTargetStorage)[id];
+                ReleaseTargetList((*mTargetStorage)[id]);
             }
 
             (*mTargetStorage)[id] = targets;
         }
 
+        /// Target lists are recycled by the script instead of being allocated for each action
+        ObjectList* AcquireTargetList()
+        {
+            if (mFreeTargetLists.empty())
+                return new ObjectList();
+
+            ObjectList* targets = mFreeTargetLists.back();
+            mFreeTargetLists.pop_back();
+            return targets;
+        }
+
+        void ReleaseTargetList(ObjectList* targets)
+        {
+            if (!targets)
+                return;
+
+            if (mFreeTargetLists.size() >= SMART_SCRIPT_MAX_FREE_TARGET_LISTS)
+            {
+                delete targets;
+                return;
+            }
+
+            targets->clear();
+            mFreeTargetLists.push_back(targets);
+        }
+
         bool IsSmart(Creature* c = NULL)
         {
             bool smart = true;
@@ -250,6 +282,29 @@ class SmartScript
         void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
         SmartAIEventList mEvents;
+        /// mEvents indexes grouped by event type, in script order: events of type T are mEventIndexes[mEventTypeOffsets[T], mEventTypeOffsets[T + 1])
+        std::vector<uint32> mEventIndexes;
+        uint32 mEventTypeOffsets[SMART_EVENT_END + 1];
+        void IndexEvents();
+
+        std::vector<ObjectList*> mFreeTargetLists;
+
+        /// Measures the outermost dispatch of the script, nested ones (links, counters, timed events) are part of it
+        class ProfileScope
+        {
+            public:
+                explicit ProfileScope(SmartScript* p_Script);
+                ~ProfileScope();
+
+            private:
+                SmartScript* m_Script;
+                bool m_Active;
+                std::chrono::steady_clock::time_point m_Start;
+        };
+
+        int32 mEntryOrGuid;                         ///< Database script run by this object, key of the execution time accounting
+        uint32 mProfileDepth;
+
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         Creature* me;
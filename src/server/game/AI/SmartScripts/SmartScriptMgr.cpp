@@ -96,6 +96,28 @@ SmartWaypointMgr::~SmartWaypointMgr()
     waypoint_map.clear();
 }
 
+void SmartAIMgr::AddScriptTime(SmartScriptType p_Type, int32 p_EntryOrGuid, uint32 p_Time)
+{
+    ACE_Guard<ACE_Thread_Mutex> l_Guard(m_ScriptTimingsLock);
+
+    SmartScriptTiming& l_Timing = m_ScriptTimings[std::make_pair(uint32(p_Type), p_EntryOrGuid)];
+    ++l_Timing.Count;
+    l_Timing.TotalTime += p_Time;
+    l_Timing.MaxTime = std::max(l_Timing.MaxTime, p_Time);
+}
+
+SmartScriptTimingMap SmartAIMgr::GetScriptTimings() const
+{
+    ACE_Guard<ACE_Thread_Mutex> l_Guard(m_ScriptTimingsLock);
+    return m_ScriptTimings;
+}
+
+void SmartAIMgr::ResetScriptTimings()
+{
+    ACE_Guard<ACE_Thread_Mutex> l_Guard(m_ScriptTimingsLock);
+    m_ScriptTimings.clear();
+}
+
 void SmartAIMgr::LoadSmartAIFromDB()
 {
     uint32 oldMSTime = getMSTime();
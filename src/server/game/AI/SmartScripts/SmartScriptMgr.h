@@ -16,6 +16,8 @@
 #include "Spell.h"
 #include "DB2Stores.h"
 
+#include <ace/Thread_Mutex.h>
+
 //#include "SmartScript.h"
 //#include "SmartAI.h"
 
@@ -1422,15 +1424,36 @@ typedef std::vector<SmartScriptHolder> SmartAIEventList;
 // all events for all entries / guids
 typedef std::unordered_map<int32, SmartAIEventList> SmartAIEventMap;
 
+/// Execution time of a database script, summed over all the objects running it, in microseconds
+struct SmartScriptTiming
+{
+    SmartScriptTiming() : Count(0), TotalTime(0), MaxTime(0) { }
+
+    uint64 Count;
+    uint64 TotalTime;
+    uint32 MaxTime;
+};
+
+/// Key is (source_type, entryorguid)
+typedef std::map<std::pair<uint32, int32>, SmartScriptTiming> SmartScriptTimingMap;
+
 class SmartAIMgr
 {
     friend class ACE_Singleton<SmartAIMgr, ACE_Null_Mutex>;
-    SmartAIMgr(){};
+    SmartAIMgr() : m_Profiling(false) {};
     public:
         ~SmartAIMgr(){};
 
         void LoadSmartAIFromDB();
 
+        /// Execution time accounting, toggled by .server smartai
+        bool IsProfiling() const { return m_Profiling; }
+        void SetProfiling(bool p_Enable) { m_Profiling = p_Enable; }
+
+        void AddScriptTime(SmartScriptType p_Type, int32 p_EntryOrGuid, uint32 p_Time);
+        SmartScriptTimingMap GetScriptTimings() const;
+        void ResetScriptTimings();
+
         SmartAIEventList GetScript(int32 entry, SmartScriptType type)
         {
             SmartAIEventList temp;
@@ -1448,6 +1471,10 @@ class SmartAIMgr
         //event stores
         SmartAIEventMap mEventMap[SMART_SCRIPT_TYPE_MAX];
 
+        std::atomic<bool> m_Profiling;
+        SmartScriptTimingMap m_ScriptTimings;
+        mutable ACE_Thread_Mutex m_ScriptTimingsLock;   ///< Scripts run from all the map threads
+
         bool IsEventValid(SmartScriptHolder& e);
         bool IsTargetValid(SmartScriptHolder const& e);
 
@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AchievementCriteriaIndex.h"
+
+#include <limits>
+
+void AchievementCriteriaIndex::AddCriteria(CriteriaEntry const* p_Criteria)
+{
+    m_AchievementCriteriasByType[p_Criteria->Type].push_back(p_Criteria);
+
+    if (GetCriteriaAssetMatch(AchievementCriteriaTypes(p_Criteria->Type)) != CRITERIA_ASSET_MATCH_NONE)
+        m_AchievementCriteriasByAsset[p_Criteria->Type][p_Criteria->raw.criteriaArg1].push_back(p_Criteria);
+
+    m_MaxCriteriaID = std::max(m_MaxCriteriaID, p_Criteria->ID);
+}
+
+void AchievementCriteriaIndex::Compile(AchievementCriteriaTreeByCriteriaId const& p_CriteriaTrees, SubCriteriaTreeListById const& p_SubCriteriaTrees,
+    AchievementEntryByCriteriaTreeId const& p_Achievements)
+{
+    m_CompiledCriteria.clear();
+    m_CompiledCriteria.resize(m_MaxCriteriaID + 1);
+
+    for (uint32 l_Type = 0; l_Type < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++l_Type)
+    for (CriteriaEntry const* l_Criteria : m_AchievementCriteriasByType[l_Type])
+    {
+        CompiledCriteria& l_Compiled = m_CompiledCriteria[l_Criteria->ID];
+        if (l_Criteria->ID >= p_CriteriaTrees.size())
+            continue;
+
+        /// Same walk as IsCompletedCriteriaForAchievement for every tree using the criteria, the criteria is completed when all of them are
+        for (CriteriaTreeEntry const* l_CriteriaTree : p_CriteriaTrees[l_Criteria->ID])
+        {
+            AchievementEntry const* l_Achievement = l_CriteriaTree->ID < p_Achievements.size() ? p_Achievements[l_CriteriaTree->ID] : nullptr;
+            if (!l_Achievement || (l_Achievement->Flags & ACHIEVEMENT_FLAG_COUNTER) || l_Achievement->CriteriaTree >= p_SubCriteriaTrees.size())
+            {
+                l_Compiled.Completion = CRITERIA_COMPLETION_NEVER;
+                break;
+            }
+
+            CriteriaTreeEntry const* l_AchievementTree = nullptr;
+            for (CriteriaTreeEntry const* l_SubTree : p_SubCriteriaTrees[l_Achievement->CriteriaTree])
+            {
+                if (l_SubTree->CriteriaID == l_Criteria->ID)
+                {
+                    l_AchievementTree = l_SubTree;
+                    break;
+                }
+            }
+
+            uint32 l_RequiredCounter = 0;
+            if (!l_AchievementTree || !GetCriteriaRequiredCounter(l_Criteria, l_AchievementTree, l_RequiredCounter))
+            {
+                l_Compiled.Completion = CRITERIA_COMPLETION_NEVER;
+                break;
+            }
+
+            l_Compiled.Completion      = CRITERIA_COMPLETION_COUNTER;
+            l_Compiled.RequiredCounter = std::max(l_Compiled.RequiredCounter, l_RequiredCounter);
+
+            if (l_Achievement->Flags & (ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL))
+                l_Compiled.RealmFirstAchievements.push_back(l_Achievement);
+        }
+
+        if (l_Compiled.Completion == CRITERIA_COMPLETION_NEVER)
+            l_Compiled.RealmFirstAchievements.clear();
+    }
+}
+
+AchievementCriteriaEntryList const& AchievementCriteriaIndex::GetAchievementCriteriaByAsset(AchievementCriteriaTypes p_Type, uint64 p_MiscValue1) const
+{
+    AchievementCriteriaAssetMatch l_Match = GetCriteriaAssetMatch(p_Type);
+    if (l_Match == CRITERIA_ASSET_MATCH_NONE || (l_Match == CRITERIA_ASSET_MATCH_OPTIONAL && !p_MiscValue1))
+        return m_AchievementCriteriasByType[p_Type];
+
+    if (p_MiscValue1 > std::numeric_limits<uint32>::max())
+        return m_EmptyCriteriaList;
+
+    AchievementCriteriaEntryListByAsset::const_iterator l_Iter = m_AchievementCriteriasByAsset[p_Type].find(uint32(p_MiscValue1));
+    return l_Iter != m_AchievementCriteriasByAsset[p_Type].end() ? l_Iter->second : m_EmptyCriteriaList;
+}
+
+/// Must follow the misc value checks of AchievementMgr::RequirementsSatisfied
+AchievementCriteriaAssetMatch AchievementCriteriaIndex::GetCriteriaAssetMatch(AchievementCriteriaTypes p_Type)
+{
+    switch (p_Type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+        case ACHIEVEMENT_CRITERIA_TYPE_CURRENCY:
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_ARENA:
+        case ACHIEVEMENT_CRITERIA_TYPE_DEFEAT_ENCOUNTER:
+            return CRITERIA_ASSET_MATCH_EXACT;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEVELUP_BATTLEPET:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAPTURE_BATTLEPET:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+            return CRITERIA_ASSET_MATCH_OPTIONAL;
+        default:
+            break;
+    }
+
+    return CRITERIA_ASSET_MATCH_NONE;
+}
+
+bool AchievementCriteriaIndex::GetCriteriaRequiredCounter(CriteriaEntry const* p_Criteria, CriteriaTreeEntry const* p_CriteriaTree, uint32& p_RequiredCounter)
+{
+    switch (AchievementCriteriaTypes(p_Criteria->Type))
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_BG:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ARCHAEOLOGY_PROJECTS:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_GUILD_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_DAILY_QUEST_DAILY:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_DAMAGE_DONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HEALING_DONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_DAILY_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_FALL_WITHOUT_DYING:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL:
+        case ACHIEVEMENT_CRITERIA_TYPE_EARN_HONORABLE_KILL:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_RATED_ARENA:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_PERSONAL_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_BUY_BANK_SLOT:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_EXALTED_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_VISIT_BARBER_SHOP:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_ROLL_NEED_ON_LOOT:
+        case ACHIEVEMENT_CRITERIA_TYPE_ROLL_GREED_ON_LOOT:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_MONEY_FROM_QUEST_REWARD:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_MONEY:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_SPECIAL_PVP_KILL:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_DUEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_ACHIEVEMENTS_IN_BATTLE_PET:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_LFD_TO_GROUP_WITH_PLAYERS:
+        case ACHIEVEMENT_CRITERIA_TYPE_GET_KILLING_BLOWS:
+        case ACHIEVEMENT_CRITERIA_TYPE_CURRENCY:
+        case ACHIEVEMENT_CRITERIA_TYPE_COOK_SOME_MEALS:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAPTURE_BATTLEPET:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAPTURE_SPECIFIC_BATTLEPET:
+        case ACHIEVEMENT_CRITERIA_TYPE_EARN_BATTLEPET:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAPTURE_BATTLEPET_IN_COMBAT:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEVELUP_BATTLEPET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BUY_GUILD_BANK_SLOTS:
+        case ACHIEVEMENT_CRITERIA_TYPE_SPENT_GOLD_GUILD_REPAIRS:
+        case ACHIEVEMENT_CRITERIA_TYPE_CRAFT_ITEMS_GUILD:
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_PETBATTLE:
+        case ACHIEVEMENT_CRITERIA_TYPE_CATCH_FROM_POOL:
+        case ACHIEVEMENT_CRITERIA_TYPE_EARN_GUILD_ACHIEVEMENT_POINTS:
+        case ACHIEVEMENT_CRITERIA_TYPE_BUY_GUILD_TABARD:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_GUILD:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILLS_GUILD:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE_TYPE_GUILD:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_GUILD_CHALLENGE_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_GUILD_CHALLENGE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COLLECT_TOYS:
+        case ACHIEVEMENT_CRITERIA_TYPE_COLLECT_HEIRLOOMS:
+        case ACHIEVEMENT_CRITERIA_TYPE_DEFEAT_ENCOUNTER:
+            p_RequiredCounter = p_CriteriaTree->Amount;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ACHIEVEMENT:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_EXPLORE_AREA:
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_CHALLENGE_DUNGEON:
+            p_RequiredCounter = 1;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+            p_RequiredCounter = p_CriteriaTree->Amount * 75;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_EARN_ACHIEVEMENT_POINTS:
+            p_RequiredCounter = 9000;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_ARENA:
+            if (!p_CriteriaTree->Amount)
+                return false;
+
+            p_RequiredCounter = p_CriteriaTree->Amount;
+            return true;
+            // handle all statistic-only criteria here
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_BATTLEGROUND:
+        case ACHIEVEMENT_CRITERIA_TYPE_DEATH_AT_MAP:
+        case ACHIEVEMENT_CRITERIA_TYPE_DEATH:
+        case ACHIEVEMENT_CRITERIA_TYPE_DEATH_IN_DUNGEON:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGH_SCORE_IN_ORDALIE:
+        case ACHIEVEMENT_CRITERIA_TYPE_MOST_CHALLENGE_DUNGEON_WON:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_PLAYER:
+        case ACHIEVEMENT_CRITERIA_TYPE_DEATHS_FROM:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_TEAM_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_MONEY_FROM_VENDORS:
+        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_SPENT_FOR_TALENTS:
+        case ACHIEVEMENT_CRITERIA_TYPE_NUMBER_OF_TALENT_RESETS:
+        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_SPENT_AT_BARBER:
+        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_SPENT_FOR_MAIL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOSE_DUEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_EARNED_BY_AUCTIONS:
+        case ACHIEVEMENT_CRITERIA_TYPE_CREATE_AUCTION:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_BID:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_SOLD:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_GOLD_VALUE_OWNED:
+        case ACHIEVEMENT_CRITERIA_TYPE_WON_AUCTIONS:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REVERED_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_HONORED_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_KNOWN_FACTIONS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_EPIC_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_RECEIVE_EPIC_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_ROLL_NEED:
+        case ACHIEVEMENT_CRITERIA_TYPE_ROLL_GREED:
+        case ACHIEVEMENT_CRITERIA_TYPE_QUEST_ABANDONED:
+        case ACHIEVEMENT_CRITERIA_TYPE_FLIGHT_PATHS_TAKEN:
+        case ACHIEVEMENT_CRITERIA_TYPE_ACCEPTED_SUMMONINGS:
+        default:
+            return false;
+    }
+    return false;
+}
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _ACHIEVEMENT_CRITERIA_INDEX_H
+#define _ACHIEVEMENT_CRITERIA_INDEX_H
+
+#include "Common.h"
+#include "DBCEnums.h"
+#include "DBCStructure.h"
+#include "AchievementDefines.h"
+
+typedef std::vector<CriteriaEntry const*>            AchievementCriteriaEntryList;
+typedef std::vector<AchievementEntry const*>         AchievementEntryList;
+typedef std::vector<CriteriaTreeEntry const*>        AchievementCriteriaTreeList;
+
+typedef std::unordered_map<uint32, AchievementCriteriaEntryList> AchievementCriteriaEntryListByAsset;
+typedef std::vector<AchievementCriteriaTreeList>     AchievementCriteriaTreeByCriteriaId;
+typedef std::vector<AchievementCriteriaTreeList>     SubCriteriaTreeListById;
+typedef std::vector<AchievementEntry const*>         AchievementEntryByCriteriaTreeId;
+
+/// How RequirementsSatisfied compares the first misc value of an update with the asset of a criteria (criteriaArg1)
+enum AchievementCriteriaAssetMatch
+{
+    CRITERIA_ASSET_MATCH_NONE,                              ///< Not compared, every criteria of the type is checked
+    CRITERIA_ASSET_MATCH_EXACT,                             ///< Only the criteria whose asset is the misc value can be updated
+    CRITERIA_ASSET_MATCH_OPTIONAL                           ///< Same, but a misc value of 0 (login check) checks every criteria of the type
+};
+
+enum AchievementCriteriaCompletion
+{
+    CRITERIA_COMPLETION_ALWAYS,                             ///< Not used by any criteria tree
+    CRITERIA_COMPLETION_NEVER,                              ///< Used by a counter, a statistic or a tree without achievement
+    CRITERIA_COMPLETION_COUNTER                             ///< Completed once its progress reaches RequiredCounter
+};
+
+/// Result of the criteria tree walk of IsCompletedCriteria, computed once at load
+struct CompiledCriteria
+{
+    CompiledCriteria() : Completion(CRITERIA_COMPLETION_ALWAYS), RequiredCounter(0) { }
+
+    AchievementCriteriaCompletion Completion;
+    uint32 RequiredCounter;                                 ///< Highest amount required by the criteria trees
+    AchievementEntryList RealmFirstAchievements;            ///< Not completed while someone else on the realm has one of them
+};
+
+/// Criteria lookups of the achievement updates, owned by AchievementGlobalMgr
+/// Only reads the DB2 entries, the achievement_criteria_bench tool builds and queries it like the server does
+class AchievementCriteriaIndex
+{
+    public:
+        AchievementCriteriaIndex() : m_MaxCriteriaID(0) { }
+
+        /// Indexes a criteria by type and by asset, for every criteria of the store
+        void AddCriteria(CriteriaEntry const* p_Criteria);
+
+        /// Walks the criteria trees of every added criteria once, p_CriteriaTrees by criteria id, p_SubCriteriaTrees by parent id
+        /// and p_Achievements by criteria tree id are the lookups of AchievementGlobalMgr
+        void Compile(AchievementCriteriaTreeByCriteriaId const& p_CriteriaTrees, SubCriteriaTreeListById const& p_SubCriteriaTrees,
+            AchievementEntryByCriteriaTreeId const& p_Achievements);
+
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes p_Type) const
+        {
+            return m_AchievementCriteriasByType[p_Type];
+        }
+
+        /// Criteria of a type that can be updated with this misc value, a subset of GetAchievementCriteriaByType
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByAsset(AchievementCriteriaTypes p_Type, uint64 p_MiscValue1) const;
+
+        CompiledCriteria const& GetCompiledCriteria(CriteriaEntry const* p_Criteria) const
+        {
+            return m_CompiledCriteria[p_Criteria->ID];
+        }
+
+        static AchievementCriteriaAssetMatch GetCriteriaAssetMatch(AchievementCriteriaTypes p_Type);
+        static bool GetCriteriaRequiredCounter(CriteriaEntry const* p_Criteria, CriteriaTreeEntry const* p_CriteriaTree, uint32& p_RequiredCounter);
+
+    private:
+        AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        AchievementCriteriaEntryListByAsset m_AchievementCriteriasByAsset[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        AchievementCriteriaEntryList m_EmptyCriteriaList;
+        std::vector<CompiledCriteria> m_CompiledCriteria;
+        uint32 m_MaxCriteriaID;
+};
+
+#endif
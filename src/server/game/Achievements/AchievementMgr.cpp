@@ -388,9 +388,15 @@ bool AchievementCriteriaDataSet::Meets(Player const* p_Source, Unit const* p_Tar
     return true;
 }
 
+// Helper function to avoid having to specialize template for a 800 line long function
+template <typename T> static bool IsGuild() { return false; }
+template<> bool IsGuild<Guild>() { return true; }
+
 template<class T>
-AchievementMgr<T>::AchievementMgr(T* owner) : _owner(owner), _achievementPoints(0), m_NeedDBSync(false)
+AchievementMgr<T>::AchievementMgr(T* owner) : _owner(owner), _achievementPoints(0), m_NeedDBSync(false), m_CoalescedCriteriaUpdates(0)
 {
+    if (!IsGuild<T>())
+        m_CompletedCriteria.resize(sCriteriaStore.GetNumRows() + 1, false);
 }
 
 template<class T>
@@ -434,6 +440,8 @@ void AchievementMgr<T>::RemoveCriteriaProgress(CriteriaEntry const* p_Entry)
     SendPacket(&l_Data);
 
     l_ProgressMap->erase(l_CriteriaProgress);
+    ForgetCompletedCriteria(p_Entry->ID);
+    QueueCriteriaRemoval(p_Entry->ID);
 }
 
 #ifndef CROSS
@@ -451,6 +459,8 @@ void AchievementMgr<Guild>::RemoveCriteriaProgress(CriteriaEntry const* p_Entry)
 
     SendPacket(&l_Data);
     GetCriteriaProgressMap()->erase(l_CriteriaProgress);
+    ForgetCompletedCriteria(p_Entry->ID);
+    QueueCriteriaRemoval(p_Entry->ID);
     m_NeedDBSync = true;
 }
 #endif
@@ -514,6 +524,141 @@ void AchievementMgr<Guild>::DeleteFromDB(uint32 p_LowGUID, uint32 /*p_AccountID*
 }
 #endif
 
+namespace
+{
+    /// Rows per statement of the batched criteria progress writes
+    uint32 const g_CriteriaProgressSaveBatchSize = 500;
+
+    /// The last criteria tree of the criteria decides if its progress is saved per account or per character, never saved without achievement
+    AchievementEntry const* GetCriteriaSaveAchievement(uint32 p_CriteriaID)
+    {
+        CriteriaEntry const* l_Criteria = sAchievementMgr->GetAchievementCriteria(p_CriteriaID);
+        if (!l_Criteria)
+            return nullptr;
+
+        AchievementEntry const* l_Achievement = nullptr;
+        AchievementCriteriaTreeList const& l_CriteriaTreeList = sAchievementMgr->GetAchievementCriteriaTreeList(l_Criteria);
+        for (AchievementCriteriaTreeList::const_iterator l_Iter = l_CriteriaTreeList.begin(); l_Iter != l_CriteriaTreeList.end(); ++l_Iter)
+            l_Achievement = sAchievementMgr->GetAchievementEntryByCriteriaTree(*l_Iter);
+
+        return l_Achievement;
+    }
+
+    /// DELETE FROM p_Table WHERE p_OwnerColumn = p_Owner AND criteria IN (...), returns the number of statements
+    uint32 AppendCriteriaProgressDeletes(SQLTransaction& p_Trans, char const* p_Table, char const* p_OwnerColumn, uint32 p_Owner, std::vector<uint32> const& p_Criterias)
+    {
+        uint32 l_Statements = 0;
+
+        for (size_t l_Begin = 0; l_Begin < p_Criterias.size(); l_Begin += g_CriteriaProgressSaveBatchSize)
+        {
+            size_t l_End = std::min(p_Criterias.size(), l_Begin + g_CriteriaProgressSaveBatchSize);
+
+            std::ostringstream l_Query;
+            l_Query << "DELETE FROM " << p_Table << " WHERE " << p_OwnerColumn << " = " << p_Owner << " AND criteria IN (";
+
+            for (size_t l_I = l_Begin; l_I < l_End; ++l_I)
+                l_Query << (l_I != l_Begin ? "," : "") << p_Criterias[l_I];
+
+            l_Query << ')';
+
+            p_Trans->Append(l_Query.str().c_str());
+            ++l_Statements;
+        }
+
+        return l_Statements;
+    }
+
+    /// Multi-row INSERT ... ON DUPLICATE KEY UPDATE, the progress tables are keyed by owner and criteria, returns the number of statements
+    uint32 AppendCriteriaProgressUpserts(SQLTransaction& p_Trans, char const* p_Table, char const* p_OwnerColumn, uint32 p_Owner, std::vector<CriteriaSaveRow> const& p_Rows, bool p_SaveCompletedGUID)
+    {
+        uint32 l_Statements = 0;
+
+        for (size_t l_Begin = 0; l_Begin < p_Rows.size(); l_Begin += g_CriteriaProgressSaveBatchSize)
+        {
+            size_t l_End = std::min(p_Rows.size(), l_Begin + g_CriteriaProgressSaveBatchSize);
+
+            std::ostringstream l_Query;
+            l_Query << "INSERT INTO " << p_Table << " (" << p_OwnerColumn << ", criteria, counter, date" << (p_SaveCompletedGUID ? ", completedGuid" : "") << ") VALUES ";
+
+            for (size_t l_I = l_Begin; l_I < l_End; ++l_I)
+            {
+                CriteriaSaveRow const& l_Row = p_Rows[l_I];
+
+                l_Query << (l_I != l_Begin ? ",(" : "(") << p_Owner << ',' << l_Row.CriteriaID << ',' << l_Row.Counter << ',' << l_Row.Date;
+
+                if (p_SaveCompletedGUID)
+                    l_Query << ',' << l_Row.CompletedGUID;
+
+                l_Query << ')';
+            }
+
+            l_Query << " ON DUPLICATE KEY UPDATE counter = VALUES(counter), date = VALUES(date)" << (p_SaveCompletedGUID ? ", completedGuid = VALUES(completedGuid)" : "");
+
+            p_Trans->Append(l_Query.str().c_str());
+            ++l_Statements;
+        }
+
+        return l_Statements;
+    }
+}
+
+/// Marks the progress as changed, only its first update since the last save queues it
+/// Called from the criteria update tasks, concurrently with SaveToDB
+template<class T>
+void AchievementMgr<T>::QueueCriteriaSave(uint32 p_CriteriaID, CriteriaProgress& p_Progress)
+{
+    ACE_Guard<ACE_Thread_Mutex> l_Guard(m_CriteriaSaveQueueLock);
+
+    if (p_Progress.changed)
+    {
+        ++m_CoalescedCriteriaUpdates;
+        return;
+    }
+
+    p_Progress.changed = true;
+    m_CriteriaSaveQueue.push_back(p_CriteriaID);
+}
+
+/// The progress row is deleted by the next save
+template<class T>
+void AchievementMgr<T>::QueueCriteriaRemoval(uint32 p_CriteriaID)
+{
+    ACE_Guard<ACE_Thread_Mutex> l_Guard(m_CriteriaSaveQueueLock);
+    m_CriteriaRemoveQueue.push_back(p_CriteriaID);
+}
+
+/// Empties the queues, copying the current progress of the changed criteria
+template<class T>
+void AchievementMgr<T>::TakeCriteriaSaveQueue(std::vector<CriteriaSaveRow>& p_Rows, std::vector<uint32>& p_Removed, uint32& p_CoalescedUpdates)
+{
+    ACE_Guard<ACE_Thread_Mutex> l_Guard(m_CriteriaSaveQueueLock);
+
+    p_Removed.swap(m_CriteriaRemoveQueue);
+    p_Rows.reserve(m_CriteriaSaveQueue.size());
+
+    for (uint32 l_CriteriaID : m_CriteriaSaveQueue)
+    {
+        /// Removed since, or removed then queued again: the progress is only written once
+        CriteriaProgress* l_Progress = GetCriteriaProgress(l_CriteriaID);
+        if (!l_Progress || !l_Progress->changed)
+            continue;
+
+        l_Progress->changed = false;
+
+        CriteriaSaveRow l_Row;
+        l_Row.CriteriaID    = l_CriteriaID;
+        l_Row.Counter       = l_Progress->counter;
+        l_Row.Date          = uint32(l_Progress->date);
+        l_Row.CompletedGUID = GUID_LOPART(l_Progress->CompletedGUID);
+        p_Rows.push_back(l_Row);
+    }
+
+    m_CriteriaSaveQueue.clear();
+
+    p_CoalescedUpdates = m_CoalescedCriteriaUpdates;
+    m_CoalescedCriteriaUpdates = 0;
+}
+
 template<class T>
 void AchievementMgr<T>::SaveToDB(SQLTransaction& /*trans*/)
 {
@@ -607,167 +752,54 @@ void AchievementMgr<Player>::SaveToDB(SQLTransaction& trans)
     
     m_CompletedAchievementsLock.release();
 
-    CriteriaProgressMap* progressMap = GetCriteriaProgressMap();
-    if (!progressMap)
-        return;
-
-    if (!progressMap->empty())
-    {
-        // Prepare deleting and insert
-        bool need_execute_del       = false;
-        bool need_execute_ins       = false;
-        bool need_execute_account   = false;
-
-        bool isAccountAchievement   = false;
+    std::vector<CriteriaSaveRow> l_Rows;
+    std::vector<uint32> l_Removed;
+    uint32 l_CoalescedUpdates = 0;
+    TakeCriteriaSaveQueue(l_Rows, l_Removed, l_CoalescedUpdates);
 
-        bool alreadyOneCharDelLine  = false;
-        bool alreadyOneAccDelLine   = false;
-        bool alreadyOneCharInsLine  = false;
-        bool alreadyOneAccInsLine   = false;
-
-        std::ostringstream ssAccdel;
-        std::ostringstream ssAccins;
-        std::ostringstream ssChardel;
-        std::ostringstream ssCharins;
-
-        uint64 guid = GetOwner()->GetRealGUIDLow();
-
-        uint32 accountId = GetOwner()->GetSession()->GetAccountId();
-
-        for (CriteriaProgressMap::iterator iter = progressMap->begin(); iter != progressMap->end(); ++iter)
-        {
-            if (!iter->second.changed)
-                continue;
-
-            CriteriaEntry const* criteria = sAchievementMgr->GetAchievementCriteria(iter->first);
-            if (!criteria)
-                continue;
+    std::vector<uint32> l_AccountDeletes;
+    std::vector<uint32> l_CharacterDeletes;
+    std::vector<CriteriaSaveRow> l_AccountUpserts;
+    std::vector<CriteriaSaveRow> l_CharacterUpserts;
 
-            AchievementEntry const* l_Achievement = nullptr;
-            AchievementCriteriaTreeList const& criteriaTreeList = sAchievementMgr->GetAchievementCriteriaTreeList(criteria);
-            for (AchievementCriteriaTreeList::const_iterator l_Iter = criteriaTreeList.begin(); l_Iter != criteriaTreeList.end(); ++l_Iter)
-            {
-                CriteriaTreeEntry const* l_CriteriaTree = *l_Iter;
-                l_Achievement = sAchievementMgr->GetAchievementEntryByCriteriaTree(l_CriteriaTree);
-            }
-
-            if (l_Achievement == nullptr)
-                continue;
-
-            if (l_Achievement->Flags & ACHIEVEMENT_FLAG_ACCOUNT)
-            {
-                isAccountAchievement = true;
-                need_execute_account = true;
-            }
-            else
-                isAccountAchievement = false;
-
-            // Deleted data (including 0 progress state)
-            {
-                // First new/changed record prefix (for any counter value)
-                if (!need_execute_del)
-                {
-                    ssAccdel  << "DELETE FROM account_achievement_progress   WHERE account = " << accountId << " AND criteria IN (";
-                    ssChardel << "DELETE FROM character_achievement_progress WHERE guid    = " << guid      << " AND criteria IN (";
-                    need_execute_del = true;
-                }
-                // Next new/changed record prefix
-                else
-                {
-                    if (isAccountAchievement)
-                    {
-                        if (alreadyOneAccDelLine)
-                            ssAccdel  << ',';
-                    }
-                    else
-                    {
-                        if (alreadyOneCharDelLine)
-                            ssChardel << ',';
-                    }
-                }
-
-                // New/changed record data
-                if (isAccountAchievement)
-                {
-                    ssAccdel << iter->first;
-                    alreadyOneAccDelLine  = true;
-                }
-                else
-                {
-                    ssChardel << iter->first;
-                    alreadyOneCharDelLine = true;
-                }
-            }
-
-            // Store data only for real progress
-            if (iter->second.counter != 0)
-            {
-                /// First new/changed record prefix
-                if (!need_execute_ins)
-                {
-                    ssAccins  << "INSERT INTO account_achievement_progress   (account, criteria, counter, date) VALUES ";
-                    ssCharins << "INSERT INTO character_achievement_progress (guid,    criteria, counter, date) VALUES ";
-                    need_execute_ins = true;
-                }
-                // Next new/changed record prefix
-                else
-                {
-                    if (isAccountAchievement)
-                    {
-                        if (alreadyOneAccInsLine)
-                            ssAccins  << ',';
-                    }
-                    else
-                    {
-                        if (alreadyOneCharInsLine)
-                            ssCharins << ',';
-                    }
-                }
+    for (uint32 l_CriteriaID : l_Removed)
+    {
+        AchievementEntry const* l_Achievement = GetCriteriaSaveAchievement(l_CriteriaID);
+        if (l_Achievement == nullptr)
+            continue;
 
-                // New/changed record data
-                if (isAccountAchievement)
-                {
-                    ssAccins  << '(' << accountId << ',' << iter->first << ',' << iter->second.counter << ',' << iter->second.date << ')';
-                    alreadyOneAccInsLine  = true;
-                }
-                else
-                {
-                    ssCharins << '(' << guid      << ',' << iter->first << ',' << iter->second.counter << ',' << iter->second.date << ')';
-                    alreadyOneCharInsLine = true;
-                }
-            }
+        if (l_Achievement->Flags & ACHIEVEMENT_FLAG_ACCOUNT)
+            l_AccountDeletes.push_back(l_CriteriaID);
+        else
+            l_CharacterDeletes.push_back(l_CriteriaID);
+    }
 
-            // Mark as updated in db
-            iter->second.changed = false;
-        }
+    for (CriteriaSaveRow const& l_Row : l_Rows)
+    {
+        AchievementEntry const* l_Achievement = GetCriteriaSaveAchievement(l_Row.CriteriaID);
+        if (l_Achievement == nullptr)
+            continue;
 
-        if (need_execute_del)                                // DELETE ... IN (.... _)_
-        {
-            ssAccdel  << ')';
-            ssChardel << ')';
-        }
+        bool l_Account = (l_Achievement->Flags & ACHIEVEMENT_FLAG_ACCOUNT) != 0;
 
-        if (need_execute_del || need_execute_ins)
-        {
-            if (need_execute_del)
-            {
-                if (need_execute_account && alreadyOneAccDelLine)
-                    trans->Append(ssAccdel.str().c_str());
+        /// Store data only for real progress, a timed criteria can be started at 0
+        if (l_Row.Counter == 0)
+            (l_Account ? l_AccountDeletes : l_CharacterDeletes).push_back(l_Row.CriteriaID);
+        else
+            (l_Account ? l_AccountUpserts : l_CharacterUpserts).push_back(l_Row);
+    }
 
-                if (alreadyOneCharDelLine)
-                    trans->Append(ssChardel.str().c_str());
-            }
+    uint32 l_AccountID = GetOwner()->GetSession()->GetAccountId();
+    uint32 l_GUIDLow   = GetOwner()->GetRealGUIDLow();
+    uint32 l_Statements = 0;
 
-            if (need_execute_ins)
-            {
-                if (need_execute_account && alreadyOneAccInsLine)
-                    trans->Append(ssAccins.str().c_str());
+    /// Deletes first, a criteria removed then progressed again since the last save is in both
+    l_Statements += AppendCriteriaProgressDeletes(trans, "account_achievement_progress", "account", l_AccountID, l_AccountDeletes);
+    l_Statements += AppendCriteriaProgressDeletes(trans, "character_achievement_progress", "guid", l_GUIDLow, l_CharacterDeletes);
+    l_Statements += AppendCriteriaProgressUpserts(trans, "account_achievement_progress", "account", l_AccountID, l_AccountUpserts, false);
+    l_Statements += AppendCriteriaProgressUpserts(trans, "character_achievement_progress", "guid", l_GUIDLow, l_CharacterUpserts, false);
 
-                if (alreadyOneCharInsLine)
-                    trans->Append(ssCharins.str().c_str());
-            }
-        }
-    }
+    sAchievementMgr->AddSaveCycle(l_AccountUpserts.size() + l_CharacterUpserts.size(), l_AccountDeletes.size() + l_CharacterDeletes.size(), l_CoalescedUpdates, l_Statements);
 }
 
 #ifndef CROSS
@@ -807,30 +839,16 @@ void AchievementMgr<Guild>::SaveToDB(SQLTransaction& trans)
         guidstr.str("");
     }
 
-    CriteriaProgressMap* progressMap = GetCriteriaProgressMap();
-    if (!progressMap)
-        return;
+    std::vector<CriteriaSaveRow> l_Rows;
+    std::vector<uint32> l_Removed;
+    uint32 l_CoalescedUpdates = 0;
+    TakeCriteriaSaveQueue(l_Rows, l_Removed, l_CoalescedUpdates);
 
-    for (CriteriaProgressMap::iterator itr = progressMap->begin(); itr != progressMap->end(); ++itr)
-    {
-        if (!itr->second.changed)
-            continue;
+    uint32 l_Statements = 0;
+    l_Statements += AppendCriteriaProgressDeletes(trans, "guild_achievement_progress", "guildId", GetOwner()->GetId(), l_Removed);
+    l_Statements += AppendCriteriaProgressUpserts(trans, "guild_achievement_progress", "guildId", GetOwner()->GetId(), l_Rows, true);
 
-        itr->second.changed = false;
-
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_ACHIEVEMENT_CRITERIA);
-        stmt->setUInt32(0, GetOwner()->GetId());
-        stmt->setUInt16(1, itr->first);
-        trans->Append(stmt);
-
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_ACHIEVEMENT_CRITERIA);
-        stmt->setUInt32(0, GetOwner()->GetId());
-        stmt->setUInt16(1, itr->first);
-        stmt->setUInt32(2, itr->second.counter);
-        stmt->setUInt32(3, itr->second.date);
-        stmt->setUInt32(4, GUID_LOPART(itr->second.CompletedGUID));
-        trans->Append(stmt);
-    }
+    sAchievementMgr->AddSaveCycle(l_Rows.size(), l_Removed.size(), l_CoalescedUpdates, l_Statements);
 }
 #endif
 
@@ -1113,6 +1131,7 @@ void AchievementMgr<Player>::Reset()
 
     _achievementPoints = 0;
     criteriaProgress->clear();
+    std::fill(m_CompletedCriteria.begin(), m_CompletedCriteria.end(), false);
     DeleteFromDB(GetOwner()->GetGUIDLow());
 
     // Re-fill data
@@ -1330,10 +1349,6 @@ void AchievementMgr<T>::CheckAllAchievementCriteria(Player* p_ReferencePlayer)
     }
 }
 
-// Helper function to avoid having to specialize template for a 800 line long function
-template <typename T> static bool IsGuild() { return false; }
-template<> bool IsGuild<Guild>() { return true; }
-
 /**
  * This function will be called whenever the user might have done a criteria relevant action
  */
@@ -1360,10 +1375,16 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes p_Typ
     if (IsGuild<T>() && !sWorld->getBoolConfig(CONFIG_GUILD_LEVELING_ENABLED))
         return;
 
-    AchievementCriteriaEntryList const& l_AchievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(p_Type);
+    // Only the criteria matching the asset of the update, see RequirementsSatisfied
+    AchievementCriteriaEntryList const& l_AchievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByAsset(p_Type, p_MiscValue1);
     for (AchievementCriteriaEntryList::const_iterator i = l_AchievementCriteriaList.begin(); i != l_AchievementCriteriaList.end(); ++i)
     {
         CriteriaEntry const* l_AchievementCriteria = (*i);
+
+        // Already known as completed, CanUpdateCriteria would refuse it
+        if (!m_CompletedCriteria.empty() && m_CompletedCriteria[l_AchievementCriteria->ID])
+            continue;
+
         if (!CanUpdateCriteria(l_AchievementCriteria, NULL, p_MiscValue1, p_MiscValue2, p_MiscValue3, p_Unit, p_ReferencePlayer))
             continue;
 
@@ -1738,22 +1759,41 @@ bool AchievementMgr<Player>::CanCompleteCriteria(CriteriaEntry const* /*achievem
 template<class T>
 bool AchievementMgr<T>::IsCompletedCriteria(CriteriaEntry const* p_AchievementCriteria)
 {
-    AchievementCriteriaTreeList const& l_CriteriaTreeList = sAchievementMgr->GetAchievementCriteriaTreeList(p_AchievementCriteria);
-    for (AchievementCriteriaTreeList::const_iterator l_Iter = l_CriteriaTreeList.begin(); l_Iter != l_CriteriaTreeList.end(); l_Iter++)
+    if (!m_CompletedCriteria.empty() && m_CompletedCriteria[p_AchievementCriteria->ID])
+        return true;
+
+    CompiledCriteria const& l_Compiled = sAchievementMgr->GetCompiledCriteria(p_AchievementCriteria);
+    if (l_Compiled.Completion == CRITERIA_COMPLETION_NEVER)
+        return false;
+
+    if (l_Compiled.Completion == CRITERIA_COMPLETION_COUNTER)
     {
-        CriteriaTreeEntry const* l_CriteriaTree = *l_Iter;
-        AchievementEntry const* l_Achievement = sAchievementMgr->GetAchievementEntryByCriteriaTree(l_CriteriaTree);
-        if (!l_Achievement)
+        CriteriaProgress const* l_Progress = GetCriteriaProgress(p_AchievementCriteria);
+        if (!l_Progress || l_Progress->counter < l_Compiled.RequiredCounter)
             return false;
 
-        if (CriteriaEntry const* l_Criteria = sCriteriaStore.LookupEntry(l_CriteriaTree->CriteriaID))
-            if (!IsCompletedCriteriaForAchievement(l_Criteria, l_Achievement))
+        // someone on this realm has already completed that achievement
+        for (AchievementEntry const* l_Achievement : l_Compiled.RealmFirstAchievements)
+        {
+            if (sAchievementMgr->IsRealmCompleted(l_Achievement, GetInstanceId(GetOwner())))
                 return false;
+        }
     }
 
+    // A realm first can be lost, the others stay completed until the progress changes
+    if (!m_CompletedCriteria.empty() && l_Compiled.RealmFirstAchievements.empty())
+        m_CompletedCriteria[p_AchievementCriteria->ID] = true;
+
     return true;
 }
 
+template<class T>
+void AchievementMgr<T>::ForgetCompletedCriteria(uint32 p_CriteriaID)
+{
+    if (p_CriteriaID < m_CompletedCriteria.size())
+        m_CompletedCriteria[p_CriteriaID] = false;
+}
+
 template<class T>
 bool AchievementMgr<T>::IsCompletedCriteriaTree(CriteriaTreeEntry const* p_CriteriaTree)
 {
@@ -1808,130 +1848,11 @@ bool AchievementMgr<T>::IsCriteriaCompleted(CriteriaEntry const* p_Criteria, Cri
     if (!l_Progress)
         return false;
 
-    switch (AchievementCriteriaTypes(p_Criteria->Type))
-    {
-        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
-        case ACHIEVEMENT_CRITERIA_TYPE_WIN_BG:
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ARCHAEOLOGY_PROJECTS:
-        case ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL:
-        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
-        case ACHIEVEMENT_CRITERIA_TYPE_REACH_GUILD_LEVEL:
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT:
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_DAILY_QUEST_DAILY:
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
-        case ACHIEVEMENT_CRITERIA_TYPE_DAMAGE_DONE:
-        case ACHIEVEMENT_CRITERIA_TYPE_HEALING_DONE:
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_DAILY_QUEST:
-        case ACHIEVEMENT_CRITERIA_TYPE_FALL_WITHOUT_DYING:
-        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
-        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
-        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
-        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
-        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
-        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
-        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL:
-        case ACHIEVEMENT_CRITERIA_TYPE_EARN_HONORABLE_KILL:
-        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
-        case ACHIEVEMENT_CRITERIA_TYPE_WIN_RATED_ARENA:
-        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_PERSONAL_RATING:
-        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
-        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
-        case ACHIEVEMENT_CRITERIA_TYPE_BUY_BANK_SLOT:
-        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
-        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_EXALTED_REPUTATION:
-        case ACHIEVEMENT_CRITERIA_TYPE_VISIT_BARBER_SHOP:
-        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM:
-        case ACHIEVEMENT_CRITERIA_TYPE_ROLL_NEED_ON_LOOT:
-        case ACHIEVEMENT_CRITERIA_TYPE_ROLL_GREED_ON_LOOT:
-        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
-        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
-        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
-        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
-        case ACHIEVEMENT_CRITERIA_TYPE_MONEY_FROM_QUEST_REWARD:
-        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_MONEY:
-        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
-        case ACHIEVEMENT_CRITERIA_TYPE_SPECIAL_PVP_KILL:
-        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
-        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
-        case ACHIEVEMENT_CRITERIA_TYPE_WIN_DUEL:
-        case ACHIEVEMENT_CRITERIA_TYPE_ACHIEVEMENTS_IN_BATTLE_PET:
-        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
-        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
-        case ACHIEVEMENT_CRITERIA_TYPE_USE_LFD_TO_GROUP_WITH_PLAYERS:
-        case ACHIEVEMENT_CRITERIA_TYPE_GET_KILLING_BLOWS:
-        case ACHIEVEMENT_CRITERIA_TYPE_CURRENCY:
-        case ACHIEVEMENT_CRITERIA_TYPE_COOK_SOME_MEALS:
-        case ACHIEVEMENT_CRITERIA_TYPE_CAPTURE_BATTLEPET:
-        case ACHIEVEMENT_CRITERIA_TYPE_CAPTURE_SPECIFIC_BATTLEPET:
-        case ACHIEVEMENT_CRITERIA_TYPE_EARN_BATTLEPET:
-        case ACHIEVEMENT_CRITERIA_TYPE_CAPTURE_BATTLEPET_IN_COMBAT:
-        case ACHIEVEMENT_CRITERIA_TYPE_LEVELUP_BATTLEPET:
-        case ACHIEVEMENT_CRITERIA_TYPE_BUY_GUILD_BANK_SLOTS:
-        case ACHIEVEMENT_CRITERIA_TYPE_SPENT_GOLD_GUILD_REPAIRS:
-        case ACHIEVEMENT_CRITERIA_TYPE_CRAFT_ITEMS_GUILD:
-        case ACHIEVEMENT_CRITERIA_TYPE_WIN_PETBATTLE:
-        case ACHIEVEMENT_CRITERIA_TYPE_CATCH_FROM_POOL:
-        case ACHIEVEMENT_CRITERIA_TYPE_EARN_GUILD_ACHIEVEMENT_POINTS:
-        case ACHIEVEMENT_CRITERIA_TYPE_BUY_GUILD_TABARD:
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_GUILD:
-        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILLS_GUILD:
-        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE_TYPE_GUILD:
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_GUILD_CHALLENGE_TYPE:
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_GUILD_CHALLENGE:
-        case ACHIEVEMENT_CRITERIA_TYPE_COLLECT_TOYS:
-        case ACHIEVEMENT_CRITERIA_TYPE_COLLECT_HEIRLOOMS:
-        case ACHIEVEMENT_CRITERIA_TYPE_DEFEAT_ENCOUNTER:
-            return l_Progress->counter >= p_CriteriaTree->Amount;
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ACHIEVEMENT:
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
-        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
-        case ACHIEVEMENT_CRITERIA_TYPE_EXPLORE_AREA:
-        case ACHIEVEMENT_CRITERIA_TYPE_WIN_CHALLENGE_DUNGEON:
-            return l_Progress->counter >= 1;
-        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
-            return l_Progress->counter >= (p_CriteriaTree->Amount * 75);
-        case ACHIEVEMENT_CRITERIA_TYPE_EARN_ACHIEVEMENT_POINTS:
-            return l_Progress->counter >= 9000;
-        case ACHIEVEMENT_CRITERIA_TYPE_WIN_ARENA:
-            return p_CriteriaTree->Amount && l_Progress->counter >= p_CriteriaTree->Amount;
-            // handle all statistic-only criteria here
-        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_BATTLEGROUND:
-        case ACHIEVEMENT_CRITERIA_TYPE_DEATH_AT_MAP:
-        case ACHIEVEMENT_CRITERIA_TYPE_DEATH:
-        case ACHIEVEMENT_CRITERIA_TYPE_DEATH_IN_DUNGEON:
-        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
-        case ACHIEVEMENT_CRITERIA_TYPE_HIGH_SCORE_IN_ORDALIE:
-        case ACHIEVEMENT_CRITERIA_TYPE_MOST_CHALLENGE_DUNGEON_WON:
-        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_PLAYER:
-        case ACHIEVEMENT_CRITERIA_TYPE_DEATHS_FROM:
-        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_TEAM_RATING:
-        case ACHIEVEMENT_CRITERIA_TYPE_MONEY_FROM_VENDORS:
-        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_SPENT_FOR_TALENTS:
-        case ACHIEVEMENT_CRITERIA_TYPE_NUMBER_OF_TALENT_RESETS:
-        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_SPENT_AT_BARBER:
-        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_SPENT_FOR_MAIL:
-        case ACHIEVEMENT_CRITERIA_TYPE_LOSE_DUEL:
-        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE_TYPE:
-        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_EARNED_BY_AUCTIONS:
-        case ACHIEVEMENT_CRITERIA_TYPE_CREATE_AUCTION:
-        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_BID:
-        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_SOLD:
-        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_GOLD_VALUE_OWNED:
-        case ACHIEVEMENT_CRITERIA_TYPE_WON_AUCTIONS:
-        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REVERED_REPUTATION:
-        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_HONORED_REPUTATION:
-        case ACHIEVEMENT_CRITERIA_TYPE_KNOWN_FACTIONS:
-        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_EPIC_ITEM:
-        case ACHIEVEMENT_CRITERIA_TYPE_RECEIVE_EPIC_ITEM:
-        case ACHIEVEMENT_CRITERIA_TYPE_ROLL_NEED:
-        case ACHIEVEMENT_CRITERIA_TYPE_ROLL_GREED:
-        case ACHIEVEMENT_CRITERIA_TYPE_QUEST_ABANDONED:
-        case ACHIEVEMENT_CRITERIA_TYPE_FLIGHT_PATHS_TAKEN:
-        case ACHIEVEMENT_CRITERIA_TYPE_ACCEPTED_SUMMONINGS:
-        default:
-            return false;
-    }
-    return false;
+    uint32 l_RequiredCounter = 0;
+    if (!AchievementGlobalMgr::GetCriteriaRequiredCounter(p_Criteria, p_CriteriaTree, l_RequiredCounter))
+        return false;
+
+    return l_Progress->counter >= l_RequiredCounter;
 }
 
 template<class T>
@@ -2141,7 +2062,8 @@ void AchievementMgr<T>::SetCriteriaProgress(CriteriaEntry const* p_Entry, uint64
         m_NeedDBSync = true;
     }
 
-    l_Progress->changed = true;
+    ForgetCompletedCriteria(p_Entry->ID);
+
     l_Progress->date = time(NULL); // set the date to the latest update.
     uint32 l_TimeElapsed = 0; // @todo : Fix me
 
@@ -2173,6 +2095,9 @@ void AchievementMgr<T>::SetCriteriaProgress(CriteriaEntry const* p_Entry, uint64
             l_Progress->CompletedGUID = p_ReferencePlayer->GetGUID();
     }
 
+    /// Queued once every field is final: a save taking the queue earlier would clear `changed` and miss the last values
+    QueueCriteriaSave(p_Entry->ID, *l_Progress);
+
     SendCriteriaUpdate(p_Entry, l_Progress, l_TimeElapsed, false, l_NeedAccountUpdate);
 }
 
@@ -2781,6 +2706,7 @@ bool AchievementMgr<T>::ConditionsSatisfied(CriteriaEntry const* /*p_Criteria*/,
 template<class T>
 bool AchievementMgr<T>::RequirementsSatisfied(CriteriaEntry const* p_Criteria, uint64 p_MiscValue1, uint64 p_MiscValue2, uint64 p_MiscValue3, Unit const* p_Unit, Player* p_ReferencePlayer) const
 {
+    // Criteria are dispatched by asset before reaching this, a change of the misc value checks must be reported in AchievementGlobalMgr::GetCriteriaAssetMatch
     switch (AchievementCriteriaTypes(p_Criteria->Type))
     {
         case ACHIEVEMENT_CRITERIA_TYPE_ACCEPTED_SUMMONINGS:
@@ -3852,7 +3778,7 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
         if (!l_Criteria)
             continue;
 
-        m_AchievementCriteriasByType[l_Criteria->Type].push_back(l_Criteria);
+        m_CriteriaIndex.AddCriteria(l_Criteria);
 
         if (l_Criteria->StartTimer)
             m_AchievementCriteriasByTimedType[l_Criteria->StartEvent].push_back(l_Criteria);
@@ -3860,6 +3786,8 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
         ++l_CriteriaCount;
     }
 
+    m_CriteriaIndex.Compile(m_AchievementCriteriaTreeByCriteriaId, m_SubCriteriaTreeListById, m_AchievementEntryByCriteriaTreeId);
+
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u achievement criteria in %u ms", l_CriteriaCount, GetMSTimeDiffToNow(l_OldMSTime));
 }
 
@@ -4224,6 +4152,35 @@ void AchievementGlobalMgr::PrepareCriteriaUpdateTaskThread()
     }
 }
 
+void AchievementGlobalMgr::AddSaveCycle(uint32 p_UpsertedRows, uint32 p_DeletedRows, uint32 p_CoalescedUpdates, uint32 p_Statements)
+{
+    uint32 l_Rows = p_UpsertedRows + p_DeletedRows;
+
+    ACE_Guard<ACE_Thread_Mutex> l_Guard(m_SaveStatsLock);
+
+    ++m_SaveStats.SaveCycles;
+    if (l_Rows)
+        ++m_SaveStats.WritingCycles;
+
+    m_SaveStats.UpsertedRows     += p_UpsertedRows;
+    m_SaveStats.DeletedRows      += p_DeletedRows;
+    m_SaveStats.CoalescedUpdates += p_CoalescedUpdates;
+    m_SaveStats.Statements       += p_Statements;
+    m_SaveStats.MaxRowsPerCycle   = std::max(m_SaveStats.MaxRowsPerCycle, l_Rows);
+}
+
+AchievementSaveStats AchievementGlobalMgr::GetSaveStats() const
+{
+    ACE_Guard<ACE_Thread_Mutex> l_Guard(m_SaveStatsLock);
+    return m_SaveStats;
+}
+
+void AchievementGlobalMgr::ResetSaveStats()
+{
+    ACE_Guard<ACE_Thread_Mutex> l_Guard(m_SaveStatsLock);
+    m_SaveStats = AchievementSaveStats();
+}
+
 AchievementCriteriaUpdateRequest::AchievementCriteriaUpdateRequest(MapUpdater* p_Updater, AchievementCriteriaTaskQueue p_TaskQueue)
 : MapUpdaterTask(p_Updater), m_CriteriaUpdateTasks(p_TaskQueue)
 {
@@ -358,9 +358,28 @@ bool AuctionHouseMgr::RemoveAItem(uint32 id)
 
 void AuctionHouseMgr::Update()
 {
-    mHordeAuctions.Update();
-    mAllianceAuctions.Update();
-    mNeutralAuctions.Update();
+    uint32 l_MaxCount = sWorld->getIntConfig(CONFIG_AUCTION_EXPIRED_PER_TICK);
+    time_t l_Now      = sWorld->GetGameTime();
+    uint32 l_Closed   = 0;
+
+    /// One transaction for all the auctions closed by this update, none if nothing expired
+    SQLTransaction l_Trans;
+
+    AuctionHouseObject* l_Houses[] = { &mHordeAuctions, &mAllianceAuctions, &mNeutralAuctions };
+    for (AuctionHouseObject* l_House : l_Houses)
+    {
+        if (l_MaxCount && l_Closed >= l_MaxCount)
+            break;
+
+        l_Closed += l_House->Update(l_Now, l_MaxCount ? l_MaxCount - l_Closed : 0, l_Trans);
+    }
+
+    if (!l_Trans)
+        return;
+
+    sLog->outDebug(LOG_FILTER_AUCTIONHOUSE, "AuctionHouseMgr::Update: %u expired auctions closed, %u queries", l_Closed, uint32(l_Trans->GetSize()));
+
+    CharacterDatabase.CommitTransaction(l_Trans);
 }
 
 AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTemplateId)
@@ -408,12 +427,14 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    m_ExpiryIndex.insert(std::make_pair(auction->expire_time, auction->Id));
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry*/)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    m_ExpiryIndex.erase(std::make_pair(auction->expire_time, auction->Id));
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -422,36 +443,30 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry
     return wasInMap;
 }
 
-void AuctionHouseObject::Update()
+uint32 AuctionHouseObject::Update(time_t p_Now, uint32 p_MaxCount, SQLTransaction& p_Trans)
 {
-    time_t curTime = sWorld->GetGameTime();
-    ///- Handle expired auctions
+    uint32 l_Closed = 0;
 
-    // If storage is empty, no need to update. next == NULL in this case.
-    if (AuctionsMap.empty())
-        return;
-
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_AUCTION_BY_TIME);
-    stmt->setUInt32(0, (uint32)curTime+60);
-    
-    PreparedQueryResult l_Result = CharacterDatabase.Query(stmt);
-    if (!l_Result)
-        return;
-
-    do
+    ///- Handle expired auctions, oldest first
+    while (!m_ExpiryIndex.empty() && m_ExpiryIndex.begin()->first <= p_Now)
     {
-        // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = GetAuction(l_Result->Fetch()->GetUInt32());
+        if (p_MaxCount && l_Closed >= p_MaxCount)
+            break;
 
+        AuctionEntry* auction = GetAuction(m_ExpiryIndex.begin()->second);
         if (!auction)
+        {
+            m_ExpiryIndex.erase(m_ExpiryIndex.begin());
             continue;
+        }
 
-        SQLTransaction trans = CharacterDatabase.BeginTransaction();
+        if (!p_Trans)
+            p_Trans = CharacterDatabase.BeginTransaction();
 
         ///- Either cancel the auction if there was no bidder
         if (auction->bidder == 0)
         {
-            sAuctionMgr->SendAuctionExpiredMail(auction, trans);
+            sAuctionMgr->SendAuctionExpiredMail(auction, p_Trans);
             sScriptMgr->OnAuctionExpire(this, auction);
         }
         ///- Or perform the transaction
@@ -460,21 +475,22 @@ void AuctionHouseObject::Update()
             //we should send an "item sold" message if the seller is online
             //we send the item to the winner
             //we send the money to the seller
-            sAuctionMgr->SendAuctionSuccessfulMail(auction, trans);
-            sAuctionMgr->SendAuctionWonMail(auction, trans);
+            sAuctionMgr->SendAuctionSuccessfulMail(auction, p_Trans);
+            sAuctionMgr->SendAuctionWonMail(auction, p_Trans);
             sScriptMgr->OnAuctionSuccessful(this, auction);
         }
 
         uint32 itemEntry = auction->itemEntry;
 
         ///- In any case clear the auction
-        auction->DeleteFromDB(trans);
-        CharacterDatabase.CommitTransaction(trans);
+        auction->DeleteFromDB(p_Trans);
 
         sAuctionMgr->RemoveAItem(auction->itemGUIDLow);
         RemoveAuction(auction, itemEntry);
+        ++l_Closed;
     }
-    while (l_Result->NextRow());
+
+    return l_Closed;
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -89,7 +89,7 @@ class AuctionHouseObject
 {
   public:
     // Initialize storage
-    AuctionHouseObject() { next = AuctionsMap.begin(); }
+    AuctionHouseObject() { }
     ~AuctionHouseObject()
     {
         for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -113,7 +113,9 @@ class AuctionHouseObject
 
     bool RemoveAuction(AuctionEntry* auction, uint32 itemEntry);
 
-    void Update();
+    /// Closes the auctions expired at p_Now in expiry order, at most p_MaxCount of them (0 for all)
+    /// Their mails and deletions are appended to p_Trans, started on the first expired auction
+    uint32 Update(time_t p_Now, uint32 p_MaxCount, SQLTransaction& p_Trans);
 
     void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
@@ -125,8 +127,9 @@ class AuctionHouseObject
   private:
     AuctionEntryMap AuctionsMap;
 
-    // storage for "next" auction item for next Update()
-    AuctionEntryMap::const_iterator next;
+    /// Expire time and id of every auction, Update only reads its front
+    typedef std::set<std::pair<time_t, uint32>> AuctionExpiryIndex;
+    AuctionExpiryIndex m_ExpiryIndex;
 };
 
 class AuctionHouseMgr
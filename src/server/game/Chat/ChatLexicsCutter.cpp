@@ -11,9 +11,8 @@
 #include "Common.h"
 #include "ChatLexicsCutter.h"
 
-LexicsCutter::LexicsCutter()
+LexicsCutter::LexicsCutter() : SpaceClass(0), SymbolCount(0), StartState(0), IgnoreMiddleSpaces(true), IgnoreLetterRepeat(true), CheckLetterContains(false)
 {
-    InvalidChars = "~`!@#$%^&*()-_+=[{]}|\\;:'\",<.>/?1234567890";
 }
 
 bool LexicsCutter::ReadUTF8(std::string& in, std::string& out, unsigned int& pos)
@@ -33,6 +32,29 @@ bool LexicsCutter::ReadUTF8(std::string& in, std::string& out, unsigned int& pos
     return true;
 }
 
+uint32 LexicsCutter::DecodeUTF8(std::string const& in, unsigned int& pos)
+{
+    // same grouping of bytes as ReadUTF8, malformed sequences still give distinct values
+    static uint32 const leadMask[6] = { 0x7F, 0x1F, 0x0F, 0x07, 0x03, 0x01 };
+
+    unsigned char c = in[pos++];
+    int toread = trailingBytesForUTF8[(int)c];
+    if (c < 0xC0)
+        return c;
+
+    uint32 codepoint = c & leadMask[toread];
+    while (toread > 0)
+    {
+        if (pos >= in.length())
+            return codepoint | 0x80000000;
+
+        codepoint = (codepoint << 6) | (uint8(in[pos++]) & 0x3F);
+        toread--;
+    }
+
+    return codepoint;
+}
+
 std::string LexicsCutter::trim(std::string& s, const std::string& drop)
 {
     std::string r = s.erase(s.find_last_not_of(drop) + 1);
@@ -51,8 +73,6 @@ bool LexicsCutter::ReadLetterAnalogs(std::string& FileName)
     char line[1024];
     unsigned int pos;
     std::string line_s;
-    std::string lchar;
-    std::string lanalog;
 
     ma_file = fopen(FileName.c_str(), "rb");
     if (!ma_file)
@@ -68,7 +88,7 @@ bool LexicsCutter::ReadLetterAnalogs(std::string& FileName)
         {
             if (line[0] == '\xEF' && line[1] == '\xBB' && line[2] == '\xBF')
             {
-                strncpy(&line[0], &line[3], strlen(line) - 3);
+                memmove(&line[0], &line[3], strlen(line) - 2);
             }
         }
 
@@ -87,14 +107,14 @@ bool LexicsCutter::ReadLetterAnalogs(std::string& FileName)
         line_s = trim(line_s, "\x0A\x0D");
 
         pos = 0;
-        if (ReadUTF8(line_s, lchar, pos))
+        if (pos < line_s.length())
         {
+            uint32 lchar = DecodeUTF8(line_s, pos);
+
             // create analogs vector
             LC_AnalogVector av;
-            while (ReadUTF8(line_s, lanalog, pos))
-            {
-                av.push_back(lanalog);
-            }
+            while (pos < line_s.length())
+                av.push_back(DecodeUTF8(line_s, pos));
 
             // store vector in hash map
             AnalogMap[lchar] = av;
@@ -112,7 +132,6 @@ bool LexicsCutter::ReadInnormativeWords(std::string& FileName)
     char line[1024];
     unsigned int pos;
     std::string line_s;
-    std::string lchar;
 
     ma_file = fopen(FileName.c_str(), "rb");
     if (!ma_file)
@@ -128,7 +147,7 @@ bool LexicsCutter::ReadInnormativeWords(std::string& FileName)
         {
             if (line[0] == '\xEF' && line[1] == '\xBB' && line[2] == '\xBF')
             {
-                strncpy(&line[0], &line[3], strlen(line) - 3);
+                memmove(&line[0], &line[3], strlen(line) - 2);
             }
         }
 
@@ -147,133 +166,340 @@ bool LexicsCutter::ReadInnormativeWords(std::string& FileName)
         line_s = line;
         line_s = trim(line_s, "\x0A\x0D");
 
-        // create word vector of vectors
-        LC_WordVector vw;
+        // letter analogs are resolved by Build
+        LC_Word word;
         pos = 0;
-        while (ReadUTF8(line_s, lchar, pos))
-        {
-            // create letter set
-            LC_LetterSet vl;
+        while (pos < line_s.length())
+            word.push_back(DecodeUTF8(line_s, pos));
+
+        // push new word to words list
+        WordList.push_back(word);
+    }
+
+    fclose(ma_file);
+
+    return true;
+}
 
-            // initialize letter set with letter read
-            vl.insert(lchar);
 
-            // find letter analogs and push them onto the vector
-            LC_AnalogMap::iterator itr = AnalogMap.find(lchar);
-            if (itr != AnalogMap.end())
+void LexicsCutter::BuildTrie()
+{
+    Trie.assign(1, TrieNode());
+
+    for (LC_WordList::const_iterator itr = WordList.begin(); itr != WordList.end(); ++itr)
+    {
+        uint32 node = 0;
+        for (LC_Word::const_iterator letter = itr->begin(); letter != itr->end(); ++letter)
+        {
+            uint32 child = 0;
+            for (uint32 i = 0; i < Trie[node].Children.size(); ++i)
             {
-                // analogs present, iterate
-                for (LC_AnalogVector::iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); itr2++)
+                if (Trie[node].Children[i].first == *letter)
                 {
-                    vl.insert(*itr2);
+                    child = Trie[node].Children[i].second;
+                    break;
                 }
             }
 
-            // add letter vector to word vector
-            vw.push_back(vl);
+            if (!child)
+            {
+                child = Trie.size();
+                Trie.push_back(TrieNode());
+                Trie[child].Depth = Trie[node].Depth + 1;
+                Trie[node].Children.push_back(std::make_pair(*letter, child));
+            }
+
+            node = child;
         }
 
-        // push new word to words list
-        WordList.push_back(vw);
+        Trie[node].Terminal = true;
     }
+}
 
-    fclose(ma_file);
+void LexicsCutter::BuildClasses()
+{
+    // word letters each codepoint can stand for: the letter itself and the letters it is an analog of
+    std::map< uint32, std::vector< uint32 > > codepointLetters;
+    for (uint32 node = 0; node < Trie.size(); ++node)
+    {
+        for (uint32 i = 0; i < Trie[node].Children.size(); ++i)
+        {
+            uint32 letter = Trie[node].Children[i].first;
+            codepointLetters[letter].push_back(letter);
 
-    return true;
+            LC_AnalogMap::const_iterator analogs = AnalogMap.find(letter);
+            if (analogs != AnalogMap.end())
+                for (LC_AnalogVector::const_iterator itr = analogs->second.begin(); itr != analogs->second.end(); ++itr)
+                    codepointLetters[*itr].push_back(letter);
+        }
+    }
+
+    if (IgnoreMiddleSpaces)
+        codepointLetters[' '];
+
+    // codepoints standing for the same letters are the same input for the automaton
+    std::map< std::pair< bool, std::vector< uint32 > >, uint16 > classes;
+    ClassLetters.assign(1, std::vector< uint32 >());
+    classes[std::make_pair(false, std::vector< uint32 >())] = 0;
+
+    DirectClasses.assign(LEXICS_CUTTER_DIRECT_CODEPOINTS, 0);
+    SparseClasses.clear();
+    SpaceClass = 0;
+
+    for (std::map< uint32, std::vector< uint32 > >::iterator itr = codepointLetters.begin(); itr != codepointLetters.end(); ++itr)
+    {
+        std::vector< uint32 >& letters = itr->second;
+        std::sort(letters.begin(), letters.end());
+        letters.erase(std::unique(letters.begin(), letters.end()), letters.end());
+
+        bool space = IgnoreMiddleSpaces && itr->first == ' ';
+        std::pair< bool, std::vector< uint32 > > key(space, letters);
+
+        std::map< std::pair< bool, std::vector< uint32 > >, uint16 >::iterator classItr = classes.find(key);
+        if (classItr == classes.end())
+        {
+            classItr = classes.insert(std::make_pair(key, uint16(ClassLetters.size()))).first;
+            ClassLetters.push_back(letters);
+        }
+
+        if (space)
+            SpaceClass = classItr->second;
+
+        if (itr->first < LEXICS_CUTTER_DIRECT_CODEPOINTS)
+            DirectClasses[itr->first] = classItr->second;
+        else
+            SparseClasses.push_back(std::make_pair(itr->first, classItr->second));
+    }
 }
 
-void LexicsCutter::MapInnormativeWords()
+uint16 LexicsCutter::GetClass(uint32 codepoint) const
+{
+    if (codepoint < LEXICS_CUTTER_DIRECT_CODEPOINTS)
+        return DirectClasses[codepoint];
+
+    std::vector< std::pair< uint32, uint16 > >::const_iterator itr = std::lower_bound(SparseClasses.begin(), SparseClasses.end(), std::make_pair(codepoint, uint16(0)));
+    if (itr != SparseClasses.end() && itr->first == codepoint)
+        return itr->second;
+
+    return 0;
+}
+
+void LexicsCutter::StepState(std::vector< uint32 > const& state, uint32 symbol, std::vector< uint32 >& next) const
+{
+    // a state is the sorted list of trie nodes reached (node << 1 | reached by a letter match), the root is implicit
+    std::vector< uint32 > const& letters = ClassLetters[symbol >> 1];
+    bool skip = (SpaceClass && (symbol >> 1) == SpaceClass) || (symbol & 1);
+
+    next.clear();
+
+    for (uint32 i = 0; i <= state.size(); ++i)
+    {
+        uint32 node = i < state.size() ? state[i] >> 1 : 0;
+        bool unmatched = false;
+
+        for (uint32 j = 0; j < Trie[node].Children.size(); ++j)
+        {
+            if (std::binary_search(letters.begin(), letters.end(), Trie[node].Children[j].first))
+                next.push_back(Trie[node].Children[j].second << 1 | 1);
+            else
+                unmatched = true;
+        }
+
+        // words going on with another letter skip the character, as the original per-word comparison did
+        if (node && skip && unmatched)
+            next.push_back(node << 1);
+    }
+
+    std::sort(next.begin(), next.end());
+
+    // a node both skipped and matched keeps the match
+    std::vector< uint32 >::iterator out = next.begin();
+    for (std::vector< uint32 >::iterator itr = next.begin(); itr != next.end(); ++itr)
+    {
+        if (out != next.begin() && (*(out - 1) >> 1) == (*itr >> 1))
+            *(out - 1) |= *itr;
+        else
+            *out++ = *itr;
+    }
+
+    next.erase(out, next.end());
+}
+
+bool LexicsCutter::BuildAutomaton()
 {
-    // process all the words in the vector
-    for (unsigned int i = 0; i < WordList.size(); i++)
+    SymbolCount = ClassLetters.size() * 2;
+    Transitions.clear();
+    StateFlags.clear();
+    StartState = 0;
+
+    // with IgnoreLetterRepeat a state also holds the class of the last character: the repeat symbols of
+    // the other classes can't follow it, exploring them would only build unreachable states
+    typedef std::pair< uint32, std::vector< uint32 > > StateKey;
+    uint32 const noClass = ClassLetters.size();
+
+    std::map< StateKey, uint32 > stateIds;
+    std::vector< StateKey > states;
+
+    states.push_back(StateKey(IgnoreLetterRepeat ? noClass : 0, std::vector< uint32 >()));
+    stateIds[states[0]] = 0;
+    StateFlags.push_back(0);
+
+    std::vector< uint32 > next;
+    for (uint32 id = 0; id < states.size(); ++id)
     {
-        // parse all analogs in the first word letter
-        for (LC_LetterSet::iterator itr = (*WordList[i].begin()).begin(); itr != (*WordList[i].begin()).end(); itr++)
+        Transitions.resize((id + 1) * SymbolCount, id);
+
+        // the scan stops on the first match
+        if (StateFlags[id] & STATE_FLAG_MATCH)
+            continue;
+
+        for (uint32 symbol = 0; symbol < SymbolCount; ++symbol)
         {
-            // map the word to its first letter variants
-            WordMap.insert(std::pair< std::string, unsigned int >(*itr, i));
+            if ((symbol & 1) && (symbol >> 1) != states[id].first)
+            {
+                Transitions[id * SymbolCount + symbol] = Transitions[id * SymbolCount + symbol - 1];
+                continue;
+            }
+
+            StepState(states[id].second, symbol, next);
+
+            StateKey key(IgnoreLetterRepeat ? symbol >> 1 : 0, next);
+            std::map< StateKey, uint32 >::iterator itr = stateIds.find(key);
+            if (itr == stateIds.end())
+            {
+                if (states.size() >= LEXICS_CUTTER_MAX_STATES)
+                {
+                    Transitions.clear();
+                    StateFlags.clear();
+                    return false;
+                }
+
+                uint8 flags = 0;
+                for (uint32 i = 0; i < next.size(); ++i)
+                {
+                    if (Trie[next[i] >> 1].Terminal)
+                        flags |= STATE_FLAG_MATCH;
+
+                    if ((next[i] & 1) && Trie[next[i] >> 1].Depth >= 2)
+                        flags |= STATE_FLAG_CONTAINS;
+                }
+
+                itr = stateIds.insert(std::make_pair(key, uint32(states.size()))).first;
+                states.push_back(key);
+                StateFlags.push_back(flags);
+            }
+
+            Transitions[id * SymbolCount + symbol] = itr->second;
         }
     }
+
+    // the original scan prepended a space to the message, words starting with a space matched at its beginning
+    StartState = Transitions[GetClass(' ') * 2];
+
+    return true;
 }
 
-bool LexicsCutter::CompareWord(std::string& str, unsigned int pos, LC_WordVector word)
+bool LexicsCutter::Build()
 {
-    std::string lchar_prev;
-    std::string lchar;
+    WordMap.clear();
+
+    BuildTrie();
+    BuildClasses();
+    if (BuildAutomaton())
+        return true;
+
+    MapInnormativeWords();
+    return false;
+}
 
-    // read first letter of the word into lchar_prev
-    ReadUTF8(str, lchar, pos);
+void LexicsCutter::MapInnormativeWords()
+{
+    for (uint32 i = 0; i < WordList.size(); ++i)
+        WordMap.insert(std::make_pair(WordList[i].front(), i));
+}
 
-    // okay, here we go, comparing word
+bool LexicsCutter::CompareWord(std::vector< uint32 > const& str, uint32 pos, LC_Word const& word) const
+{
     // first letter is already okay, we do begin from second and go on
-    LC_WordVector::iterator i = word.begin();
-    i++;
-    while (i != word.end())
+    uint32 previous = str[pos++];
+
+    LC_Word::const_iterator letter = word.begin() + 1;
+    while (letter != word.end())
     {
-        // get letter from word, return false if the string is shorter
-        if (!ReadUTF8(str, lchar, pos))
+        // return false if the string is shorter
+        if (pos >= str.size())
             return false;
 
-        // check, if the letter is in the set
-        LC_LetterSet ls = *i;
-        if (ls.count(lchar) == 0)
+        uint32 codepoint = str[pos++];
+        std::vector< uint32 > const& letters = ClassLetters[GetClass(codepoint)];
+        if (!std::binary_search(letters.begin(), letters.end(), *letter))
         {
-            // letter is not in set, but we must check, if it is not space or repeat
-            if ((!(IgnoreMiddleSpaces && (lchar == " "))) &&
-                (!(IgnoreLetterRepeat && (lchar == lchar_prev))))
-            {
+            // letter doesn't match, but we must check, if it is not space or repeat
+            if (!(IgnoreMiddleSpaces && codepoint == ' ') && !(IgnoreLetterRepeat && codepoint == previous))
                 return false;
-            }
         }
         else
         {
-            if (CheckLetterContains)
-                if (str.size() == pos)
-                    return true;
+            if (CheckLetterContains && pos == str.size())
+                return true;
 
             // next word letter
-            i++;
+            ++letter;
         }
-        // set previous string letter to compare if needed (this check can really conserve time)
-        if (IgnoreLetterRepeat)
-            lchar_prev = lchar;
+
+        previous = codepoint;
     }
 
     return true;
 }
 
-bool LexicsCutter::CheckLexics(std::string& Phrase)
+bool LexicsCutter::CheckLexicsPerWord(std::string const& Phrase) const
 {
-    std::string lchar;
-    LC_WordMap::iterator i;
-    std::pair< LC_WordMap::iterator, LC_WordMap::iterator > ii;
-
-    if (Phrase.size() == 0)
+    if (WordMap.empty() || Phrase.empty())
         return false;
 
-    // first, convert the string, adding spaces and removing invalid characters
-    // also create fast position vector for the new positions
-    std::string str = " ";
+    // same leading space as the automaton
+    std::vector< uint32 > str(1, ' ');
     unsigned int pos = 0;
-    while (ReadUTF8(Phrase, lchar, pos))
-        str.append(lchar);
+    while (pos < Phrase.length())
+        str.push_back(DecodeUTF8(Phrase, pos));
 
-    // string prepared, now parse it and scan for all the words
-    unsigned int pos_prev = 0;
-    pos = 0;
-    while (ReadUTF8(str, lchar, pos))
+    for (uint32 start = 0; start < str.size(); ++start)
     {
-        // got character, now try to find wordmap for it
-        ii = WordMap.equal_range(lchar);
-        for (i = ii.first; i != ii.second; i++)
+        // words whose first letter the character stands for
+        std::vector< uint32 > const& letters = ClassLetters[GetClass(str[start])];
+        for (std::vector< uint32 >::const_iterator letter = letters.begin(); letter != letters.end(); ++letter)
         {
-            // compare word at initial position
-            if (CompareWord(str, pos_prev, WordList[i->second]))
-                return true;
+            std::pair< LC_WordMap::const_iterator, LC_WordMap::const_iterator > words = WordMap.equal_range(*letter);
+            for (LC_WordMap::const_iterator itr = words.first; itr != words.second; ++itr)
+                if (CompareWord(str, start, WordList[itr->second]))
+                    return true;
         }
-        // set initial position to the current position
-        pos_prev = pos;
     }
 
     return false;
 }
+
+bool LexicsCutter::CheckLexics(std::string const& Phrase) const
+{
+    if (Transitions.empty())
+        return CheckLexicsPerWord(Phrase);
+
+    uint32 state = StartState;
+    uint32 previous = ' ';
+    unsigned int pos = 0;
+
+    while (pos < Phrase.length())
+    {
+        uint32 codepoint = DecodeUTF8(Phrase, pos);
+        uint32 symbol = GetClass(codepoint) * 2 + (IgnoreLetterRepeat && codepoint == previous ? 1 : 0);
+
+        state = Transitions[state * SymbolCount + symbol];
+        if (StateFlags[state] & STATE_FLAG_MATCH)
+            return true;
+
+        previous = codepoint;
+    }
+
+    return CheckLetterContains && (StateFlags[state] & STATE_FLAG_CONTAINS);
+}
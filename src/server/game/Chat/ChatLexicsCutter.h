@@ -1,12 +1,11 @@
 #ifndef CHATLEXICSCUTTER_H
 #define CHATLEXICSCUTTER_H
 
-typedef std::vector< std::string > LC_AnalogVector;
-typedef std::map< std::string, LC_AnalogVector > LC_AnalogMap;
-typedef std::set< std::string > LC_LetterSet;
-typedef std::vector< LC_LetterSet > LC_WordVector;
-typedef std::vector< LC_WordVector > LC_WordList;
-typedef std::multimap< std::string, unsigned int > LC_WordMap;
+typedef std::vector< uint32 > LC_AnalogVector;
+typedef std::map< uint32, LC_AnalogVector > LC_AnalogMap;
+typedef std::vector< uint32 > LC_Word;
+typedef std::vector< LC_Word > LC_WordList;
+typedef std::multimap< uint32, uint32 > LC_WordMap;
 
 static int trailingBytesForUTF8[256] = {
     0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
@@ -19,14 +18,66 @@ static int trailingBytesForUTF8[256] = {
     2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2, 3,3,3,3,3,3,3,3,4,4,4,4,5,5,5,5
 };
 
+/// Codepoints below this bound are classified with a plain array, the others by binary search
+#define LEXICS_CUTTER_DIRECT_CODEPOINTS 0x800
+/// Upper bound of the automaton, a word list needing more states is checked with the per-word scan instead
+#define LEXICS_CUTTER_MAX_STATES 262144
+
+/// Innormative words filter
+/// The words and the letter analogs are compiled by Build into a DFA over UTF-8 codepoints: every state is the set of
+/// word prefixes matched so far (from any start position, like Aho-Corasick), so CheckLexics reads each message once,
+/// without allocation, whatever the size of the word list
+/// A letter of a word matches itself and its analogs; inside a word, spaces (IgnoreMiddleSpaces) and repeats of the
+/// previous character (IgnoreLetterRepeat) are skipped when they don't match the next letter
+/// Messages are read as if they started with a space, so words written with a leading space also match at the start
 class LexicsCutter
 {
     protected:
         LC_AnalogMap AnalogMap;
         LC_WordList WordList;
-        LC_WordMap WordMap;
+        LC_WordMap WordMap;                                         ///< first word letter -> word, only for the per-word scan
+
+        struct TrieNode
+        {
+            TrieNode() : Depth(0), Terminal(false) { }
+
+            std::vector< std::pair< uint32, uint32 > > Children;    ///< word letter, node
+            uint32 Depth;
+            bool Terminal;
+        };
+
+        std::vector< TrieNode > Trie;
+
+        /// codepoint -> class, codepoints sharing the same letters share a class, 0 matches no letter
+        std::vector< uint16 > DirectClasses;
+        std::vector< std::pair< uint32, uint16 > > SparseClasses;
+        std::vector< std::vector< uint32 > > ClassLetters;          ///< sorted word letters matched by each class
+        uint16 SpaceClass;
+
+        /// DFA, symbol = class * 2 + (codepoint repeats the previous one)
+        uint32 SymbolCount;
+        std::vector< uint32 > Transitions;
+        std::vector< uint8 > StateFlags;
+        uint32 StartState;                                          ///< state after the leading space
+
+        enum StateFlag
+        {
+            STATE_FLAG_MATCH    = 0x1,      ///< a whole word was read
+            STATE_FLAG_CONTAINS = 0x2,      ///< the last character matched at least the second letter of a word, for CheckLetterContains
+        };
 
-        std::string InvalidChars;
+        static uint32 DecodeUTF8(std::string const& in, unsigned int& pos);
+
+        uint16 GetClass(uint32 codepoint) const;
+        void BuildTrie();
+        void BuildClasses();
+        bool BuildAutomaton();
+        void StepState(std::vector< uint32 > const& state, uint32 symbol, std::vector< uint32 >& next) const;
+
+        /// Per-word scan, used when the word list needs more than LEXICS_CUTTER_MAX_STATES states
+        void MapInnormativeWords();
+        bool CompareWord(std::vector< uint32 > const& str, uint32 pos, LC_Word const& word) const;
+        bool CheckLexicsPerWord(std::string const& Phrase) const;
 
     public:
         LexicsCutter();
@@ -37,11 +88,14 @@ class LexicsCutter
         static std::string ltrim(std::string &data);
         bool ReadLetterAnalogs(std::string& FileName);
         bool ReadInnormativeWords(std::string& FileName);
-        void MapInnormativeWords();
-        bool CompareWord(std::string& str, unsigned int pos, LC_WordVector word);
-        bool CheckLexics(std::string& Phrase);
-        
-        std::vector< std::pair< unsigned int, unsigned int > > Found;
+        /// Compiles the automaton, must be called once the files are read and the options set
+        /// Returns false if the automaton needs too many states, CheckLexics then falls back to the per-word scan
+        bool Build();
+        bool CheckLexics(std::string const& Phrase) const;
+
+        uint32 GetWordCount() const { return WordList.size(); }
+        uint32 GetStateCount() const { return StateFlags.size(); }
+
         bool IgnoreMiddleSpaces;
         bool IgnoreLetterRepeat;
         bool CheckLetterContains;
@@ -340,6 +340,42 @@ bool Condition::Meets(ConditionSourceInfo& sourceInfo) const
     return condMeets && script;
 }
 
+bool Condition::IsWorldCondition() const
+{
+    if (ReferenceId || ScriptId)
+        return false;
+
+    switch (ConditionType)
+    {
+        case CONDITION_ACTIVE_EVENT:
+        case CONDITION_WORLD_STATE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool Condition::MeetsWorld() const
+{
+    bool condMeets = false;
+    switch (ConditionType)
+    {
+        case CONDITION_ACTIVE_EVENT:
+            condMeets = sGameEventMgr->IsActiveEvent(ConditionValue1);
+            break;
+        case CONDITION_WORLD_STATE:
+            condMeets = ConditionValue2 == sWorld->getWorldState(ConditionValue1);
+            break;
+        default:
+            return true;                                        // depends on the object, unknown here
+    }
+
+    if (NegativeCondition)
+        condMeets = !condMeets;
+
+    return condMeets;
+}
+
 uint32 Condition::GetSearcherTypeMaskForCondition() const
 {
     // build mask of types for which condition can return true
@@ -652,6 +688,39 @@ bool ConditionMgr::IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, Con
     return IsObjectMeetToConditionList(sourceInfo, conditions);
 }
 
+bool ConditionMgr::CanMeetWorldConditions(ConditionContainer const& conditions) const
+{
+    //     groupId, groupCanPass
+    std::map<uint32, bool> elseGroupStore;
+    for (Condition const* condition : conditions)
+    {
+        if (!condition->isLoaded())
+            continue;
+
+        bool& canPass = elseGroupStore.insert(std::make_pair(condition->ElseGroup, true)).first->second;
+        if (canPass && condition->IsWorldCondition() && !condition->MeetsWorld())
+            canPass = false;
+    }
+
+    if (elseGroupStore.empty())
+        return true;
+
+    for (std::map<uint32, bool>::const_iterator i = elseGroupStore.begin(); i != elseGroupStore.end(); ++i)
+        if (i->second)
+            return true;
+
+    return false;
+}
+
+bool ConditionMgr::HasWorldConditions(ConditionContainer const& conditions) const
+{
+    for (Condition const* condition : conditions)
+        if (condition->isLoaded() && condition->IsWorldCondition())
+            return true;
+
+    return false;
+}
+
 bool ConditionMgr::CanHaveSourceGroupSet(ConditionSourceType sourceType) const
 {
     return (sourceType == CONDITION_SOURCE_TYPE_CREATURE_LOOT_TEMPLATE ||
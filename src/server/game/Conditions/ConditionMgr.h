@@ -196,6 +196,9 @@ struct Condition
     }
 
     bool Meets(ConditionSourceInfo& sourceInfo) const;
+    // Conditions which don't depend on the checked object (events, world states), they can be checked without target
+    bool IsWorldCondition() const;
+    bool MeetsWorld() const;
     uint32 GetSearcherTypeMaskForCondition() const;
     bool isLoaded() const { return ConditionType > CONDITION_NONE || ReferenceId; }
     uint32 GetMaxAvailableConditionTargets() const;
@@ -226,6 +229,9 @@ class ConditionMgr
         bool IsObjectMeetToConditions(WorldObject* object, ConditionContainer const& conditions) const;
         bool IsObjectMeetToConditions(WorldObject* object1, WorldObject* object2, ConditionContainer const& conditions) const;
         bool IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const;
+        // False if no else group can be met whatever the object, only world conditions are checked
+        bool CanMeetWorldConditions(ConditionContainer const& conditions) const;
+        bool HasWorldConditions(ConditionContainer const& conditions) const;
         bool CanHaveSourceGroupSet(ConditionSourceType sourceType) const;
         bool CanHaveSourceIdSet(ConditionSourceType sourceType) const;
         bool IsObjectMeetingNotGroupedConditions(ConditionSourceType sourceType, uint32 entry, ConditionSourceInfo& sourceInfo) const;
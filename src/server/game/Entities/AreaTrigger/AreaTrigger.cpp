@@ -20,6 +20,8 @@
 #include "ScriptMgr.h"
 #include "MoveSplineInit.h"
 
+POOLED_OBJECT_DEFINE(AreaTrigger, sizeof(AreaTrigger), 64)
+
 AreaTrigger::AreaTrigger()
     : WorldObject(false),
     m_Duration(0),
@@ -11,6 +11,7 @@
 
 # include "Object.h"
 # include "Timer.h"
+# include "PoolAllocator.h"
 
 class Unit;
 class SpellInfo;
@@ -245,6 +246,8 @@ typedef std::map<uint32, AreaTriggerTemplateList> AreaTriggerTemplateContainer;
 
 class AreaTrigger : public WorldObject, public GridObject<AreaTrigger>
 {
+    POOLED_OBJECT_DECLARE()
+
     public:
         AreaTrigger();
         ~AreaTrigger();
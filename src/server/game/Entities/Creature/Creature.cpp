@@ -42,11 +42,17 @@
 #include "MoveSpline.h"
 #include "WildBattlePet.h"
 #include "Transport.h"
+#include "TickProfiler.h"
+#include "TemporarySummon.h"
+#include "Totem.h"
 
 #ifndef CROSS
 # include "GarrisonNPCAI.hpp"
 #endif
 
+/// Summons share the creature blocks, pets are saved and reloaded with their owner and stay on the global allocator
+POOLED_OBJECT_DEFINE(Creature, std::max({ sizeof(Creature), sizeof(TempSummon), sizeof(Minion), sizeof(Guardian), sizeof(Puppet), sizeof(Totem) }), 64)
+
 TrainerSpell const* TrainerSpellData::Find(uint32 spell_id) const
 {
     TrainerSpellMap::const_iterator itr = spellList.find(spell_id);
@@ -497,6 +503,8 @@ void Creature::UpdateMovementFlags()
 
 void Creature::Update(uint32 diff)
 {
+    TICK_PROFILE_ZONE_ARG("Creature::Update", GetEntry());
+
     if (m_LOSCheckTimer <= diff)
     {
         m_LOSCheck_player = true;
@@ -645,7 +653,10 @@ void Creature::Update(uint32 diff)
                 m_AI_locked = true;
                 uint32 diffAI = getMSTime();
 
-                i_AI->UpdateAI(diff);
+                {
+                    TICK_PROFILE_ZONE_ARG("CreatureAI::UpdateAI", GetEntry());
+                    i_AI->UpdateAI(diff);
+                }
 
                 if ((getMSTime() - diffAI) > 10)
                     sLog->outAshran("CreatureScript [%u] take more than 10 ms to execute (%u ms)", GetEntry(), (getMSTime() - diffAI));
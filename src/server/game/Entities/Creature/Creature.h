@@ -16,6 +16,7 @@
 #include "LootMgr.h"
 #include "DatabaseEnv.h"
 #include "Cell.h"
+#include "PoolAllocator.h"
 
 class SpellInfo;
 class GarrisonNPCAI;
@@ -44,6 +45,7 @@ enum CreatureFlagsExtra
     CREATURE_FLAG_EXTRA_TAUNT_DIMINISH      = 0x00080000,       ///< Taunt is a subject to diminishing returns on this creautre·
     CREATURE_FLAG_EXTRA_ALL_DIMINISH        = 0x00100000,       ///< Creature is subject to all diminishing returns as player are
     CREATURE_FLAG_EXTRA_LOG_GROUP_DMG       = 0x00200000,       ///< All damage done to the create will be logged into database, help to spot cheaters/exploit/usebug
+    CREATURE_FLAG_EXTRA_FLOW_FIELD_PATHING  = 0x00400000,       ///< creature chase path is taken from a flow field shared with the other chasers of its target (armies, big packs)
     CREATURE_FLAG_EXTRA_DUNGEON_BOSS        = 0x10000000,       ///< creature is a dungeon boss
     CREATURE_FLAG_EXTRA_IGNORE_PATHFINDING  = 0x20000000,       ///< creature ignore pathfinding (NYI)
     CREATURE_FLAG_EXTRA_DUNGEON_END_BOSS    = 0x40000000        ///< Creature is the last boss of the dungeon where he is
@@ -54,7 +56,8 @@ enum CreatureFlagsExtra
     CREATURE_FLAG_EXTRA_NO_CRUSH | CREATURE_FLAG_EXTRA_NO_XP_AT_KILL | CREATURE_FLAG_EXTRA_TRIGGER | \
     CREATURE_FLAG_EXTRA_NO_TAUNT | CREATURE_FLAG_EXTRA_WORLDEVENT | CREATURE_FLAG_EXTRA_NO_CRIT | CREATURE_FLAG_EXTRA_IGNORE_PATHFINDING | \
     CREATURE_FLAG_EXTRA_NO_SKILLGAIN | CREATURE_FLAG_EXTRA_TAUNT_DIMINISH | CREATURE_FLAG_EXTRA_ALL_DIMINISH | \
-    CREATURE_FLAG_EXTRA_GUARD | CREATURE_FLAG_EXTRA_DUNGEON_END_BOSS | CREATURE_FLAG_EXTRA_DUNGEON_BOSS | CREATURE_FLAG_EXTRA_LOG_GROUP_DMG)
+    CREATURE_FLAG_EXTRA_GUARD | CREATURE_FLAG_EXTRA_DUNGEON_END_BOSS | CREATURE_FLAG_EXTRA_DUNGEON_BOSS | CREATURE_FLAG_EXTRA_LOG_GROUP_DMG | \
+    CREATURE_FLAG_EXTRA_FLOW_FIELD_PATHING)
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push, N), also any gcc version not support it at some platform
 #if defined(__GNUC__)
@@ -513,6 +516,8 @@ typedef std::map<uint32, time_t> CreatureSpellCooldowns;
 
 class Creature : public Unit, public GridObject<Creature>, public MapObject
 {
+    POOLED_OBJECT_DECLARE()
+
     public:
 
         explicit Creature(bool isWorldObject = true);
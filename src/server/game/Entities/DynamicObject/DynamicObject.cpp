@@ -17,6 +17,8 @@
 #include "GridNotifiersImpl.h"
 #include "ScriptMgr.h"
 
+POOLED_OBJECT_DEFINE(DynamicObject, sizeof(DynamicObject), 64)
+
 DynamicObject::DynamicObject(bool isWorldObject) : WorldObject(isWorldObject),
     _aura(NULL), _removedAura(NULL), _caster(NULL), _duration(0), _isViewpoint(false)
 {
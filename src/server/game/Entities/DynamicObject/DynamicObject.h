@@ -11,6 +11,7 @@
 
 #include "Object.h"
 #include "../SharedPtrs/SharedPtrs.h"
+#include "PoolAllocator.h"
 
 
 class Unit;
@@ -27,6 +28,8 @@ enum DynamicObjectType
 
 class DynamicObject : public WorldObject, public GridObject<DynamicObject>
 {
+    POOLED_OBJECT_DECLARE()
+
     public:
         DynamicObject(bool isWorldObject);
         ~DynamicObject();
@@ -27,6 +27,9 @@
 #include "UpdateFieldFlags.h"
 #include "Transport.h"
 
+/// Transports are rare and long lived, they stay on the global allocator
+POOLED_OBJECT_DEFINE(GameObject, sizeof(GameObject), 64)
+
 GameObject::GameObject() : WorldObject(false), MapObject(),
 m_model(NULL), m_goValue(new GameObjectValue), m_AI(NULL)
 {
@@ -16,6 +16,7 @@
 #include "LootMgr.h"
 #include "DatabaseEnv.h"
 #include "DB2Stores.h"
+#include "PoolAllocator.h"
 
 class GameObjectAI;
 class Transport;
@@ -931,6 +932,8 @@ enum eGoBCustomFlags
 
 class GameObject : public WorldObject, public GridObject<GameObject>, public MapObject
 {
+    POOLED_OBJECT_DECLARE()
+
     public:
         explicit GameObject();
         ~GameObject();
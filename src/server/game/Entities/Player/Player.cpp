@@ -71,6 +71,7 @@
 #include "MSCallback.hpp"
 #include "Vignette.hpp"
 #include "WowTime.hpp"
+#include "TickProfiler.h"
 
 #ifndef CROSS
 # include "CharacterDatabaseCleaner.h"
@@ -1525,6 +1526,8 @@ void Player::SetDrunkValue(uint8 newDrunkValue, uint32 itemId /*= 0*/)
 
 void Player::Update(uint32 p_time)
 {
+    TICK_PROFILE_ZONE("Player::Update");
+
     if (!IsInWorld())
         return;
 
@@ -28207,6 +28210,9 @@ void Player::SendInitialPacketsAfterAddToMap()
 
     if (IsInGarrison())
         m_Garrison->OnPlayerEnter();
+
+    if (m_Garrison)
+        m_Garrison->OnOwnerAddedToMap();
 #endif
 
     std::map<uint32, bool> l_MountSpells;
@@ -339,20 +339,16 @@ void Transport::LoadStaticPassengers()
 {
     if (uint32 mapId = GetGOInfo()->moTransport.mapID)
     {
-        CellObjectGuidsMap const& cells = sObjectMgr->GetMapObjectGuids(mapId, GetMap()->GetSpawnMode());
-        CellGuidSet::const_iterator guidEnd;
-        for (CellObjectGuidsMap::const_iterator cellItr = cells.begin(); cellItr != cells.end(); ++cellItr)
-        {
-            // Creatures on transport
-            guidEnd = cellItr->second.creatures.end();
-            for (CellGuidSet::const_iterator guidItr = cellItr->second.creatures.begin(); guidItr != guidEnd; ++guidItr)
-                CreateNPCPassenger(*guidItr, sObjectMgr->GetCreatureData(*guidItr));
-
-            // GameObjects on transport
-            guidEnd = cellItr->second.gameobjects.end();
-            for (CellGuidSet::const_iterator guidItr = cellItr->second.gameobjects.begin(); guidItr != guidEnd; ++guidItr)
-                CreateGOPassenger(*guidItr, sObjectMgr->GetGOData(*guidItr));
-        }
+        CellGuidSet creatures, gameobjects;
+        sObjectMgr->GetMapSpawnGuids(mapId, GetMap()->GetSpawnMode(), creatures, gameobjects);
+
+        // Creatures on transport
+        for (CellGuidSet::const_iterator guidItr = creatures.begin(); guidItr != creatures.end(); ++guidItr)
+            CreateNPCPassenger(*guidItr, sObjectMgr->GetCreatureData(*guidItr));
+
+        // GameObjects on transport
+        for (CellGuidSet::const_iterator guidItr = gameobjects.begin(); guidItr != gameobjects.end(); ++guidItr)
+            CreateGOPassenger(*guidItr, sObjectMgr->GetGOData(*guidItr));
     }
 }
 
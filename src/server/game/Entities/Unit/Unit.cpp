@@ -55,6 +55,7 @@
 #include "BattlegroundWS.h"
 #include "BattlegroundTP.h"
 #include "BattlegroundDG.h"
+#include "TickProfiler.h"
 #ifndef CROSS
 #include "Guild.h"
 #endif /* not CROSS */
@@ -376,6 +377,8 @@ Unit::~Unit()
 
 void Unit::Update(uint32 p_time)
 {
+    TICK_PROFILE_ZONE("Unit::Update");
+
     // WARNING! Order of execution here is important, do not change.
     // Spells must be processed with event system BEFORE they go to _UpdateSpells.
     // Or else we may have some SPELL_STATE_FINISHED spells stalled in pointers, that is bad.
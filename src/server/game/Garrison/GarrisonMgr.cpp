@@ -33,7 +33,8 @@ namespace MS { namespace Garrison
 
         m_CacheGameObjectGUID = 0;
 
-        m_CacheLastTokenAmount = 0;
+        memset(m_TimerEvents, 0, sizeof(m_TimerEvents));
+        m_NextTimerEvent = std::numeric_limits<uint32>::max();
 
         m_GarrisonScript = nullptr;
         m_CanRecruitFollower = p_Owner->HasCharacterWorldState(CharacterWorldStates::GarrisonTavernBoolCanRecruitFollower) ? p_Owner->GetCharacterWorldStateValue(CharacterWorldStates::GarrisonTavernBoolCanRecruitFollower) : 1;
@@ -691,18 +692,63 @@ namespace MS { namespace Garrison
     /// Update the garrison
     void Manager::Update()
     {
-        /// Update buildings
-        UpdateBuildings();
-        /// Update followers
-        UpdateFollowers();
-        /// Update cache
-        UpdateCache();
-        /// Update mission distribution
-        UpdateMissionDistribution();
-        /// Update garrison ability
-        UpdateGarrisonAbility();
-        /// Update work order
-        UpdateWorkOrders();
+        uint32 l_Now = time(nullptr);
+
+        if (l_Now < m_NextTimerEvent)
+            return;
+
+        m_NextTimerEvent = std::numeric_limits<uint32>::max();
+
+        /// Each update reschedules its event when it has a next state change to wait for
+        for (uint8 l_I = 0; l_I < TimerEvent::Max; ++l_I)
+        {
+            if (!m_TimerEvents[l_I])
+                continue;
+
+            if (m_TimerEvents[l_I] > l_Now)
+            {
+                m_NextTimerEvent = std::min(m_NextTimerEvent, m_TimerEvents[l_I]);
+                continue;
+            }
+
+            m_TimerEvents[l_I] = 0;
+
+            switch (l_I)
+            {
+                case TimerEvent::BuildingComplete:
+                    UpdateBuildings();
+                    break;
+                case TimerEvent::FollowerActivation:
+                    UpdateFollowers();
+                    break;
+                case TimerEvent::Cache:
+                    UpdateCache();
+                    break;
+                case TimerEvent::MissionDistribution:
+                    UpdateMissionDistribution();
+                    ScheduleEvent(TimerEvent::MissionDistribution, std::max(m_MissionDistributionLastUpdate + Globals::MissionDistributionInterval + 1, l_Now + 1));
+                    break;
+                case TimerEvent::Ability:
+                    UpdateGarrisonAbility();
+                    ScheduleEvent(TimerEvent::Ability, l_Now + Globals::AbilityCheckInterval);
+                    break;
+                case TimerEvent::WorkOrders:
+                    UpdateWorkOrders();
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    /// Schedule a garrison event at p_Time, the earliest time is kept if it's already scheduled
+    void Manager::ScheduleEvent(TimerEvent::Type p_Event, uint32 p_Time)
+    {
+        if (m_TimerEvents[p_Event] && m_TimerEvents[p_Event] <= p_Time)
+            return;
+
+        m_TimerEvents[p_Event] = p_Time;
+        m_NextTimerEvent = std::min(m_NextTimerEvent, p_Time);
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -723,7 +769,7 @@ namespace MS { namespace Garrison
     /// Get garrison cache token count
     uint32 Manager::GetGarrisonCacheTokenCount() const
     {
-        return m_CacheLastTokenAmount;
+        return std::min((uint32)((time(nullptr) - m_CacheLastUsage) / Globals::CacheTokenGenerateTime), (uint32)Globals::CacheMaxToken);
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -826,11 +872,15 @@ namespace MS { namespace Garrison
     /// Reward garrison cache content
     void Manager::RewardGarrisonCache()
     {
-        m_Owner->SendDisplayToast(Globals::CurrencyID, m_CacheLastTokenAmount, DISPLAY_TOAST_METHOD_GARRISON_CACHE, TOAST_TYPE_NEW_CURRENCY, false, false);
-        m_Owner->ModifyCurrency(Globals::CurrencyID, m_CacheLastTokenAmount, false);
+        uint32 l_TokenCount = GetGarrisonCacheTokenCount();
 
-        m_CacheLastTokenAmount  = 0;
-        m_CacheLastUsage        = time(0);
+        m_Owner->SendDisplayToast(Globals::CurrencyID, l_TokenCount, DISPLAY_TOAST_METHOD_GARRISON_CACHE, TOAST_TYPE_NEW_CURRENCY, false, false);
+        m_Owner->ModifyCurrency(Globals::CurrencyID, l_TokenCount, false);
+
+        m_CacheLastUsage = time(0);
+
+        /// Despawn the emptied cache
+        ScheduleEvent(TimerEvent::Cache, m_CacheLastUsage);
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -854,6 +904,9 @@ namespace MS { namespace Garrison
             if (GameObject* l_Gob = HashMapHolder<GameObject>::Find(l_It->second))
                 l_Gob->SendGameObjectActivateAnimKit(1696);
         }
+
+        ScheduleEvent(TimerEvent::Cache, time(nullptr));
+        ScheduleEvent(TimerEvent::Ability, time(nullptr));
     }
 
     /// When the garrison owner leave the garrisson (@See Player::UpdateArea)
@@ -878,6 +931,15 @@ namespace MS { namespace Garrison
 
         /// Disable AI Client collision manager
         m_Owner->RemoveFlag(UNIT_FIELD_NPC_FLAGS + 1, UNIT_NPC_FLAG2_AI_OBSTACLE);
+
+        ScheduleEvent(TimerEvent::Ability, time(nullptr));
+    }
+
+    /// When the garrison owner is added to a map (@See Player::SendInitialPacketsAfterAddToMap)
+    void Manager::OnOwnerAddedToMap()
+    {
+        /// The garrison ability is only available in Draenor
+        ScheduleEvent(TimerEvent::Ability, time(nullptr));
     }
 
     /// When the garrison owner started a quest
@@ -906,6 +968,10 @@ namespace MS { namespace Garrison
             /// Update phasing
             m_Owner->SetPhaseMask(l_GarrisonScript->GetPhaseMask(m_Owner), true);
         }
+
+        /// Both the cache and the garrison ability are unlocked by quests
+        ScheduleEvent(TimerEvent::Cache, time(nullptr));
+        ScheduleEvent(TimerEvent::Ability, time(nullptr));
     }
 
     /// When the garrison owner abandon a quest
@@ -2658,6 +2724,8 @@ namespace MS { namespace Garrison
                 m_NumFollowerActivation--;
                 m_NumFollowerActivationRegenTimestamp = time(0);
 
+                ScheduleEvent(TimerEvent::FollowerActivation, m_NumFollowerActivationRegenTimestamp + DAY + 1);
+
                 l_It->Flags = l_It->Flags & ~GARRISON_FOLLOWER_FLAG_INACTIVE;
                 l_Follower = &(*l_It);
 
@@ -3023,6 +3091,8 @@ namespace MS { namespace Garrison
 
         m_Buildings.push_back(l_Building);
 
+        ScheduleEvent(TimerEvent::BuildingComplete, l_Building.TimeBuiltEnd + 1);
+
         UpdatePlot(p_PlotInstanceID);
 
         if (l_GarrisonScript)
@@ -3417,6 +3487,8 @@ namespace MS { namespace Garrison
 
         m_WorkOrders.push_back(l_WorkOrder);
 
+        ScheduleEvent(TimerEvent::WorkOrders, time(nullptr));
+
         return l_WorkOrder.DatabaseID;
     }
 
@@ -3435,6 +3507,8 @@ namespace MS { namespace Garrison
                 break;
             }
         }
+
+        ScheduleEvent(TimerEvent::WorkOrders, time(nullptr));
     }
 
     uint8 Manager::CalculateAssignedFollowerShipmentBonus(uint32 p_PlotInstanceID)
@@ -3722,6 +3796,12 @@ namespace MS { namespace Garrison
         return m_WorkOrders;
     }
 
+    /// Reschedule the work order update
+    void Manager::ScheduleWorkOrdersUpdate()
+    {
+        ScheduleEvent(TimerEvent::WorkOrders, time(nullptr));
+    }
+
     /// Check if any followers has ability in parameter
     bool Manager::HasFollowerAbility(uint32 p_AbilityID) const
     {
@@ -3748,6 +3828,9 @@ namespace MS { namespace Garrison
         InitDataForLevel();
         InitPlots();
         UpdateStats();
+
+        for (uint8 l_I = 0; l_I < TimerEvent::Max; ++l_I)
+            ScheduleEvent(TimerEvent::Type(l_I), time(nullptr));
     }
 
     /// Init data for level
@@ -3921,6 +4004,9 @@ namespace MS { namespace Garrison
         if (!m_Owner->IsInGarrison())
             return;
 
+        /// The work order gameobject can be respawned
+        ScheduleEvent(TimerEvent::WorkOrders, time(nullptr));
+
         GarrisonPlotInstanceInfoLocation    l_PlotInfo = GetPlot(p_PlotInstanceID);
         GarrisonBuilding                    l_Building = GetBuilding(p_PlotInstanceID);
     
@@ -4295,18 +4381,25 @@ namespace MS { namespace Garrison
     /// Update building
     void Manager::UpdateBuildings()
     {
+        uint32 l_Now = time(nullptr);
+
         /// Update building in construction
         for (uint32 l_I = 0; l_I < m_Buildings.size(); ++l_I)
         {
             GarrisonBuilding* l_Building = &m_Buildings[l_I];
 
-            if (!l_Building->Active && !l_Building->BuiltNotified && time(0) > l_Building->TimeBuiltEnd)
+            if (l_Building->Active || l_Building->BuiltNotified)
+                continue;
+
+            if (l_Now > l_Building->TimeBuiltEnd)
             {
                 l_Building->BuiltNotified = true;
 
                 /// Nothing more needed, client auto deduce notification
                 UpdatePlot(l_Building->PlotInstanceID);
             }
+            else
+                ScheduleEvent(TimerEvent::BuildingComplete, l_Building->TimeBuiltEnd + 1);
         }
     }
 
@@ -4324,6 +4417,9 @@ namespace MS { namespace Garrison
 
             m_Owner->SendDirectMessage(&l_Data);
         }
+
+        if (m_NumFollowerActivation < Globals::FollowerActivationMaxStack)
+            ScheduleEvent(TimerEvent::FollowerActivation, m_NumFollowerActivationRegenTimestamp + DAY + 1);
     }
 
     /// Update cache
@@ -4356,11 +4452,14 @@ namespace MS { namespace Garrison
             return;
         }
 
-        uint32 l_NumRessourceGenerated = std::min((uint32)((time(0) - m_CacheLastUsage) / Globals::CacheTokenGenerateTime), (uint32)Globals::CacheMaxToken);
+        uint32 l_NumRessourceGenerated = GetGarrisonCacheTokenCount();
+
+        /// Refresh the token count world state on the next generated token
+        if (l_NumRessourceGenerated < Globals::CacheMaxToken)
+            ScheduleEvent(TimerEvent::Cache, m_CacheLastUsage + (l_NumRessourceGenerated + 1) * Globals::CacheTokenGenerateTime);
 
         if (!m_CacheGameObjectGUID)
         {
-            m_CacheLastTokenAmount = l_NumRessourceGenerated;
             m_Owner->SendUpdateWorldState(WorldStates::CacheNumToken, l_NumRessourceGenerated);
 
             if (l_NumRessourceGenerated >= Globals::CacheMinToken)
@@ -4906,6 +5005,15 @@ namespace MS { namespace Garrison
                 l_WorkOrderGameObject->RemoveFlag(GAMEOBJECT_FIELD_FLAGS, GO_FLAG_ACTIVATED);
             }
         }
+
+        /// Next work order to complete
+        uint32 l_Now = time(nullptr);
+
+        for (GarrisonWorkOrder const& l_WorkOrder : m_WorkOrders)
+        {
+            if (l_WorkOrder.CompleteTime > l_Now)
+                ScheduleEvent(TimerEvent::WorkOrders, l_WorkOrder.CompleteTime);
+        }
     }
 
     bool Manager::RenameFollower(uint32 p_DatabaseID, std::string p_FollowerName)
@@ -50,7 +50,7 @@ namespace MS { namespace Garrison
             /// Delete garrison
             static void DeleteFromDB(uint64 p_PlayerGUID, SQLTransaction p_Transation);
 
-            /// Update the garrison
+            /// Run the garrison events which are due, idle garrisons return immediately
             void Update();
 
             /// Set garrison level
@@ -76,6 +76,8 @@ namespace MS { namespace Garrison
             void OnPlayerEnter();
             /// When the garrison owner leave the garrisson (@See Player::UpdateArea)
             void OnPlayerLeave();
+            /// When the garrison owner is added to a map (@See Player::SendInitialPacketsAfterAddToMap)
+            void OnOwnerAddedToMap();
             /// When the garrison owner started a quest
             void OnQuestStarted(const Quest* p_Quest);
             /// When the garrison owner reward a quest
@@ -299,6 +301,8 @@ namespace MS { namespace Garrison
 
             /// Get work orders
             std::vector<GarrisonWorkOrder>& GetWorkOrders();
+            /// Reschedule the work order update, to call after changing completion times through GetWorkOrders
+            void ScheduleWorkOrdersUpdate();
 
             /// Update mission distribution
             void UpdateMissionDistribution(bool p_Force = false, uint32 p_ForcedCount = 0);
@@ -407,6 +411,9 @@ namespace MS { namespace Garrison
             /// Update garrison stats
             void UpdateStats();
 
+            /// Schedule a garrison event at p_Time, the earliest time is kept if it's already scheduled
+            void ScheduleEvent(TimerEvent::Type p_Event, uint32 p_Time);
+
             /// Update buildings
             void UpdateBuildings();
             /// Update followers
@@ -430,9 +437,11 @@ namespace MS { namespace Garrison
             uint32      m_MissionDistributionLastUpdate;
             uint64      m_LastUsedActivationGameObject;
             uint64      m_CacheGameObjectGUID;
-            uint32      m_CacheLastTokenAmount;
             bool        m_CanRecruitFollower;
 
+            uint32      m_TimerEvents[TimerEvent::Max];     ///< Next run time of each event, 0 if not scheduled
+            uint32      m_NextTimerEvent;                   ///< Earliest of m_TimerEvents
+
             std::vector<GarrisonPlotInstanceInfoLocation>   m_Plots;
             std::vector<GarrisonMission>                    m_Missions;
             std::vector<GarrisonFollower>                   m_Followers;
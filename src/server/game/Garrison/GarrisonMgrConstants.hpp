@@ -40,7 +40,23 @@ namespace MS { namespace Garrison
             ShipyardBuildingType            = 9,
             ShipyardBuildingID              = 205,
             ShipyardPlotID                  = 98,
-            MaxActiveFollowerAllowedCount   = 20
+            MaxActiveFollowerAllowedCount   = 20,
+            AbilityCheckInterval            = MINUTE
+        };
+    }
+
+    /// Garrison state changes run by Manager::Update at their scheduled time
+    namespace TimerEvent
+    {
+        enum Type : uint8
+        {
+            BuildingComplete    = 0,
+            FollowerActivation  = 1,
+            Cache               = 2,
+            MissionDistribution = 3,
+            Ability             = 4,
+            WorkOrders          = 5,
+            Max                 = 6
         };
     }
 
@@ -38,6 +38,7 @@
 #include "DB2Stores.h"
 #include "Configuration/Config.h"
 #include "VMapFactory.h"
+#include "WorldSnapshot.h"
 #ifndef CROSS
 #include "GarrisonMgr.hpp"
 #endif /* not CROSS */
@@ -1585,6 +1586,66 @@ void ObjectMgr::LoadTempSummons()
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u temp summons in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
+namespace
+{
+    /// Spawn snapshot payload: spawn count, (guid, raw record) per spawn, then the guids added to the grids
+    template<class T> void WriteSpawnSnapshot(ByteBuffer& p_Data, SpawnDataStore<T> const& p_Store, std::vector<uint32> const& p_GridGuids)
+    {
+        p_Data << uint32(p_Store.GetCount());
+        p_Store.ForEach([&p_Data](uint32 p_Guid, T const& p_Record)
+        {
+            p_Data << uint32(p_Guid);
+            p_Data.append(reinterpret_cast<uint8 const*>(&p_Record), sizeof(T));
+        });
+
+        p_Data << uint32(p_GridGuids.size());
+        for (uint32 l_Guid : p_GridGuids)
+            p_Data << uint32(l_Guid);
+    }
+
+    /// Maps the spawn loaders check against, with their type and supported difficulties
+    std::string GetSpawnSnapshotMapKey(std::map<uint32, uint32> const& p_SpawnMasks)
+    {
+        std::ostringstream l_Key;
+        for (uint32 l_I = 0; l_I < sMapStore.GetNumRows(); ++l_I)
+        {
+            MapEntry const* l_Map = sMapStore.LookupEntry(l_I);
+            if (!l_Map)
+                continue;
+
+            std::map<uint32, uint32>::const_iterator l_Itr = p_SpawnMasks.find(l_I);
+            l_Key << l_I << ':' << l_Map->instanceType << ':' << (l_Itr != p_SpawnMasks.end() ? l_Itr->second : 0) << ' ';
+        }
+
+        return l_Key.str();
+    }
+
+    /// Existing rows of a store the spawn loaders look entries up in
+    template<class T> std::string GetSpawnSnapshotStoreKey(DBCStorage<T> const& p_Store)
+    {
+        std::ostringstream l_Key;
+        for (uint32 l_I = 0; l_I < p_Store.GetNumRows(); ++l_I)
+            if (p_Store.LookupEntry(l_I))
+                l_Key << l_I << ' ';
+
+        return l_Key.str();
+    }
+
+    template<class T> void ReadSpawnSnapshot(ByteBuffer& p_Data, SpawnDataStore<T>& p_Store, std::vector<uint32>& p_GridGuids)
+    {
+        uint32 l_Count = p_Data.read<uint32>();
+        for (uint32 l_I = 0; l_I < l_Count; ++l_I)
+        {
+            uint32 l_Guid = p_Data.read<uint32>();
+            p_Data.read(reinterpret_cast<uint8*>(&p_Store.NewOrExist(l_Guid)), sizeof(T));
+        }
+
+        p_GridGuids.resize(p_Data.read<uint32>());
+        for (uint32& l_Guid : p_GridGuids)
+            l_Guid = p_Data.read<uint32>();
+    }
+}
+
 void ObjectMgr::LoadCreatures()
 {
     uint32 oldMSTime = getMSTime();
@@ -1618,6 +1679,31 @@ void ObjectMgr::LoadCreatures()
         l_Query += l_TempQueryEnding;
     }
 
+    // Build single time for check spawnmask
+    std::map<uint32, uint32> spawnMasks;
+    for (uint32 i = 0; i < sMapStore.GetNumRows(); ++i)
+        if (sMapStore.LookupEntry(i))
+            for (int k = 0; k < Difficulty::MaxDifficulties; ++k)
+                if (GetMapDifficultyData(i, Difficulty(k)))
+                    spawnMasks[i] |= (1 << k);
+
+    // records are stored as is, the key changes with their size
+    WorldSnapshot snapshot("creature", { "creature", "creature_template", "creature_equip_template", "game_event_creature", "pool_creature" },
+        l_Query + " " + std::to_string(sizeof(CreatureData)));
+    snapshot.AddKeyInput(GetSpawnSnapshotMapKey(spawnMasks));
+
+    std::vector<uint32> gridGuids;
+    if (snapshot.Load())
+    {
+        ReadSpawnSnapshot(snapshot.GetData(), _creatureDataStore, gridGuids);
+
+        for (uint32 guid : gridGuids)
+            AddCreatureToGrid(guid, GetCreatureData(guid));
+
+        sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u creatures from snapshot in %u ms (checksum %u ms)", _creatureDataStore.GetCount(), GetMSTimeDiffToNow(oldMSTime), snapshot.GetChecksumTime());
+        return;
+    }
+
     QueryResult result = WorldDatabase.Query(l_Query.c_str());
 
     if (!result)
@@ -1627,16 +1713,7 @@ void ObjectMgr::LoadCreatures()
         return;
     }
 
-    // Build single time for check spawnmask
-    std::map<uint32, uint32> spawnMasks;
-    for (uint32 i = 0; i < sMapStore.GetNumRows(); ++i)
-        if (sMapStore.LookupEntry(i))
-            for (int k = 0; k < Difficulty::MaxDifficulties; ++k)
-                if (GetMapDifficultyData(i, Difficulty(k)))
-                    spawnMasks[i] |= (1 << k);
-
     //_creatureDataStore.rehash(result->GetRowCount());
-    uint32 count = 0;
     do
     {
         Field* fields = result->Fetch();
@@ -1653,7 +1730,7 @@ void ObjectMgr::LoadCreatures()
             continue;
         }
 
-        CreatureData& data = _creatureDataStore[guid];
+        CreatureData& data = _creatureDataStore.NewOrExist(guid);
         data.id             = entry;
         data.mapid          = fields[index++].GetUInt16();
         data.zoneId         = fields[index++].GetUInt16();
@@ -1752,7 +1829,10 @@ void ObjectMgr::LoadCreatures()
 
         // Add to grid if not managed by the game event or pool system
         if (gameEvent == 0 && PoolId == 0)
+        {
             AddCreatureToGrid(guid, &data);
+            gridGuids.push_back(guid);
+        }
 
         if (!data.zoneId || !data.areaId)
         {
@@ -1765,11 +1845,64 @@ void ObjectMgr::LoadCreatures()
     }
     while (result->NextRow());
 
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u creatures in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
+    if (snapshot.IsEnabled())
+    {
+        WriteSpawnSnapshot(snapshot.GetData(), _creatureDataStore, gridGuids);
+        snapshot.Save();
+    }
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u creatures from database in %u ms (" UI64FMTD " KB of spawn data)", _creatureDataStore.GetCount(), GetMSTimeDiffToNow(oldMSTime), _creatureDataStore.GetMemoryUsage() / 1024);
+}
+
+void ObjectMgr::AddGuidToCell(CellGuidSet& cell, uint32 guid)
+{
+    // spawns are loaded in guid order, keep that case out of the binary search
+    if (cell.empty() || cell.back() < guid)
+    {
+        cell.push_back(guid);
+        return;
+    }
+
+    CellGuidSet::iterator itr = std::lower_bound(cell.begin(), cell.end(), guid);
+    if (*itr != guid)
+        cell.insert(itr, guid);
+}
+
+void ObjectMgr::RemoveGuidFromCell(CellGuidSet& cell, uint32 guid)
+{
+    CellGuidSet::iterator itr = std::lower_bound(cell.begin(), cell.end(), guid);
+    if (itr != cell.end() && *itr == guid)
+        cell.erase(itr);
+}
+
+CellGuidSet ObjectMgr::GetCellCreatureGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id)
+{
+    ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(_cellGuidsLock);
+    return _mapObjectGuidsStore[MAKE_PAIR32(mapid, spawnMode)][cell_id].creatures;
+}
+
+CellGuidSet ObjectMgr::GetCellGameObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id)
+{
+    ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(_cellGuidsLock);
+    return _mapObjectGuidsStore[MAKE_PAIR32(mapid, spawnMode)][cell_id].gameobjects;
+}
+
+void ObjectMgr::GetMapSpawnGuids(uint16 mapid, uint8 spawnMode, CellGuidSet& creatures, CellGuidSet& gameobjects)
+{
+    ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(_cellGuidsLock);
+
+    CellObjectGuidsMap const& cells = _mapObjectGuidsStore[MAKE_PAIR32(mapid, spawnMode)];
+    for (CellObjectGuidsMap::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
+    {
+        creatures.insert(creatures.end(), itr->second.creatures.begin(), itr->second.creatures.end());
+        gameobjects.insert(gameobjects.end(), itr->second.gameobjects.begin(), itr->second.gameobjects.end());
+    }
 }
 
 void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
 {
+    ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(_cellGuidsLock);
+
     uint32 mask = data->spawnMask;
     for (uint32 i = 0; mask != 0; i++, mask >>= 1)
     {
@@ -1777,13 +1910,15 @@ void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
         {
             CellCoord cellCoord = JadeCore::ComputeCellCoord(data->posX, data->posY);
             CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.creatures.insert(guid);
+            AddGuidToCell(cell_guids.creatures, guid);
         }
     }
 }
 
 void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
 {
+    ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(_cellGuidsLock);
+
     uint32 mask = data->spawnMask;
     for (uint32 i = 0; mask != 0; i++, mask >>= 1)
     {
@@ -1791,7 +1926,7 @@ void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
         {
             CellCoord cellCoord = JadeCore::ComputeCellCoord(data->posX, data->posY);
             CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.creatures.erase(guid);
+            RemoveGuidFromCell(cell_guids.creatures, guid);
         }
     }
 }
@@ -1975,14 +2110,6 @@ void ObjectMgr::LoadGameobjects()
         l_Query += l_TempQueryEnding;
     }
 
-    QueryResult result = WorldDatabase.Query(l_Query.c_str());
-
-    if (!result)
-    {
-        sLog->outError(LOG_FILTER_SERVER_LOADING, ">> Loaded 0 gameobjects. DB table `gameobject` is empty.");
-        return;
-    }
-
     // build single time for check spawnmask
     std::map<uint32, uint32> spawnMasks;
     for (uint32 i = 0; i < sMapStore.GetNumRows(); ++i)
@@ -1991,6 +2118,33 @@ void ObjectMgr::LoadGameobjects()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
+    // records are stored as is, the key changes with their size
+    // instance_template decides which dungeon spawns have valid coordinates (MapManager::IsValidMapCoord)
+    WorldSnapshot snapshot("gameobject", { "gameobject", "gameobject_template", "game_event_gameobject", "pool_gameobject", "instance_template" },
+        l_Query + " " + std::to_string(sizeof(GameObjectData)));
+    snapshot.AddKeyInput(GetSpawnSnapshotMapKey(spawnMasks));
+    snapshot.AddKeyInput(GetSpawnSnapshotStoreKey(sGameObjectDisplayInfoStore));
+
+    std::vector<uint32> gridGuids;
+    if (snapshot.Load())
+    {
+        ReadSpawnSnapshot(snapshot.GetData(), _gameObjectDataStore, gridGuids);
+
+        for (uint32 guid : gridGuids)
+            AddGameobjectToGrid(guid, GetGOData(guid));
+
+        sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u gameobjects from snapshot in %u ms (checksum %u ms)", _gameObjectDataStore.GetCount(), GetMSTimeDiffToNow(oldMSTime), snapshot.GetChecksumTime());
+        return;
+    }
+
+    QueryResult result = WorldDatabase.Query(l_Query.c_str());
+
+    if (!result)
+    {
+        sLog->outError(LOG_FILTER_SERVER_LOADING, ">> Loaded 0 gameobjects. DB table `gameobject` is empty.");
+        return;
+    }
+
     //_gameObjectDataStore.rehash(result->GetRowCount());
     do
     {
@@ -2025,7 +2179,7 @@ void ObjectMgr::LoadGameobjects()
             continue;
         }
 
-        GameObjectData& data = _gameObjectDataStore[guid];
+        GameObjectData& data = _gameObjectDataStore.NewOrExist(guid);
 
         data.id             = entry;
         data.mapid          = fields[2].GetUInt16();
@@ -2110,16 +2264,27 @@ void ObjectMgr::LoadGameobjects()
         }
 
         if (gameEvent == 0 && PoolId == 0)                      // if not this is to be managed by GameEvent System or Pool system
+        {
             AddGameobjectToGrid(guid, &data);
+            gridGuids.push_back(guid);
+        }
         ++count;
     }
     while (result->NextRow());
 
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %lu gameobjects in %u ms", (unsigned long)_gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
+    if (snapshot.IsEnabled())
+    {
+        WriteSpawnSnapshot(snapshot.GetData(), _gameObjectDataStore, gridGuids);
+        snapshot.Save();
+    }
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %lu gameobjects from database in %u ms (" UI64FMTD " KB of spawn data)", (unsigned long)_gameObjectDataStore.GetCount(), GetMSTimeDiffToNow(oldMSTime), _gameObjectDataStore.GetMemoryUsage() / 1024);
 }
 
 void ObjectMgr::AddGameobjectToGrid(uint32 guid, GameObjectData const* data)
 {
+    ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(_cellGuidsLock);
+
     uint32 mask = data->spawnMask;
     for (uint32 i = 0; mask != 0; i++, mask >>= 1)
     {
@@ -2127,13 +2292,15 @@ void ObjectMgr::AddGameobjectToGrid(uint32 guid, GameObjectData const* data)
         {
             CellCoord cellCoord = JadeCore::ComputeCellCoord(data->posX, data->posY);
             CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.gameobjects.insert(guid);
+            AddGuidToCell(cell_guids.gameobjects, guid);
         }
     }
 }
 
 void ObjectMgr::RemoveGameobjectFromGrid(uint32 guid, GameObjectData const* data)
 {
+    ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(_cellGuidsLock);
+
     uint32 mask = data->spawnMask;
     for (uint32 i = 0; mask != 0; i++, mask >>= 1)
     {
@@ -2141,7 +2308,7 @@ void ObjectMgr::RemoveGameobjectFromGrid(uint32 guid, GameObjectData const* data
         {
             CellCoord cellCoord = JadeCore::ComputeCellCoord(data->posX, data->posY);
             CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.gameobjects.erase(guid);
+            RemoveGuidFromCell(cell_guids.gameobjects, guid);
         }
     }
 }
@@ -5765,133 +5932,195 @@ void ObjectMgr::LoadNpcTextLocales()
 }
 
 #ifndef CROSS
-//not very fast function but it is called only once a day, or on starting-up
+/// Called once a day, or on starting-up
+/// The expired mails are read by pages of MailExpiry.BatchSize mails in ascending id. At startup the pages are read in a row,
+/// while the server is up each page is queried asynchronously and handled by the world thread once its result is there,
+/// so a run costs at most one page per world update whatever the size of the mail table
 void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 {
-    uint32 oldMSTime = getMSTime();
+    if (m_MailExpiry.Running)
+    {
+        sLog->outError(LOG_FILTER_GENERAL, "Expired mails of the previous run are still processed (%u pages done), skipping this run", m_MailExpiry.Batches);
+        return;
+    }
 
     time_t curTime = time(NULL);
     tm* lt = localtime(&curTime);
-    uint64 basetime(curTime);
     sLog->outInfo(LOG_FILTER_GENERAL, "Returning mails current time: hour: %d, minute: %d, second: %d ", lt->tm_hour, lt->tm_min, lt->tm_sec);
 
     // Delete all old mails without item and without body immediately, if starting server
     if (!serverUp)
     {
         PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EMPTY_EXPIRED_MAIL);
-        stmt->setUInt64(0, basetime);
+        stmt->setUInt64(0, uint64(curTime));
         CharacterDatabase.Execute(stmt);
     }
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL);
-    stmt->setUInt64(0, basetime);
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
-    if (!result)
+
+    m_MailExpiry           = MailExpiryProgress();
+    m_MailExpiry.Running   = true;
+    m_MailExpiry.BaseTime  = curTime;
+    m_MailExpiry.StartTime = getMSTime();
+
+    if (serverUp)
     {
-        sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> No expired mails found.");
-        return;                                             // any mails need to be returned or deleted
+        QueryExpiredMailPage(true);
+        return;
     }
 
-    std::map<uint32 /*messageId*/, MailItemInfoVec> itemsCache;
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_ITEMS);
-    stmt->setUInt32(0, (uint32)basetime);
-    if (PreparedQueryResult items = CharacterDatabase.Query(stmt))
+    while (m_MailExpiry.Running)
+        QueryExpiredMailPage(false);
+}
+
+void ObjectMgr::QueryExpiredMailPage(bool p_ServerUp)
+{
+    PreparedStatement* l_Statement = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_PAGE);
+    l_Statement->setUInt32(0, m_MailExpiry.LastMailID);
+    l_Statement->setUInt32(1, uint32(m_MailExpiry.BaseTime));
+    l_Statement->setUInt32(2, std::max(sWorld->getIntConfig(CONFIG_MAIL_EXPIRY_BATCH_SIZE), 1u));
+
+    if (!p_ServerUp)
+    {
+        ProcessExpiredMailPage(CharacterDatabase.Query(l_Statement), false);
+        return;
+    }
+
+    AsyncQuery(CharacterDatabase, l_Statement, [this](PreparedQueryResult const& p_Result) -> void
+    {
+        ProcessExpiredMailPage(p_Result, true);
+
+        if (m_MailExpiry.Running)
+            QueryExpiredMailPage(true);
+    });
+}
+
+/// Returns or deletes the mails of one page in a single transaction, a page that isn't full ends the run
+void ObjectMgr::ProcessExpiredMailPage(PreparedQueryResult p_Result, bool p_ServerUp)
+{
+    uint32 l_OldMSTime = getMSTime();
+
+    /// One row per item of the mail, or a single row without item
+    std::vector<Mail> l_Mails;
+    std::vector<bool> l_HasItems;
+
+    if (p_Result)
     {
-        MailItemInfo item;
         do
         {
-            Field* fields = items->Fetch();
-            item.item_guid = fields[0].GetUInt32();
-            item.item_template = fields[1].GetUInt32();
-            uint32 mailId = fields[2].GetUInt32();
-            itemsCache[mailId].push_back(item);
+            Field* fields = p_Result->Fetch();
+            uint32 l_MailID = fields[0].GetUInt32();
+
+            if (l_Mails.empty() || l_Mails.back().messageID != l_MailID)
+            {
+                l_Mails.push_back(Mail());
+
+                Mail& m = l_Mails.back();
+                m.messageID      = l_MailID;
+                m.messageType    = fields[1].GetUInt8();
+                m.sender         = fields[2].GetUInt32();
+                m.receiver       = fields[3].GetUInt32();
+                m.expire_time    = time_t(fields[5].GetUInt32());
+                m.deliver_time   = 0;
+                m.COD            = fields[6].GetUInt64();
+                m.checked        = fields[7].GetUInt8();
+                m.mailTemplateId = fields[8].GetInt16();
+
+                l_HasItems.push_back(fields[4].GetBool());
+            }
+
+            if (uint32 l_ItemGUID = fields[9].GetUInt32())
+                l_Mails.back().AddItem(l_ItemGUID, fields[10].GetUInt32());
         }
-        while (items->NextRow());
+        while (p_Result->NextRow());
     }
 
-    uint32 deletedCount = 0;
-    uint32 returnedCount = 0;
-    do
+    uint32 basetime = uint32(m_MailExpiry.BaseTime);
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    PreparedStatement* stmt = NULL;
+
+    for (size_t l_I = 0; l_I < l_Mails.size(); ++l_I)
     {
-        Field* fields = result->Fetch();
-        Mail* m = new Mail;
-        m->messageID      = fields[0].GetUInt32();
-        m->messageType    = fields[1].GetUInt8();
-        m->sender         = fields[2].GetUInt32();
-        m->receiver       = fields[3].GetUInt32();
-        bool has_items    = fields[4].GetBool();
-        m->expire_time    = time_t(fields[5].GetUInt32());
-        m->deliver_time   = 0;
-        m->COD            = fields[6].GetUInt64();
-        m->checked        = fields[7].GetUInt8();
-        m->mailTemplateId = fields[8].GetInt16();
-
-        Player* player = NULL;
-        if (serverUp)
-            player = ObjectAccessor::FindPlayer((uint64)m->receiver);
+        Mail& m = l_Mails[l_I];
 
-        if (player)
-        {                                                   // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
-            // his in mailbox and he has already listed his mails)
-            delete m;
+        // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
+        // his in mailbox and he has already listed his mails)
+        if (p_ServerUp && ObjectAccessor::FindPlayer((uint64)m.receiver))
+        {
+            ++m_MailExpiry.Skipped;
             continue;
         }
 
         // Delete or return mail
-        if (has_items)
+        if (l_HasItems[l_I])
         {
-            // read items from cache
-            m->items.swap(itemsCache[m->messageID]);
-
             // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+            if (m.messageType != MAIL_NORMAL || (m.checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
             {
                 // mail open and then not returned
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
+                for (MailItemInfoVec::iterator itr2 = m.items.begin(); itr2 != m.items.end(); ++itr2)
                 {
                     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
                     stmt->setUInt32(0, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    trans->Append(stmt);
                 }
             }
             else
             {
                 // Mail will be returned
                 stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
-                stmt->setUInt32(0, m->receiver);
-                stmt->setUInt32(1, m->sender);
+                stmt->setUInt32(0, m.receiver);
+                stmt->setUInt32(1, m.sender);
                 stmt->setUInt32(2, basetime + 30 * DAY);
                 stmt->setUInt32(3, basetime);
                 stmt->setUInt8 (4, uint8(MAIL_CHECK_MASK_RETURNED));
-                stmt->setUInt32(5, m->messageID);
-                CharacterDatabase.Execute(stmt);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
+                stmt->setUInt32(5, m.messageID);
+                trans->Append(stmt);
+                for (MailItemInfoVec::iterator itr2 = m.items.begin(); itr2 != m.items.end(); ++itr2)
                 {
                     // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
                     stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
-                    stmt->setUInt32(0, m->sender);
+                    stmt->setUInt32(0, m.sender);
                     stmt->setUInt32(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    trans->Append(stmt);
 
                     stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
-                    stmt->setUInt32(0, m->sender);
+                    stmt->setUInt32(0, m.sender);
                     stmt->setUInt32(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    trans->Append(stmt);
                 }
-                delete m;
-                ++returnedCount;
+                ++m_MailExpiry.Returned;
                 continue;
             }
         }
 
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
-        stmt->setUInt32(0, m->messageID);
-        CharacterDatabase.Execute(stmt);
-        delete m;
-        ++deletedCount;
+        stmt->setUInt32(0, m.messageID);
+        trans->Append(stmt);
+        ++m_MailExpiry.Deleted;
     }
-    while (result->NextRow());
 
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Processed %u expired mails: %u deleted and %u returned in %u ms", deletedCount + returnedCount, deletedCount, returnedCount, GetMSTimeDiffToNow(oldMSTime));
+    if (trans->GetSize())
+        CharacterDatabase.CommitTransaction(trans);
+
+    if (!l_Mails.empty())
+        m_MailExpiry.LastMailID = l_Mails.back().messageID;
+
+    uint32 l_BatchTime = GetMSTimeDiffToNow(l_OldMSTime);
+
+    ++m_MailExpiry.Batches;
+    m_MailExpiry.LastBatchTime   = l_BatchTime;
+    m_MailExpiry.MaxBatchTime    = std::max(m_MailExpiry.MaxBatchTime, l_BatchTime);
+    m_MailExpiry.TotalBatchTime += l_BatchTime;
+
+    sLog->outDebug(LOG_FILTER_GENERAL, "Expired mails page %u: %u mails up to id %u in %u ms", m_MailExpiry.Batches, uint32(l_Mails.size()), m_MailExpiry.LastMailID, l_BatchTime);
+
+    if (l_Mails.size() >= std::max(sWorld->getIntConfig(CONFIG_MAIL_EXPIRY_BATCH_SIZE), 1u))
+        return;
+
+    m_MailExpiry.Running = false;
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Processed %u expired mails: %u deleted and %u returned (%u skipped) in %u pages, %u ms max per page, %u ms total",
+        m_MailExpiry.Deleted + m_MailExpiry.Returned, m_MailExpiry.Deleted, m_MailExpiry.Returned, m_MailExpiry.Skipped, m_MailExpiry.Batches,
+        m_MailExpiry.MaxBatchTime, GetMSTimeDiffToNow(m_MailExpiry.StartTime));
 }
 
 #endif /* not CROSS */
@@ -8149,7 +8378,7 @@ void ObjectMgr::DeleteCreatureData(uint32 guid)
     if (data)
         RemoveCreatureFromGrid(guid, data);
 
-    _creatureDataStore.erase(guid);
+    _creatureDataStore.Erase(guid);
 }
 
 void ObjectMgr::DeleteGOData(uint32 guid)
@@ -8159,11 +8388,13 @@ void ObjectMgr::DeleteGOData(uint32 guid)
     if (data)
         RemoveGameobjectFromGrid(guid, data);
 
-    _gameObjectDataStore.erase(guid);
+    _gameObjectDataStore.Erase(guid);
 }
 
 void ObjectMgr::AddCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid, uint32 instance)
 {
+    ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(_cellGuidsLock);
+
     // corpses are always added to spawn mode 0 and they are spawned by their instance id
     CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(mapid, 0)][cellid];
     cell_guids.corpses[player_guid] = instance;
@@ -8171,6 +8402,8 @@ void ObjectMgr::AddCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_gui
 
 void ObjectMgr::DeleteCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid)
 {
+    ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(_cellGuidsLock);
+
     // corpses are always added to spawn mode 0 and they are spawned by their instance id
     CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(mapid, 0)][cellid];
     cell_guids.corpses.erase(player_guid);
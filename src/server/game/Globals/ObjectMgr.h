@@ -31,6 +31,7 @@
 #include "ConditionMgr.h"
 #include <functional>
 #include "PhaseMgr.h"
+#include "SpawnDataStore.h"
 #include <ace/Thread_Mutex.h>
 #include <unordered_set>
 
@@ -389,7 +390,9 @@ struct AreaTriggerStruct
     float  target_Orientation;
 };
 
-typedef std::set<uint32> CellGuidSet;
+/// Sorted guids, a cell holds a few dozen spawns
+/// Pools and events change the lists from the map threads: they are read through copies, see ObjectMgr::GetCellCreatureGuids
+typedef std::vector<uint32> CellGuidSet;
 typedef std::map<uint32/*player guid*/, uint32/*instance*/> CellCorpseSet;
 struct CellObjectGuids
 {
@@ -436,8 +439,8 @@ private:
 };
 
 typedef std::map<uint64, uint64> LinkedRespawnContainer;
-typedef ACE_Based::LockedMap<uint32, CreatureData> CreatureDataContainer;
-typedef ACE_Based::LockedMap<uint32, GameObjectData> GameObjectDataContainer;
+typedef SpawnDataStore<CreatureData> CreatureDataContainer;
+typedef SpawnDataStore<GameObjectData> GameObjectDataContainer;
 typedef ACE_Based::LockedMap<TempSummonGroupKey, std::vector<TempSummonData>> TempSummonDataContainer;
 typedef ACE_Based::LockedMap<uint32, CreatureLocale> CreatureLocaleContainer;
 typedef ACE_Based::LockedMap<uint32, GameObjectLocale> GameObjectLocaleContainer;
@@ -856,6 +859,24 @@ typedef std::map<uint32, std::vector<RecipesConditions>> NpcRecipesContainer;
 
 #ifndef CROSS
 class PlayerDumpReader;
+
+/// Progress of the return/deletion of the expired mails, see ObjectMgr::ReturnOrDeleteOldMails
+struct MailExpiryProgress
+{
+    MailExpiryProgress() : Running(false), BaseTime(0), LastMailID(0), StartTime(0), Batches(0), Deleted(0), Returned(0), Skipped(0), LastBatchTime(0), MaxBatchTime(0), TotalBatchTime(0) { }
+
+    bool Running;
+    time_t BaseTime;                                        ///< Mails expired before this time are processed
+    uint32 LastMailID;                                      ///< Mails are read by pages of ascending id
+    uint32 StartTime;
+    uint32 Batches;
+    uint32 Deleted;
+    uint32 Returned;
+    uint32 Skipped;                                         ///< Receiver online, left for the next run
+    uint32 LastBatchTime;                                   ///< World thread time spent on the pages, in ms
+    uint32 MaxBatchTime;
+    uint64 TotalBatchTime;
+};
 #endif /* not CROSS */
 
 class ObjectMgr
@@ -1366,6 +1387,7 @@ class ObjectMgr
 
 #ifndef CROSS
         void ReturnOrDeleteOldMails(bool serverUp);
+        MailExpiryProgress const& GetMailExpiryProgress() const { return m_MailExpiry; }
 
 #endif /* not CROSS */
         CreatureBaseStats const* GetCreatureBaseStats(uint8 level, uint8 unitClass);
@@ -1416,10 +1438,11 @@ class ObjectMgr
             return _mapObjectGuidsStore[MAKE_PAIR32(mapid, spawnMode)][cell_id];
         }
 
-        CellObjectGuidsMap const& GetMapObjectGuids(uint16 mapid, uint8 spawnMode)
-        {
-            return _mapObjectGuidsStore[MAKE_PAIR32(mapid, spawnMode)];
-        }
+        /// Copies of the spawn guids of a cell, taken under the lock guarding the lists
+        CellGuidSet GetCellCreatureGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id);
+        CellGuidSet GetCellGameObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id);
+        /// Copies of the spawn guids of every cell of a map
+        void GetMapSpawnGuids(uint16 mapid, uint8 spawnMode, CellGuidSet& creatures, CellGuidSet& gameobjects);
 
        /**
         * Gets temp summon data for all creatures of specified group.
@@ -1441,11 +1464,9 @@ class ObjectMgr
 
         CreatureData const* GetCreatureData(uint32 guid) const
         {
-            CreatureDataContainer::const_iterator itr = _creatureDataStore.find(guid);
-            if (itr == _creatureDataStore.end()) return NULL;
-            return &itr->second;
+            return _creatureDataStore.Find(guid);
         }
-        CreatureData& NewOrExistCreatureData(uint32 guid) { return _creatureDataStore[guid]; }
+        CreatureData& NewOrExistCreatureData(uint32 guid) { return _creatureDataStore.NewOrExist(guid); }
         void DeleteCreatureData(uint32 guid);
         uint64 GetLinkedRespawnGuid(uint64 guid) const
         {
@@ -1499,11 +1520,9 @@ class ObjectMgr
 
         GameObjectData const* GetGOData(uint32 guid) const
         {
-            GameObjectDataContainer::const_iterator itr = _gameObjectDataStore.find(guid);
-            if (itr == _gameObjectDataStore.end()) return NULL;
-            return &itr->second;
+            return _gameObjectDataStore.Find(guid);
         }
-        GameObjectData& NewGOData(uint32 guid) { return _gameObjectDataStore[guid]; }
+        GameObjectData& NewGOData(uint32 guid) { return _gameObjectDataStore.NewOrExist(guid); }
         void DeleteGOData(uint32 guid);
 
         TrinityStringLocale const* GetTrinityStringLocale(int32 entry) const
@@ -1809,6 +1828,11 @@ class ObjectMgr
         std::atomic<uint32> m_MailId;
         std::atomic<uint32> m_PetNumber;
         std::atomic<uint64> m_EquipmentSetGuid;
+
+        void QueryExpiredMailPage(bool p_ServerUp);
+        void ProcessExpiredMailPage(PreparedQueryResult p_Result, bool p_ServerUp);
+
+        MailExpiryProgress m_MailExpiry;
 #endif
 
         // first free id for selected id type
@@ -1926,6 +1950,8 @@ class ObjectMgr
         void CheckScripts(ScriptsType type, std::set<int32>& ids);
         void LoadQuestRelationsHelper(QuestRelations& map, std::string table, bool starter, bool go);
         void PlayerCreateInfoAddItemHelper(uint32 race_, uint32 class_, uint32 itemId, int32 count);
+        static void AddGuidToCell(CellGuidSet& cell, uint32 guid);
+        static void RemoveGuidFromCell(CellGuidSet& cell, uint32 guid);
 
         MailLevelRewardContainer _mailLevelRewardStore;
 
@@ -1953,6 +1979,7 @@ class ObjectMgr
         HalfNameContainer _petHalfName1;
 
         MapObjectGuids _mapObjectGuidsStore;
+        ACE_RW_Thread_Mutex _cellGuidsLock;                 ///< guid lists of the cells, changed by pools, events and corpses from the map threads
         CreatureDataContainer _creatureDataStore;
 
         CreatureTemplate** m_CreatureTemplateStore;
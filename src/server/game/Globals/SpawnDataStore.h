@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SPAWN_DATA_STORE_H
+#define _SPAWN_DATA_STORE_H
+
+#include "Define.h"
+
+#include <ace/RW_Thread_Mutex.h>
+#include <ace/Guard_T.h>
+
+#include <vector>
+
+/// Spawn ids per chunk, must be a multiple of 64
+#define SPAWN_DATA_CHUNK_SIZE 256
+
+/// Spawn data (creature, gameobject) indexed by database guid
+/// Guids of the spawn tables are dense, so the records are stored in fixed size chunks indexed by guid / SPAWN_DATA_CHUNK_SIZE
+/// instead of one tree node per spawn: a lookup is two array accesses and the records of neighbour guids are contiguous
+/// Chunks are never moved, the pointers returned stay valid until the spawn is erased
+template<class T>
+class SpawnDataStore
+{
+    public:
+        SpawnDataStore() : m_Count(0) { }
+        ~SpawnDataStore() { Clear(); }
+
+        T const* Find(uint32 p_SpawnId) const
+        {
+            ACE_Read_Guard<ACE_RW_Thread_Mutex> l_Guard(m_Lock);
+
+            Chunk const* l_Chunk = GetChunk(p_SpawnId);
+            if (!l_Chunk || !l_Chunk->IsPresent(p_SpawnId % SPAWN_DATA_CHUNK_SIZE))
+                return nullptr;
+
+            return &l_Chunk->Data[p_SpawnId % SPAWN_DATA_CHUNK_SIZE];
+        }
+
+        /// Same as std::map::operator[]
+        T& NewOrExist(uint32 p_SpawnId)
+        {
+            ACE_Write_Guard<ACE_RW_Thread_Mutex> l_Guard(m_Lock);
+
+            uint32 l_ChunkIndex = p_SpawnId / SPAWN_DATA_CHUNK_SIZE;
+            if (l_ChunkIndex >= m_Chunks.size())
+                m_Chunks.resize(l_ChunkIndex + 1, nullptr);
+
+            Chunk*& l_Chunk = m_Chunks[l_ChunkIndex];
+            if (!l_Chunk)
+                l_Chunk = new Chunk();
+
+            uint32 l_Slot = p_SpawnId % SPAWN_DATA_CHUNK_SIZE;
+            if (!l_Chunk->IsPresent(l_Slot))
+            {
+                l_Chunk->Present[l_Slot / 64] |= uint64(1) << (l_Slot % 64);
+                ++m_Count;
+            }
+
+            return l_Chunk->Data[l_Slot];
+        }
+
+        void Erase(uint32 p_SpawnId)
+        {
+            ACE_Write_Guard<ACE_RW_Thread_Mutex> l_Guard(m_Lock);
+
+            Chunk* l_Chunk = const_cast<Chunk*>(GetChunk(p_SpawnId));
+            uint32 l_Slot = p_SpawnId % SPAWN_DATA_CHUNK_SIZE;
+
+            if (!l_Chunk || !l_Chunk->IsPresent(l_Slot))
+                return;
+
+            l_Chunk->Present[l_Slot / 64] &= ~(uint64(1) << (l_Slot % 64));
+            l_Chunk->Data[l_Slot] = T();
+            --m_Count;
+        }
+
+        void Clear()
+        {
+            ACE_Write_Guard<ACE_RW_Thread_Mutex> l_Guard(m_Lock);
+
+            for (Chunk* l_Chunk : m_Chunks)
+                delete l_Chunk;
+
+            m_Chunks.clear();
+            m_Count = 0;
+        }
+
+        uint32 GetCount() const { return m_Count; }
+
+        /// Memory used by the chunks, for the load statistics
+        uint64 GetMemoryUsage() const
+        {
+            ACE_Read_Guard<ACE_RW_Thread_Mutex> l_Guard(m_Lock);
+
+            uint64 l_Size = m_Chunks.capacity() * sizeof(Chunk*);
+            for (Chunk const* l_Chunk : m_Chunks)
+            {
+                if (l_Chunk)
+                    l_Size += sizeof(Chunk);
+            }
+
+            return l_Size;
+        }
+
+        /// Calls p_Function(uint32 spawnId, T const& data) for each spawn, in guid order
+        template<class Function> void ForEach(Function p_Function) const
+        {
+            ACE_Read_Guard<ACE_RW_Thread_Mutex> l_Guard(m_Lock);
+
+            for (uint32 l_ChunkIndex = 0; l_ChunkIndex < m_Chunks.size(); ++l_ChunkIndex)
+            {
+                Chunk const* l_Chunk = m_Chunks[l_ChunkIndex];
+                if (!l_Chunk)
+                    continue;
+
+                for (uint32 l_Slot = 0; l_Slot < SPAWN_DATA_CHUNK_SIZE; ++l_Slot)
+                {
+                    if (l_Chunk->IsPresent(l_Slot))
+                        p_Function(l_ChunkIndex * SPAWN_DATA_CHUNK_SIZE + l_Slot, l_Chunk->Data[l_Slot]);
+                }
+            }
+        }
+
+    private:
+        struct Chunk
+        {
+            Chunk()
+            {
+                for (uint32 l_I = 0; l_I < SPAWN_DATA_CHUNK_SIZE / 64; ++l_I)
+                    Present[l_I] = 0;
+            }
+
+            bool IsPresent(uint32 p_Slot) const { return (Present[p_Slot / 64] & (uint64(1) << (p_Slot % 64))) != 0; }
+
+            T Data[SPAWN_DATA_CHUNK_SIZE];
+            uint64 Present[SPAWN_DATA_CHUNK_SIZE / 64];
+        };
+
+        Chunk const* GetChunk(uint32 p_SpawnId) const
+        {
+            uint32 l_ChunkIndex = p_SpawnId / SPAWN_DATA_CHUNK_SIZE;
+            return l_ChunkIndex < m_Chunks.size() ? m_Chunks[l_ChunkIndex] : nullptr;
+        }
+
+        std::vector<Chunk*> m_Chunks;
+        uint32 m_Count;
+        mutable ACE_RW_Thread_Mutex m_Lock;       ///< Spawns are added by GM commands and events at run time
+};
+
+#endif
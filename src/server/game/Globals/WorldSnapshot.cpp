@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "WorldSnapshot.h"
+#include "DatabaseEnv.h"
+#include "World.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <ace/OS_NS_sys_stat.h>
+
+namespace
+{
+    uint32 const g_SnapshotMagic = 0x504E5357;     ///< "WSNP"
+
+    struct WorldSnapshotHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint64 Checksum;
+        uint64 PayloadSize;
+        uint64 PayloadHash;
+    };
+
+    /// FNV-1a, only used to detect changes and corruption
+    uint64 HashBytes(uint8 const* p_Data, size_t p_Size, uint64 p_Hash = 14695981039346656037ULL)
+    {
+        for (size_t l_I = 0; l_I < p_Size; ++l_I)
+        {
+            p_Hash ^= p_Data[l_I];
+            p_Hash *= 1099511628211ULL;
+        }
+
+        return p_Hash;
+    }
+
+    uint64 HashString(std::string const& p_String, uint64 p_Hash)
+    {
+        return HashBytes(reinterpret_cast<uint8 const*>(p_String.c_str()), p_String.size() + 1, p_Hash);
+    }
+
+    uint64 HashBuffer(ByteBuffer const& p_Buffer)
+    {
+        return p_Buffer.size() ? HashBytes(p_Buffer.contents(), p_Buffer.size()) : HashBytes(nullptr, 0);
+    }
+}
+
+WorldSnapshot::WorldSnapshot(std::string const& p_Name, std::vector<std::string> const& p_Tables, std::string const& p_Key)
+    : m_Name(p_Name), m_Tables(p_Tables), m_Key(p_Key), m_Enabled(sWorld->getBoolConfig(CONFIG_WORLD_SNAPSHOT_ENABLE)), m_Checksum(0), m_ChecksumTime(0)
+{
+}
+
+std::string WorldSnapshot::GetFileName() const
+{
+    return sWorld->GetDataPath() + "snapshots/" + m_Name + ".snapshot";
+}
+
+uint64 WorldSnapshot::ComputeKey()
+{
+    uint32 l_OldMSTime = getMSTime();
+
+    uint64 l_Hash = HashString(m_Key, HashBytes(nullptr, 0));
+    uint32 l_Version = WORLD_SNAPSHOT_VERSION;
+    l_Hash = HashBytes(reinterpret_cast<uint8 const*>(&l_Version), sizeof(l_Version), l_Hash);
+
+    std::string l_Query = "CHECKSUM TABLE ";
+    for (size_t l_I = 0; l_I < m_Tables.size(); ++l_I)
+    {
+        if (l_I)
+            l_Query += ", ";
+
+        l_Query += "`" + m_Tables[l_I] + "`";
+    }
+
+    QueryResult l_Result = WorldDatabase.Query(l_Query.c_str());
+    if (!l_Result)
+        return 0;
+
+    do
+    {
+        Field* l_Fields = l_Result->Fetch();
+
+        /// NULL for a missing table, never worth a snapshot
+        std::string l_TableChecksum = l_Fields[1].GetString();
+        if (l_TableChecksum.empty())
+            return 0;
+
+        l_Hash = HashString(l_Fields[0].GetString(), l_Hash);
+        l_Hash = HashString(l_TableChecksum, l_Hash);
+    }
+    while (l_Result->NextRow());
+
+    m_ChecksumTime = GetMSTimeDiffToNow(l_OldMSTime);
+
+    /// 0 means no key
+    return l_Hash ? l_Hash : 1;
+}
+
+bool WorldSnapshot::Load()
+{
+    if (!m_Enabled)
+        return false;
+
+    m_Checksum = ComputeKey();
+    if (!m_Checksum)
+        return false;
+
+    FILE* l_File = fopen(GetFileName().c_str(), "rb");
+    if (!l_File)
+        return false;
+
+    WorldSnapshotHeader l_Header;
+    bool l_Valid = fread(&l_Header, sizeof(l_Header), 1, l_File) == 1
+        && l_Header.Magic == g_SnapshotMagic
+        && l_Header.Version == WORLD_SNAPSHOT_VERSION
+        && l_Header.Checksum == m_Checksum;
+
+    if (l_Valid)
+    {
+        m_Data.clear();
+        m_Data.resize(size_t(l_Header.PayloadSize));
+
+        if (l_Header.PayloadSize)
+            l_Valid = fread(const_cast<uint8*>(m_Data.contents()), size_t(l_Header.PayloadSize), 1, l_File) == 1;
+
+        l_Valid = l_Valid && HashBuffer(m_Data) == l_Header.PayloadHash;
+    }
+
+    fclose(l_File);
+
+    if (!l_Valid)
+    {
+        sLog->outInfo(LOG_FILTER_SERVER_LOADING, "World snapshot %s is outdated, loading from the database", m_Name.c_str());
+        m_Data.clear();
+        return false;
+    }
+
+    m_Data.rpos(0);
+    return true;
+}
+
+void WorldSnapshot::Save()
+{
+    if (!m_Enabled || !m_Checksum)
+        return;
+
+    std::string l_Directory = sWorld->GetDataPath() + "snapshots";
+    ACE_OS::mkdir(l_Directory.c_str());
+
+    /// Written aside then renamed, a crash while writing must not leave a truncated snapshot with a valid header
+    std::string l_FileName = GetFileName();
+    std::string l_TempFileName = l_FileName + ".tmp";
+
+    FILE* l_File = fopen(l_TempFileName.c_str(), "wb");
+    if (!l_File)
+    {
+        sLog->outError(LOG_FILTER_SERVER_LOADING, "World snapshot %s can't be written to %s", m_Name.c_str(), l_TempFileName.c_str());
+        return;
+    }
+
+    WorldSnapshotHeader l_Header;
+    l_Header.Magic       = g_SnapshotMagic;
+    l_Header.Version     = WORLD_SNAPSHOT_VERSION;
+    l_Header.Checksum    = m_Checksum;
+    l_Header.PayloadSize = m_Data.size();
+    l_Header.PayloadHash = HashBuffer(m_Data);
+
+    bool l_Written = fwrite(&l_Header, sizeof(l_Header), 1, l_File) == 1;
+    if (l_Written && m_Data.size())
+        l_Written = fwrite(m_Data.contents(), m_Data.size(), 1, l_File) == 1;
+
+    fclose(l_File);
+
+    remove(l_FileName.c_str());
+    if (!l_Written || rename(l_TempFileName.c_str(), l_FileName.c_str()) != 0)
+    {
+        sLog->outError(LOG_FILTER_SERVER_LOADING, "World snapshot %s can't be written to %s", m_Name.c_str(), l_FileName.c_str());
+        remove(l_TempFileName.c_str());
+    }
+}
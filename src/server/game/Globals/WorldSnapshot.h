@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WORLD_SNAPSHOT_H
+#define _WORLD_SNAPSHOT_H
+
+#include "Common.h"
+#include "ByteBuffer.h"
+
+/// Bumped when the layout of a snapshot payload or of a stored structure changes
+#define WORLD_SNAPSHOT_VERSION 1
+
+/// Binary copy of what a world database loader built in memory, reused on the next start while its source tables are unchanged
+/// The key is a checksum of the source tables (CHECKSUM TABLE) combined with the loader query, the sizes of the stored structures
+/// and the DBC data the loader filters on, any difference, a missing or a corrupted file makes the loader fall back to the database
+/// and write a new snapshot
+///
+/// Usage in a loader:
+///     WorldSnapshot l_Snapshot("creature", { "creature", "creature_template" }, l_Query);
+///     l_Snapshot.AddKeyInput(...DBC rows used by the loader...);
+///     if (l_Snapshot.Load())  -> read l_Snapshot.GetData(), return
+///     ... usual SQL loading, filling l_Snapshot.GetData() ...
+///     l_Snapshot.Save();
+class WorldSnapshot
+{
+    public:
+        WorldSnapshot(std::string const& p_Name, std::vector<std::string> const& p_Tables, std::string const& p_Key);
+
+        /// WorldSnapshot.Enable
+        bool IsEnabled() const { return m_Enabled; }
+
+        /// Data from outside the world database the loader depends on, must be added before Load
+        void AddKeyInput(std::string const& p_Input) { m_Key += '\n' + p_Input; }
+
+        /// True if a snapshot matching the current tables was read into GetData
+        bool Load();
+        /// Writes GetData for the next start, does nothing if disabled
+        void Save();
+
+        ByteBuffer& GetData() { return m_Data; }
+
+        /// Time spent computing the table checksums, reported with the loader timings
+        uint32 GetChecksumTime() const { return m_ChecksumTime; }
+
+    private:
+        uint64 ComputeKey();
+        std::string GetFileName() const;
+
+        std::string m_Name;
+        std::vector<std::string> m_Tables;
+        std::string m_Key;
+        bool m_Enabled;
+
+        uint64 m_Checksum;
+        uint32 m_ChecksumTime;
+        ByteBuffer m_Data;
+};
+
+#endif
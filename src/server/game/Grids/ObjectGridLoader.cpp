@@ -152,15 +152,16 @@ void LoadHelper(CellCorpseSet const& cell_corpses, CellCoord &cell, CorpseMapTyp
 void ObjectGridLoader::Visit(GameObjectMapType &m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId());
-    LoadHelper(cell_guids.gameobjects, cellCoord, m, i_gameObjects, i_map);
+    // a copy, pools may spawn into this cell while it is loaded
+    CellGuidSet guids = sObjectMgr->GetCellGameObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId());
+    LoadHelper(guids, cellCoord, m, i_gameObjects, i_map);
 }
 
 void ObjectGridLoader::Visit(CreatureMapType &m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId());
-    LoadHelper(cell_guids.creatures, cellCoord, m, i_creatures, i_map);
+    CellGuidSet guids = sObjectMgr->GetCellCreatureGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId());
+    LoadHelper(guids, cellCoord, m, i_creatures, i_map);
 }
 
 void ObjectWorldLoader::Visit(CorpseMapType &m)
@@ -219,6 +220,29 @@ void ObjectGridUnloader::Visit(GridRefManager<T> &m)
     }
 }
 
+template<class T>
+void ObjectGridDetacher::Visit(GridRefManager<T> &m)
+{
+    while (!m.isEmpty())
+    {
+        T *obj = m.getFirst()->getSource();
+        // same as ObjectGridUnloader, everything touching the map is done here
+        if (!sWorld->getBoolConfig(CONFIG_SAVE_RESPAWN_TIME_IMMEDIATELY))
+            obj->SaveRespawnTime();
+        obj->CleanupsBeforeDelete();
+
+        // world objects unregister from the map and transport passengers from their transport when deleted
+        if (obj->IsWorldObject() || obj->GetTransport())
+        {
+            delete obj;
+            continue;
+        }
+
+        obj->RemoveFromGrid();
+        i_objects.push_back(obj);
+    }
+}
+
 void ObjectGridStoper::Visit(CreatureMapType &m)
 {
     // stop any fights at grid de-activation and remove dynobjects created at cast by creatures
@@ -255,6 +279,12 @@ template void ObjectGridUnloader::Visit(DynamicObjectMapType &);
 template void ObjectGridUnloader::Visit(CorpseMapType &);
 template void ObjectGridUnloader::Visit(AreaTriggerMapType &);
 template void ObjectGridUnloader::Visit(ConversationMapType &);
+template void ObjectGridDetacher::Visit(CreatureMapType &);
+template void ObjectGridDetacher::Visit(GameObjectMapType &);
+template void ObjectGridDetacher::Visit(DynamicObjectMapType &);
+template void ObjectGridDetacher::Visit(CorpseMapType &);
+template void ObjectGridDetacher::Visit(AreaTriggerMapType &);
+template void ObjectGridDetacher::Visit(ConversationMapType &);
 template void ObjectGridCleaner::Visit(CreatureMapType &);
 template void ObjectGridCleaner::Visit<GameObject>(GameObjectMapType &);
 template void ObjectGridCleaner::Visit<DynamicObject>(DynamicObjectMapType &);
@@ -76,4 +76,16 @@ class ObjectGridUnloader
     public:
         template<class T> void Visit(GridRefManager<T> &m);
 };
+
+//Same as ObjectGridUnloader, but hands the objects to the GridReclaimer instead of deleting them
+class ObjectGridDetacher
+{
+    public:
+        ObjectGridDetacher(std::vector<WorldObject*>& objects) : i_objects(objects) {}
+
+        template<class T> void Visit(GridRefManager<T> &m);
+
+    private:
+        std::vector<WorldObject*>& i_objects;
+};
 #endif
@@ -26,6 +26,7 @@
 #include "LFGMgr.h"
 #include "UpdateFieldFlags.h"
 #include "LFGListMgr.h"
+#include "PacketBroadcast.h"
 #ifdef CROSS
 #include "InterRealmClient.h"
 #endif /* CROSS */
@@ -1945,6 +1946,7 @@ void Group::UpdatePlayerOutOfRange(Player* player)
 
 void Group::BroadcastAddonMessagePacket(WorldPacket* packet, const std::string& prefix, bool ignorePlayersInBGRaid, int group, uint64 ignore)
 {
+    PacketBroadcast broadcast(packet);
     for (GroupReference* itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player* player = itr->getSource();
@@ -1954,12 +1956,13 @@ void Group::BroadcastAddonMessagePacket(WorldPacket* packet, const std::string&
         if (WorldSession* session = player->GetSession())
             if (session && (group == -1 || itr->getSubGroup() == group))
                 if (session->IsAddonRegistered(prefix))
-                    session->SendPacket(packet);
+                    broadcast.SendTo(session);
     }
 }
 
 void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int group, uint64 ignore)
 {
+    PacketBroadcast broadcast(packet);
     for (GroupReference* itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player* player = itr->getSource();
@@ -1967,18 +1970,19 @@ void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int
             continue;
 
         if (player->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            player->GetSession()->SendPacket(packet);
+            broadcast.SendTo(player->GetSession());
     }
 }
 
 void Group::BroadcastReadyCheck(WorldPacket* packet)
 {
+    PacketBroadcast broadcast(packet);
     for (GroupReference* itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player* player = itr->getSource();
         if (player && player->GetSession())
             if (IsLeader(player->GetGUID()) || IsAssistant(player->GetGUID()) || m_PartyFlags & PARTY_FLAG_EVERYONE_IS_ASSISTANT)
-                player->GetSession()->SendPacket(packet);
+                broadcast.SendTo(player->GetSession());
     }
 }
 
@@ -19,6 +19,7 @@
 #include "AccountMgr.h"
 #include "CalendarMgr.h"
 #include "WowTime.hpp"
+#include "PacketBroadcast.h"
 
 #define MAX_GUILD_BANK_TAB_TEXT_LEN 500
 #define EMBLEM_PRICE 10 * GOLD
@@ -2051,6 +2052,8 @@ void Guild::HandleMemberLogout(WorldSession * p_Session)
 
     BroadcastPacket(&l_Data);
 
+    _SetMemberOnline(l_Player->GetGUID(), false);
+
     SaveToDB();
 }
 
@@ -2306,6 +2309,8 @@ void Guild::SendLoginInfo(WorldSession * p_Session)
           SMSG_GUILD_SEND_PLAYER_LOGIN_STATUS
           */
 
+    _SetMemberOnline(p_Session->GetPlayer()->GetGUID(), true);
+
     WorldPacket l_Data(SMSG_GUILD_EVENT_MOTD, 1 + 1 + m_motd.size());
 
     l_Data.WriteBits(m_motd.size(), 10);
@@ -2636,15 +2641,20 @@ void Guild::BroadcastToGuild(WorldSession* session, bool officerOnly, const std:
     {
         WorldPacket data;
         ChatHandler::FillMessageData(&data, session, officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, language, NULL, 0, msg.c_str(), NULL);
-        for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
+
+        PacketBroadcast broadcast(&data);
+        std::vector<uint64> onlineMembers;
+        _GetOnlineMembers(onlineMembers);
+
+        for (uint64 guid : onlineMembers)
         {
-            if (Player* player = itr->second->FindPlayer())
+            if (Player* player = ObjectAccessor::FindPlayer(guid))
             {
                 if (player->GetSession() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
                     !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUIDLow()))
-                    player->GetSession()->SendPacket(&data);
+                    broadcast.SendTo(player->GetSession());
             }
-           else if (Player* player = ObjectAccessor::FindPlayerInOrOutOfWorld(itr->second->GetGUID()))
+           else if (Player* player = ObjectAccessor::FindPlayerInOrOutOfWorld(guid))
            {
                if (player->GetSession() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
                    !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUIDLow()) &&
@@ -2663,28 +2673,42 @@ void Guild::BroadcastAddonToGuild(WorldSession* session, bool officerOnly, const
     {
         WorldPacket data;
         ChatHandler::FillMessageData(&data, session, officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, CHAT_MSG_ADDON, NULL, 0, msg.c_str(), NULL, prefix.c_str());
-        for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-            if (Player* player = itr->second->FindPlayer())
+
+        PacketBroadcast broadcast(&data);
+        std::vector<uint64> onlineMembers;
+        _GetOnlineMembers(onlineMembers);
+
+        for (uint64 guid : onlineMembers)
+            if (Player* player = ObjectAccessor::FindPlayer(guid))
                 if (player->GetSession() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
                     !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUIDLow()) &&
                     player->GetSession()->IsAddonRegistered(prefix))
-                        player->GetSession()->SendPacket(&data);
+                        broadcast.SendTo(player->GetSession());
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const
 {
-    for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (itr->second->IsRank(rankId))
-            if (Player* player = itr->second->FindPlayer())
-                player->GetSession()->SendPacket(packet);
+    PacketBroadcast broadcast(packet);
+    std::vector<uint64> onlineMembers;
+    _GetOnlineMembers(onlineMembers);
+
+    for (uint64 guid : onlineMembers)
+        if (Member const* member = GetMember(guid))
+            if (member->IsRank(rankId))
+                if (Player* player = ObjectAccessor::FindPlayer(guid))
+                    broadcast.SendTo(player->GetSession());
 }
 
 void Guild::BroadcastPacket(WorldPacket* packet) const
 {
-    for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (Player* player = itr->second->FindPlayer())
-            player->GetSession()->SendPacket(packet);
+    PacketBroadcast broadcast(packet);
+    std::vector<uint64> onlineMembers;
+    _GetOnlineMembers(onlineMembers);
+
+    for (uint64 guid : onlineMembers)
+        if (Player* player = ObjectAccessor::FindPlayer(guid))
+            broadcast.SendTo(player->GetSession());
 }
 
 void Guild::MassInviteToEvent(WorldSession* /*p_Session*/, uint32 /*p_MinLevel*/, uint32 /*p_MaxLevel*/, uint32 /*p_MinRank*/)
@@ -2782,6 +2806,9 @@ bool Guild::AddMember(uint64 p_Guid, uint8 p_RankID)
 
     m_members[l_LowGuid] = l_Member;
 
+    if (l_Player)
+        _SetMemberOnline(p_Guid, true);
+
     SQLTransaction l_Transaction(NULL);
     l_Member->SaveToDB(l_Transaction);
 
@@ -2895,6 +2922,8 @@ void Guild::DeleteMember(uint64 p_Guid, bool p_IsDisbanding, bool p_IsKicked, bo
 
     m_members.erase(l_LowGuid);
 
+    _SetMemberOnline(p_Guid, false);
+
     /// If player not online data in data field will be loaded from guild tabs no need to update it !!
     if (l_Player)
     {
@@ -2929,6 +2958,23 @@ bool Guild::ChangeMemberRank(uint64 p_GUID, uint8 p_NewRank)
     return false;
 }
 
+void Guild::_SetMemberOnline(uint64 guid, bool online)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_onlineMembersLock);
+
+    if (online)
+        m_onlineMembers.insert(guid);
+    else
+        m_onlineMembers.erase(guid);
+}
+
+void Guild::_GetOnlineMembers(std::vector<uint64>& guids) const
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_onlineMembersLock);
+
+    guids.assign(m_onlineMembers.begin(), m_onlineMembers.end());
+}
+
 bool Guild::IsMember(uint64 p_Guid)
 {
     Members::const_iterator l_It = m_members.find(GUID_LOPART(p_Guid));
@@ -740,6 +740,8 @@ class Guild
         void HandleMemberDepositMoney(WorldSession* session, uint64 amount, bool cashFlow = false);
         bool HandleMemberWithdrawMoney(WorldSession* session, uint64 amount, bool repair = false);
         void HandleMemberLogout(WorldSession* session);
+        // Back from a cross realm, the logout took the member out of the online members but SendLoginInfo isn't sent again
+        void HandleMemberBackFromCross(uint64 guid) { _SetMemberOnline(guid, true); }
         void HandleDisband(WorldSession* session);
         void HandleGuildPartyRequest(WorldSession* session);
 
@@ -780,8 +782,11 @@ class Guild
         template<class Do>
         void BroadcastWorker(Do& _do, Player* except = NULL)
         {
-            for (Members::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-                if (Player* player = itr->second->FindPlayer())
+            std::vector<uint64> onlineMembers;
+            _GetOnlineMembers(onlineMembers);
+
+            for (uint64 guid : onlineMembers)
+                if (Player* player = ObjectAccessor::FindPlayer(guid))
                     if (player != except)
                         _do(player);
         }
@@ -850,6 +855,10 @@ class Guild
         Members m_members;
         BankTabs m_bankTabs;
 
+        // Members in game, kept on login/logout so broadcasts don't look up the whole roster
+        std::set<uint64> m_onlineMembers;
+        mutable ACE_Thread_Mutex m_onlineMembersLock;
+
         // These are actually ordered lists. The first element is the oldest entry.
         LogHolder* m_eventLog;
         LogHolder* m_bankEventLog[GUILD_BANK_MAX_TABS + 1];
@@ -903,6 +912,9 @@ class Guild
         void _CreateRank(const std::string& name, uint32 rights);
         // Update account number when member added/removed from guild
         void _UpdateAccountsNumber();
+        void _SetMemberOnline(uint64 guid, bool online);
+        // Copy, so broadcast workers can change the guild
+        void _GetOnlineMembers(std::vector<uint64>& guids) const;
         bool _IsLeader(Player* player) const;
         void _DeleteBankItems(SQLTransaction& trans, bool removeItemsFromDB = false);
         bool _ModifyBankMoney(SQLTransaction& trans, uint64 amount, bool add);
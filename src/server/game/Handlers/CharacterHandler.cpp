@@ -1200,6 +1200,11 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* l_CharacterHolder, LoginD
             pCurrChar->SetInGuild(0);
         }
     }
+    else if (pCurrChar->GetGuildId() != 0)
+    {
+        if (Guild* guild = sGuildMgr->GetGuildById(pCurrChar->GetGuildId()))
+            guild->HandleMemberBackFromCross(pCurrChar->GetGUID());
+    }
 
     //uint32 time5 = getMSTime() - time4;
 
@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "LootAliasTable.h"
+
+#include <algorithm>
+
+void LootAliasTable::Build(std::vector<float> const& p_Chances)
+{
+    m_EntryCount = p_Chances.size();
+
+    uint32 l_SlotCount = m_EntryCount + 1;
+    std::vector<double> l_Weights(l_SlotCount, 0.0);
+
+    /// Same reachability as the walk: each entry only owns the part of [0, 100) its chance covers
+    double l_Cumulated = 0.0;
+    for (uint32 l_I = 0; l_I < m_EntryCount; ++l_I)
+    {
+        double l_Start = l_Cumulated;
+        l_Cumulated    = p_Chances[l_I] >= 100.0f ? 100.0 : std::min(100.0, l_Cumulated + p_Chances[l_I]);
+        l_Weights[l_I] = l_Cumulated - l_Start;
+    }
+
+    l_Weights[m_EntryCount] = 100.0 - l_Cumulated;
+
+    m_Thresholds.assign(l_SlotCount, 1.0);
+    m_Aliases.resize(l_SlotCount);
+
+    std::vector<uint32> l_Small;
+    std::vector<uint32> l_Large;
+
+    for (uint32 l_I = 0; l_I < l_SlotCount; ++l_I)
+    {
+        m_Aliases[l_I] = l_I;
+        l_Weights[l_I] = l_Weights[l_I] * l_SlotCount / 100.0;
+
+        if (l_Weights[l_I] < 1.0)
+            l_Small.push_back(l_I);
+        else
+            l_Large.push_back(l_I);
+    }
+
+    while (!l_Small.empty() && !l_Large.empty())
+    {
+        uint32 l_Less = l_Small.back();
+        uint32 l_More = l_Large.back();
+        l_Small.pop_back();
+
+        m_Thresholds[l_Less] = l_Weights[l_Less];
+        m_Aliases[l_Less]    = l_More;
+
+        l_Weights[l_More] = (l_Weights[l_More] + l_Weights[l_Less]) - 1.0;
+        if (l_Weights[l_More] < 1.0)
+        {
+            l_Large.pop_back();
+            l_Small.push_back(l_More);
+        }
+    }
+
+    /// Leftovers only differ from 1 by rounding errors
+    for (uint32 l_Slot : l_Small)
+        m_Thresholds[l_Slot] = 1.0;
+    for (uint32 l_Slot : l_Large)
+        m_Thresholds[l_Slot] = 1.0;
+}
@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LOOT_ALIAS_TABLE_H
+#define _LOOT_ALIAS_TABLE_H
+
+#include "Define.h"
+
+#include <vector>
+
+/// Returned by LootAliasTable::Pick when the roll falls outside every explicit chance
+#define LOOT_ALIAS_NO_PICK 0xFFFFFFFF
+/// Random numbers drawn at once by the loot processors
+#define LOOT_ROLL_BATCH_SIZE 64
+
+/// Compiled explicit chances of a loot group (Walker / Vose alias method)
+/// A group rolls rand_chance() and walks its entries subtracting their chance, the first entry bringing the roll below 0 wins,
+/// and when the chances sum to less than 100 the remainder is "no explicit entry". The table holds the same distribution,
+/// one slot per entry plus one for the remainder, so a pick is one random number and two array reads whatever the size of the group
+class LootAliasTable
+{
+    public:
+        LootAliasTable() : m_EntryCount(0) { }
+
+        /// Builds the table from the chances of the entries (percent, in the walk order)
+        /// Chances past a cumulated 100% are unreachable in the walk and get no slot weight either
+        void Build(std::vector<float> const& p_Chances);
+
+        /// Index of the picked entry, or LOOT_ALIAS_NO_PICK, for a uniform roll in [0, 1)
+        uint32 Pick(double p_Roll) const
+        {
+            double l_Scaled = p_Roll * m_Thresholds.size();
+            uint32 l_Slot   = uint32(l_Scaled);
+
+            if (l_Slot >= m_Thresholds.size())
+                l_Slot = m_Thresholds.size() - 1;
+
+            uint32 l_Outcome = (l_Scaled - l_Slot) < m_Thresholds[l_Slot] ? l_Slot : m_Aliases[l_Slot];
+            return l_Outcome < m_EntryCount ? l_Outcome : LOOT_ALIAS_NO_PICK;
+        }
+
+        bool IsEmpty() const { return m_EntryCount == 0; }
+        uint32 GetMemoryUsage() const { return m_Thresholds.capacity() * sizeof(double) + m_Aliases.capacity() * sizeof(uint32); }
+
+    private:
+        std::vector<double> m_Thresholds;   ///< Probability to keep the slot, else its alias is picked
+        std::vector<uint32> m_Aliases;
+        uint32 m_EntryCount;                ///< Slot m_EntryCount is the "no explicit entry" remainder
+};
+
+#endif
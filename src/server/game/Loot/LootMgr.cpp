@@ -7,6 +7,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "LootMgr.h"
+#include "LootAliasTable.h"
+#include "LootRoll.h"
 #include "Log.h"
 #include "ObjectMgr.h"
 #include "World.h"
@@ -58,11 +60,15 @@ class LootTemplate::LootGroup                               // A set of loot def
         LootStoreItemList* GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
         LootStoreItemList* GetEqualChancedItemList() { return &EqualChanced; }
         void CopyConditions(ConditionContainer conditions);
+        void LoadItemTemplates();                           // Refreshes the item_template data cached by the entries
+        void Compile();                                     // Builds ExplicitTable from ExplicitlyChanced
     private:
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
+        LootAliasTable    ExplicitTable;                    // Compiled chances of ExplicitlyChanced, picks like the walk of Roll()
 
         LootStoreItem const* Roll() const;                 // Rolls an item from the group, returns NULL if all miss their chances
+        static bool IsDuplicate(Loot const& loot, LootStoreItem const& item);
 };
 
 //Remove all data and free all memory
@@ -141,6 +147,8 @@ uint32 LootStore::LoadLootTable()
         if (!storeitem.IsValid(*this, entry))            // Validity checks
             continue;
 
+        storeitem.LoadItemTemplate();
+
         // Looking for the template of the entry
                                                         // often entries are put together
         if (m_LootTemplates.empty() || tab->first != entry)
@@ -164,6 +172,9 @@ uint32 LootStore::LoadLootTable()
 
     Verify();                                           // Checks validity of the loot store
 
+    for (LootTemplateMap::const_iterator itr = m_LootTemplates.begin(); itr != m_LootTemplates.end(); ++itr)
+        itr->second->Compile();
+
     return count;
 }
 
@@ -196,6 +207,12 @@ void LootStore::ResetConditions()
     }
 }
 
+void LootStore::LoadItemTemplates()
+{
+    for (LootTemplateMap::iterator itr = m_LootTemplates.begin(); itr != m_LootTemplates.end(); ++itr)
+        itr->second->LoadItemTemplates();
+}
+
 LootTemplate const* LootStore::GetLootFor(uint32 loot_id) const
 {
     LootTemplateMap::const_iterator tab = m_LootTemplates.find(loot_id);
@@ -248,30 +265,46 @@ void LootStore::ReportNotExistedId(uint32 id) const
 // --------- LootStoreItem ---------
 //
 
-// Checks if the entry (quest, non-quest, reference) takes it's chance (at loot generation)
+// Chance of the entry (quest, non-quest, reference) to be taken (at loot generation), the entry drops if it's above rand_chance()
 // RATE_DROP_ITEMS is no longer used for all types of entries
-bool LootStoreItem::Roll(bool rate, Player const* p_Player) const
+float LootStoreItem::GetRollChance(bool rate, Player const* p_Player) const
 {
     if (chance >= 100.0f)
-        return true;
+        return 100.0f;
 
     if (mincountOrRef < 0)                                   // reference case
-        return roll_chance_f(chance* (rate ? sWorld->getRate(RATE_DROP_ITEM_REFERENCED) : 1.0f));
+        return chance * (rate ? sWorld->getRate(RATE_DROP_ITEM_REFERENCED) : 1.0f);
 
     if (type == LOOT_ITEM_TYPE_ITEM)
     {
-        ItemTemplate const* pProto = sObjectMgr->GetItemTemplate(itemid);
-        float qualityModifier = pProto && rate ? sWorld->getRate(qualityToRate[pProto->Quality]) : 1.0f;
-        return roll_chance_f(chance*qualityModifier);
+        float qualityModifier = quality >= 0 && rate ? sWorld->getRate(qualityToRate[quality]) : 1.0f;
+        return chance * qualityModifier;
     }
     else if (type == LOOT_ITEM_TYPE_CURRENCY)
     {
         if ((sCurrencyTypesStore.LookupEntry(itemid)->Category == CURRENCY_TYPE_APEXIS_CRYSTAL) && p_Player->HasAura(186400))
-            return roll_chance_f(chance * 2);
-        return roll_chance_f(chance);
+            return chance * 2;
+        return chance;
     }
 
-    return false;
+    return 0.0f;
+}
+
+// Caches the item_template data used at loot generation
+// Item templates can be reloaded at runtime (hotfix reload), LoadLootItemTemplates() refreshes the cache afterwards
+void LootStoreItem::LoadItemTemplate()
+{
+    quality   = -1;
+    dropLimit = 0;
+
+    if (type != LOOT_ITEM_TYPE_ITEM || mincountOrRef < 0)
+        return;
+
+    if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(itemid))
+    {
+        quality   = proto->Quality < MAX_ITEM_QUALITY ? int8(proto->Quality) : -1;
+        dropLimit = proto->InventoryType == 0 ? 3 : 1;     // Non-equippable items are limited to 3 drops, equippable ones to 1
+    }
 }
 
 // Checks correctness of values
@@ -1615,6 +1648,26 @@ bool LootTemplate::LootGroup::HasQuestDropForPlayer(Player const* player) const
     return false;
 }
 
+void LootTemplate::LootGroup::Compile()
+{
+    std::vector<float> chances;
+    chances.reserve(ExplicitlyChanced.size());
+
+    for (LootStoreItemList::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
+        chances.push_back(i->chance);
+
+    ExplicitTable.Build(chances);
+}
+
+void LootTemplate::LootGroup::LoadItemTemplates()
+{
+    for (LootStoreItemList::iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
+        i->LoadItemTemplate();
+
+    for (LootStoreItemList::iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
+        i->LoadItemTemplate();
+}
+
 void LootTemplate::LootGroup::CopyConditions(ConditionContainer /*conditions*/)
 {
     for (LootStoreItemList::iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
@@ -1627,91 +1680,26 @@ void LootTemplate::LootGroup::CopyConditions(ConditionContainer /*conditions*/)
     }
 }
 
-// Rolls an item from the group (if any takes its chance) and adds the item to the loot
-void LootTemplate::LootGroup::Process(Loot& loot, uint16 lootMode) const
+// True if the loot already holds as many copies of the item as a group may add
+bool LootTemplate::LootGroup::IsDuplicate(Loot const& loot, LootStoreItem const& item)
 {
-    // build up list of possible drops
-    LootStoreItemList EqualPossibleDrops = EqualChanced;
-    LootStoreItemList ExplicitPossibleDrops = ExplicitlyChanced;
-
-    uint8 uiAttemptCount = 0;
-    const uint8 uiMaxAttempts = ExplicitlyChanced.size() + EqualChanced.size();
-
-    while (!ExplicitPossibleDrops.empty() || !EqualPossibleDrops.empty())
-    {
-        if (uiAttemptCount == uiMaxAttempts)             // already tried rolling too many times, just abort
-            return;
-
-        LootStoreItem* item = NULL;
-
-        // begin rolling (normally called via Roll())
-        LootStoreItemList::iterator itr;
-        uint8 itemSource = 0;
-        if (!ExplicitPossibleDrops.empty())              // First explicitly chanced entries are checked
-        {
-            itemSource = 1;
-            float Roll = (float)rand_chance();
-            // check each explicitly chanced entry in the template and modify its chance based on quality
-            for (itr = ExplicitPossibleDrops.begin(); itr != ExplicitPossibleDrops.end(); itr = ExplicitPossibleDrops.erase(itr))
-            {
-                if (itr->chance >= 100.0f)
-                {
-                    item = &*itr;
-                    break;
-                }
+    if (!item.dropLimit)
+        return false;
 
-                Roll -= itr->chance;
-                if (Roll < 0)
-                {
-                    item = &*itr;
-                    break;
-                }
-            }
-        }
-        if (item == NULL && !EqualPossibleDrops.empty()) // If nothing selected yet - an item is taken from equal-chanced part
-        {
-            itemSource = 2;
-            itr = EqualPossibleDrops.begin();
-            std::advance(itr, irand(0, EqualPossibleDrops.size()-1));
-            item = &*itr;
-        }
-        // finish rolling
+    uint8 counter = 0;
+    for (LootItemList::const_iterator itr = loot.Items.begin(); itr != loot.Items.end(); ++itr)
+        if (itr->itemid == item.itemid && ++counter == item.dropLimit)   // search through the items that have already dropped
+            return true;
 
-        ++uiAttemptCount;
+    return false;
+}
 
-        if (item != NULL && item->lootmode & lootMode)   // only add this item if roll succeeds and the mode matches
-        {
-            bool duplicate = false;
-            if (ItemTemplate const* _proto = sObjectMgr->GetItemTemplate(item->itemid))
-            {
-                uint8 _item_counter = 0;
-                for (LootItemList::const_iterator _item = loot.Items.begin(); _item != loot.Items.end(); ++_item)
-                    if (_item->itemid == item->itemid)                             // search through the items that have already dropped
-                    {
-                        ++_item_counter;
-                        if (_proto->InventoryType == 0 && _item_counter == 3)      // Non-equippable items are limited to 3 drops
-                            duplicate = true;
-                        else if (_proto->InventoryType != 0 && _item_counter == 1) // Equippable item are limited to 1 drop
-                            duplicate = true;
-                    }
-            }
-            if (duplicate) // if item->itemid is a duplicate, remove it
-                switch (itemSource)
-                {
-                    case 1: // item came from ExplicitPossibleDrops
-                        ExplicitPossibleDrops.erase(itr);
-                        break;
-                    case 2: // item came from EqualPossibleDrops
-                        EqualPossibleDrops.erase(itr);
-                        break;
-                }
-            else           // otherwise, add the item and exit the function
-            {
-                loot.AddItem(*item);
-                return;
-            }
-        }
-    }
+// Rolls an item from the group (if any takes its chance) and adds the item to the loot, see LootRoll::RollGroup
+void LootTemplate::LootGroup::Process(Loot& loot, uint16 lootMode) const
+{
+    LootRoll::RollGroup(ExplicitlyChanced, EqualChanced, ExplicitTable, lootMode,
+        [&loot](LootStoreItem const& item) { return IsDuplicate(loot, item); },
+        [&loot](LootStoreItem const& item) { loot.AddItem(item); });
 }
 
 void LootTemplate::FillAutoAssignationLoot(std::list<const ItemTemplate*>& p_ItemList, Player* /*p_Player*/ /*= nullpltr*/, bool p_IsBGReward /*= false*/) const
@@ -1865,12 +1853,30 @@ void LootTemplate::AddEntry(LootStoreItem& item)
 void LootTemplate::CopyConditions(ConditionContainer conditions)
 {
     for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
+    {
         i->conditions.clear();
+        i->hasWorldConditions = false;
+    }
 
     for (LootGroups::iterator i = Groups.begin(); i != Groups.end(); ++i)
         i->CopyConditions(conditions);
 }
 
+void LootTemplate::LoadItemTemplates()
+{
+    for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
+        i->LoadItemTemplate();
+
+    for (LootGroups::iterator i = Groups.begin(); i != Groups.end(); ++i)
+        i->LoadItemTemplates();
+}
+
+void LootTemplate::Compile()
+{
+    for (LootGroups::iterator i = Groups.begin(); i != Groups.end(); ++i)
+        i->Compile();
+}
+
 // Rolls for every item in the template and adds the rolled items the the loot
 void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, Player const* lootOwner, uint8 groupId) const
 {
@@ -1883,49 +1889,26 @@ void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, Player const*
         return;
     }
 
-    // Rolling non-grouped items
-    for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
-    {
-        if (i->lootmode &~ lootMode)                          // Do not add if mode mismatch
-            continue;
-
-        if (!i->Roll(rate, lootOwner))
-            continue;                                         // Bad luck for the entry
-
-        if (i->type == LOOT_ITEM_TYPE_ITEM)
+    // Rolling non-grouped items, the random numbers are drawn by batches
+    LootRoll::RollEntries(Entries.begin(), Entries.end(), lootMode,
+        [rate, lootOwner](LootStoreItem const& item) { return item.GetRollChance(rate, lootOwner); },
+        [](LootStoreItem const& item) { return sConditionMgr->CanMeetWorldConditions(item.conditions); },
+        [&loot, rate, lootMode, lootOwner](LootStoreItem const& item)
         {
-            if (ItemTemplate const* _proto = sObjectMgr->GetItemTemplate(i->itemid))
+            if (item.mincountOrRef < 0 && item.type == LOOT_ITEM_TYPE_ITEM)     // References processing
             {
-                uint8 _item_counter = 0;
-                LootItemList::const_iterator _item = loot.Items.begin();
-                for (; _item != loot.Items.end(); ++_item)
-                    if (_item->itemid == i->itemid)                               // search through the items that have already dropped
-                    {
-                        ++_item_counter;
-                        if (_proto->InventoryType == 0 && _item_counter == 3)     // Non-equippable items are limited to 3 drops
-                            continue;
-                        else if (_proto->InventoryType != 0 && _item_counter == 1) // Equippable item are limited to 1 drop
-                            continue;
-                    }
-                if (_item != loot.Items.end())
-                    continue;
-            }
-        }
-
-        if (i->mincountOrRef < 0 && i->type == LOOT_ITEM_TYPE_ITEM)                             // References processing
-        {
-            LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(-i->mincountOrRef);
+                LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(-item.mincountOrRef);
 
-            if (!Referenced)
-                continue;                                     // Error message already printed at loading stage
+                if (!Referenced)
+                    return;                                   // Error message already printed at loading stage
 
-            uint32 maxcount = uint32(float(i->maxcount) * sWorld->getRate(RATE_DROP_ITEM_REFERENCED_AMOUNT));
-            for (uint32 loop = 0; loop < maxcount; ++loop)    // Ref multiplicator
-                Referenced->Process(loot, rate, lootMode, lootOwner, i->group);
-        }
-        else                                                  // Plain entries (not a reference, not grouped)
-            loot.AddItem(*i);                                 // Chance is already checked, just add
-    }
+                uint32 maxcount = uint32(float(item.maxcount) * sWorld->getRate(RATE_DROP_ITEM_REFERENCED_AMOUNT));
+                for (uint32 loop = 0; loop < maxcount; ++loop)    // Ref multiplicator
+                    Referenced->Process(loot, rate, lootMode, lootOwner, item.group);
+            }
+            else                                              // Plain entries (not a reference, not grouped)
+                loot.AddItem(item);                           // Chance is already checked, just add
+        });
 
     // Now processing groups
     for (LootGroups::const_iterator i = Groups.begin(); i != Groups.end(); ++i)
@@ -2031,6 +2014,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
             if (i->itemid == uint32(cond->SourceEntry))
             {
                 i->conditions.push_back(cond);
+                i->hasWorldConditions = sConditionMgr->HasWorldConditions(i->conditions);
                 return true;
             }
         }
@@ -116,15 +116,19 @@ struct LootStoreItem
     uint32   maxcount;                                      // max drop count for the item (mincountOrRef positive) or Ref multiplicator (mincountOrRef negative)
     std::vector<uint32> itemBonuses;                        // item bonuses >= WoD
     ConditionContainer conditions;                               // additional loot condition
+    int8    quality;                                        // item quality for the drop rates, -1 if unknown, filled by LoadItemTemplate()
+    uint8   dropLimit;                                      // max copies of the item in a loot rolled from groups, 0 = no limit
+    bool    hasWorldConditions;                             // some conditions don't depend on the looter, checked at loot generation
 
     // Constructor, converting ChanceOrQuestChance -> (chance, needs_quest)
     // displayid is filled in IsValid() which must be called after
     LootStoreItem(uint32 _itemid, uint8 _type, float _chanceOrQuestChance, uint16 _lootmode, uint8 _group, int32 _mincountOrRef, uint32 _maxcount, std::vector<uint32> _itemBonuses)
         : itemid(_itemid), type(_type), chance(fabs(_chanceOrQuestChance)), mincountOrRef(_mincountOrRef), lootmode(_lootmode),
-        group(_group), needs_quest(_chanceOrQuestChance < 0), maxcount(_maxcount), itemBonuses(_itemBonuses)
+        group(_group), needs_quest(_chanceOrQuestChance < 0), maxcount(_maxcount), itemBonuses(_itemBonuses), quality(-1), dropLimit(0), hasWorldConditions(false)
          {}
 
-    bool Roll(bool rate, Player const* Player) const;                             // Checks if the entry takes it's chance (at loot generation)
+    float GetRollChance(bool rate, Player const* Player) const;                   // Chance of the entry at loot generation, rates applied, >= 100 always drops
+    void LoadItemTemplate();                                                      // Caches the item_template data used at loot generation, see LoadLootItemTemplates()
     bool IsValid(LootStore const& store, uint32 entry) const;
                                                             // Checks correctness of values
 };
@@ -212,6 +216,7 @@ class LootStore
 
         LootTemplate const* GetLootFor(uint32 loot_id) const;
         void ResetConditions();
+        void LoadItemTemplates();                           // Refreshes the item_template data cached by the entries
         LootTemplate* GetLootForConditionFill(uint32 loot_id);
 
         char const* GetName() const { return m_name; }
@@ -238,6 +243,8 @@ class LootTemplate
         // Rolls for every item in the template and adds the rolled items the the loot
         void Process(Loot& loot, bool rate, uint16 lootMode, Player const* p_Player, uint8 groupId = 0) const;
         void CopyConditions(ConditionContainer conditions);
+        // Refreshes the item_template data cached by the entries
+        void LoadItemTemplates();
         void FillAutoAssignationLoot(std::list<const ItemTemplate*>& p_ItemList, Player* p_Player = nullptr, bool p_IsBGReward = false) const;
 
         // True if template includes at least 1 quest drop entry
@@ -245,6 +252,9 @@ class LootTemplate
         // True if template includes at least 1 quest drop for an active quest of the player
         bool HasQuestDropForPlayer(LootTemplateMap const& store, Player const* player, uint8 groupId = 0) const;
 
+        // Builds the roll tables of the groups, once all the entries are added
+        void Compile();
+
         // Checks integrity of the template
         void Verify(LootStore const& store, uint32 Id) const;
         void CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_set) const;
@@ -498,4 +508,21 @@ inline void LoadLootTables()
     LoadLootTemplates_Reference();
 }
 
+// The loot entries cache item_template data, to refresh once the item templates are reloaded
+inline void LoadLootItemTemplates()
+{
+    LootTemplates_Creature.LoadItemTemplates();
+    LootTemplates_Fishing.LoadItemTemplates();
+    LootTemplates_Gameobject.LoadItemTemplates();
+    LootTemplates_Item.LoadItemTemplates();
+    LootTemplates_Mail.LoadItemTemplates();
+    LootTemplates_Milling.LoadItemTemplates();
+    LootTemplates_Pickpocketing.LoadItemTemplates();
+    LootTemplates_Reference.LoadItemTemplates();
+    LootTemplates_Skinning.LoadItemTemplates();
+    LootTemplates_Disenchant.LoadItemTemplates();
+    LootTemplates_Prospecting.LoadItemTemplates();
+    LootTemplates_Spell.LoadItemTemplates();
+}
+
 #endif
@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LOOT_ROLL_H
+#define _LOOT_ROLL_H
+
+#include "Define.h"
+#include "Util.h"
+#include "LootAliasTable.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+/// Roll algorithms of the loot templates, used by LootTemplate and by the loot_roll_bench tool
+/// They only read the chance and the loot mode of the entries, what depends on the loot (adding an item, duplicates,
+/// world conditions) is given by the caller:
+///     p_IsDuplicate(entry)            the loot already holds as many copies as allowed
+///     p_Drop(entry)                   the entry won its roll
+///     p_CanMeetWorldConditions(entry) only called for entries having world conditions
+namespace LootRoll
+{
+    /// Non grouped entries: each entry of the loot mode rolls its own chance, the random numbers are drawn by batches
+    /// (at most p_BatchSize numbers at once, 1 draws one number per roll)
+    template<class Iterator, class ChanceFn, class WorldConditionsFn, class DropFn>
+    void RollEntries(Iterator p_Begin, Iterator p_End, uint16 p_LootMode, ChanceFn p_Chance, WorldConditionsFn p_CanMeetWorldConditions, DropFn p_Drop, uint32 p_BatchSize = LOOT_ROLL_BATCH_SIZE)
+    {
+        double l_Rolls[LOOT_ROLL_BATCH_SIZE];
+        uint32 l_RollIndex = 0;
+        uint32 l_RollCount = 0;
+
+        p_BatchSize = std::max<uint32>(1, std::min<uint32>(p_BatchSize, LOOT_ROLL_BATCH_SIZE));
+
+        for (Iterator l_Itr = p_Begin; l_Itr != p_End; ++l_Itr)
+        {
+            if (l_Itr->lootmode & ~p_LootMode)                                  ///< Do not add if mode mismatch
+                continue;
+
+            if (l_Itr->hasWorldConditions && !p_CanMeetWorldConditions(*l_Itr))
+                continue;                                                       ///< Nobody could see it (inactive event, world state)
+
+            float l_Chance = p_Chance(*l_Itr);
+            if (l_Chance < 100.0f)
+            {
+                if (l_RollIndex == l_RollCount)
+                {
+                    l_RollCount = uint32(std::min<size_t>(p_BatchSize, std::distance(l_Itr, p_End)));
+                    l_RollIndex = 0;
+                    rand_norm_batch(l_Rolls, l_RollCount);
+                }
+
+                if (l_Chance <= l_Rolls[l_RollIndex++] * 100.0)
+                    continue;                                                   ///< Bad luck for the entry
+            }
+
+            p_Drop(*l_Itr);
+        }
+    }
+
+    /// Walk of a group: the explicit candidates are checked in order against rand_chance(), the equal chanced ones are picked
+    /// uniformly when no explicit one is, until an entry of the loot mode which isn't a duplicate drops or the attempts run out
+    /// The candidates skipped by the walk and the duplicates are erased from the lists
+    template<class Entry, class DuplicateFn, class DropFn>
+    void ProcessRemaining(std::vector<Entry const*>& p_ExplicitPossibleDrops, std::vector<Entry const*>& p_EqualPossibleDrops, uint16 p_LootMode,
+        uint8 p_MaxAttempts, uint8 p_AttemptCount, DuplicateFn p_IsDuplicate, DropFn p_Drop)
+    {
+        typedef typename std::vector<Entry const*>::iterator PossibleDropIterator;
+
+        while (!p_ExplicitPossibleDrops.empty() || !p_EqualPossibleDrops.empty())
+        {
+            if (p_AttemptCount == p_MaxAttempts)                                ///< Already tried rolling too many times, just abort
+                return;
+
+            Entry const* l_Item = nullptr;
+
+            PossibleDropIterator l_Itr;
+            std::vector<Entry const*>* l_ItemSource = nullptr;
+            if (!p_ExplicitPossibleDrops.empty())                               ///< First explicitly chanced entries are checked
+            {
+                l_ItemSource = &p_ExplicitPossibleDrops;
+                float l_Roll = (float)rand_chance();
+
+                for (l_Itr = p_ExplicitPossibleDrops.begin(); l_Itr != p_ExplicitPossibleDrops.end(); l_Itr = p_ExplicitPossibleDrops.erase(l_Itr))
+                {
+                    if ((*l_Itr)->chance >= 100.0f)
+                    {
+                        l_Item = *l_Itr;
+                        break;
+                    }
+
+                    l_Roll -= (*l_Itr)->chance;
+                    if (l_Roll < 0)
+                    {
+                        l_Item = *l_Itr;
+                        break;
+                    }
+                }
+            }
+
+            if (l_Item == nullptr && !p_EqualPossibleDrops.empty())             ///< If nothing selected yet - an item is taken from equal-chanced part
+            {
+                l_ItemSource = &p_EqualPossibleDrops;
+                l_Itr = p_EqualPossibleDrops.begin();
+                std::advance(l_Itr, irand(0, p_EqualPossibleDrops.size() - 1));
+                l_Item = *l_Itr;
+            }
+
+            ++p_AttemptCount;
+
+            if (l_Item != nullptr && l_Item->lootmode & p_LootMode)            ///< Only add this item if roll succeeds and the mode matches
+            {
+                if (p_IsDuplicate(*l_Item))                                     ///< If the item is a duplicate, remove it
+                    l_ItemSource->erase(l_Itr);
+                else                                                            ///< Otherwise, add the item and exit the function
+                {
+                    p_Drop(*l_Item);
+                    return;
+                }
+            }
+        }
+    }
+
+    /// Group: the first attempt picks in the compiled table of the explicit chances, when it fails (loot mode, duplicate)
+    /// the candidates left by the walk are rebuilt and the next attempts go on like the walk does
+    template<class Entry, class DuplicateFn, class DropFn>
+    void RollGroup(std::vector<Entry> const& p_ExplicitlyChanced, std::vector<Entry> const& p_EqualChanced, LootAliasTable const& p_ExplicitTable,
+        uint16 p_LootMode, DuplicateFn p_IsDuplicate, DropFn p_Drop)
+    {
+        uint32 l_ExplicitIndex = LOOT_ALIAS_NO_PICK;
+        if (!p_ExplicitlyChanced.empty())
+            l_ExplicitIndex = p_ExplicitTable.Pick(rand_norm());
+
+        Entry const* l_Item = nullptr;
+        uint32 l_EqualIndex = 0;
+
+        if (l_ExplicitIndex != LOOT_ALIAS_NO_PICK)
+            l_Item = &p_ExplicitlyChanced[l_ExplicitIndex];
+        else if (!p_EqualChanced.empty())                                       ///< If nothing selected yet - an item is taken from equal-chanced part
+        {
+            l_EqualIndex = irand(0, p_EqualChanced.size() - 1);
+            l_Item = &p_EqualChanced[l_EqualIndex];
+        }
+
+        if (l_Item == nullptr)                                                  ///< Empty drop from the group
+            return;
+
+        bool l_Duplicate = false;
+        if (l_Item->lootmode & p_LootMode)                                      ///< Only add this item if roll succeeds and the mode matches
+        {
+            if (!p_IsDuplicate(*l_Item))
+            {
+                p_Drop(*l_Item);
+                return;
+            }
+
+            l_Duplicate = true;
+        }
+
+        /// The walk erased the explicit entries before the picked one (all of them if none was picked), and the duplicate itself
+        std::vector<Entry const*> l_ExplicitPossibleDrops;
+        std::vector<Entry const*> l_EqualPossibleDrops;
+
+        if (l_ExplicitIndex != LOOT_ALIAS_NO_PICK)
+        {
+            for (uint32 l_I = l_ExplicitIndex + (l_Duplicate ? 1 : 0); l_I < p_ExplicitlyChanced.size(); ++l_I)
+                l_ExplicitPossibleDrops.push_back(&p_ExplicitlyChanced[l_I]);
+        }
+
+        for (uint32 l_I = 0; l_I < p_EqualChanced.size(); ++l_I)
+            if (!l_Duplicate || l_ExplicitIndex != LOOT_ALIAS_NO_PICK || l_I != l_EqualIndex)
+                l_EqualPossibleDrops.push_back(&p_EqualChanced[l_I]);
+
+        ProcessRemaining(l_ExplicitPossibleDrops, l_EqualPossibleDrops, p_LootMode, uint8(p_ExplicitlyChanced.size() + p_EqualChanced.size()), 1, p_IsDuplicate, p_Drop);
+    }
+}
+
+#endif
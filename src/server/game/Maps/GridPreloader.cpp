@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "GridPreloader.h"
+#include "Map.h"
+#include "VMapFactory.h"
+#include "VMapManager2.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "Log.h"
+
+GridPreloadRequest::~GridPreloadRequest()
+{
+    delete Terrain;
+
+    if (MMapTile)
+    {
+        dtFree(MMapTile->data);
+        delete MMapTile;
+    }
+
+    if (!VMapModels.empty())
+    {
+        if (VMAP::VMapManager2* l_VMapMgr = dynamic_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager()))
+            l_VMapMgr->releaseTileModels(VMapModels);
+    }
+}
+
+GridPreloader::GridPreloader()
+    : m_CancelationToken(false), m_SynchronousLoads(0), m_PrefetchedLoads(0), m_Submitted(0), m_Completed(0), m_LatePreloads(0), m_WastedPreloads(0)
+{
+}
+
+GridPreloader::~GridPreloader()
+{
+    Shutdown();
+}
+
+void GridPreloader::Initialize(uint32 p_ThreadCount)
+{
+    if (IsEnabled())
+        return;
+
+    for (uint32 l_I = 0; l_I < p_ThreadCount; ++l_I)
+        m_WorkerThreads.push_back(std::thread(&GridPreloader::WorkerThread, this));
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Grid preloading started with %u worker threads", p_ThreadCount);
+}
+
+void GridPreloader::Shutdown()
+{
+    if (!IsEnabled())
+        return;
+
+    m_CancelationToken = true;
+    m_Queue.Cancel();
+
+    for (std::thread& l_Thread : m_WorkerThreads)
+        l_Thread.join();
+
+    m_WorkerThreads.clear();
+}
+
+void GridPreloader::Submit(GridPreloadRequestPtr const& p_Request)
+{
+    ++m_Submitted;
+    m_Queue.Push(p_Request);
+}
+
+void GridPreloader::WorkerThread()
+{
+    while (true)
+    {
+        GridPreloadRequestPtr l_Request;
+
+        m_Queue.WaitAndPop(l_Request);
+
+        if (m_CancelationToken)
+            return;
+
+        if (!l_Request)
+            continue;
+
+        /// The map already loaded the grid by itself or dropped the request
+        if (l_Request.unique())
+            continue;
+
+        Process(*l_Request);
+
+        ++m_Completed;
+        l_Request->Done = true;
+    }
+}
+
+void GridPreloader::Process(GridPreloadRequest& p_Request)
+{
+    /// Same file and error handling as Map::LoadMap
+    char l_FileName[512];
+    snprintf(l_FileName, sizeof(l_FileName), "%smaps/%04u_%02u_%02u.map", p_Request.DataPath.c_str(), p_Request.MapId, p_Request.TileX, p_Request.TileY);
+
+    p_Request.Terrain = new GridMap();
+    if (!p_Request.Terrain->loadData(l_FileName))
+        sLog->outError(LOG_FILTER_MAPS, "GridPreloader: error loading map file %s", l_FileName);
+
+    /// Only the model files are shared, the tile itself is inserted in the map tree by the map thread
+    if (p_Request.LoadVMap)
+    {
+        if (VMAP::VMapManager2* l_VMapMgr = dynamic_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager()))
+            l_VMapMgr->preloadTileModels(p_Request.DataPath + "vmaps", p_Request.MapId, p_Request.TileX, p_Request.TileY, p_Request.VMapModels);
+    }
+
+    /// The navmesh is queried without lock by the map threads, the tile is only read here
+    if (p_Request.LoadMMap)
+        p_Request.MMapTile = MMAP::MMapFactory::createOrGetMMapManager()->LoadTile(p_Request.MapId, p_Request.TileX, p_Request.TileY);
+
+    sLog->outDebug(LOG_FILTER_MAPS, "GridPreloader: preloaded grid [%u, %u] of map %u (%u vmap models, mmap tile %s)", p_Request.TileX, p_Request.TileY, p_Request.MapId,
+        uint32(p_Request.VMapModels.size()), p_Request.MMapTile ? "read" : "missing");
+}
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _GRID_PRELOADER_H
+#define _GRID_PRELOADER_H
+
+#include "Common.h"
+#include "ProducerConsumerQueue.h"
+
+class GridMap;
+
+namespace MMAP
+{
+    struct PhasedTile;
+}
+
+/// Time a finished preload is kept for its map before being dropped as wasted
+#define GRID_PRELOAD_EXPIRY (2 * MINUTE * IN_MILLISECONDS)
+
+/// Terrain of one grid read ahead of the players by the preloader workers
+/// Written by the map thread before Submit, then only by the worker until Done is set
+/// Whatever hasn't been handed over to the map is freed with the request
+struct GridPreloadRequest
+{
+    GridPreloadRequest(uint32 p_MapId, uint32 p_TileX, uint32 p_TileY, std::string const& p_DataPath, bool p_LoadVMap, bool p_LoadMMap)
+        : MapId(p_MapId), TileX(p_TileX), TileY(p_TileY), DataPath(p_DataPath), LoadVMap(p_LoadVMap), LoadMMap(p_LoadMMap),
+        LastRequestTime(0), Terrain(nullptr), MMapTile(nullptr), Done(false) { }
+
+    ~GridPreloadRequest();
+
+    uint32 MapId;
+    uint32 TileX;                               ///< Terrain tile coordinates, as used by Map::LoadMapAndVMap
+    uint32 TileY;
+    std::string DataPath;
+    bool LoadVMap;
+    bool LoadMMap;
+    uint32 LastRequestTime;                     ///< Map thread only, last time a prediction wanted this grid
+
+    GridMap* Terrain;
+    std::vector<std::string> VMapModels;        ///< WorldModels held in the vmap model cache until the tile is loaded
+    MMAP::PhasedTile* MMapTile;
+    std::atomic<bool> Done;
+};
+
+typedef std::shared_ptr<GridPreloadRequest> GridPreloadRequestPtr;
+
+/// Reads the terrain (.map), vmap models and mmap tile of the grids players are heading to on worker threads
+/// Maps submit the grids predicted from player movement and taxi paths, then pick the result up when the grid
+/// is created, so only the tree/navmesh insertion and the object loading are left to the map thread
+class GridPreloader
+{
+    public:
+        GridPreloader();
+        ~GridPreloader();
+
+        void Initialize(uint32 p_ThreadCount);
+        void Shutdown();
+
+        bool IsEnabled() const { return !m_WorkerThreads.empty(); }
+
+        void Submit(GridPreloadRequestPtr const& p_Request);
+
+        /// Terrain load of a grid, p_Prefetched if the preloader had it ready
+        void OnGridLoaded(bool p_Prefetched) { ++(p_Prefetched ? m_PrefetchedLoads : m_SynchronousLoads); }
+        /// The grid was needed while its preload was still running
+        void OnPreloadLate() { ++m_LatePreloads; }
+        /// The preload expired before any player reached the grid
+        void OnPreloadWasted() { ++m_WastedPreloads; }
+
+        uint64 GetSynchronousLoadCount() const { return m_SynchronousLoads; }
+        uint64 GetPrefetchedLoadCount() const { return m_PrefetchedLoads; }
+        uint64 GetSubmittedCount() const { return m_Submitted; }
+        uint64 GetCompletedCount() const { return m_Completed; }
+        uint64 GetLateCount() const { return m_LatePreloads; }
+        uint64 GetWastedCount() const { return m_WastedPreloads; }
+
+    private:
+        void WorkerThread();
+        void Process(GridPreloadRequest& p_Request);
+
+        ProducerConsumerQueue<GridPreloadRequestPtr> m_Queue;
+        std::vector<std::thread> m_WorkerThreads;
+        std::atomic<bool> m_CancelationToken;
+
+        std::atomic<uint64> m_SynchronousLoads;
+        std::atomic<uint64> m_PrefetchedLoads;
+        std::atomic<uint64> m_Submitted;
+        std::atomic<uint64> m_Completed;
+        std::atomic<uint64> m_LatePreloads;
+        std::atomic<uint64> m_WastedPreloads;
+};
+
+#define sGridPreloader ACE_Singleton<GridPreloader, ACE_Null_Mutex>::instance()
+
+#endif
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "GridReclaimer.h"
+#include "Map.h"
+#include "Object.h"
+#include "VMapFactory.h"
+#include "VMapManager2.h"
+#include "Log.h"
+
+#include <chrono>
+
+GridReclaimRequest::~GridReclaimRequest()
+{
+    for (WorldObject* l_Object : Objects)
+        delete l_Object;
+
+    if (Terrain)
+    {
+        Terrain->unloadData();
+        delete Terrain;
+    }
+
+    if (!VMapModels.empty())
+    {
+        if (VMAP::VMapManager2* l_VMapMgr = dynamic_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager()))
+            l_VMapMgr->releaseTileModels(VMapModels);
+    }
+}
+
+GridReclaimer::GridReclaimer()
+    : m_CancelationToken(false), m_ObjectsPerTick(0), m_TickInterval(0), m_TickObjects(0), m_Submitted(0), m_ReclaimedObjects(0), m_PendingObjects(0)
+{
+}
+
+GridReclaimer::~GridReclaimer()
+{
+    Shutdown();
+}
+
+void GridReclaimer::Initialize(uint32 p_ObjectsPerTick, uint32 p_TickInterval)
+{
+    if (IsEnabled())
+        return;
+
+    m_ObjectsPerTick = p_ObjectsPerTick;
+    m_TickInterval   = p_TickInterval;
+    m_WorkerThread   = std::thread(&GridReclaimer::WorkerThread, this);
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Grid reclaimer started, %u objects per %u ms", p_ObjectsPerTick, p_TickInterval);
+}
+
+void GridReclaimer::Shutdown()
+{
+    if (!IsEnabled())
+        return;
+
+    /// The requests still queued are freed by the queue, the one being processed is finished without pause
+    m_CancelationToken = true;
+    m_Queue.Cancel();
+
+    m_WorkerThread.join();
+}
+
+void GridReclaimer::Submit(GridReclaimRequest* p_Request)
+{
+    ++m_Submitted;
+    m_PendingObjects += p_Request->Objects.size();
+
+    m_Queue.Push(p_Request);
+}
+
+void GridReclaimer::WorkerThread()
+{
+    while (true)
+    {
+        GridReclaimRequest* l_Request = nullptr;
+
+        m_Queue.WaitAndPop(l_Request);
+
+        if (!l_Request)
+        {
+            if (m_CancelationToken)
+                return;
+
+            continue;
+        }
+
+        Process(l_Request);
+    }
+}
+
+void GridReclaimer::Process(GridReclaimRequest* p_Request)
+{
+    while (!p_Request->Objects.empty())
+    {
+        if (m_ObjectsPerTick && m_TickObjects >= m_ObjectsPerTick && !m_CancelationToken)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(m_TickInterval));
+            m_TickObjects = 0;
+        }
+
+        delete p_Request->Objects.back();
+        p_Request->Objects.pop_back();
+
+        ++m_TickObjects;
+        ++m_ReclaimedObjects;
+        --m_PendingObjects;
+    }
+
+    /// Terrain and vmap models
+    delete p_Request;
+
+    /// The worker idles until the next grid, which starts with a full budget
+    if (m_Queue.Empty())
+        m_TickObjects = 0;
+}
@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _GRID_RECLAIMER_H
+#define _GRID_RECLAIMER_H
+
+#include "Common.h"
+#include "ProducerConsumerQueue.h"
+
+class GridMap;
+class WorldObject;
+
+/// What is left of an unloaded grid once the map thread detached it
+/// The objects are out of the world, out of the grid and their respawn time is saved, nothing references them anymore
+/// Whatever the reclaimer didn't free yet is freed with the request
+struct GridReclaimRequest
+{
+    GridReclaimRequest() : Terrain(nullptr) { }
+    ~GridReclaimRequest();
+
+    std::vector<WorldObject*> Objects;
+    GridMap* Terrain;
+    std::vector<std::string> VMapModels;        ///< Model files released by the vmap tile, deleted with their last reference
+};
+
+/// Destroys the objects, terrain and vmap models of unloaded grids on a background thread
+/// At most ObjectsPerTick objects are deleted per map update interval, so a large continent unloading
+/// many grids at once doesn't compete with the map threads for the whole tick
+class GridReclaimer
+{
+    public:
+        GridReclaimer();
+        ~GridReclaimer();
+
+        void Initialize(uint32 p_ObjectsPerTick, uint32 p_TickInterval);
+        void Shutdown();
+
+        bool IsEnabled() const { return m_WorkerThread.joinable(); }
+
+        /// Takes ownership of p_Request
+        void Submit(GridReclaimRequest* p_Request);
+
+        uint64 GetSubmittedCount() const { return m_Submitted; }
+        uint64 GetReclaimedObjectCount() const { return m_ReclaimedObjects; }
+        uint64 GetPendingObjectCount() const { return m_PendingObjects; }
+
+    private:
+        void WorkerThread();
+        void Process(GridReclaimRequest* p_Request);
+
+        ProducerConsumerQueue<GridReclaimRequest*> m_Queue;
+        std::thread m_WorkerThread;
+        std::atomic<bool> m_CancelationToken;
+
+        uint32 m_ObjectsPerTick;
+        uint32 m_TickInterval;
+        uint32 m_TickObjects;                   ///< Objects deleted since the last pause, worker thread only
+
+        std::atomic<uint64> m_Submitted;
+        std::atomic<uint64> m_ReclaimedObjects;
+        std::atomic<uint64> m_PendingObjects;
+};
+
+#define sGridReclaimer ACE_Singleton<GridReclaimer, ACE_Null_Mutex>::instance()
+
+#endif
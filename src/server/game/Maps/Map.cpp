@@ -11,6 +11,11 @@
 #include "ScriptMgr.h"
 #include "VMapFactory.h"
 #include "MMapFactory.h"
+#include "VMapManager2.h"
+#include "GridReclaimer.h"
+#include "PathCache.h"
+#include "FlowField.h"
+#include "VignetteRegistry.hpp"
 #include "MapInstanced.h"
 #include "CellImpl.h"
 #include "GridNotifiers.h"
@@ -28,6 +33,8 @@
 #include "OutdoorPvPMgr.h"
 #include "DisableMgr.h"
 #include "Logger.h"
+#include "TickProfiler.h"
+#include "WaypointMovementGenerator.h"
 
 u_map_magic MapMagic        = { {'M','A','P','S'} };
 u_map_magic MapVersionMagic = { {'v','1','.','8'} };
@@ -68,6 +75,10 @@ Map::~Map()
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
+
+    delete m_PathCache;
+    delete m_FlowFieldMgr;
+    delete m_VignetteRegistry;
 }
 
 NGridType* Map::getNGrid(uint32 x, uint32 y) const
@@ -203,13 +214,166 @@ void Map::LoadMap(int gx, int gy, bool reload)
 
 void Map::LoadMapAndVMap(int gx, int gy)
 {
-    LoadMap(gx, gy);
-
     // Only load the data for the base map
-    if (i_InstanceId == 0)
+    if (i_InstanceId != 0)
+    {
+        LoadMap(gx, gy);
+        return;
+    }
+
+    GridPreloadRequestPtr l_Preload = TakeGridPreload(gx, gy);
+    if (!l_Preload || !l_Preload->Done)
     {
+        /// Only the open world is predicted, see UpdateGridPreload
+        if (!Instanceable())
+        {
+            if (l_Preload)
+                sGridPreloader->OnPreloadLate();
+
+            sGridPreloader->OnGridLoaded(false);
+        }
+
+        LoadMap(gx, gy);
         LoadVMap(gx, gy);
         LoadMMap(gx, gy);
+        return;
+    }
+
+    /// Files already read by the preloader, the models of the vmap tile are in the model cache
+    sLog->outDebug(LOG_FILTER_MAPS, "Using preloaded terrain of grid [%u, %u] for map %u", gx, gy, GetId());
+    sGridPreloader->OnGridLoaded(true);
+
+    if (!GridMaps[gx][gy])
+    {
+        GridMaps[gx][gy] = l_Preload->Terrain;
+        l_Preload->Terrain = nullptr;
+    }
+
+    LoadVMap(gx, gy);
+
+    if (l_Preload->MMapTile && DisableMgr::IsPathfindingEnabled(GetId()))
+    {
+        MMAP::MMapFactory::createOrGetMMapManager()->loadMap(GetId(), gx, gy, l_Preload->MMapTile);
+        l_Preload->MMapTile = nullptr;
+    }
+    else
+        LoadMMap(gx, gy);
+}
+
+GridPreloadRequestPtr Map::TakeGridPreload(int p_TileX, int p_TileY)
+{
+    std::lock_guard<std::mutex> l_Guard(m_GridPreloadLock);
+
+    auto l_Iter = m_GridPreloads.find(p_TileX * MAX_NUMBER_OF_GRIDS + p_TileY);
+    if (l_Iter == m_GridPreloads.end())
+        return GridPreloadRequestPtr();
+
+    GridPreloadRequestPtr l_Preload = l_Iter->second;
+    m_GridPreloads.erase(l_Iter);
+    return l_Preload;
+}
+
+void Map::PreloadGridsAround(float p_X, float p_Y, float p_Radius)
+{
+    GridCoord l_Low  = JadeCore::ComputeGridCoord(p_X - p_Radius, p_Y - p_Radius).normalize();
+    GridCoord l_High = JadeCore::ComputeGridCoord(p_X + p_Radius, p_Y + p_Radius).normalize();
+
+    for (uint32 l_X = l_Low.x_coord; l_X <= l_High.x_coord; ++l_X)
+    {
+        for (uint32 l_Y = l_Low.y_coord; l_Y <= l_High.y_coord; ++l_Y)
+        {
+            if (getNGrid(l_X, l_Y))
+                continue;
+
+            /// Terrain tiles are indexed the other way around, see EnsureGridCreated
+            uint32 l_TileX = (MAX_NUMBER_OF_GRIDS - 1) - l_X;
+            uint32 l_TileY = (MAX_NUMBER_OF_GRIDS - 1) - l_Y;
+
+            std::lock_guard<std::mutex> l_Guard(m_GridPreloadLock);
+
+            GridPreloadRequestPtr& l_Preload = m_GridPreloads[l_TileX * MAX_NUMBER_OF_GRIDS + l_TileY];
+            if (!l_Preload)
+            {
+                VMAP::IVMapManager* l_VMapMgr = VMAP::VMapFactory::createOrGetVMapManager();
+                l_Preload = std::make_shared<GridPreloadRequest>(GetId(), l_TileX, l_TileY, sWorld->GetDataPath(), l_VMapMgr->isMapLoadingEnabled(), DisableMgr::IsPathfindingEnabled(GetId()));
+                sGridPreloader->Submit(l_Preload);
+            }
+
+            l_Preload->LastRequestTime = getMSTime();
+        }
+    }
+}
+
+void Map::UpdateGridPreload()
+{
+    /// Instances grids are created through their parent map and dungeons are small, the hitches are in the open world
+    if (i_InstanceId != 0 || Instanceable())
+        return;
+
+    TICK_PROFILE_ZONE_ARG("Map::UpdateGridPreload", GetId());
+
+    uint32 l_LookAhead = sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD) * IN_MILLISECONDS;
+    float l_Radius = GetVisibilityRange();
+    std::vector<TaxiPathNodeEntry const*> l_Nodes;
+
+    for (MapRefManager::iterator l_Iter = m_mapRefManager.begin(); l_Iter != m_mapRefManager.end(); ++l_Iter)
+    {
+        Player* l_Player = l_Iter->getSource();
+        if (!l_Player || !l_Player->IsInWorld())
+            continue;
+
+        /// Taxi flights, the remaining path is known
+        if (l_Player->isInFlight())
+        {
+            if (l_Player->GetMotionMaster()->GetCurrentMovementGeneratorType() != FLIGHT_MOTION_TYPE)
+                continue;
+
+            l_Nodes.clear();
+            static_cast<FlightPathMovementGenerator*>(l_Player->GetMotionMaster()->top())->GetNodesAhead(l_LookAhead, l_Nodes);
+
+            for (TaxiPathNodeEntry const* l_Node : l_Nodes)
+            {
+                if (l_Node->MapID == GetId())
+                    PreloadGridsAround(l_Node->x, l_Node->y, l_Radius);
+            }
+
+            continue;
+        }
+
+        /// Free movement, extrapolate the current heading at full speed
+        if (!l_Player->m_movementInfo.HasMovementFlag(MOVEMENTFLAG_FORWARD))
+            continue;
+
+        float l_Distance = l_Player->GetSpeed(l_Player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN) * l_LookAhead / IN_MILLISECONDS;
+        float l_Cos = std::cos(l_Player->GetOrientation());
+        float l_Sin = std::sin(l_Player->GetOrientation());
+
+        /// Half grid steps, the visibility radius covers what is between them
+        for (float l_Step = SIZE_OF_GRIDS / 2.0f; ; l_Step += SIZE_OF_GRIDS / 2.0f)
+        {
+            float l_StepDistance = std::min(l_Step, l_Distance);
+            PreloadGridsAround(l_Player->GetPositionX() + l_StepDistance * l_Cos, l_Player->GetPositionY() + l_StepDistance * l_Sin, l_Radius);
+
+            if (l_Step >= l_Distance)
+                break;
+        }
+    }
+
+    /// Players turned away, give the memory and the vmap model references back
+    uint32 l_Now = getMSTime();
+
+    std::lock_guard<std::mutex> l_Guard(m_GridPreloadLock);
+
+    for (auto l_Iter = m_GridPreloads.begin(); l_Iter != m_GridPreloads.end();)
+    {
+        if (getMSTimeDiff(l_Iter->second->LastRequestTime, l_Now) < GRID_PRELOAD_EXPIRY)
+        {
+            ++l_Iter;
+            continue;
+        }
+
+        sGridPreloader->OnPreloadWasted();
+        l_Iter = m_GridPreloads.erase(l_Iter);
     }
 }
 
@@ -237,6 +401,10 @@ m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsGameObjectUpdateIte
 i_gridExpiry(expiry), i_scriptLock(false)
 {
     m_parentMap = (_parent ? _parent : this);
+    m_PathCache = new PathCache(sWorld->getIntConfig(CONFIG_PATHFINDING_CACHE_SIZE));
+    m_FlowFieldMgr = new FlowFieldMgr();
+    m_VignetteRegistry = new Vignette::Registry(this);
+    m_GridPreloadTimer = 0;
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
     {
         for (unsigned int j=0; j < MAX_NUMBER_OF_GRIDS; ++j)
@@ -615,6 +783,8 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<JadeCore::Ob
 
 void Map::Update(const uint32 t_diff)
 {
+    TICK_PROFILE_ZONE_ARG("Map::Update", GetId());
+
 #ifdef CROSS
     SetUpdating(true);
 #endif
@@ -622,6 +792,21 @@ void Map::Update(const uint32 t_diff)
     uint32 l_Time = getMSTime();
 
     _dynamicTree.update(t_diff);
+    m_FlowFieldMgr->Update(t_diff);
+
+    if (sGridPreloader->IsEnabled())
+    {
+        if (m_GridPreloadTimer <= t_diff)
+        {
+            m_GridPreloadTimer = sWorld->getIntConfig(CONFIG_GRID_PRELOAD_INTERVAL);
+            UpdateGridPreload();
+        }
+        else
+            m_GridPreloadTimer -= t_diff;
+    }
+
+    sWildBattlePetMgr->Update(this, t_diff);
+
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -654,6 +839,9 @@ void Map::Update(const uint32 t_diff)
     // for pets
     TypeContainerVisitor<JadeCore::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
+    /// Vignette sources are looked up once for all the players, before they consume the change set
+    m_VignetteRegistry->Update();
+
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -736,6 +924,7 @@ void Map::Update(const uint32 t_diff)
 
 void Map::RemovePlayerFromMap(Player* player, bool remove)
 {
+    player->GetVignetteMgr().DetachFromRegistry();
     player->RemoveFromWorld();
     SendRemoveTransports(player);
     sOutdoorPvPMgr->HandlePlayerLeaveMap(player, GetId());
@@ -1269,6 +1458,8 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
     const uint32 x = ngrid.getX();
     const uint32 y = ngrid.getY();
 
+    GridReclaimRequest* l_Reclaim = nullptr;
+
     {
         if (!unloadAll)
         {
@@ -1282,6 +1473,10 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
 
         sLog->outDebug(LOG_FILTER_MAPS, "Unloading grid[%u, %u] for map %u", x, y, GetId());
 
+        /// Map destruction and shutdown unload everything synchronously
+        if (!unloadAll && sGridReclaimer->IsEnabled())
+            l_Reclaim = new GridReclaimRequest();
+
         if (!unloadAll)
         {
             // Finish creature moves, remove and delete all creatures with delayed remove before moving to respawn grids
@@ -1307,6 +1502,13 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
 
         RemoveAllObjectsInRemoveList();
 
+        if (l_Reclaim)
+        {
+            ObjectGridDetacher worker(l_Reclaim->Objects);
+            TypeContainerVisitor<ObjectGridDetacher, GridTypeMapContainer> visitor(worker);
+            ngrid.VisitAllGrids(visitor);
+        }
+        else
         {
             ObjectGridUnloader worker;
             TypeContainerVisitor<ObjectGridUnloader, GridTypeMapContainer> visitor(worker);
@@ -1326,13 +1528,22 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
     {
         if (i_InstanceId == 0)
         {
-            if (GridMaps[gx][gy])
+            VMAP::VMapManager2* l_VMapMgr = l_Reclaim ? dynamic_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager()) : nullptr;
+
+            if (l_Reclaim)
+                l_Reclaim->Terrain = GridMaps[gx][gy];
+            else if (GridMaps[gx][gy])
             {
                 GridMaps[gx][gy]->unloadData();
                 delete GridMaps[gx][gy];
             }
 
-            VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
+            /// The tile leaves the tree now, a reload of the grid before the reclaimer runs must not find it loaded
+            if (l_VMapMgr)
+                l_VMapMgr->unloadMapKeepModels(GetId(), gx, gy, l_Reclaim->VMapModels);
+            else
+                VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
+
             MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gx, gy);
         }
         else
@@ -1340,6 +1551,10 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
 
         GridMaps[gx][gy] = NULL;
     }
+
+    if (l_Reclaim)
+        sGridReclaimer->Submit(l_Reclaim);
+
     sLog->outDebug(LOG_FILTER_MAPS, "Unloading grid[%u, %u] for map %u finished", x, y, GetId());
     return true;
 }
@@ -2989,7 +3204,10 @@ void InstanceMap::Update(const uint32 t_diff)
     Map::Update(t_diff);
 
     if (i_data)
+    {
+        TICK_PROFILE_ZONE_ARG("InstanceScript::Update", GetId());
         i_data->Update(t_diff);
+    }
 }
 
 void InstanceMap::RemovePlayerFromMap(Player* p_Player, bool p_Remove)
@@ -20,6 +20,7 @@
 #include "MapRefManager.h"
 #include "DynamicTree.h"
 #include "GameObjectModel.h"
+#include "GridPreloader.h"
 #include "Common.h"
 
 #include <bitset>
@@ -41,6 +42,9 @@ class Battleground;
 class MapInstanced;
 class InstanceMap;
 class Transport;
+class PathCache;
+class FlowFieldMgr;
+namespace Vignette { class Registry; }
 namespace JadeCore { struct ObjectUpdater; }
 
 struct ScriptAction
@@ -529,7 +533,19 @@ class Map : public GridRefManager<NGridType>
         void RemoveScriptedCollisionGameObject(uint64 p_Guid) { m_ScriptedCollisionGobs.erase(p_Guid); }
         bool CollideWithScriptedGameObject(float p_X, float p_Y, float p_Z, float* p_OutZ = nullptr) const;
 
+        /// Poly corridors shared by every PathGenerator of this map
+        PathCache* GetPathCache() const { return m_PathCache; }
+        /// Flow fields shared by the creatures chasing a same target on this map
+        FlowFieldMgr* GetFlowFieldMgr() const { return m_FlowFieldMgr; }
+        /// Creatures followed by the vignettes of the players of this map
+        Vignette::Registry* GetVignetteRegistry() const { return m_VignetteRegistry; }
+
     private:
+        /// Predictive terrain loading, see GridPreloader
+        void UpdateGridPreload();
+        void PreloadGridsAround(float p_X, float p_Y, float p_Radius);
+        GridPreloadRequestPtr TakeGridPreload(int p_TileX, int p_TileY);
+
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
         void LoadMap(int gx, int gy, bool reload = false);
@@ -671,6 +687,14 @@ class Map : public GridRefManager<NGridType>
 
         std::unordered_map<uint32 /*dbGUID*/, time_t> _creatureRespawnTimes;
         std::unordered_map<uint32 /*dbGUID*/, time_t> _goRespawnTimes;
+
+        PathCache* m_PathCache;
+        FlowFieldMgr* m_FlowFieldMgr;
+        Vignette::Registry* m_VignetteRegistry;
+
+        std::unordered_map<uint32, GridPreloadRequestPtr> m_GridPreloads;   ///< Keyed by terrain tile, x * MAX_NUMBER_OF_GRIDS + y
+        std::mutex m_GridPreloadLock;                                       ///< Base maps grids are also created from their instances threads
+        uint32 m_GridPreloadTimer;
 };
 
 enum InstanceResetMethod
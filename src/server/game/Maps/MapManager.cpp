@@ -24,6 +24,9 @@
 #include "WorldPacket.h"
 #include "Group.h"
 #include "Common.h"
+#include "PathfindingService.h"
+#include "GridPreloader.h"
+#include "GridReclaimer.h"
 
 extern GridState* si_GridStates[];                          // debugging code, should be deleted some day
 
@@ -52,6 +55,15 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (sWorld->getBoolConfig(CONFIG_PATHFINDING_ASYNC_ENABLE) && sWorld->getIntConfig(CONFIG_PATHFINDING_ASYNC_THREADS) > 0)
+        sPathfindingService->Initialize(sWorld->getIntConfig(CONFIG_PATHFINDING_ASYNC_THREADS));
+
+    if (sWorld->getBoolConfig(CONFIG_GRID_PRELOAD_ENABLE) && sWorld->getIntConfig(CONFIG_GRID_PRELOAD_THREADS) > 0)
+        sGridPreloader->Initialize(sWorld->getIntConfig(CONFIG_GRID_PRELOAD_THREADS));
+
+    if (sWorld->getBoolConfig(CONFIG_GRID_RECLAIM_ENABLE))
+        sGridReclaimer->Initialize(sWorld->getIntConfig(CONFIG_GRID_RECLAIM_OBJECTS_PER_TICK), sWorld->getIntConfig(CONFIG_INTERVAL_MAPUPDATE));
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -367,6 +379,9 @@ bool MapManager::IsValidMAP(uint32 mapid, bool startUp)
 
 void MapManager::UnloadAll()
 {
+    /// Objects of grids already unloaded go before their maps
+    sGridReclaimer->Shutdown();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end();)
     {
         iter->second->UnloadAll();
@@ -377,6 +392,9 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    sPathfindingService->Shutdown();
+    sGridPreloader->Shutdown();
+
     Map::DeleteStateMachine();
 }
 
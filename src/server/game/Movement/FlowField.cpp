@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FlowField.h"
+#include "Unit.h"
+#include "Timer.h"
+#include "DetourCommon.h"
+
+namespace
+{
+    void GetPolyCenter(dtMeshTile const* p_Tile, dtPoly const* p_Poly, float* p_Center)
+    {
+        dtVset(p_Center, 0.0f, 0.0f, 0.0f);
+        for (uint32 l_I = 0; l_I < p_Poly->vertCount; ++l_I)
+            dtVadd(p_Center, p_Center, &p_Tile->verts[p_Poly->verts[l_I] * 3]);
+
+        if (p_Poly->vertCount)
+            dtVscale(p_Center, p_Center, 1.0f / float(p_Poly->vertCount));
+    }
+}
+
+void FlowField::Build(dtNavMesh const* p_NavMesh, dtQueryFilter const& p_Filter, dtPolyRef p_RootPoly)
+{
+    m_RootPoly = p_RootPoly;
+    m_Nodes.clear();
+
+    typedef std::pair<float, dtPolyRef> OpenNode;
+    std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>> l_OpenList;
+
+    Node l_Root;
+    l_Root.Parent = 0;
+    l_Root.Cost = 0.0f;
+    m_Nodes[p_RootPoly] = l_Root;
+    l_OpenList.push(OpenNode(0.0f, p_RootPoly));
+
+    while (!l_OpenList.empty())
+    {
+        OpenNode l_Current = l_OpenList.top();
+        l_OpenList.pop();
+
+        /// Stale entry, the polygon has been reached by a cheaper way meanwhile
+        if (l_Current.first > m_Nodes[l_Current.second].Cost)
+            continue;
+
+        dtMeshTile const* l_Tile = nullptr;
+        dtPoly const* l_Poly = nullptr;
+        p_NavMesh->getTileAndPolyByRefUnsafe(l_Current.second, &l_Tile, &l_Poly);
+
+        float l_Center[3];
+        GetPolyCenter(l_Tile, l_Poly, l_Center);
+
+        for (uint32 l_Link = l_Poly->firstLink; l_Link != DT_NULL_LINK; l_Link = l_Tile->links[l_Link].next)
+        {
+            dtPolyRef l_NeighbourRef = l_Tile->links[l_Link].ref;
+            if (!l_NeighbourRef)
+                continue;
+
+            dtMeshTile const* l_NeighbourTile = nullptr;
+            dtPoly const* l_NeighbourPoly = nullptr;
+            p_NavMesh->getTileAndPolyByRefUnsafe(l_NeighbourRef, &l_NeighbourTile, &l_NeighbourPoly);
+
+            if (!p_Filter.passFilter(l_NeighbourRef, l_NeighbourTile, l_NeighbourPoly))
+                continue;
+
+            float l_NeighbourCenter[3];
+            GetPolyCenter(l_NeighbourTile, l_NeighbourPoly, l_NeighbourCenter);
+
+            float l_Cost = l_Current.first + dtVdist(l_Center, l_NeighbourCenter) * p_Filter.getAreaCost(l_NeighbourPoly->getArea());
+            if (l_Cost > FLOW_FIELD_MAX_COST)
+                continue;
+
+            auto l_Itr = m_Nodes.find(l_NeighbourRef);
+            if (l_Itr != m_Nodes.end())
+            {
+                if (l_Itr->second.Cost <= l_Cost)
+                    continue;
+            }
+            else if (m_Nodes.size() >= FLOW_FIELD_MAX_NODES)
+                continue;
+
+            Node& l_Node = m_Nodes[l_NeighbourRef];
+            l_Node.Parent = l_Current.second;
+            l_Node.Cost = l_Cost;
+            l_OpenList.push(OpenNode(l_Cost, l_NeighbourRef));
+        }
+    }
+}
+
+bool FlowField::BuildCorridor(dtPolyRef p_StartPoly, dtPolyRef p_EndPoly, dtPolyRef* p_Path, uint32& p_PathLength, uint32 p_MaxPathLength) const
+{
+    p_PathLength = 0;
+
+    /// The end polygon is the target's one or one of its neighbours in the field
+    auto l_EndItr = m_Nodes.find(p_EndPoly);
+    if (l_EndItr == m_Nodes.end() || (p_EndPoly != m_RootPoly && l_EndItr->second.Parent != m_RootPoly))
+        return false;
+
+    dtPolyRef l_Current = p_StartPoly;
+    while (p_PathLength < p_MaxPathLength)
+    {
+        auto l_Itr = m_Nodes.find(l_Current);
+        if (l_Itr == m_Nodes.end())
+            return false;
+
+        p_Path[p_PathLength++] = l_Current;
+
+        if (l_Current == p_EndPoly)
+            return true;
+
+        if (l_Current == m_RootPoly)
+        {
+            /// Last step from the target polygon to the chaser destination polygon
+            if (p_PathLength >= p_MaxPathLength)
+                return false;
+
+            p_Path[p_PathLength++] = p_EndPoly;
+            return true;
+        }
+
+        l_Current = l_Itr->second.Parent;
+    }
+
+    return false;
+}
+
+FlowFieldMgr::FlowFieldMgr()
+    : m_ExpireTimer(FLOW_FIELD_EXPIRE_TIME), m_Builds(0), m_Hits(0)
+{
+}
+
+FlowFieldMgr::~FlowFieldMgr()
+{
+    for (auto& l_Pair : m_Fields)
+        delete l_Pair.second;
+}
+
+bool FlowFieldMgr::FindCorridor(Unit const* p_Target, dtNavMeshQuery const* p_Query, dtQueryFilter const& p_Filter, uint32 p_TileGeneration,
+                                dtPolyRef p_StartPoly, dtPolyRef p_EndPoly, dtPolyRef* p_Path, uint32& p_PathLength, uint32 p_MaxPathLength)
+{
+    FieldKey l_Key(p_Target->GetGUID(), (uint32(p_Filter.getIncludeFlags()) << 16) | p_Filter.getExcludeFlags());
+
+    FlowField*& l_Field = m_Fields[l_Key];
+    if (!l_Field)
+        l_Field = new FlowField();
+
+    l_Field->m_LastUseTime = getMSTime();
+
+    float l_TargetPoint[3] = { p_Target->GetPositionY(), p_Target->GetPositionZ(), p_Target->GetPositionX() };
+
+    /// Only resolve the target polygon again once it moved a bit, all chasers of a tick share the lookup
+    bool l_NeedBuild = !l_Field->GetRootPoly() || l_Field->m_TileGeneration != p_TileGeneration;
+    if (l_NeedBuild || dtVdistSqr(l_TargetPoint, l_Field->m_TargetPoint) > 1.0f)
+    {
+        float l_Extents[3] = { 3.0f, 5.0f, 3.0f };
+        float l_ClosestPoint[3];
+        dtPolyRef l_TargetPoly = 0;
+        if (dtStatusFailed(p_Query->findNearestPoly(l_TargetPoint, l_Extents, &p_Filter, &l_TargetPoly, l_ClosestPoint)) || !l_TargetPoly)
+            return false;
+
+        dtVcopy(l_Field->m_TargetPoint, l_TargetPoint);
+        l_NeedBuild = l_NeedBuild || l_TargetPoly != l_Field->GetRootPoly();
+
+        if (l_NeedBuild)
+        {
+            l_Field->Build(p_Query->getAttachedNavMesh(), p_Filter, l_TargetPoly);
+            l_Field->m_TileGeneration = p_TileGeneration;
+            ++m_Builds;
+        }
+    }
+
+    if (!l_Field->BuildCorridor(p_StartPoly, p_EndPoly, p_Path, p_PathLength, p_MaxPathLength))
+        return false;
+
+    ++m_Hits;
+    return true;
+}
+
+void FlowFieldMgr::Update(uint32 p_Diff)
+{
+    if (m_ExpireTimer > p_Diff)
+    {
+        m_ExpireTimer -= p_Diff;
+        return;
+    }
+
+    m_ExpireTimer = FLOW_FIELD_EXPIRE_TIME;
+
+    uint32 l_Now = getMSTime();
+    for (FieldMap::iterator l_Itr = m_Fields.begin(); l_Itr != m_Fields.end();)
+    {
+        if (getMSTimeDiff(l_Itr->second->m_LastUseTime, l_Now) > FLOW_FIELD_EXPIRE_TIME)
+        {
+            delete l_Itr->second;
+            l_Itr = m_Fields.erase(l_Itr);
+        }
+        else
+            ++l_Itr;
+    }
+}
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _FLOW_FIELD_H
+#define _FLOW_FIELD_H
+
+#include "Common.h"
+#include "DetourNavMesh.h"
+#include "DetourNavMeshQuery.h"
+
+class Unit;
+
+// max polygons expanded around a target, chasers outside of the field use a regular path search
+#define FLOW_FIELD_MAX_NODES        4096
+// max travel cost (~yards) from the target covered by a field
+#define FLOW_FIELD_MAX_COST         200.0f
+// fields not used by any chaser for this long are released
+#define FLOW_FIELD_EXPIRE_TIME      (10 * IN_MILLISECONDS)
+
+/// Distance field over the navmesh polygons around a target
+/// Every polygon knows its neighbour one step closer to the target, so every chaser
+/// walking the field gets its poly corridor without its own path search
+class FlowField
+{
+    public:
+        FlowField() : m_TileGeneration(0), m_LastUseTime(0), m_RootPoly(0)
+        {
+            memset(m_TargetPoint, 0, sizeof(m_TargetPoint));
+        }
+
+        /// Dijkstra expansion from p_RootPoly over every polygon passing p_Filter
+        void Build(dtNavMesh const* p_NavMesh, dtQueryFilter const& p_Filter, dtPolyRef p_RootPoly);
+
+        /// Corridor from p_StartPoly toward the root, stopping at p_EndPoly if met on the way
+        /// @return false if p_StartPoly is outside of the field or the corridor does not end on p_EndPoly
+        bool BuildCorridor(dtPolyRef p_StartPoly, dtPolyRef p_EndPoly, dtPolyRef* p_Path, uint32& p_PathLength, uint32 p_MaxPathLength) const;
+
+        dtPolyRef GetRootPoly() const { return m_RootPoly; }
+        uint32 GetNodeCount() const { return uint32(m_Nodes.size()); }
+
+        float m_TargetPoint[3];     ///< Last target position used to resolve m_RootPoly, detour coordinates
+        uint32 m_TileGeneration;
+        uint32 m_LastUseTime;
+
+    private:
+        struct Node
+        {
+            dtPolyRef Parent;
+            float Cost;
+        };
+
+        dtPolyRef m_RootPoly;
+        std::unordered_map<dtPolyRef, Node> m_Nodes;
+};
+
+/// Per map registry of the flow fields shared by the chasers of a same target
+/// Only accessed from the thread updating the owning map
+class FlowFieldMgr
+{
+    public:
+        FlowFieldMgr();
+        ~FlowFieldMgr();
+
+        /// Fill p_Path with the corridor from p_StartPoly to p_EndPoly using the field of p_Target
+        /// The field is (re)built only when the target moved to another polygon or tiles changed
+        bool FindCorridor(Unit const* p_Target, dtNavMeshQuery const* p_Query, dtQueryFilter const& p_Filter, uint32 p_TileGeneration,
+                          dtPolyRef p_StartPoly, dtPolyRef p_EndPoly, dtPolyRef* p_Path, uint32& p_PathLength, uint32 p_MaxPathLength);
+
+        /// Release the fields nobody walked recently
+        void Update(uint32 p_Diff);
+
+        uint32 GetFieldCount() const { return uint32(m_Fields.size()); }
+        uint64 GetBuildCount() const { return m_Builds; }
+        uint64 GetHitCount() const { return m_Hits; }
+
+    private:
+        /// Target guid and filter flags, walkers and swimmers do not share a field
+        typedef std::pair<uint64, uint32> FieldKey;
+
+        struct FieldKeyHash
+        {
+            std::size_t operator()(FieldKey const& p_Key) const
+            {
+                return std::hash<uint64>()(p_Key.first) ^ (std::hash<uint32>()(p_Key.second) << 1);
+            }
+        };
+
+        typedef std::unordered_map<FieldKey, FlowField*, FieldKeyHash> FieldMap;
+
+        FieldMap m_Fields;
+        uint32 m_ExpireTimer;
+        uint64 m_Builds;
+        uint64 m_Hits;
+};
+
+#endif
@@ -149,16 +149,27 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     }
 
     if (!i_path)
+    {
         i_path = new PathGenerator(owner);
 
+        // chasing creatures can wait a tick for their path, long searches are done off the map thread
+        if (owner->GetTypeId() == TYPEID_UNIT && sWorld->getBoolConfig(CONFIG_PATHFINDING_ASYNC_ENABLE))
+            i_path->SetAsync(true);
+    }
+
     // allow pets to use shortcut if no path found when following their master
     bool forceDest = (owner->GetTypeId() == TYPEID_UNIT && owner->ToCreature()->isPet()
         && owner->HasUnitState(UNIT_STATE_FOLLOW));
 
+    // large groups chasing the same target share its flow field instead of searching their own path
+    bool useFlowField = owner->GetTypeId() == TYPEID_UNIT && (owner->ToCreature()->GetCreatureTemplate()->flags_extra & CREATURE_FLAG_EXTRA_FLOW_FIELD_PATHING);
+    i_path->SetFlowFieldTarget(useFlowField ? i_target.getTarget() : NULL);
+
     bool result = i_path->CalculatePath(x, y, z, forceDest);
+    i_path->SetFlowFieldTarget(NULL);
     if (!result || (i_path->GetPathType() & PATHFIND_NOPATH))
     {
-        // Cant reach target
+        // Cant reach target, or path still computed by the pathfinding service
         i_recalculateTravel = true;
         return;
     }
@@ -442,3 +442,20 @@ void FlightPathMovementGenerator::PreloadEndGrid()
     else
         sLog->outDebug(LOG_FILTER_GENERAL, "Unable to determine map to preload flightmaster grid");
 }
+
+void FlightPathMovementGenerator::GetNodesAhead(uint32 p_Time, std::vector<TaxiPathNodeEntry const*>& p_Nodes) const
+{
+    float l_Distance = PLAYER_FLIGHT_SPEED * p_Time / IN_MILLISECONDS;
+
+    for (uint32 l_I = i_currentNode + 1; l_I < i_path.size() && l_Distance > 0.0f; ++l_I)
+    {
+        TaxiPathNodeEntry const* l_Previous = i_path[l_I - 1];
+        TaxiPathNodeEntry const* l_Node     = i_path[l_I];
+
+        /// Map change nodes are teleports, they don't consume flight time
+        if (l_Node->MapID == l_Previous->MapID)
+            l_Distance -= std::sqrt(std::pow(l_Node->x - l_Previous->x, 2) + std::pow(l_Node->y - l_Previous->y, 2));
+
+        p_Nodes.push_back(l_Node);
+    }
+}
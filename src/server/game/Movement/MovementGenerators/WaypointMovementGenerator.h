@@ -123,6 +123,9 @@ class FlightPathMovementGenerator : public MovementGeneratorMedium< Player, Flig
         void InitEndGridInfo();
         void PreloadEndGrid();
 
+        /// Nodes of the remaining path reached within p_Time milliseconds, used by the grid preloader
+        void GetNodesAhead(uint32 p_Time, std::vector<TaxiPathNodeEntry const*>& p_Nodes) const;
+
     private:
 
         float _endGridX;                            //! X coord of last node location
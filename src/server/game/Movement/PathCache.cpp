@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "PathCache.h"
+
+uint32 PathCacheKey::HashTerrainSwaps(MMAP::TerrainSet const& p_Swaps)
+{
+    /// FNV-1a over the sorted swap map ids
+    uint32 l_Hash = 2166136261u;
+    for (uint32 l_Swap : p_Swaps)
+    {
+        for (uint32 l_I = 0; l_I < 4; ++l_I)
+        {
+            l_Hash ^= (l_Swap >> (l_I * 8)) & 0xFF;
+            l_Hash *= 16777619u;
+        }
+    }
+
+    return l_Hash;
+}
+
+PathCache::PathCache(uint32 p_MaxEntries)
+    : m_MaxEntries(p_MaxEntries), m_TileGeneration(0), m_Hits(0), m_Misses(0)
+{
+}
+
+void PathCache::CheckGeneration(uint32 p_TileGeneration)
+{
+    if (m_TileGeneration == p_TileGeneration)
+        return;
+
+    /// A tile has been added or removed since the corridors were computed, poly refs may be stale
+    Clear();
+    m_TileGeneration = p_TileGeneration;
+}
+
+bool PathCache::Find(PathCacheKey const& p_Key, uint32 p_TileGeneration, dtPolyRef* p_Path, uint32& p_PathLength, uint32 p_MaxPathLength)
+{
+    if (!m_MaxEntries)
+        return false;
+
+    CheckGeneration(p_TileGeneration);
+
+    EntryLookup::iterator l_Itr = m_Lookup.find(p_Key);
+    if (l_Itr == m_Lookup.end() || l_Itr->second->Path.size() > p_MaxPathLength)
+    {
+        ++m_Misses;
+        return false;
+    }
+
+    /// Move the entry in front of the list, it's now the most recently used one
+    m_Entries.splice(m_Entries.begin(), m_Entries, l_Itr->second);
+
+    std::vector<dtPolyRef> const& l_Path = l_Itr->second->Path;
+    std::copy(l_Path.begin(), l_Path.end(), p_Path);
+    p_PathLength = uint32(l_Path.size());
+
+    ++m_Hits;
+    return true;
+}
+
+void PathCache::Insert(PathCacheKey const& p_Key, uint32 p_TileGeneration, dtPolyRef const* p_Path, uint32 p_PathLength)
+{
+    if (!m_MaxEntries || !p_PathLength)
+        return;
+
+    /// Corridor computed against an older navmesh than the cached ones
+    if (p_TileGeneration < m_TileGeneration)
+        return;
+
+    CheckGeneration(p_TileGeneration);
+
+    EntryLookup::iterator l_Itr = m_Lookup.find(p_Key);
+    if (l_Itr != m_Lookup.end())
+    {
+        l_Itr->second->Path.assign(p_Path, p_Path + p_PathLength);
+        m_Entries.splice(m_Entries.begin(), m_Entries, l_Itr->second);
+        return;
+    }
+
+    if (m_Lookup.size() >= m_MaxEntries)
+    {
+        m_Lookup.erase(m_Entries.back().Key);
+        m_Entries.pop_back();
+    }
+
+    Entry l_Entry;
+    l_Entry.Key = p_Key;
+    l_Entry.Path.assign(p_Path, p_Path + p_PathLength);
+
+    m_Entries.push_front(l_Entry);
+    m_Lookup[p_Key] = m_Entries.begin();
+}
+
+void PathCache::Clear()
+{
+    m_Entries.clear();
+    m_Lookup.clear();
+}
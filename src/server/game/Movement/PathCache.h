@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _PATH_CACHE_H
+#define _PATH_CACHE_H
+
+#include "Common.h"
+#include "DetourNavMesh.h"
+#include "MMapManager.h"
+
+struct PathCacheKey
+{
+    PathCacheKey() : StartPoly(0), EndPoly(0), IncludeFlags(0), ExcludeFlags(0), TerrainSwapHash(0) { }
+    PathCacheKey(dtPolyRef p_StartPoly, dtPolyRef p_EndPoly, uint16 p_IncludeFlags, uint16 p_ExcludeFlags, uint32 p_TerrainSwapHash)
+        : StartPoly(p_StartPoly), EndPoly(p_EndPoly), IncludeFlags(p_IncludeFlags), ExcludeFlags(p_ExcludeFlags), TerrainSwapHash(p_TerrainSwapHash) { }
+
+    bool operator==(PathCacheKey const& p_Other) const
+    {
+        return StartPoly == p_Other.StartPoly && EndPoly == p_Other.EndPoly
+            && IncludeFlags == p_Other.IncludeFlags && ExcludeFlags == p_Other.ExcludeFlags
+            && TerrainSwapHash == p_Other.TerrainSwapHash;
+    }
+
+    /// Hash of a terrain swap set, two units with the same swaps share their cached paths
+    static uint32 HashTerrainSwaps(MMAP::TerrainSet const& p_Swaps);
+
+    dtPolyRef StartPoly;
+    dtPolyRef EndPoly;
+    uint16 IncludeFlags;
+    uint16 ExcludeFlags;
+    uint32 TerrainSwapHash;
+};
+
+struct PathCacheKeyHash
+{
+    std::size_t operator()(PathCacheKey const& p_Key) const
+    {
+        std::size_t l_Hash = std::hash<uint64>()(p_Key.StartPoly);
+        l_Hash ^= std::hash<uint64>()(p_Key.EndPoly) + 0x9E3779B9 + (l_Hash << 6) + (l_Hash >> 2);
+        l_Hash ^= std::hash<uint32>()((uint32(p_Key.IncludeFlags) << 16) | p_Key.ExcludeFlags) + 0x9E3779B9 + (l_Hash << 6) + (l_Hash >> 2);
+        l_Hash ^= std::hash<uint32>()(p_Key.TerrainSwapHash) + 0x9E3779B9 + (l_Hash << 6) + (l_Hash >> 2);
+        return l_Hash;
+    }
+};
+
+/// Per map LRU cache of poly corridors computed by dtNavMeshQuery::findPath
+/// Only the corridor is stored, point paths still depend on the exact start and end positions
+/// Not thread safe, only accessed from the thread updating the owning map
+class PathCache
+{
+    public:
+        explicit PathCache(uint32 p_MaxEntries);
+
+        /// Copy the cached corridor for this key into p_Path, return false on miss
+        /// @p_TileGeneration : current MMapManager tile generation of the map, the whole cache is dropped when it changed
+        bool Find(PathCacheKey const& p_Key, uint32 p_TileGeneration, dtPolyRef* p_Path, uint32& p_PathLength, uint32 p_MaxPathLength);
+
+        /// Store a corridor, evicting the least recently used one if the cache is full
+        /// Corridors of a tile generation older than the cached ones are ignored
+        void Insert(PathCacheKey const& p_Key, uint32 p_TileGeneration, dtPolyRef const* p_Path, uint32 p_PathLength);
+
+        void Clear();
+
+        uint32 GetSize() const { return uint32(m_Lookup.size()); }
+        uint32 GetMaxSize() const { return m_MaxEntries; }
+        uint64 GetHits() const { return m_Hits; }
+        uint64 GetMisses() const { return m_Misses; }
+
+    private:
+        void CheckGeneration(uint32 p_TileGeneration);
+
+        struct Entry
+        {
+            PathCacheKey Key;
+            std::vector<dtPolyRef> Path;
+        };
+
+        typedef std::list<Entry> EntryList;
+        typedef std::unordered_map<PathCacheKey, EntryList::iterator, PathCacheKeyHash> EntryLookup;
+
+        EntryList m_Entries;        ///< Most recently used first
+        EntryLookup m_Lookup;
+        uint32 m_MaxEntries;
+        uint32 m_TileGeneration;
+        uint64 m_Hits;
+        uint64 m_Misses;
+};
+
+#endif
@@ -15,11 +15,15 @@
 #include "DisableMgr.h"
 #include "DetourCommon.h"
 #include "DetourNavMeshQuery.h"
+#include "PathCache.h"
+#include "FlowField.h"
+#include "PathfindingService.h"
 
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(const Unit* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _straightLine(false),
+    _async(false), _pathPending(false), _terrainSwapHash(0), _flowFieldTarget(NULL),
     _endPosition(G3D::Vector3::zero()), _sourceUnit(owner), _navMesh(NULL),
     _navMeshQuery(NULL)
 {
@@ -31,6 +35,7 @@ PathGenerator::PathGenerator(const Unit* owner) :
     if (DisableMgr::IsPathfindingEnabled(mapId))
     {
         MMAP::TerrainSet l_TerrainSwaps;
+        _terrainSwapHash = PathCacheKey::HashTerrainSwaps(l_TerrainSwaps);
 
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         _navMesh = mmap->GetNavMesh(mapId, l_TerrainSwaps);
@@ -61,6 +66,7 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
     _forceDestination = forceDest;
     _straightLine = straightLine;
+    _pathPending = false;
 
     //sLog->outDebug(LOG_FILTER_MAPS, "++ PathGenerator::CalculatePath() for %llu", _sourceUnit->GetGUID());
 
@@ -77,9 +83,68 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
     UpdateFilter();
 
     BuildPolyPath(start, dest);
+    return !_pathPending;
+}
+
+PathCache* PathGenerator::GetPathCache() const
+{
+    if (Map* map = _sourceUnit->FindMap())
+        return map->GetPathCache();
+
+    return nullptr;
+}
+
+uint32 PathGenerator::GetTileGeneration() const
+{
+    return MMAP::MMapFactory::createOrGetMMapManager()->GetTileGeneration(_sourceUnit->GetMapId());
+}
+
+bool PathGenerator::ConsumeAsyncRequest()
+{
+    if (!_asyncRequest || !_asyncRequest->Done)
+        return true;
+
+    PathfindingRequestPtr request = _asyncRequest;
+    _asyncRequest.reset();
+
+    if (!request->Succeeded)
+        return false;
+
+    // a tile was loaded or unloaded while the worker searched, the corridor may hold stale poly refs
+    if (request->TileGeneration != GetTileGeneration())
+        return true;
+
+    // the corridor becomes our current poly path, BuildPolyPath then cuts or extends it like any previous path
+    memcpy(_pathPolyRefs, request->Path, request->PathLength * sizeof(dtPolyRef));
+    _polyLength = request->PathLength;
+
+    if (PathCache* cache = GetPathCache())
+        cache->Insert(request->Key, request->TileGeneration, request->Path, request->PathLength);
+
     return true;
 }
 
+void PathGenerator::SubmitAsyncRequest(PathCacheKey const& key, float const* startPoint, float const* endPoint)
+{
+    _pathPending = true;
+    _type = PATHFIND_BLANK;
+
+    // same search already in flight
+    if (_asyncRequest && _asyncRequest->Key == key)
+        return;
+
+    // a request for a previous destination is simply abandoned, the worker drops it
+    _asyncRequest = std::make_shared<PathfindingRequest>();
+    _asyncRequest->MapId = _sourceUnit->GetMapId();
+    _asyncRequest->TileGeneration = GetTileGeneration();
+    _asyncRequest->Key = key;
+    _asyncRequest->Filter = _filter;
+    dtVcopy(_asyncRequest->StartPoint, startPoint);
+    dtVcopy(_asyncRequest->EndPoint, endPoint);
+
+    sPathfindingService->Submit(_asyncRequest);
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -149,6 +214,9 @@ dtPolyRef PathGenerator::GetPolyByLocation(float const* point, float* distance)
 
 void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos)
 {
+    // a finished async search replaces our previous poly path
+    bool asyncFailed = !ConsumeAsyncRequest();
+
     // *** getting start/end poly logic ***
 
     float distToStartPoly, distToEndPoly;
@@ -431,15 +499,37 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
-                            startPoly,          // start polygon
-                            endPoly,            // end polygon
-                            startPoint,         // start position
-                            endPoint,           // end position
-                            &_filter,           // polygon search filter
-                            _pathPolyRefs,     // [out] path
-                            (int*)&_polyLength,
-                            MAX_PATH_LENGTH);   // max number of polygons in output path
+            PathCacheKey key(startPoly, endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags(), _terrainSwapHash);
+            PathCache* cache = GetPathCache();
+            uint32 tileGeneration = GetTileGeneration();
+
+            FlowFieldMgr* flowFields = _flowFieldTarget && _sourceUnit->FindMap() ? _sourceUnit->FindMap()->GetFlowFieldMgr() : nullptr;
+
+            if (flowFields && flowFields->FindCorridor(_flowFieldTarget, _navMeshQuery, _filter, tileGeneration, startPoly, endPoly, _pathPolyRefs, _polyLength, MAX_PATH_LENGTH))
+                dtResult = DT_SUCCESS;
+            else if (cache && cache->Find(key, tileGeneration, _pathPolyRefs, _polyLength, MAX_PATH_LENGTH))
+                dtResult = DT_SUCCESS;
+            else if (_async && !asyncFailed && sPathfindingService->IsEnabled())
+            {
+                // result is picked up by a next CalculatePath call
+                SubmitAsyncRequest(key, startPoint, endPoint);
+                return;
+            }
+            else
+            {
+                dtResult = _navMeshQuery->findPath(
+                                startPoly,          // start polygon
+                                endPoly,            // end polygon
+                                startPoint,         // start position
+                                endPoint,           // end position
+                                &_filter,           // polygon search filter
+                                _pathPolyRefs,     // [out] path
+                                (int*)&_polyLength,
+                                MAX_PATH_LENGTH);   // max number of polygons in output path
+
+                if (cache && dtStatusSucceed(dtResult))
+                    cache->Insert(key, tileGeneration, _pathPolyRefs, _polyLength);
+            }
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -14,7 +14,14 @@
 #include "DetourNavMeshQuery.h"
 #include "MoveSplineInitArgs.h"
 
+#include <memory>
+
 class Unit;
+class PathCache;
+struct PathCacheKey;
+struct PathfindingRequest;
+
+typedef std::shared_ptr<PathfindingRequest> PathfindingRequestPtr;
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -30,7 +37,7 @@ class Unit;
 
 enum PathType
 {
-    PATHFIND_BLANK          = 0x00,   // path not built yet
+    PATHFIND_BLANK          = 0x00,   // path not built yet (or still computed by the pathfinding service)
     PATHFIND_NORMAL         = 0x01,   // normal path
     PATHFIND_SHORTCUT       = 0x02,   // travel through obstacles, terrain, air, etc (old behavior)
     PATHFIND_INCOMPLETE     = 0x04,   // we have partial path to follow - getting closer to target
@@ -46,11 +53,15 @@ class PathGenerator
         ~PathGenerator();
 
         // Calculate the path from owner to given destination
-        // return: true if new path was calculated, false otherwise (no change needed)
+        // return: true if new path was calculated, false otherwise (no change needed, or path pending in async mode)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false, bool straightLine = false);
 
         // option setters - use optional
         void SetUseStraightPath(bool useStraightPath) { _useStraightPath = useStraightPath; }
+        // when set, full path searches are handed to the pathfinding service and the result is used on a later CalculatePath call
+        void SetAsync(bool async) { _async = async; }
+        // when set, full path searches walk the flow field shared by every chaser of this target (valid for the next CalculatePath only)
+        void SetFlowFieldTarget(Unit const* target) { _flowFieldTarget = target; }
         void SetPathLengthLimit(float distance) { _pointPathLimit = std::min<uint32>(uint32(distance/SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); }
 
         // result getters
@@ -61,6 +72,7 @@ class PathGenerator
         Movement::PointsArray const& GetPath() const { return _pathPoints; }
 
         PathType GetPathType() const { return _type; }
+        bool IsPathPending() const { return _pathPending; }
 
         void ReducePathLenghtByDist(float dist); // path must be already built
 
@@ -76,6 +88,12 @@ class PathGenerator
         bool _forceDestination; // when set, we will always arrive at given point
         uint32 _pointPathLimit; // limit point path size; min(this, MAX_POINT_PATH_LENGTH)
         bool _straightLine;     // use raycast if true for a straight line path
+        bool _async;            // hand full path searches to the pathfinding service
+        bool _pathPending;      // last CalculatePath is waiting for _asyncRequest
+        uint32 _terrainSwapHash;
+
+        PathfindingRequestPtr _asyncRequest;    // in flight or finished request of the pathfinding service
+        Unit const* _flowFieldTarget;           // chased unit whose flow field is used, if any
 
         G3D::Vector3 _startPosition;        // {x, y, z} of current location
         G3D::Vector3 _endPosition;          // {x, y, z} of the destination
@@ -110,6 +128,12 @@ class PathGenerator
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
 
+        // path cache & async helpers
+        PathCache* GetPathCache() const;
+        uint32 GetTileGeneration() const;
+        bool ConsumeAsyncRequest();
+        void SubmitAsyncRequest(PathCacheKey const& key, float const* startPoint, float const* endPoint);
+
         NavTerrain GetNavTerrain(float x, float y, float z);
         void CreateFilter();
         void UpdateFilter();
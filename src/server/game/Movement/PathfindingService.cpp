@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "PathfindingService.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "Log.h"
+
+PathfindingService::PathfindingService()
+    : m_CancelationToken(false), m_Submitted(0), m_Completed(0), m_Dropped(0)
+{
+}
+
+PathfindingService::~PathfindingService()
+{
+    Shutdown();
+}
+
+void PathfindingService::Initialize(uint32 p_ThreadCount)
+{
+    if (IsEnabled())
+        return;
+
+    for (uint32 l_I = 0; l_I < p_ThreadCount; ++l_I)
+        m_WorkerThreads.push_back(std::thread(&PathfindingService::WorkerThread, this, l_I));
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Asynchronous pathfinding started with %u worker threads", p_ThreadCount);
+}
+
+void PathfindingService::Shutdown()
+{
+    if (!IsEnabled())
+        return;
+
+    m_CancelationToken = true;
+    m_Queue.Cancel();
+
+    for (std::thread& l_Thread : m_WorkerThreads)
+        l_Thread.join();
+
+    m_WorkerThreads.clear();
+}
+
+void PathfindingService::Submit(PathfindingRequestPtr const& p_Request)
+{
+    ++m_Submitted;
+    m_Queue.Push(p_Request);
+}
+
+void PathfindingService::WorkerThread(uint32 p_WorkerId)
+{
+    while (true)
+    {
+        PathfindingRequestPtr l_Request;
+
+        m_Queue.WaitAndPop(l_Request);
+
+        if (m_CancelationToken)
+            return;
+
+        if (!l_Request)
+            continue;
+
+        /// The requesting PathGenerator has been destroyed or moved on to another destination
+        if (l_Request.unique())
+        {
+            ++m_Dropped;
+            continue;
+        }
+
+        Process(*l_Request, p_WorkerId);
+        l_Request->Done = true;
+    }
+}
+
+void PathfindingService::Process(PathfindingRequest& p_Request, uint32 p_WorkerId)
+{
+    MMAP::MMapManager* l_MMap = MMAP::MMapFactory::createOrGetMMapManager();
+
+    ACE_Read_Guard<ACE_RW_Thread_Mutex> l_Guard(l_MMap->GetNavMeshLock());
+
+    /// Tiles have been (un)loaded since the poly refs were resolved, let the map thread compute it again
+    if (l_MMap->GetTileGeneration(p_Request.MapId) != p_Request.TileGeneration)
+    {
+        ++m_Dropped;
+        return;
+    }
+
+    dtNavMeshQuery const* l_Query = l_MMap->GetWorkerNavMeshQuery(p_Request.MapId, p_WorkerId);
+    if (!l_Query)
+    {
+        ++m_Dropped;
+        return;
+    }
+
+    int l_PathLength = 0;
+    dtStatus l_Result = l_Query->findPath(
+                            p_Request.Key.StartPoly,    // start polygon
+                            p_Request.Key.EndPoly,      // end polygon
+                            p_Request.StartPoint,       // start position
+                            p_Request.EndPoint,         // end position
+                            &p_Request.Filter,          // polygon search filter
+                            p_Request.Path,             // [out] path
+                            &l_PathLength,
+                            MAX_PATH_LENGTH);           // max number of polygons in output path
+
+    p_Request.PathLength = uint32(l_PathLength);
+    p_Request.Succeeded = dtStatusSucceed(l_Result) && l_PathLength > 0;
+
+    ++m_Completed;
+}
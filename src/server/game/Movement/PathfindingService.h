@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _PATHFINDING_SERVICE_H
+#define _PATHFINDING_SERVICE_H
+
+#include "Common.h"
+#include "PathCache.h"
+#include "PathGenerator.h"
+#include "ProducerConsumerQueue.h"
+
+/// Poly corridor request handed to the pathfinding workers
+/// Written by the map thread before Submit, then only by the worker until Done is set
+struct PathfindingRequest
+{
+    PathfindingRequest() : MapId(0), TileGeneration(0), PathLength(0), Done(false), Succeeded(false)
+    {
+        memset(StartPoint, 0, sizeof(StartPoint));
+        memset(EndPoint, 0, sizeof(EndPoint));
+        memset(Path, 0, sizeof(Path));
+    }
+
+    uint32 MapId;
+    uint32 TileGeneration;              ///< Tile generation the poly refs were computed on, request is dropped if it changed
+    PathCacheKey Key;
+    float StartPoint[VERTEX_SIZE];
+    float EndPoint[VERTEX_SIZE];
+    dtQueryFilter Filter;
+
+    dtPolyRef Path[MAX_PATH_LENGTH];
+    uint32 PathLength;
+    std::atomic<bool> Done;
+    bool Succeeded;
+};
+
+/// Computes findPath corridors on worker threads, each worker owning its own dtNavMeshQuery per map
+/// Results are consumed by PathGenerator on the next update of the requesting unit
+class PathfindingService
+{
+    public:
+        PathfindingService();
+        ~PathfindingService();
+
+        void Initialize(uint32 p_ThreadCount);
+        void Shutdown();
+
+        bool IsEnabled() const { return !m_WorkerThreads.empty(); }
+
+        void Submit(PathfindingRequestPtr const& p_Request);
+
+        uint64 GetSubmittedCount() const { return m_Submitted; }
+        uint64 GetCompletedCount() const { return m_Completed; }
+        uint64 GetDroppedCount() const { return m_Dropped; }
+
+    private:
+        void WorkerThread(uint32 p_WorkerId);
+        void Process(PathfindingRequest& p_Request, uint32 p_WorkerId);
+
+        ProducerConsumerQueue<PathfindingRequestPtr> m_Queue;
+        std::vector<std::thread> m_WorkerThreads;
+        std::atomic<bool> m_CancelationToken;
+
+        std::atomic<uint64> m_Submitted;
+        std::atomic<uint64> m_Completed;
+        std::atomic<uint64> m_Dropped;
+};
+
+#define sPathfindingService ACE_Singleton<PathfindingService, ACE_Null_Mutex>::instance()
+
+#endif
@@ -16,6 +16,9 @@
 #include "CellImpl.h"
 #include "DB2Stores.h"
 #include "Common.h"
+#include "TickProfiler.h"
+
+#include <chrono>
 
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
@@ -51,6 +54,10 @@ void WildBattlePetZonePools::LoadPoolTemplate(Field* l_Fields)
 
 void WildBattlePetZonePools::Populate()
 {
+    TICK_PROFILE_ZONE_ARG("WildBattlePetZonePools::Populate", ZoneID);
+
+    std::chrono::steady_clock::time_point l_Start = std::chrono::steady_clock::now();
+
     for (size_t l_I = 0; l_I < m_Templates.size(); l_I++)
     {
         WildBattlePetPoolTemplate* l_Template = &m_Templates[l_I];
@@ -87,6 +94,15 @@ void WildBattlePetZonePools::Populate()
         for (size_t l_Y = 0; l_Y < l_AvailableForReplacement.size() && l_Y < l_ToReplaceCount; l_Y++)
             ReplaceCreature(l_AvailableForReplacement[l_Y], l_Template);
     }
+
+    uint32 l_Time = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_Start).count());
+
+    ++PopulateCount;
+    PopulateTotalTime += l_Time;
+    PopulateLastTime = l_Time;
+
+    if (l_Time > PopulateMaxTime)
+        PopulateMaxTime = l_Time;
 }
 void WildBattlePetZonePools::Depopulate()
 {
@@ -286,7 +302,6 @@ void WildBattlePetZonePools::UnreplaceCreature(Creature* p_Creature, WildBattleP
 
 WildBattlePetMgr::WildBattlePetMgr()
 {
-    m_UpdateTime.SetInterval(WILDBATTLEPETMGR_UPDATE_INTERVAL);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -326,10 +341,12 @@ void WildBattlePetMgr::Load()
             continue;
         }
 
+        WildBattlePetZonePools& l_Pools = m_PoolsByMap[l_MapID].Zones[l_ZoneID];
+
         bool l_Error = false;
-        for (size_t l_I = 0; l_I < m_PoolsByMap[l_MapID][l_ZoneID].m_Templates.size(); l_I++)
+        for (size_t l_I = 0; l_I < l_Pools.m_Templates.size(); l_I++)
         {
-            if (m_PoolsByMap[l_MapID][l_ZoneID].m_Templates[l_I].Replace == l_Fields[2].GetUInt32())
+            if (l_Pools.m_Templates[l_I].Replace == l_Fields[2].GetUInt32())
             {
                 l_Error = true;
                 sLog->outError(LOG_FILTER_SERVER_LOADING, "WildBattlePetMgr::Load() zone %u already contains a replacement for creature entry %u", l_ZoneID, l_Fields[2].GetUInt32());
@@ -341,9 +358,9 @@ void WildBattlePetMgr::Load()
         if (l_Error)
             continue;
 
-        m_PoolsByMap[l_MapID][l_ZoneID].LoadPoolTemplate(l_Fields);
-        m_PoolsByMap[l_MapID][l_ZoneID].MapID   = l_MapID;
-        m_PoolsByMap[l_MapID][l_ZoneID].ZoneID  = l_ZoneID;
+        l_Pools.LoadPoolTemplate(l_Fields);
+        l_Pools.MapID   = l_MapID;
+        l_Pools.ZoneID  = l_ZoneID;
 
         ++l_Count;
     }
@@ -356,60 +373,60 @@ void WildBattlePetMgr::Load()
 
 void WildBattlePetMgr::PopulateAll()
 {
-    for (std::map<uint32, std::map<uint32, WildBattlePetZonePools> >::iterator l_It = m_PoolsByMap.begin(); l_It != m_PoolsByMap.end(); l_It++)
-        for (std::map<uint32, WildBattlePetZonePools>::iterator l_It2 = l_It->second.begin(); l_It2 != l_It->second.end(); l_It2++)
-            (*l_It2).second.Populate();
+    for (std::map<uint32, WildBattlePetMapPools>::iterator l_It = m_PoolsByMap.begin(); l_It != m_PoolsByMap.end(); l_It++)
+        PopulateMap(l_It->first);
 }
 void WildBattlePetMgr::PopulateMap(uint32 p_MapID)
 {
-    if (m_PoolsByMap.find(p_MapID) == m_PoolsByMap.end())
+    std::map<uint32, WildBattlePetMapPools>::iterator l_MapPools = m_PoolsByMap.find(p_MapID);
+    if (l_MapPools == m_PoolsByMap.end())
         return;
 
-    for (std::map<uint32, WildBattlePetZonePools>::iterator l_It = m_PoolsByMap[p_MapID].begin(); l_It != m_PoolsByMap[p_MapID].end(); l_It++)
+    for (std::map<uint32, WildBattlePetZonePools>::iterator l_It = l_MapPools->second.Zones.begin(); l_It != l_MapPools->second.Zones.end(); l_It++)
         (*l_It).second.Populate();
 }
 void WildBattlePetMgr::DepopulateMap(uint32 p_MapID)
 {
-    if (m_PoolsByMap.find(p_MapID) == m_PoolsByMap.end())
+    std::map<uint32, WildBattlePetMapPools>::iterator l_MapPools = m_PoolsByMap.find(p_MapID);
+    if (l_MapPools == m_PoolsByMap.end())
         return;
 
-    for (std::map<uint32, WildBattlePetZonePools>::iterator l_It = m_PoolsByMap[p_MapID].begin(); l_It != m_PoolsByMap[p_MapID].end(); l_It++)
+    for (std::map<uint32, WildBattlePetZonePools>::iterator l_It = l_MapPools->second.Zones.begin(); l_It != l_MapPools->second.Zones.end(); l_It++)
         (*l_It).second.Depopulate();
 }
 
 //////////////////////////////////////////////////////////////////////////
 
-void WildBattlePetMgr::OnAddToMap(Creature* p_Creature)
+WildBattlePetZonePools* WildBattlePetMgr::GetZonePools(uint32 p_MapID, uint32 p_ZoneID)
 {
-    if (!p_Creature)
-        return;
+    std::map<uint32, WildBattlePetMapPools>::iterator l_MapPools = m_PoolsByMap.find(p_MapID);
+    if (l_MapPools == m_PoolsByMap.end())
+        return nullptr;
 
-    uint32 l_ZoneID = p_Creature->GetZoneId();
-    uint32 l_MapID  = p_Creature->GetMapId();
+    std::map<uint32, WildBattlePetZonePools>::iterator l_ZonePools = l_MapPools->second.Zones.find(p_ZoneID);
+    if (l_ZonePools == l_MapPools->second.Zones.end())
+        return nullptr;
 
-    if (m_PoolsByMap.find(l_MapID) == m_PoolsByMap.end())
-        return;
+    return &l_ZonePools->second;
+}
 
-    if (m_PoolsByMap[l_MapID].find(l_ZoneID) == m_PoolsByMap[l_MapID].end())
+//////////////////////////////////////////////////////////////////////////
+
+void WildBattlePetMgr::OnAddToMap(Creature* p_Creature)
+{
+    if (!p_Creature)
         return;
 
-    m_PoolsByMap[l_MapID][l_ZoneID].OnAddToMap(p_Creature);
+    if (WildBattlePetZonePools* l_Pools = GetZonePools(p_Creature->GetMapId(), p_Creature->GetZoneId()))
+        l_Pools->OnAddToMap(p_Creature);
 }
 void WildBattlePetMgr::OnRemoveToMap(Creature* p_Creature)
 {
     if (!p_Creature)
         return;
 
-    uint32 l_ZoneID = p_Creature->GetZoneId();
-    uint32 l_MapID  = p_Creature->GetMapId();
-
-    if (m_PoolsByMap.find(l_MapID) == m_PoolsByMap.end())
-        return;
-
-    if (m_PoolsByMap[l_MapID].find(l_ZoneID) == m_PoolsByMap[l_MapID].end())
-        return;
-
-    m_PoolsByMap[l_MapID][l_ZoneID].OnRemoveToMap(p_Creature);
+    if (WildBattlePetZonePools* l_Pools = GetZonePools(p_Creature->GetMapId(), p_Creature->GetZoneId()))
+        l_Pools->OnRemoveToMap(p_Creature);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -419,17 +436,10 @@ bool WildBattlePetMgr::IsWildPet(Creature* p_Creature)
     if (!p_Creature)
         return false;
 
-    uint32 l_ZoneID = p_Creature->GetZoneId();
-    uint32 l_MapID  = p_Creature->GetMapId();
-
-    if (m_PoolsByMap.find(l_MapID) == m_PoolsByMap.end())
-        return false;
-
-    if (m_PoolsByMap[l_MapID].find(l_ZoneID) == m_PoolsByMap[l_MapID].end())
+    WildBattlePetZonePools* l_Pools = GetZonePools(p_Creature->GetMapId(), p_Creature->GetZoneId());
+    if (!l_Pools)
         return false;
 
-    WildBattlePetZonePools* l_Pools = &m_PoolsByMap[l_MapID][l_ZoneID];
-
     for (size_t l_I = 0; l_I < l_Pools->m_Templates.size(); l_I++)
     {
         if (l_Pools->m_Templates[l_I].ReplacedBattlePetInstances.find(p_Creature->GetGUID()) != l_Pools->m_Templates[l_I].ReplacedBattlePetInstances.end())
@@ -443,10 +453,7 @@ std::shared_ptr<BattlePetInstance> WildBattlePetMgr::GetWildBattlePet(Creature*
     if (!IsWildPet(p_Creature) || !p_Creature)
         return NULL;
 
-    uint32 l_ZoneID = p_Creature->GetZoneId();
-    uint32 l_MapID  = p_Creature->GetMapId();
-
-    WildBattlePetZonePools* l_Pools = &m_PoolsByMap[l_MapID][l_ZoneID];
+    WildBattlePetZonePools* l_Pools = GetZonePools(p_Creature->GetMapId(), p_Creature->GetZoneId());
 
     for (size_t l_I = 0; l_I < l_Pools->m_Templates.size(); l_I++)
     {
@@ -473,10 +480,7 @@ void WildBattlePetMgr::LeaveBattle(Creature* p_Creature, bool /*p_Defeated*/)
     if (!IsWildPet(p_Creature))
         return;
 
-    uint32 l_ZoneID = p_Creature->GetZoneId();
-    uint32 l_MapID  = p_Creature->GetMapId();
-
-    WildBattlePetZonePools* l_Pools = &m_PoolsByMap[l_MapID][l_ZoneID];
+    WildBattlePetZonePools* l_Pools = GetZonePools(p_Creature->GetMapId(), p_Creature->GetZoneId());
 
 
     for (size_t l_I = 0; l_I < l_Pools->m_Templates.size(); l_I++)
@@ -502,14 +506,32 @@ void WildBattlePetMgr::LeaveBattle(Creature* p_Creature, bool /*p_Defeated*/)
 
 //////////////////////////////////////////////////////////////////////////
 
-void WildBattlePetMgr::Update(uint32 p_TimeDiff)
+void WildBattlePetMgr::Update(Map* p_Map, uint32 p_TimeDiff)
 {
-    m_UpdateTime.Update(p_TimeDiff);
+    /// The pools are shared by every instance of a map id, only the continents are populated
+    if (p_Map->Instanceable())
+        return;
 
-    if (m_UpdateTime.Passed())
-    {
-        m_UpdateTime.Reset();
+    std::map<uint32, WildBattlePetMapPools>::iterator l_MapPools = m_PoolsByMap.find(p_Map->GetId());
+    if (l_MapPools == m_PoolsByMap.end())
+        return;
+
+    IntervalTimer& l_Timer = l_MapPools->second.UpdateTimer;
+    l_Timer.Update(p_TimeDiff);
 
-        PopulateAll();
+    if (!l_Timer.Passed())
+        return;
+
+    /// Nobody would see the replacements, the timer stays expired so they are spawned as soon as a player enters
+    /// (held at one interval, an empty map doesn't pile up catch-up passes)
+    if (!p_Map->HavePlayers())
+    {
+        l_Timer.SetCurrent(l_Timer.GetInterval());
+        return;
     }
+
+    l_Timer.Reset();
+
+    for (std::map<uint32, WildBattlePetZonePools>::iterator l_It = l_MapPools->second.Zones.begin(); l_It != l_MapPools->second.Zones.end(); l_It++)
+        (*l_It).second.Populate();
 }
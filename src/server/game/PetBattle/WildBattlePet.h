@@ -18,6 +18,7 @@
 #define WILDBATTLEPET_RESPAWN_WHEN_NOT_DEFEATED 10
 
 class Creature;
+class Map;
 
 struct WildBattlePetPoolTemplate
 {
@@ -41,6 +42,8 @@ struct WildBattlePetPoolTemplate
 class WildBattlePetZonePools
 {
     public:
+        WildBattlePetZonePools() : ZoneID(0), MapID(0), PopulateCount(0), PopulateTotalTime(0), PopulateLastTime(0), PopulateMaxTime(0) { }
+
         void LoadPoolTemplate(Field* fields);
 
         void Populate();
@@ -60,6 +63,25 @@ class WildBattlePetZonePools
         uint32 MapID;
 
         std::vector<WildBattlePetPoolTemplate> m_Templates;
+
+        /// Cost of Populate in microseconds, written by the map thread and read by the GM command
+        std::atomic<uint32> PopulateCount;
+        std::atomic<uint64> PopulateTotalTime;
+        std::atomic<uint32> PopulateLastTime;
+        std::atomic<uint32> PopulateMaxTime;
+};
+
+/// Pools of one map, only touched by the thread updating that map once the world is running
+struct WildBattlePetMapPools
+{
+    WildBattlePetMapPools()
+    {
+        UpdateTimer.SetInterval(WILDBATTLEPETMGR_UPDATE_INTERVAL);
+    }
+
+    ///      zone          pools
+    std::map<uint32, WildBattlePetZonePools>    Zones;
+    IntervalTimer                               UpdateTimer;
 };
 
 class WildBattlePetMgr
@@ -82,12 +104,17 @@ class WildBattlePetMgr
         void EnterInBattle(Creature* p_Creature);
         void LeaveBattle(Creature* p_Creature, bool p_Defeated);
 
-        void Update(uint32 p_TimeDiff);
+        /// Called by Map::Update, populates the zones of the map while players are in it
+        void Update(Map* p_Map, uint32 p_TimeDiff);
+
+        /// Read only after Load, the pools themselves are only updated by their map
+        std::map<uint32, WildBattlePetMapPools> const& GetPoolsByMap() const { return m_PoolsByMap; }
 
     private:
-        ///        map              zone          pools
-        std::map<uint32, std::map<uint32, WildBattlePetZonePools>>  m_PoolsByMap;
-        IntervalTimer                                               m_UpdateTime;
+        WildBattlePetZonePools* GetZonePools(uint32 p_MapID, uint32 p_ZoneID);
+
+        ///        map        pools
+        std::map<uint32, WildBattlePetMapPools> m_PoolsByMap;
 };
 
 #define sWildBattlePetMgr ACE_Singleton<WildBattlePetMgr, ACE_Null_Mutex>::instance()
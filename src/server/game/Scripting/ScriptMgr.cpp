@@ -21,6 +21,7 @@
 #include "GossipDef.h"
 #include "CreatureAIImpl.h"
 #include "SpellAuraEffects.h"
+#include "TickProfiler.h"
 #ifndef CROSS
 #include "BattlepayMgr.h"
 #endif /* not CROSS */
@@ -1341,6 +1342,8 @@ void ScriptMgr::OnMapUpdate(Map* p_Map, uint32 p_Diff)
 {
     ASSERT(p_Map);
 
+    TICK_PROFILE_ZONE_ARG("ScriptMgr::OnMapUpdate", p_Map->GetId());
+
     SCR_MAP_BGN(WorldMapScript, p_Map, l_It, end, entry, IsWorldMap);
         l_It->second->OnUpdate(p_Map, p_Diff);
     SCR_MAP_END;
@@ -1417,11 +1420,17 @@ void ScriptMgr::OnPacketReceive(WorldSocket* p_Socket, WorldPacket p_Packet, Wor
 /// Called when a (valid) packet is received by a client. The packet object is a copy of the original packet, so reading and modifying it is safe.
 /// @p_Socket : Socket who received the packet
 /// @p_Packet : Received packet
-void ScriptMgr::OnPacketSend(WorldSocket* p_Socket, WorldPacket p_Packet)
+void ScriptMgr::OnPacketSend(WorldSocket* p_Socket, WorldPacket const& p_Packet)
 {
     ASSERT(p_Socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnPacketSend(p_Socket, p_Packet);
+    /// Scripts get a copy of the sent packet, only made when there is a script to give it to
+    if (SCR_REG_LST(ServerScript).empty())
+        return;
+
+    WorldPacket l_Packet(p_Packet);
+
+    FOREACH_SCRIPT(ServerScript)->OnPacketSend(p_Socket, l_Packet);
 }
 
 /// Called when an invalid (unknown opcode) packet is received by a client. The packet is a reference to the original packet; not a copy.
@@ -1478,6 +1487,7 @@ void ScriptMgr::OnShutdownCancel()
 /// @p_Diff : Time since last update
 void ScriptMgr::OnWorldUpdate(uint32 p_Diff)
 {
+    TICK_PROFILE_ZONE("ScriptMgr::OnWorldUpdate");
     FOREACH_SCRIPT(WorldScript)->OnUpdate(p_Diff);
 }
 
@@ -1975,6 +1985,7 @@ void ScriptMgr::OnPlayerDelete(uint64 p_GUID)
 /// @p_Diff : diff time
 void ScriptMgr::OnPlayerUpdate(Player* p_Player, uint32 p_Diff)
 {
+    TICK_PROFILE_ZONE("ScriptMgr::OnPlayerUpdate");
     FOREACH_SCRIPT(PlayerScript)->OnUpdate(p_Player, p_Diff);
 }
 
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "PacketBroadcast.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+#include "Opcodes.h"
+#include "Log.h"
+
+#include <ace/Message_Block.h>
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Thread_Mutex.h>
+
+/// Shared bodies are released by the network threads, their reference count must be locked
+static ACE_Lock_Adapter<ACE_Thread_Mutex> g_SharedBodyLock;
+
+PacketBroadcast::PacketBroadcast(WorldPacket const* p_Packet)
+    : m_Packet(p_Packet), m_SharedBody(nullptr), m_Valid(true)
+{
+    WorldPacket* l_Packet = const_cast<WorldPacket*>(p_Packet);
+
+    l_Packet->FlushBits();
+    l_Packet->OnSend();
+
+    /// Same checks as WorldSession::SendPacket, logged once for all the recipients
+    if (p_Packet->GetOpcode() == NULL_OPCODE || p_Packet->GetOpcode() == UNKNOWN_OPCODE)
+    {
+        sLog->outError(LOG_FILTER_OPCODES, "Prevented broadcast of %s", p_Packet->GetOpcode() == NULL_OPCODE ? "NULL_OPCODE" : "UNKNOWN_OPCODE");
+        m_Valid = false;
+        return;
+    }
+
+    OpcodeHandler* l_Handler = g_OpcodeTable[WOW_SERVER_TO_CLIENT][p_Packet->GetOpcode()];
+    if (!l_Handler || l_Handler->status == STATUS_UNHANDLED)
+    {
+        sLog->outError(LOG_FILTER_OPCODES, "Prevented broadcast of disabled opcode %s", GetOpcodeNameForLogging(p_Packet->GetOpcode(), WOW_SERVER_TO_CLIENT).c_str());
+        m_Valid = false;
+    }
+}
+
+PacketBroadcast::~PacketBroadcast()
+{
+    if (m_SharedBody)
+        m_SharedBody->release();
+}
+
+ACE_Message_Block* PacketBroadcast::GetSharedBody()
+{
+    if (!m_SharedBody)
+    {
+        m_SharedBody = new ACE_Message_Block(m_Packet->size(), ACE_Message_Block::MB_DATA, nullptr, nullptr, nullptr, &g_SharedBodyLock);
+        m_SharedBody->copy((char const*)m_Packet->contents(), m_Packet->size());
+    }
+
+    return m_SharedBody;
+}
+
+void PacketBroadcast::SendTo(WorldSession* p_Session)
+{
+    if (p_Session)
+        p_Session->SendPacket(*this);
+}
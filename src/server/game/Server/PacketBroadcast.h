@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _PACKET_BROADCAST_H
+#define _PACKET_BROADCAST_H
+
+#include "Common.h"
+
+class ACE_Message_Block;
+class WorldPacket;
+class WorldSession;
+
+/// Server packet sent to many sessions (guild, group and channel broadcasts)
+/// The opcode checks, bit flush and size profiling are done once at construction instead of once per recipient,
+/// only the header is built for each socket since it's encrypted with the session key.
+/// Sockets which can't write the packet immediately queue a reference to one shared body instead of a copy.
+class PacketBroadcast
+{
+    public:
+        explicit PacketBroadcast(WorldPacket const* p_Packet);
+        ~PacketBroadcast();
+
+        /// False if the packet must not be sent to clients (null, unknown or disabled opcode)
+        bool IsValid() const { return m_Valid; }
+
+        WorldPacket const* GetPacket() const { return m_Packet; }
+
+        /// Body of the packet for the socket output queues, created on first use
+        /// Every queued packet holds a reference, the body is freed with the last one
+        ACE_Message_Block* GetSharedBody();
+
+        /// Send the packet to one more session, see WorldSession::SendPacket
+        void SendTo(WorldSession* p_Session);
+
+    private:
+        WorldPacket const* m_Packet;
+        ACE_Message_Block* m_SharedBody;
+        bool m_Valid;
+};
+
+#endif
@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "OpcodeStats.h"
+#include "Log.h"
+
+namespace
+{
+    bool SortByTotalTime(OpcodeStatsEntry const& p_Left, OpcodeStatsEntry const& p_Right)
+    {
+        return p_Left.TotalTime > p_Right.TotalTime;
+    }
+
+    uint32 GetBucket(uint32 p_Time)
+    {
+        uint32 l_Bucket = 0;
+        while (p_Time >= 2 && l_Bucket + 1 < OPCODE_STATS_BUCKET_COUNT)
+        {
+            p_Time >>= 1;
+            ++l_Bucket;
+        }
+
+        return l_Bucket;
+    }
+}
+
+OpcodeStats::OpcodeStats()
+    : m_Enabled(true), m_Interval(MINUTE * IN_MILLISECONDS), m_IntervalTimer(MINUTE * IN_MILLISECONDS), m_TopCount(10)
+{
+    m_Handlers = new OpcodeHandlerStats[NUM_OPCODE_HANDLERS];
+    Reset();
+}
+
+OpcodeStats::~OpcodeStats()
+{
+    delete[] m_Handlers;
+}
+
+void OpcodeStats::SetInterval(uint32 p_Interval, uint32 p_TopCount)
+{
+    m_Interval      = std::max(p_Interval, uint32(IN_MILLISECONDS));
+    m_IntervalTimer = m_Interval;
+    m_TopCount      = p_TopCount;
+}
+
+void OpcodeStats::UpdateMax(std::atomic<uint32>& p_Max, uint32 p_Value)
+{
+    uint32 l_Max = p_Max.load(std::memory_order_relaxed);
+    while (l_Max < p_Value && !p_Max.compare_exchange_weak(l_Max, p_Value, std::memory_order_relaxed))
+        ;
+}
+
+void OpcodeStats::AddHandlerTime(uint16 p_Opcode, uint32 p_Time)
+{
+    if (p_Opcode >= NUM_OPCODE_HANDLERS)
+        return;
+
+    OpcodeHandlerStats& l_Stats = m_Handlers[p_Opcode];
+
+    l_Stats.Count.fetch_add(1, std::memory_order_relaxed);
+    l_Stats.TotalTime.fetch_add(p_Time, std::memory_order_relaxed);
+    l_Stats.Buckets[GetBucket(p_Time)].fetch_add(1, std::memory_order_relaxed);
+    UpdateMax(l_Stats.MaxTime, p_Time);
+
+    l_Stats.IntervalCount.fetch_add(1, std::memory_order_relaxed);
+    l_Stats.IntervalTime.fetch_add(p_Time, std::memory_order_relaxed);
+    UpdateMax(l_Stats.IntervalMaxTime, p_Time);
+}
+
+void OpcodeStats::Update(uint32 p_Diff)
+{
+    if (m_IntervalTimer > p_Diff)
+    {
+        m_IntervalTimer -= p_Diff;
+        return;
+    }
+
+    m_IntervalTimer = m_Interval;
+    m_LastIntervalTop.clear();
+
+    for (uint32 l_Opcode = 0; l_Opcode < NUM_OPCODE_HANDLERS; ++l_Opcode)
+    {
+        OpcodeHandlerStats& l_Stats = m_Handlers[l_Opcode];
+        if (!l_Stats.IntervalCount.load(std::memory_order_relaxed))
+            continue;
+
+        OpcodeStatsEntry l_Entry;
+        l_Entry.Opcode    = uint16(l_Opcode);
+        l_Entry.Count     = l_Stats.IntervalCount.exchange(0, std::memory_order_relaxed);
+        l_Entry.TotalTime = l_Stats.IntervalTime.exchange(0, std::memory_order_relaxed);
+        l_Entry.MaxTime   = l_Stats.IntervalMaxTime.exchange(0, std::memory_order_relaxed);
+        m_LastIntervalTop.push_back(l_Entry);
+    }
+
+    uint32 l_Count = std::min(uint32(m_LastIntervalTop.size()), m_TopCount);
+    std::partial_sort(m_LastIntervalTop.begin(), m_LastIntervalTop.begin() + l_Count, m_LastIntervalTop.end(), SortByTotalTime);
+    m_LastIntervalTop.resize(l_Count);
+}
+
+void OpcodeStats::GetTotalTop(std::vector<OpcodeStatsEntry>& p_Entries, uint32 p_Count) const
+{
+    p_Entries.clear();
+
+    for (uint32 l_Opcode = 0; l_Opcode < NUM_OPCODE_HANDLERS; ++l_Opcode)
+    {
+        OpcodeHandlerStats const& l_Stats = m_Handlers[l_Opcode];
+        if (!l_Stats.Count.load(std::memory_order_relaxed))
+            continue;
+
+        OpcodeStatsEntry l_Entry;
+        l_Entry.Opcode    = uint16(l_Opcode);
+        l_Entry.Count     = l_Stats.Count.load(std::memory_order_relaxed);
+        l_Entry.TotalTime = l_Stats.TotalTime.load(std::memory_order_relaxed);
+        l_Entry.MaxTime   = l_Stats.MaxTime.load(std::memory_order_relaxed);
+        p_Entries.push_back(l_Entry);
+    }
+
+    uint32 l_Count = std::min(uint32(p_Entries.size()), p_Count);
+    std::partial_sort(p_Entries.begin(), p_Entries.begin() + l_Count, p_Entries.end(), SortByTotalTime);
+    p_Entries.resize(l_Count);
+}
+
+OpcodeHandlerStats const* OpcodeStats::GetHandlerStats(uint16 p_Opcode) const
+{
+    if (p_Opcode >= NUM_OPCODE_HANDLERS)
+        return nullptr;
+
+    return &m_Handlers[p_Opcode];
+}
+
+uint32 OpcodeStats::GetPercentile(OpcodeHandlerStats const& p_Stats, float p_Percent) const
+{
+    uint64 l_Total = 0;
+    for (uint32 l_I = 0; l_I < OPCODE_STATS_BUCKET_COUNT; ++l_I)
+        l_Total += p_Stats.Buckets[l_I].load(std::memory_order_relaxed);
+
+    if (!l_Total)
+        return 0;
+
+    uint64 l_Threshold = uint64(std::ceil(double(l_Total) * p_Percent / 100.0));
+    uint64 l_Seen = 0;
+    for (uint32 l_I = 0; l_I < OPCODE_STATS_BUCKET_COUNT; ++l_I)
+    {
+        l_Seen += p_Stats.Buckets[l_I].load(std::memory_order_relaxed);
+        if (l_Seen >= l_Threshold)
+            return std::min(GetBucketLimit(l_I), p_Stats.MaxTime.load(std::memory_order_relaxed));
+    }
+
+    return p_Stats.MaxTime.load(std::memory_order_relaxed);
+}
+
+bool OpcodeStats::DumpToFile(std::string const& p_FileName) const
+{
+    FILE* l_File = fopen(p_FileName.c_str(), "w");
+    if (!l_File)
+    {
+        sLog->outError(LOG_FILTER_GENERAL, "OpcodeStats::DumpToFile: can't open %s", p_FileName.c_str());
+        return false;
+    }
+
+    fprintf(l_File, "# Opcode handler latencies (microseconds) - %s\n", Log::GetTimestampStr().c_str());
+    fprintf(l_File, "# opcode;name;count;total;avg;max;p50;p95;p99");
+    for (uint32 l_I = 0; l_I + 1 < OPCODE_STATS_BUCKET_COUNT; ++l_I)
+        fprintf(l_File, ";<%u", GetBucketLimit(l_I));
+    fprintf(l_File, ";>=%u\n", GetBucketLimit(OPCODE_STATS_BUCKET_COUNT - 2));
+
+    for (uint32 l_Opcode = 0; l_Opcode < NUM_OPCODE_HANDLERS; ++l_Opcode)
+    {
+        OpcodeHandlerStats const& l_Stats = m_Handlers[l_Opcode];
+        uint64 l_Count = l_Stats.Count.load(std::memory_order_relaxed);
+        if (!l_Count)
+            continue;
+
+        OpcodeHandler const* l_Handler = g_OpcodeTable[WOW_CLIENT_TO_SERVER][l_Opcode];
+        uint64 l_TotalTime = l_Stats.TotalTime.load(std::memory_order_relaxed);
+
+        fprintf(l_File, "0x%04X;%s;" UI64FMTD ";" UI64FMTD ";" UI64FMTD ";%u;%u;%u;%u", l_Opcode, l_Handler ? l_Handler->name : "UNKNOWN",
+            l_Count, l_TotalTime, l_TotalTime / l_Count, l_Stats.MaxTime.load(std::memory_order_relaxed),
+            GetPercentile(l_Stats, 50.0f), GetPercentile(l_Stats, 95.0f), GetPercentile(l_Stats, 99.0f));
+
+        for (uint32 l_I = 0; l_I < OPCODE_STATS_BUCKET_COUNT; ++l_I)
+            fprintf(l_File, ";%u", l_Stats.Buckets[l_I].load(std::memory_order_relaxed));
+
+        fprintf(l_File, "\n");
+    }
+
+    fclose(l_File);
+    return true;
+}
+
+void OpcodeStats::Reset()
+{
+    for (uint32 l_Opcode = 0; l_Opcode < NUM_OPCODE_HANDLERS; ++l_Opcode)
+    {
+        OpcodeHandlerStats& l_Stats = m_Handlers[l_Opcode];
+
+        l_Stats.Count.store(0, std::memory_order_relaxed);
+        l_Stats.TotalTime.store(0, std::memory_order_relaxed);
+        l_Stats.MaxTime.store(0, std::memory_order_relaxed);
+
+        for (uint32 l_I = 0; l_I < OPCODE_STATS_BUCKET_COUNT; ++l_I)
+            l_Stats.Buckets[l_I].store(0, std::memory_order_relaxed);
+
+        l_Stats.IntervalCount.store(0, std::memory_order_relaxed);
+        l_Stats.IntervalTime.store(0, std::memory_order_relaxed);
+        l_Stats.IntervalMaxTime.store(0, std::memory_order_relaxed);
+    }
+
+    m_LastIntervalTop.clear();
+}
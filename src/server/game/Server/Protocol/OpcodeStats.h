@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _OPCODE_STATS_H
+#define _OPCODE_STATS_H
+
+#include "Common.h"
+#include "Opcodes.h"
+
+#include <chrono>
+
+// Bucket N holds the handler calls that took [2^N, 2^(N+1)[ microseconds, the last one is open ended (>= ~32 ms)
+#define OPCODE_STATS_BUCKET_COUNT 16
+
+/// Cumulated handler timings of one client opcode, updated by every thread running sessions
+struct OpcodeHandlerStats
+{
+    std::atomic<uint64> Count;
+    std::atomic<uint64> TotalTime;                              ///< Microseconds
+    std::atomic<uint32> MaxTime;                                ///< Microseconds
+    std::atomic<uint32> Buckets[OPCODE_STATS_BUCKET_COUNT];
+
+    /// Reset each time the interval rolls
+    std::atomic<uint32> IntervalCount;
+    std::atomic<uint64> IntervalTime;
+    std::atomic<uint32> IntervalMaxTime;
+};
+
+/// Snapshot of a handler for the top lists
+struct OpcodeStatsEntry
+{
+    uint16 Opcode;
+    uint64 Count;
+    uint64 TotalTime;
+    uint32 MaxTime;
+};
+
+/// Always-on latency instrumentation of the client opcode handlers
+/// Recording is a few relaxed atomic operations per packet, the top N of the slowest handlers
+/// is computed once per interval by the world thread
+class OpcodeStats
+{
+    public:
+        OpcodeStats();
+        ~OpcodeStats();
+
+        void SetEnabled(bool p_Enabled) { m_Enabled = p_Enabled; }
+        bool IsEnabled() const { return m_Enabled; }
+
+        void SetInterval(uint32 p_Interval, uint32 p_TopCount);
+        uint32 GetInterval() const { return m_Interval; }
+
+        /// Thread safe, called by WorldSession::Update after each handler
+        void AddHandlerTime(uint16 p_Opcode, uint32 p_Time);
+
+        /// World thread only, rolls the interval and computes its top N
+        void Update(uint32 p_Diff);
+
+        /// Slowest handlers of the last complete interval, sorted by total time
+        std::vector<OpcodeStatsEntry> const& GetLastIntervalTop() const { return m_LastIntervalTop; }
+        /// Slowest handlers since startup or the last reset, sorted by total time
+        void GetTotalTop(std::vector<OpcodeStatsEntry>& p_Entries, uint32 p_Count) const;
+
+        OpcodeHandlerStats const* GetHandlerStats(uint16 p_Opcode) const;
+        /// Upper bound (microseconds) of the bucket holding the p_Percent percentile
+        uint32 GetPercentile(OpcodeHandlerStats const& p_Stats, float p_Percent) const;
+
+        /// Write the cumulated stats of every received opcode in p_FileName
+        bool DumpToFile(std::string const& p_FileName) const;
+        void Reset();
+
+        static uint32 GetBucketLimit(uint32 p_Bucket) { return p_Bucket + 1 < OPCODE_STATS_BUCKET_COUNT ? (2 << p_Bucket) : 0xFFFFFFFF; }
+
+    private:
+        static void UpdateMax(std::atomic<uint32>& p_Max, uint32 p_Value);
+
+        OpcodeHandlerStats* m_Handlers;
+        bool m_Enabled;
+
+        uint32 m_Interval;
+        uint32 m_IntervalTimer;
+        uint32 m_TopCount;
+        std::vector<OpcodeStatsEntry> m_LastIntervalTop;
+};
+
+#define sOpcodeStats ACE_Singleton<OpcodeStats, ACE_Null_Mutex>::instance()
+
+/// Measure the handler time of one packet
+class OpcodeStatsTimer
+{
+    public:
+        OpcodeStatsTimer(uint16 p_Opcode) : m_Opcode(p_Opcode), m_Enabled(sOpcodeStats->IsEnabled())
+        {
+            if (m_Enabled)
+                m_StartTime = std::chrono::high_resolution_clock::now();
+        }
+
+        /// Record the time elapsed since the construction
+        void Stop()
+        {
+            if (!m_Enabled)
+                return;
+
+            std::chrono::high_resolution_clock::duration l_Elapsed = std::chrono::high_resolution_clock::now() - m_StartTime;
+            sOpcodeStats->AddHandlerTime(m_Opcode, uint32(std::chrono::duration_cast<std::chrono::microseconds>(l_Elapsed).count()));
+            m_Enabled = false;
+        }
+
+    private:
+        uint16 m_Opcode;
+        bool m_Enabled;
+        std::chrono::high_resolution_clock::time_point m_StartTime;
+};
+
+#endif
@@ -24,6 +24,7 @@
 #include "DatabaseEnv.h"
 #include "Log.h"
 #include "Opcodes.h"
+#include "OpcodeStats.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
@@ -45,6 +46,7 @@
 #include "AccountMgr.h"
 #include "PetBattle.h"
 #include "Chat.h"
+#include "PacketBroadcast.h"
 
 bool MapSessionFilter::Process(WorldPacket* packet)
 {
@@ -167,6 +169,11 @@ WorldSession::WorldSession(uint32 id, InterRealmClient* irc, AccountTypes sec, b
     m_AlreadyPurchasePoints = false;
 
     m_IsStressTestSession   = false;
+
+    m_ReceivedPacketCounter = 0;
+    m_ReceiveRateTimer      = 0;
+    m_ReceiveRate           = 0;
+    m_PeakReceiveRate       = 0;
     m_playerRecentlyLogout  = false;
     m_playerSave            = false;
     m_TutorialsChanged      = false;
@@ -361,12 +368,45 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
 #endif
 }
 
+/// Send a packet prepared once for many sessions, the checks of the method above are done by PacketBroadcast
+void WorldSession::SendPacket(PacketBroadcast& p_Broadcast)
+{
+    if (!p_Broadcast.IsValid())
+        return;
+
+#ifndef CROSS
+    if (!m_Socket)
+        return;
+
+    if (GetInterRealmBG() && !CanBeSentDuringInterRealm(p_Broadcast.GetPacket()->GetOpcode()))
+        return;
+
+    if (m_Socket->SendBroadcastPacket(p_Broadcast) == -1)
+        m_Socket->CloseSocket();
+#else /* CROSS */
+    SendPacket(p_Broadcast.GetPacket());
+#endif
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
+    ++m_ReceivedPacketCounter;
     _recvQueue.add(new_packet);
 }
 
+/// Refresh the packets per second received by the session
+void WorldSession::UpdateReceiveRate(uint32 p_Diff)
+{
+    m_ReceiveRateTimer += p_Diff;
+    if (m_ReceiveRateTimer < IN_MILLISECONDS)
+        return;
+
+    m_ReceiveRate       = m_ReceivedPacketCounter.exchange(0) * IN_MILLISECONDS / m_ReceiveRateTimer;
+    m_PeakReceiveRate   = std::max(m_PeakReceiveRate, m_ReceiveRate);
+    m_ReceiveRateTimer  = 0;
+}
+
 /// Logging helper for unexpected opcodes
 void WorldSession::LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason)
 {
@@ -407,6 +447,10 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     uint32 opcode = 0;
 
+    /// Sessions are also updated by the map threads, only the world thread updater accounts the receive rate
+    if (updater.ProcessLogout())
+        UpdateReceiveRate(diff);
+
     while (!_recvQueue.empty() && _recvQueue.next(packet, updater))
     {
         opcode = packet->GetOpcode();
@@ -414,6 +458,8 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
         const OpcodeHandler* opHandle = g_OpcodeTable[WOW_CLIENT_TO_SERVER][packet->GetOpcode()];
         if (opHandle)
         {
+            OpcodeStatsTimer l_StatsTimer(packet->GetOpcode());
+
             try
             {
                 switch (opHandle->status)
@@ -436,6 +482,8 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             {
                 //
             }
+
+            l_StatsTimer.Stop();
         }
 
         if (packet != NULL)
@@ -514,6 +562,10 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     /// Update Timeout timer.
     UpdateTimeOutTime(diff);
 
+    /// Sessions are also updated by the map threads, only the world thread updater accounts the receive rate
+    if (updater.ProcessLogout())
+        UpdateReceiveRate(diff);
+
     ///- Before we process anything:
     /// If necessary, kick the player from the character select screen
     if (IsConnectionIdle() && m_Socket)
@@ -538,6 +590,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     {
         const OpcodeHandler* opHandle = g_OpcodeTable[WOW_CLIENT_TO_SERVER][packet->GetOpcode()];
         uint32 pktTime = getMSTime();
+        OpcodeStatsTimer l_StatsTimer(packet->GetOpcode());
 
         try
         {
@@ -556,7 +609,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                                 firstDelayedPacket = packet;
                             //! Because checking a bool is faster than reallocating memory
                             deletePacket = false;
-                            QueuePacket(packet);
+                            _recvQueue.add(packet);     ///< Not a newly received packet for the receive rate
                             //! Log
                                 sLog->outDebug(LOG_FILTER_NETWORKIO, "Re-enqueueing packet with opcode %s with with status STATUS_LOGGEDIN. "
                                     "Player is currently not in world yet.", GetOpcodeNameForLogging(packet->GetOpcode(), WOW_CLIENT_TO_SERVER).c_str());
@@ -701,6 +754,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             }
         }
 
+        l_StatsTimer.Stop();
         nbPacket++;
 
         if (deletePacket)
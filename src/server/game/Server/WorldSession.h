@@ -35,6 +35,7 @@ class Unit;
 class Warden;
 class WorldPacket;
 class WorldSocket;
+class PacketBroadcast;
 struct AreaTableEntry;
 struct AuctionEntry;
 struct DeclinedName;
@@ -443,6 +444,7 @@ class WorldSession
         static void WriteMovementInfo(WorldPacket& data, MovementInfo* mi);
 
         void SendPacket(WorldPacket const* packet, bool forced = false, bool ir_packet = false);
+        void SendPacket(PacketBroadcast& p_Broadcast);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -1474,6 +1476,10 @@ class WorldSession
         void SetStressTest(bool p_Value) { m_IsStressTestSession = p_Value; }
         bool IsStressTest() const { return m_IsStressTestSession; }
 
+        /// Packets received per second over the last second
+        uint32 GetReceiveRate() const { return m_ReceiveRate; }
+        uint32 GetPeakReceiveRate() const { return m_PeakReceiveRate; }
+
         uint32 GetActivityDays() const { return m_ActivityDays; }
         time_t GetLastBan() const { return m_LastBan; };
         time_t GetLastClaim() const { return m_LastClaim; }
@@ -1664,6 +1670,13 @@ class WorldSession
         time_t m_LoginTime;
 
         bool m_IsStressTestSession;
+
+        void UpdateReceiveRate(uint32 p_Diff);
+
+        std::atomic<uint32> m_ReceivedPacketCounter;        ///< Incremented by the network thread
+        uint32 m_ReceiveRateTimer;                          ///< Rate fields are only touched by the world thread
+        uint32 m_ReceiveRate;
+        uint32 m_PeakReceiveRate;
 };
 #endif
 /// @}
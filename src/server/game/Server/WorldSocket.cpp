@@ -37,6 +37,7 @@
 #include "ScriptMgr.h"
 #include "AccountMgr.h"
 #include "ObjectMgr.h"
+#include "PacketBroadcast.h"
 
 uint32_t gReceivedBytes = 0;
 uint32_t gSentBytes = 0;
@@ -220,6 +221,65 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
     return 0;
 }
 
+int WorldSocket::SendBroadcastPacket(PacketBroadcast& p_Broadcast)
+{
+    ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+
+    if (closing_)
+        return -1;
+
+    WorldPacket const& l_Packet = *p_Broadcast.GetPacket();
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(l_Packet, SERVER_TO_CLIENT);
+
+    gSentBytes += l_Packet.size() + 3;
+
+    sScriptMgr->OnPacketSend(this, l_Packet);
+
+    ServerPktHeader l_Header(!m_Crypt.IsInitialized() ? l_Packet.size() + 2 : l_Packet.size(), l_Packet.GetOpcode(), &m_Crypt);
+
+    if (m_OutBuffer->space() >= l_Packet.size() + l_Header.getHeaderLength() && msg_queue()->is_empty())
+    {
+        if (m_OutBuffer->copy((char*)l_Header.header, l_Header.getHeaderLength()) == -1)
+            ACE_ASSERT(false);
+
+        if (!l_Packet.empty())
+        if (m_OutBuffer->copy((char*)l_Packet.contents(), l_Packet.size()) == -1)
+            ACE_ASSERT(false);
+
+        return 0;
+    }
+
+    /// Only the header is specific to this socket, the body is a reference to the broadcast one
+    ACE_Message_Block* l_HeaderBlock;
+    ACE_NEW_RETURN(l_HeaderBlock, ACE_Message_Block(l_Header.getHeaderLength()), -1);
+
+    l_HeaderBlock->copy((char*)l_Header.header, l_Header.getHeaderLength());
+
+    if (msg_queue()->enqueue_tail(l_HeaderBlock, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+    {
+        sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::SendBroadcastPacket enqueue_tail failed");
+        l_HeaderBlock->release();
+        return -1;
+    }
+
+    if (!l_Packet.empty())
+    {
+        ACE_Message_Block* l_BodyBlock = p_Broadcast.GetSharedBody()->duplicate();
+
+        /// The header is already queued, the stream can't be recovered
+        if (msg_queue()->enqueue_tail(l_BodyBlock, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+        {
+            sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::SendBroadcastPacket enqueue_tail failed");
+            l_BodyBlock->release();
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 long WorldSocket::AddReference (void)
 {
     return static_cast<long> (add_reference());
@@ -36,6 +36,7 @@
 class ACE_Message_Block;
 class WorldPacket;
 class WorldSession;
+class PacketBroadcast;
 
 /// Handler that can communicate over stream sockets.
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
@@ -102,6 +103,10 @@ class WorldSocket : public WorldHandler
         /// @return -1 of failure
         int SendPacket(const WorldPacket& pct);
 
+        /// Send a packet prepared for many sockets, queued packets share its body.
+        /// @return -1 of failure
+        int SendBroadcastPacket(PacketBroadcast& p_Broadcast);
+
         /// Add reference to this object.
         long AddReference (void);
 
@@ -27,6 +27,8 @@
 #include "SpellScript.h"
 #include "Vehicle.h"
 
+POOLED_OBJECT_DEFINE(Aura, std::max(sizeof(UnitAura), sizeof(DynObjAura)), 256)
+
 AuraApplication::AuraApplication(Unit* target, Unit* caster, Aura* aura, uint32 effMask):
 _target(target), _base(aura), _removeMode(AURA_REMOVE_NONE), m_Slot(MAX_AURAS),
 _flags(AFLAG_NONE), _effectMask(0), _effectsToApply(effMask), _needClientUpdate(false)
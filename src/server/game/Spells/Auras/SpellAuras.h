@@ -12,6 +12,7 @@
 #include "SpellAuraDefines.h"
 #include "SpellInfo.h"
 #include "Unit.h"
+#include "PoolAllocator.h"
 
 class Unit;
 class SpellInfo;
@@ -77,6 +78,8 @@ class AuraApplication
 
 class Aura
 {
+    POOLED_OBJECT_DECLARE()
+
     friend Aura* Unit::_TryStackingOrRefreshingExistingAura(SpellInfo const* newAura, uint32 effMask, Unit* caster, int32 *baseAmount, Item* castItem, uint64 casterGUID, int32 castItemLevel);
     public:
         typedef std::map<uint64, AuraApplication *> ApplicationMap;
@@ -48,10 +48,13 @@
 #include "Battlefield.h"
 #include "BattlefieldMgr.h"
 #include "GuildMgr.h"
+#include "TickProfiler.h"
 #ifndef CROSS
 #include "GarrisonMgr.hpp"
 #endif /* not CROSS */
 
+POOLED_OBJECT_DEFINE(Spell, sizeof(Spell), 128)
+
 extern pEffect SpellEffects[TOTAL_SPELL_EFFECTS];
 
 SpellDestination::SpellDestination()
@@ -4485,6 +4488,8 @@ void Spell::SendSpellCooldown()
 
 void Spell::update(uint32 difftime)
 {
+    TICK_PROFILE_ZONE_ARG("Spell::update", m_spellInfo->Id);
+
     // update pointers based at it's GUIDs
     UpdatePointers();
 
@@ -14,6 +14,7 @@
 #include "ObjectMgr.h"
 #include "SpellInfo.h"
 #include "PathGenerator.h"
+#include "PoolAllocator.h"
 
 class Unit;
 class Player;
@@ -358,6 +359,8 @@ enum SpellEffectHandleMode
 
 class Spell
 {
+    POOLED_OBJECT_DECLARE()
+
     friend void Unit::SetCurrentCastedSpell(Spell* pSpell);
     friend class SpellScript;
 public:
@@ -8624,6 +8624,8 @@ void Spell::EffectFinishGarrisonShipment(SpellEffIndex p_EffIndex)
                     l_TempShipmentsList[l_OrderI]->CompleteTime = l_CurrentTimeStamp;
                 }
 
+                l_GarrisonMgr->ScheduleWorkOrdersUpdate();
+
                 m_caster->CastSpell(m_caster, 180704, true); ///< Rush Order visual
             }
         }
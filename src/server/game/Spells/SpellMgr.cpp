@@ -1419,8 +1419,8 @@ void SpellMgr::LoadSpellRanks()
     {
         for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
         {
-            if (mSpellInfoMap[difficulty][itr->first])
-                mSpellInfoMap[difficulty][itr->first]->ChainEntry = NULL;
+            if (SpellInfo* l_SpellInfo = GetSpellInfoForDifficulty(itr->first, difficulty))
+                l_SpellInfo->ChainEntry = NULL;
         }
     }
     mSpellChains.clear();
@@ -1512,8 +1512,8 @@ void SpellMgr::LoadSpellRanks()
             mSpellChains[addedSpell].rank = itr->second;
             mSpellChains[addedSpell].prev = GetSpellInfo(prevRank);
             for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
-                if (mSpellInfoMap[difficulty][addedSpell])
-                    mSpellInfoMap[difficulty][addedSpell]->ChainEntry = &mSpellChains[addedSpell];
+                if (SpellInfo* l_SpellInfo = GetSpellInfoForDifficulty(addedSpell, difficulty))
+                    l_SpellInfo->ChainEntry = &mSpellChains[addedSpell];
             prevRank = addedSpell;
             ++itr;
             if (itr == rankChain.end())
@@ -3122,8 +3122,26 @@ void SpellMgr::LoadSpellInfoStore()
     uint32 oldMSTime = getMSTime();
 
     UnloadSpellInfoStore();
-    for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
-        mSpellInfoMap[difficulty].resize(sSpellStore.GetNumRows(), nullptr);
+    mSpellInfoMap.resize(sSpellStore.GetNumRows(), nullptr);
+    mSpellDifficultyRows.resize(sSpellStore.GetNumRows(), 0);
+
+    /// Only a few spells have difficulty specific data, they get a row of the overlay, the others only a base entry
+    std::vector<std::set<uint32> const*> l_DifficultiesBySpell(sSpellStore.GetNumRows(), nullptr);
+    uint32 l_RowCount = 0;
+
+    for (AvaiableDifficultySpell::const_iterator l_Itr = mAvaiableDifficultyBySpell.begin(); l_Itr != mAvaiableDifficultyBySpell.end(); ++l_Itr)
+    {
+        if (l_Itr->first >= sSpellStore.GetNumRows())
+            continue;
+
+        l_DifficultiesBySpell[l_Itr->first] = &l_Itr->second;
+
+        if (!l_Itr->second.empty() && *l_Itr->second.rbegin() != DifficultyNone)
+            mSpellDifficultyRows[l_Itr->first] = ++l_RowCount;
+    }
+
+    mSpellDifficultyInfos.resize(l_RowCount * Difficulty::MaxDifficulties, nullptr);
+    mSpellDifficultyLookup.resize(l_RowCount * Difficulty::MaxDifficulties, nullptr);
 
     for (uint32 l_ID = 0; l_ID < sSpellXSpellVisualStore.GetNumRows(); ++l_ID)
     {
@@ -3134,7 +3152,8 @@ void SpellMgr::LoadSpellInfoStore()
         VisualsBySpellMap[l_Entry->SpellId][l_Entry->DifficultyID].push_back(l_Entry);
     }
 
-    ParallelFor(0, sSpellStore.GetNumRows(), [this](uint32 l_I) -> void
+    /// Each spell only writes its own slots
+    ParallelFor(0, sSpellStore.GetNumRows(), [this, &l_DifficultiesBySpell](uint32 l_I) -> void
     {
         if (SpellEntry const* spellEntry = sSpellStore.LookupEntry(l_I))
         {
@@ -3142,22 +3161,34 @@ void SpellMgr::LoadSpellInfoStore()
             SpellVisualMap emptyMap;
             SpellVisualMap& visualMap = (l_Itr == VisualsBySpellMap.end()) ? emptyMap : l_Itr->second;
 
-            std::set<uint32> difficultyInfo = mAvaiableDifficultyBySpell[l_I];
+            if (!l_DifficultiesBySpell[l_I])
+                return;
+
+            std::set<uint32> const& difficultyInfo = *l_DifficultiesBySpell[l_I];
 
-            for (std::set<uint32>::iterator itr = difficultyInfo.begin(); itr != difficultyInfo.end(); itr++)
-                mSpellInfoMap[(*itr)][l_I] = new SpellInfo(spellEntry, (*itr), std::move(visualMap));
+            for (std::set<uint32>::const_iterator itr = difficultyInfo.begin(); itr != difficultyInfo.end(); itr++)
+                SetSpellInfoForDifficulty(l_I, (*itr), new SpellInfo(spellEntry, (*itr), std::move(visualMap)));
         }
     });
 
+    for (uint32 l_I = 0; l_I < mSpellDifficultyRows.size(); ++l_I)
+    {
+        if (mSpellDifficultyRows[l_I])
+            ResolveSpellDifficulty(l_I);
+    }
+
     for (uint32 l_I = 0; l_I < sSpellPowerStore.GetNumRows(); l_I++)
     {
         SpellPowerEntry const* spellPower = sSpellPowerStore.LookupEntry(l_I);
         if (!spellPower)
             continue;
 
+        if (spellPower->SpellId >= GetSpellInfoStoreSize())
+            continue;
+
         for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
         {
-            SpellInfo* spell = mSpellInfoMap[difficulty][spellPower->SpellId];
+            SpellInfo* spell = GetSpellInfoForDifficulty(spellPower->SpellId, difficulty);
             if (!spell)
                 continue;
 
@@ -3171,7 +3202,7 @@ void SpellMgr::LoadSpellInfoStore()
         if (!l_TalentEntry)
             continue;
 
-        SpellInfo* l_SpellInfo = mSpellInfoMap[DifficultyNone][l_TalentEntry->SpellID];
+        SpellInfo* l_SpellInfo = l_TalentEntry->SpellID < GetSpellInfoStoreSize() ? mSpellInfoMap[l_TalentEntry->SpellID] : nullptr;
         if (l_SpellInfo)
             l_SpellInfo->m_TalentIDs.push_back(l_TalentEntry->Id);
 
@@ -3184,31 +3215,98 @@ void SpellMgr::LoadSpellInfoStore()
         }
     }
 
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded spell info store in %u ms", GetMSTimeDiffToNow(oldMSTime));
+    /// What a full pointer table per difficulty would cost, against the base table and the overlay
+    uint64 l_TableSize = uint64(Difficulty::MaxDifficulties) * mSpellInfoMap.size() * sizeof(SpellInfo*);
+    uint64 l_StoreSize = mSpellInfoMap.capacity() * sizeof(SpellInfo*) + mSpellDifficultyRows.capacity() * sizeof(uint32)
+        + mSpellDifficultyInfos.capacity() * sizeof(SpellInfo*) + mSpellDifficultyLookup.capacity() * sizeof(SpellInfo const*);
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded spell info store in %u ms, %u spells with difficulty data, %u KB of lookup tables (%u KB saved)",
+        GetMSTimeDiffToNow(oldMSTime), l_RowCount, uint32(l_StoreSize / 1024), uint32(l_TableSize > l_StoreSize ? (l_TableSize - l_StoreSize) / 1024 : 0));
 }
 
-void SpellMgr::UnloadSpellInfoStore()
+SpellInfo* SpellMgr::GetSpellInfoForDifficulty(uint32 p_SpellID, uint32 p_Difficulty) const
 {
-    for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
+    if (p_Difficulty == DifficultyNone)
+        return mSpellInfoMap[p_SpellID];
+
+    uint32 l_Row = mSpellDifficultyRows[p_SpellID];
+    return l_Row ? mSpellDifficultyInfos[(l_Row - 1) * Difficulty::MaxDifficulties + p_Difficulty] : nullptr;
+}
+
+void SpellMgr::SetSpellInfoForDifficulty(uint32 p_SpellID, uint32 p_Difficulty, SpellInfo* p_SpellInfo)
+{
+    if (p_Difficulty == DifficultyNone)
     {
-        for (uint32 i = 0; i < mSpellInfoMap[difficulty].size(); ++i)
+        mSpellInfoMap[p_SpellID] = p_SpellInfo;
+        return;
+    }
+
+    /// Rows are allocated before the parallel load, a new one is only needed for spells created afterwards
+    if (!mSpellDifficultyRows[p_SpellID])
+    {
+        mSpellDifficultyRows[p_SpellID] = mSpellDifficultyInfos.size() / Difficulty::MaxDifficulties + 1;
+        mSpellDifficultyInfos.resize(mSpellDifficultyInfos.size() + Difficulty::MaxDifficulties, nullptr);
+        mSpellDifficultyLookup.resize(mSpellDifficultyLookup.size() + Difficulty::MaxDifficulties, nullptr);
+    }
+
+    mSpellDifficultyInfos[(mSpellDifficultyRows[p_SpellID] - 1) * Difficulty::MaxDifficulties + p_Difficulty] = p_SpellInfo;
+}
+
+void SpellMgr::ResolveSpellDifficulty(uint32 p_SpellID)
+{
+    uint32 l_Row = mSpellDifficultyRows[p_SpellID] - 1;
+    SpellInfo* const* l_Loaded = &mSpellDifficultyInfos[l_Row * Difficulty::MaxDifficulties];
+    SpellInfo const** l_Lookup = &mSpellDifficultyLookup[l_Row * Difficulty::MaxDifficulties];
+
+    /// End of every chain
+    SpellInfo const* l_Base = mSpellInfoMap[p_SpellID];
+    l_Lookup[DifficultyNone] = l_Base;
+
+    for (uint32 l_I = 1; l_I < Difficulty::MaxDifficulties; ++l_I)
+    {
+        l_Lookup[l_I] = l_Base;
+
+        /// Same walk as GetSpellInfo used to do on every call, bounded in case of a looping chain
+        DifficultyEntry const* l_Difficulty = sDifficultyStore.LookupEntry(l_I);
+        for (uint32 l_Step = 0; l_Difficulty != nullptr && l_Step < Difficulty::MaxDifficulties; ++l_Step)
         {
-            if (mSpellInfoMap[difficulty][i])
-                delete mSpellInfoMap[difficulty][i];
+            if (l_Difficulty->ID < Difficulty::MaxDifficulties && l_Loaded[l_Difficulty->ID] != nullptr)
+            {
+                l_Lookup[l_I] = l_Loaded[l_Difficulty->ID];
+                break;
+            }
+
+            l_Difficulty = sDifficultyStore.LookupEntry(l_Difficulty->FallbackDifficultyID);
         }
-        mSpellInfoMap[difficulty].clear();
     }
 }
 
+void SpellMgr::UnloadSpellInfoStore()
+{
+    for (uint32 i = 0; i < mSpellInfoMap.size(); ++i)
+        delete mSpellInfoMap[i];
+
+    for (uint32 i = 0; i < mSpellDifficultyInfos.size(); ++i)
+        delete mSpellDifficultyInfos[i];
+
+    mSpellInfoMap.clear();
+    mSpellDifficultyRows.clear();
+    mSpellDifficultyInfos.clear();
+    mSpellDifficultyLookup.clear();
+}
+
 void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
 {
-    for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
+    for (uint32 i = 0; i < mSpellInfoMap.size(); ++i)
     {
-        for (uint32 i = 0; i < mSpellInfoMap[difficulty].size(); ++i)
-        {
-            if (mSpellInfoMap[difficulty][i])
-                mSpellInfoMap[difficulty][i]->_UnloadImplicitTargetConditionLists();
-        }
+        if (mSpellInfoMap[i])
+            mSpellInfoMap[i]->_UnloadImplicitTargetConditionLists();
+    }
+
+    for (uint32 i = 0; i < mSpellDifficultyInfos.size(); ++i)
+    {
+        if (mSpellDifficultyInfos[i])
+            mSpellDifficultyInfos[i]->_UnloadImplicitTargetConditionLists();
     }
 }
 
@@ -3221,7 +3319,7 @@ void SpellMgr::LoadSpellCustomAttr()
     {
         for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
         {
-            spellInfo = mSpellInfoMap[difficulty][i];
+            spellInfo = GetSpellInfoForDifficulty(i, difficulty);
             if (!spellInfo)
                 continue;
 
@@ -6886,7 +6984,9 @@ void SpellMgr::LoadSpellCustomAttr()
                 std::unordered_map<uint32, SpellVisualMap> l_VisualsBySpell;
                 SpellInfo* fishingDummy = new SpellInfo(sSpellStore.LookupEntry(131474), difficulty, std::move(l_VisualsBySpell[spellInfo->Effects[0].TriggerSpell]));
                 fishingDummy->Id = spellInfo->Effects[0].TriggerSpell;
-                mSpellInfoMap[difficulty][spellInfo->Effects[0].TriggerSpell] = fishingDummy;
+                SetSpellInfoForDifficulty(spellInfo->Effects[0].TriggerSpell, difficulty, fishingDummy);
+                if (mSpellDifficultyRows[spellInfo->Effects[0].TriggerSpell])
+                    ResolveSpellDifficulty(spellInfo->Effects[0].TriggerSpell);
                 break;
             }
             /// Mogu'shan Vault
@@ -7854,21 +7954,12 @@ const SpellInfo* SpellMgr::GetSpellInfo(uint32 p_SpellID, Difficulty p_Difficult
 {
     if (p_SpellID < GetSpellInfoStoreSize())
     {
-        if (p_Difficulty != DifficultyNone)
-        {
-            /// If spell isn't available in difficulty we want, check fallback difficulty ...
-            DifficultyEntry const* l_Difficulty = sDifficultyStore.LookupEntry(p_Difficulty);
-            while (l_Difficulty != nullptr)
-            {
-                SpellInfo const* l_SpellInfo = mSpellInfoMap[l_Difficulty->ID][p_SpellID];
-                if (l_SpellInfo != nullptr)
-                    return l_SpellInfo;
-
-                l_Difficulty = sDifficultyStore.LookupEntry(l_Difficulty->FallbackDifficultyID);
-            }
-        }
+        /// Fallback difficulties are resolved at load, see ResolveSpellDifficulty
+        uint32 l_Row = mSpellDifficultyRows[p_SpellID];
+        if (l_Row && p_Difficulty != DifficultyNone && p_Difficulty < Difficulty::MaxDifficulties)
+            return mSpellDifficultyLookup[(l_Row - 1) * Difficulty::MaxDifficulties + p_Difficulty];
 
-        return mSpellInfoMap[DifficultyNone][p_SpellID];
+        return mSpellInfoMap[p_SpellID];
     }
 
     return nullptr;
@@ -708,7 +708,7 @@ class SpellMgr
         // SpellInfo object management
         SpellInfo const* GetSpellInfo(uint32 spellId, Difficulty difficulty = DifficultyNone) const;
         int64 GetSpellVisualOverride(uint32 p_SpellID) const;
-        uint32 GetSpellInfoStoreSize() const { return mSpellInfoMap[DifficultyNone].size(); }
+        uint32 GetSpellInfoStoreSize() const { return mSpellInfoMap.size(); }
         std::set<uint32> GetSpellClassList(uint8 ClassID) const { return mSpellClassInfo[ClassID]; }
         std::list<uint32> GetSpellPowerList(uint32 spellId) const { return mSpellPowerInfo[spellId]; }
         TalentsPlaceHoldersSpell GetTalentPlaceHoldersSpell() const { return mPlaceHolderSpells; }
@@ -824,6 +824,12 @@ class SpellMgr
         std::vector<uint32>        mSpellCreateItemList;
 
     private:
+        /// Spell info loaded for exactly this difficulty, without fallback
+        SpellInfo* GetSpellInfoForDifficulty(uint32 p_SpellID, uint32 p_Difficulty) const;
+        void SetSpellInfoForDifficulty(uint32 p_SpellID, uint32 p_Difficulty, SpellInfo* p_SpellInfo);
+        /// Fills the overlay lookup row of a spell by walking the DifficultyEntry fallback chains once
+        void ResolveSpellDifficulty(uint32 p_SpellID);
+
         SpellDifficultySearcherMap mSpellDifficultySearcherMap;
         SpellChainMap              mSpellChains;
         SpellsRequiringSpellMap    mSpellsReqSpell;
@@ -851,7 +857,10 @@ class SpellMgr
         SkillLineAbilityMap        mSkillLineAbilityMap;
         PetLevelupSpellMap         mPetLevelupSpellMap;
         PetDefaultSpellsMap        mPetDefaultSpellsMap;           // only spells not listed in related mPetLevelupSpellMap entry
-        SpellInfoMap               mSpellInfoMap[Difficulty::MaxDifficulties];
+        SpellInfoMap               mSpellInfoMap;                  // DifficultyNone spell infos, indexed by spell id
+        std::vector<uint32>        mSpellDifficultyRows;           // spell id -> overlay row + 1, 0 for the spells without difficulty data
+        SpellInfoMap               mSpellDifficultyInfos;          // overlay, MaxDifficulties loaded spell infos per row
+        std::vector<SpellInfo const*> mSpellDifficultyLookup;      // overlay, MaxDifficulties spell infos per row with the fallback chain resolved
         SpellClassList             mSpellClassInfo;
         SpecializatioPerkMap       mSpecializationPerks;
         TalentSpellSet             mTalentSpellInfo;
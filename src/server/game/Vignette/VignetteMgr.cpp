@@ -16,16 +16,22 @@
 #include "AreaTrigger.h"
 #include "Conversation.hpp"
 #include "Object.h"
+#include "Map.h"
 
 namespace Vignette
 {
     Manager::Manager(Player const* p_Player)
     {
-        m_Owner = p_Player;
+        m_Owner              = p_Player;
+        m_Registry           = nullptr;
+        m_RegistryGeneration = 0;
+        m_NeedResync         = false;
     }
 
     Manager::~Manager()
     {
+        DetachFromRegistry();
+
         m_Owner = nullptr;
 
         for (auto l_Iterator : m_Vignettes)
@@ -47,6 +53,7 @@ namespace Vignette
 
         m_Vignettes.insert(std::make_pair(l_Vignette->GetGuid(), l_Vignette));
         m_AddedVignette.insert(l_Vignette->GetGuid());
+        TrackSource(l_Vignette);
 
         return l_Vignette;
     }
@@ -60,6 +67,7 @@ namespace Vignette
         {
             if (l_Iterator->second->GetVignetteEntry()->Id == p_VignetteEntry->Id)
             {
+                UntrackSource(l_Iterator->second);
                 delete l_Iterator->second;
                 m_RemovedVignette.insert(l_Iterator->first);
                 l_Iterator = m_Vignettes.erase(l_Iterator);
@@ -76,6 +84,7 @@ namespace Vignette
         {
             if (p_Lamba(l_Iterator->second))
             {
+                UntrackSource(l_Iterator->second);
                 delete l_Iterator->second;
                 m_RemovedVignette.insert(l_Iterator->first);
                 l_Iterator = m_Vignettes.erase(l_Iterator);
@@ -160,17 +169,110 @@ namespace Vignette
 
     void Manager::Update()
     {
-        for (auto l_Iterator : m_Vignettes)
+        /// - Follow the registry of the map the player is in, the previous one was left by Map::RemovePlayerFromMap
+        Registry* l_Registry = m_Owner->IsInWorld() ? m_Owner->GetMap()->GetVignetteRegistry() : nullptr;
+        if (l_Registry != m_Registry)
         {
-            auto l_Vignette = l_Iterator.second;
+            if (l_Registry != nullptr)
+                AttachToRegistry(l_Registry);
+            else
+                DetachFromRegistry();
+        }
 
-            /// - Update the position of the vignette if vignette is linked to a creature
-            if (IS_UNIT_GUID(l_Vignette->GeSourceGuid()))
+        /// - Update the position of the vignettes linked to a creature, the registry looked the creatures up once for the whole map
+        if (m_Registry != nullptr)
+        {
+            uint32 l_Generation = m_Registry->GetGeneration();
+            SourceChangeList const& l_Changes = m_Registry->GetChanges();
+
+            if (l_Generation != m_RegistryGeneration)
             {
-                Creature* l_SourceCreature = sObjectAccessor->FindCreature(l_Vignette->GeSourceGuid());
-                if (l_SourceCreature != nullptr)
-                    l_Vignette->UpdatePosition(G3D::Vector3(l_SourceCreature->GetPositionX(), l_SourceCreature->GetPositionY(), l_SourceCreature->GetPositionZ()));
+                /// Change sets were missed, or the player follows less sources than the map has changes
+                if (m_NeedResync || (l_Generation - m_RegistryGeneration) != 1 || m_VignettesBySource.size() < l_Changes.size())
+                {
+                    for (auto l_Iterator = m_VignettesBySource.begin(); l_Iterator != m_VignettesBySource.end(); l_Iterator = m_VignettesBySource.upper_bound(l_Iterator->first))
+                    {
+                        if (G3D::Vector3 const* l_Position = m_Registry->GetPosition(l_Iterator->first))
+                            UpdateSourcePosition(l_Iterator->first, *l_Position);
+                    }
+                }
+                else
+                {
+                    for (SourceChange const& l_Change : l_Changes)
+                        UpdateSourcePosition(l_Change.SourceGuid, l_Change.Position);
+                }
+
+                m_RegistryGeneration = l_Generation;
+                m_NeedResync         = false;
             }
+        }
+
+        /// Send update to client if needed
+        if (!m_AddedVignette.empty() || !m_UpdatedVignette.empty() || !m_RemovedVignette.empty())
+            SendVignetteUpdateToClient();
+    }
+
+    void Manager::DetachFromRegistry()
+    {
+        if (m_Registry == nullptr)
+            return;
+
+        for (auto const& l_Iterator : m_VignettesBySource)
+            m_Registry->Unsubscribe(l_Iterator.first);
+
+        m_Registry = nullptr;
+    }
+
+    void Manager::AttachToRegistry(Registry* p_Registry)
+    {
+        DetachFromRegistry();
+
+        m_Registry   = p_Registry;
+        m_NeedResync = true;
+
+        for (auto const& l_Iterator : m_VignettesBySource)
+            m_Registry->Subscribe(l_Iterator.first, l_Iterator.second->GetPosition());
+    }
+
+    void Manager::TrackSource(Vignette::Entity const* p_Vignette)
+    {
+        /// Only vignettes linked to a creature move with their source
+        if (!IS_UNIT_GUID(p_Vignette->GeSourceGuid()))
+            return;
+
+        m_VignettesBySource.insert(std::make_pair(p_Vignette->GeSourceGuid(), const_cast<Vignette::Entity*>(p_Vignette)));
+
+        if (m_Registry != nullptr)
+            m_Registry->Subscribe(p_Vignette->GeSourceGuid(), p_Vignette->GetPosition());
+    }
+
+    void Manager::UntrackSource(Vignette::Entity const* p_Vignette)
+    {
+        if (!IS_UNIT_GUID(p_Vignette->GeSourceGuid()))
+            return;
+
+        auto l_Range = m_VignettesBySource.equal_range(p_Vignette->GeSourceGuid());
+        for (auto l_Iterator = l_Range.first; l_Iterator != l_Range.second; ++l_Iterator)
+        {
+            if (l_Iterator->second != p_Vignette)
+                continue;
+
+            m_VignettesBySource.erase(l_Iterator);
+
+            if (m_Registry != nullptr)
+                m_Registry->Unsubscribe(p_Vignette->GeSourceGuid());
+
+            return;
+        }
+    }
+
+    void Manager::UpdateSourcePosition(uint64 const p_SourceGuid, G3D::Vector3 const& p_Position)
+    {
+        auto l_Range = m_VignettesBySource.equal_range(p_SourceGuid);
+        for (auto l_Iterator = l_Range.first; l_Iterator != l_Range.second; ++l_Iterator)
+        {
+            Vignette::Entity* l_Vignette = l_Iterator->second;
+            l_Vignette->UpdatePosition(p_Position);
 
             if (l_Vignette->NeedClientUpdate())
             {
@@ -178,12 +280,8 @@ namespace Vignette
                 l_Vignette->ResetNeedClientUpdate();
             }
         }
-
-        /// Send update to client if needed
-        if (!m_AddedVignette.empty() || !m_UpdatedVignette.empty() || !m_RemovedVignette.empty())
-            SendVignetteUpdateToClient();
     }
-    
+
     template <class T>
     inline void Manager::OnWorldObjectAppear(T const* p_Target)
     {
@@ -11,6 +11,7 @@
   
 # include "Common.h"
 # include "Vignette.hpp"
+# include "VignetteRegistry.hpp"
 
 class WorldObject;
 class GameObject;
@@ -60,9 +61,16 @@ namespace Vignette
 
             /**
             * Update the vignette manager, send vignette update to client if needed
+            * Positions of the vignettes following a creature come from the change set of the map registry
             */
             void Update();
 
+            /**
+            * Call by Map::RemovePlayerFromMap
+            * Stop following the sources of the vignettes in the registry of the map the player leaves
+            */
+            void DetachFromRegistry();
+
             /**
             * Call by Player::UpdateVisibilityOf
             * Hook to handle vignettes linked to WorldObjects
@@ -86,11 +94,40 @@ namespace Vignette
             */
             void SendVignetteUpdateToClient();
 
+            /**
+            * Subscribe the vignettes following a creature to the registry of the current map
+            * @param p_Registry : Registry of the map the player is in
+            */
+            void AttachToRegistry(Registry* p_Registry);
+
+            /**
+            * Index the vignette by source, and follow the source in the registry if any
+            * @param p_Vignette : The vignette added to m_Vignettes
+            */
+            void TrackSource(Vignette::Entity const* p_Vignette);
+
+            /**
+            * Reverse of TrackSource, must be called before the vignette is destroyed
+            * @param p_Vignette : The vignette removed from m_Vignettes
+            */
+            void UntrackSource(Vignette::Entity const* p_Vignette);
+
+            /**
+            * Update the position of the vignettes following a source, and queue their client update
+            * @param p_SourceGuid : Guid of the creature
+            * @param p_Position : New position of the creature
+            */
+            void UpdateSourcePosition(uint64 const p_SourceGuid, G3D::Vector3 const& p_Position);
+
             Player const*                m_Owner;                      ///< Player for who we handle the vignettes
             VignetteContainer            m_Vignettes;                  ///< Contains all the vignette the player can see
             std::set<uint64>             m_RemovedVignette;            ///< Contains all the removed vignettes to send to client at the next SMSG_VIGNETTE_UPDATE
             std::set<uint64>             m_AddedVignette;              ///< Contains all the added vignettes to send to client at the next SMSG_VIGNETTE_UPDATE
             std::set<uint64>             m_UpdatedVignette;            ///< Contains all the updated vignettes to send to client at the next SMSG_VIGNETTE_UPDATE
+            std::multimap<uint64, Vignette::Entity*> m_VignettesBySource;  ///< Vignettes following a creature, by guid of the creature
+            Registry*                    m_Registry;                   ///< Registry of the map the player is in, nullptr while not attached
+            uint32                       m_RegistryGeneration;         ///< Generation of the last change set applied
+            bool                         m_NeedResync;                 ///< Change sets were missed, positions must be read from the registry
     };
 }
 
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "VignetteRegistry.hpp"
+#include "Map.h"
+#include "Creature.h"
+
+namespace Vignette
+{
+    Registry::Registry(Map* p_Map)
+        : m_Map(p_Map), m_Generation(0)
+    {
+    }
+
+    void Registry::Subscribe(uint64 const p_SourceGuid, G3D::Vector3 const& p_Position)
+    {
+        auto l_Result = m_Sources.insert(std::make_pair(p_SourceGuid, Source()));
+        if (l_Result.second)
+        {
+            l_Result.first->second.Position   = p_Position;
+            l_Result.first->second.References = 0;
+        }
+
+        ++l_Result.first->second.References;
+    }
+
+    void Registry::Unsubscribe(uint64 const p_SourceGuid)
+    {
+        auto l_Iterator = m_Sources.find(p_SourceGuid);
+        if (l_Iterator == m_Sources.end())
+            return;
+
+        if (--l_Iterator->second.References == 0)
+            m_Sources.erase(l_Iterator);
+    }
+
+    void Registry::Update()
+    {
+        m_Changes.clear();
+        ++m_Generation;
+
+        for (auto& l_Iterator : m_Sources)
+        {
+            Creature* l_Creature = m_Map->GetCreature(l_Iterator.first);
+            if (l_Creature == nullptr)
+                continue;
+
+            G3D::Vector3& l_Position = l_Iterator.second.Position;
+
+            /// Same precision as Entity::UpdatePosition, the minimap doesn't need more
+            if ((int32)l_Position.x == (int32)l_Creature->GetPositionX() &&
+                (int32)l_Position.y == (int32)l_Creature->GetPositionY())
+                continue;
+
+            l_Position = G3D::Vector3(l_Creature->GetPositionX(), l_Creature->GetPositionY(), l_Creature->GetPositionZ());
+
+            SourceChange l_Change;
+            l_Change.SourceGuid = l_Iterator.first;
+            l_Change.Position   = l_Position;
+            m_Changes.push_back(l_Change);
+        }
+    }
+
+    G3D::Vector3 const* Registry::GetPosition(uint64 const p_SourceGuid) const
+    {
+        auto l_Iterator = m_Sources.find(p_SourceGuid);
+        if (l_Iterator == m_Sources.end())
+            return nullptr;
+
+        return &l_Iterator->second.Position;
+    }
+}
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef VIGNETTE_REGISTRY_HPP
+# define VIGNETTE_REGISTRY_HPP
+
+# include "Common.h"
+# include <G3D/Vector3.h>
+
+class Map;
+
+namespace Vignette
+{
+    /// Position change of a vignette source during the last registry update
+    struct SourceChange
+    {
+        uint64       SourceGuid;
+        G3D::Vector3 Position;
+    };
+
+    using SourceChangeList = std::vector<SourceChange>;
+
+    /// Per-map registry of the creatures followed by vignettes
+    /// Every player seeing a rare has its own vignette on it, the registry looks each source up once per map update and
+    /// publishes the sources which moved, the managers of the players then only apply that change set
+    class Registry
+    {
+        public:
+
+            /**
+            * Constructor of the vignette registry
+            * @param p_Map : Map owning the registry
+            */
+            Registry(Map* p_Map);
+
+            /**
+            * Start following a source, sources are reference counted by the managers
+            * @param p_SourceGuid : Guid of the creature
+            * @param p_Position : Current position of the creature
+            */
+            void Subscribe(uint64 const p_SourceGuid, G3D::Vector3 const& p_Position);
+
+            /**
+            * Stop following a source once the last manager unsubscribed
+            * @param p_SourceGuid : Guid of the creature
+            */
+            void Unsubscribe(uint64 const p_SourceGuid);
+
+            /**
+            * Refresh the position of every source and build the change set, called once per map update before the players
+            */
+            void Update();
+
+            /**
+            * Last known position of a source, nullptr if the source isn't followed
+            * @param p_SourceGuid : Guid of the creature
+            */
+            G3D::Vector3 const* GetPosition(uint64 const p_SourceGuid) const;
+
+            /**
+            * Sources which moved during the last update
+            */
+            SourceChangeList const& GetChanges() const { return m_Changes; }
+
+            /**
+            * Incremented by each update, a manager which missed one must resynchronize from GetPosition
+            */
+            uint32 GetGeneration() const { return m_Generation; }
+
+        private:
+
+            struct Source
+            {
+                G3D::Vector3 Position;                 ///< Position sent to the clients, only whole yards changes are published
+                uint32       References;               ///< Number of vignettes following the source
+            };
+
+            Map*                               m_Map;               ///< Map of the sources
+            std::unordered_map<uint64, Source> m_Sources;           ///< Followed sources by guid
+            SourceChangeList                   m_Changes;           ///< Change set of the last update
+            uint32                             m_Generation;        ///< Update counter
+    };
+}
+
+#endif ///< VIGNETTE_REGISTRY_HPP
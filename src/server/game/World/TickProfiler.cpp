@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TickProfiler.h"
+#include "Log.h"
+
+TickProfiler::TickProfiler()
+    : m_Active(false), m_CaptureId(0), m_PendingTicks(0), m_RemainingTicks(0), m_MaxEventsPerThread(0), m_TickStart(0), m_WorldThreadIndex(0)
+{
+}
+
+TickProfiler::~TickProfiler()
+{
+    for (TickProfilerThreadBuffer* l_Buffer : m_Buffers)
+        delete l_Buffer;
+}
+
+bool TickProfiler::StartCapture(uint32 p_TickCount, uint32 p_MaxEventsPerThread, std::string const& p_FileName)
+{
+    if (IsCapturing() || IsCapturePending() || !p_TickCount)
+        return false;
+
+    /// Started on the next BeginTick, commands are handled in the middle of a world tick
+    m_PendingTicks       = std::min(p_TickCount, uint32(TICK_PROFILER_MAX_TICKS));
+    m_MaxEventsPerThread = std::max(p_MaxEventsPerThread, uint32(1024));
+    m_FileName           = p_FileName;
+    return true;
+}
+
+void TickProfiler::BeginTick()
+{
+    if (m_PendingTicks)
+    {
+        m_RemainingTicks = m_PendingTicks;
+        m_PendingTicks   = 0;
+        m_CaptureStart   = std::chrono::high_resolution_clock::now();
+
+        ++m_CaptureId;
+        m_Active.store(true, std::memory_order_release);
+
+        m_WorldThreadIndex = GetThreadBuffer()->ThreadIndex;
+    }
+
+    if (IsCapturing())
+        m_TickStart = GetTime();
+}
+
+void TickProfiler::EndTick()
+{
+    if (!IsCapturing())
+        return;
+
+    AddEvent("World tick", m_TickStart, uint32(GetTime() - m_TickStart));
+
+    if (--m_RemainingTicks)
+        return;
+
+    m_Active.store(false, std::memory_order_release);
+    Export();
+}
+
+uint64 TickProfiler::GetTime() const
+{
+    return uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - m_CaptureStart).count());
+}
+
+TickProfilerThreadBuffer* TickProfiler::GetThreadBuffer()
+{
+    /// Creates the slot on the first call of the thread, ts_object() would only return an existing one
+    TickProfilerThreadSlot* l_Slot = m_ThreadSlot;
+    if (!l_Slot)
+        return nullptr;
+
+    if (!l_Slot->Buffer)
+    {
+        std::lock_guard<std::mutex> l_Guard(m_BuffersLock);
+        l_Slot->Buffer = new TickProfilerThreadBuffer(uint32(m_Buffers.size()));
+        m_Buffers.push_back(l_Slot->Buffer);
+    }
+
+    return l_Slot->Buffer;
+}
+
+void TickProfiler::AddEvent(char const* p_Name, uint64 p_Start, uint32 p_Duration, uint32 p_Arg /*= 0*/)
+{
+    if (!IsCapturing())
+        return;
+
+    TickProfilerThreadBuffer* l_Buffer = GetThreadBuffer();
+    if (!l_Buffer)
+        return;
+
+    /// First event of this thread in the capture, the buffer is only allocated for the profiled threads
+    uint32 l_CaptureId = m_CaptureId.load(std::memory_order_relaxed);
+    if (l_Buffer->CaptureId != l_CaptureId)
+    {
+        l_Buffer->CaptureId = l_CaptureId;
+        l_Buffer->Events.resize(m_MaxEventsPerThread);
+        l_Buffer->Count.store(0, std::memory_order_relaxed);
+        l_Buffer->Dropped = 0;
+    }
+
+    uint32 l_Count = l_Buffer->Count.load(std::memory_order_relaxed);
+    if (l_Count >= l_Buffer->Events.size())
+    {
+        ++l_Buffer->Dropped;
+        return;
+    }
+
+    TickProfilerEvent& l_Event = l_Buffer->Events[l_Count];
+    l_Event.Name     = p_Name;
+    l_Event.Start    = p_Start;
+    l_Event.Duration = p_Duration;
+    l_Event.Arg      = p_Arg;
+
+    l_Buffer->Count.store(l_Count + 1, std::memory_order_release);
+}
+
+/// Called by the world thread at the end of the last captured tick, map threads are idle at this point
+void TickProfiler::Export()
+{
+    FILE* l_File = fopen(m_FileName.c_str(), "w");
+    if (!l_File)
+        sLog->outError(LOG_FILTER_GENERAL, "TickProfiler::Export: can't open %s", m_FileName.c_str());
+
+    uint32 l_CaptureId = m_CaptureId.load(std::memory_order_relaxed);
+    uint32 l_EventCount = 0;
+    uint32 l_DroppedCount = 0;
+    bool l_First = true;
+
+    std::lock_guard<std::mutex> l_Guard(m_BuffersLock);
+
+    if (l_File)
+        fprintf(l_File, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    for (TickProfilerThreadBuffer* l_Buffer : m_Buffers)
+    {
+        if (l_Buffer->CaptureId != l_CaptureId)
+            continue;
+
+        uint32 l_Count = l_Buffer->Count.load(std::memory_order_acquire);
+
+        if (l_File)
+        {
+            fprintf(l_File, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}", l_First ? "" : ",\n",
+                l_Buffer->ThreadIndex, l_Buffer->ThreadIndex == m_WorldThreadIndex ? "World" : "Map thread", l_Buffer->ThreadIndex);
+            l_First = false;
+
+            for (uint32 l_I = 0; l_I < l_Count; ++l_I)
+            {
+                TickProfilerEvent const& l_Event = l_Buffer->Events[l_I];
+                fprintf(l_File, ",\n{\"name\":\"%s\",\"cat\":\"tick\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":" UI64FMTD ",\"dur\":%u",
+                    l_Event.Name, l_Buffer->ThreadIndex, l_Event.Start, l_Event.Duration);
+
+                if (l_Event.Arg)
+                    fprintf(l_File, ",\"args\":{\"id\":%u}", l_Event.Arg);
+
+                fprintf(l_File, "}");
+            }
+        }
+
+        l_EventCount   += l_Count;
+        l_DroppedCount += l_Buffer->Dropped;
+
+        /// Release the capture memory, it can be hundreds of MB on a crowded realm
+        std::vector<TickProfilerEvent>().swap(l_Buffer->Events);
+        l_Buffer->Count.store(0, std::memory_order_relaxed);
+    }
+
+    if (!l_File)
+        return;
+
+    fprintf(l_File, "\n]}\n");
+    fclose(l_File);
+
+    sLog->outInfo(LOG_FILTER_GENERAL, "TickProfiler: %u events written in %s (%u dropped, buffers full)", l_EventCount, m_FileName.c_str(), l_DroppedCount);
+}
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TICKPROFILER_H
+# define TICKPROFILER_H
+
+#include "Common.h"
+
+#include <chrono>
+#include <ace/TSS_T.h>
+
+#define TICK_PROFILER_MAX_TICKS 1000
+
+/// One closed zone, times are in microseconds since the capture start
+struct TickProfilerEvent
+{
+    char const* Name;           ///< Must be a string literal
+    uint64 Start;
+    uint32 Duration;
+    uint32 Arg;                 ///< Map id, entry, spell id... 0 if none
+};
+
+/// Events of one thread, only written by its owner thread
+struct TickProfilerThreadBuffer
+{
+    TickProfilerThreadBuffer(uint32 p_ThreadIndex) : ThreadIndex(p_ThreadIndex), CaptureId(0), Count(0), Dropped(0) { }
+
+    uint32 ThreadIndex;
+    uint32 CaptureId;
+    std::vector<TickProfilerEvent> Events;
+    std::atomic<uint32> Count;  ///< Number of events published in Events
+    uint32 Dropped;
+};
+
+/// Per thread pointer to the buffer, the buffers themselves are owned by the profiler
+/// so they survive the thread for the export
+struct TickProfilerThreadSlot
+{
+    TickProfilerThreadSlot() : Buffer(nullptr) { }
+
+    TickProfilerThreadBuffer* Buffer;
+};
+
+/// Hierarchical profiler of the world ticks
+/// Zones are recorded lock free in per thread buffers while a capture runs and exported
+/// as a Chrome trace (chrome://tracing) once the requested number of ticks elapsed
+class TickProfiler
+{
+    public:
+        TickProfiler();
+        ~TickProfiler();
+
+        /// Capture the p_TickCount next world ticks into p_FileName
+        bool StartCapture(uint32 p_TickCount, uint32 p_MaxEventsPerThread, std::string const& p_FileName);
+
+        bool IsCapturing() const { return m_Active.load(std::memory_order_acquire); }
+        bool IsCapturePending() const { return m_PendingTicks != 0; }
+        uint32 GetRemainingTicks() const { return m_RemainingTicks; }
+        std::string const& GetFileName() const { return m_FileName; }
+
+        /// World thread, around each World::Update
+        void BeginTick();
+        void EndTick();
+
+        /// Microseconds since the capture start
+        uint64 GetTime() const;
+        void AddEvent(char const* p_Name, uint64 p_Start, uint32 p_Duration, uint32 p_Arg = 0);
+
+    private:
+        TickProfilerThreadBuffer* GetThreadBuffer();
+        void Export();
+
+        std::atomic<bool> m_Active;
+        std::atomic<uint32> m_CaptureId;
+        std::chrono::high_resolution_clock::time_point m_CaptureStart;
+
+        uint32 m_PendingTicks;
+        uint32 m_RemainingTicks;
+        uint32 m_MaxEventsPerThread;
+        std::string m_FileName;
+
+        uint64 m_TickStart;
+        uint32 m_WorldThreadIndex;
+
+        std::mutex m_BuffersLock;
+        std::vector<TickProfilerThreadBuffer*> m_Buffers;
+        ACE_TSS<TickProfilerThreadSlot> m_ThreadSlot;
+};
+
+#define sTickProfiler ACE_Singleton<TickProfiler, ACE_Null_Mutex>::instance()
+
+/// Scoped zone, recorded only while a capture runs
+class TickProfilerZone
+{
+    public:
+        TickProfilerZone(char const* p_Name, uint32 p_Arg = 0) : m_Name(p_Name), m_Arg(p_Arg), m_Start(0), m_Active(sTickProfiler->IsCapturing())
+        {
+            if (m_Active)
+                m_Start = sTickProfiler->GetTime();
+        }
+
+        ~TickProfilerZone()
+        {
+            if (m_Active)
+                sTickProfiler->AddEvent(m_Name, m_Start, uint32(sTickProfiler->GetTime() - m_Start), m_Arg);
+        }
+
+    private:
+        char const* m_Name;
+        uint32 m_Arg;
+        uint64 m_Start;
+        bool m_Active;
+};
+
+#define TICK_PROFILE_CONCAT_IMPL(p_Left, p_Right) p_Left##p_Right
+#define TICK_PROFILE_CONCAT(p_Left, p_Right) TICK_PROFILE_CONCAT_IMPL(p_Left, p_Right)
+
+/// Profile the enclosing scope under p_Name, p_Name must be a string literal
+#define TICK_PROFILE_ZONE(p_Name) TickProfilerZone TICK_PROFILE_CONCAT(l_ProfilerZone, __LINE__)(p_Name)
+#define TICK_PROFILE_ZONE_ARG(p_Name, p_Arg) TickProfilerZone TICK_PROFILE_CONCAT(l_ProfilerZone, __LINE__)(p_Name, p_Arg)
+
+#endif // TICKPROFILER_H
@@ -91,6 +91,8 @@
 #include "WildBattlePet.h"
 #include "TransportMgr.h"
 #include "InterRealmOpcodes.h"
+#include "OpcodeStats.h"
+#include "TickProfiler.h"
 #include "MMapFactory.h"
 #include "TaxiPathGraph.h"
 #include "ChatLexicsCutter.h"
@@ -151,6 +153,7 @@ World::World()
 
     m_updateTimeSum = 0;
     m_updateTimeCount = 0;
+    m_ProfilerSectionStart = 0;
 
     m_serverDelaySum = 0;
     m_serverDelayTimer = 0;
@@ -682,6 +685,17 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr->SetGridCleanUpDelay(m_int_configs[CONFIG_INTERVAL_GRIDCLEAN]);
 
+    m_bool_configs[CONFIG_GRID_PRELOAD_ENABLE] = ConfigMgr::GetBoolDefault("GridPreload.Enable", false);
+    m_int_configs[CONFIG_GRID_PRELOAD_THREADS] = ConfigMgr::GetIntDefault("GridPreload.Threads", 1);
+    m_int_configs[CONFIG_GRID_PRELOAD_INTERVAL] = ConfigMgr::GetIntDefault("GridPreload.Interval", 1000);
+    m_int_configs[CONFIG_GRID_PRELOAD_LOOKAHEAD] = ConfigMgr::GetIntDefault("GridPreload.LookAhead", 20);
+
+    m_bool_configs[CONFIG_GRID_RECLAIM_ENABLE] = ConfigMgr::GetBoolDefault("GridReclaim.Enable", false);
+    m_int_configs[CONFIG_GRID_RECLAIM_OBJECTS_PER_TICK] = ConfigMgr::GetIntDefault("GridReclaim.ObjectsPerTick", 500);
+    m_int_configs[CONFIG_AUCTION_EXPIRED_PER_TICK] = ConfigMgr::GetIntDefault("AuctionHouse.ExpiredPerTick", 100);
+    m_int_configs[CONFIG_MAIL_EXPIRY_BATCH_SIZE] = ConfigMgr::GetIntDefault("MailExpiry.BatchSize", 500);
+    m_bool_configs[CONFIG_WORLD_SNAPSHOT_ENABLE] = ConfigMgr::GetBoolDefault("WorldSnapshot.Enable", false);
+
     m_int_configs[CONFIG_INTERVAL_MAPUPDATE] = ConfigMgr::GetIntDefault("MapUpdateInterval", 100);
     if (m_int_configs[CONFIG_INTERVAL_MAPUPDATE] < MIN_MAP_UPDATE_DELAY)
     {
@@ -1024,6 +1038,14 @@ void World::LoadConfigSettings(bool reload)
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Will clear `logs` table of entries older than %i seconds every %u minutes.",
         m_int_configs[CONFIG_LOGDB_CLEARTIME], m_int_configs[CONFIG_LOGDB_CLEARINTERVAL]);
 
+    m_bool_configs[CONFIG_OPCODE_STATS_ENABLE] = ConfigMgr::GetBoolDefault("OpcodeStats.Enable", true);
+    m_int_configs[CONFIG_OPCODE_STATS_INTERVAL] = ConfigMgr::GetIntDefault("OpcodeStats.Interval", 60);
+    m_int_configs[CONFIG_OPCODE_STATS_TOP_COUNT] = ConfigMgr::GetIntDefault("OpcodeStats.TopCount", 10);
+    sOpcodeStats->SetEnabled(m_bool_configs[CONFIG_OPCODE_STATS_ENABLE]);
+    sOpcodeStats->SetInterval(m_int_configs[CONFIG_OPCODE_STATS_INTERVAL] * IN_MILLISECONDS, m_int_configs[CONFIG_OPCODE_STATS_TOP_COUNT]);
+
+    m_int_configs[CONFIG_TICK_PROFILER_MAX_EVENTS] = ConfigMgr::GetIntDefault("TickProfiler.MaxEventsPerThread", 262144);
+
     m_int_configs[CONFIG_SKILL_CHANCE_ORANGE] = ConfigMgr::GetIntDefault("SkillChance.Orange", 100);
     m_int_configs[CONFIG_SKILL_CHANCE_YELLOW] = ConfigMgr::GetIntDefault("SkillChance.Yellow", 75);
     m_int_configs[CONFIG_SKILL_CHANCE_GREEN]  = ConfigMgr::GetIntDefault("SkillChance.Green", 25);
@@ -1266,6 +1288,9 @@ void World::LoadConfigSettings(bool reload)
     }
 
     m_bool_configs[CONFIG_ENABLE_MMAPS] = ConfigMgr::GetBoolDefault("mmap.enablePathFinding", true);
+    m_int_configs[CONFIG_PATHFINDING_CACHE_SIZE] = ConfigMgr::GetIntDefault("mmap.pathCacheSize", 512);
+    m_bool_configs[CONFIG_PATHFINDING_ASYNC_ENABLE] = ConfigMgr::GetBoolDefault("mmap.asyncPathFinding", false);
+    m_int_configs[CONFIG_PATHFINDING_ASYNC_THREADS] = ConfigMgr::GetIntDefault("mmap.asyncPathFindingThreads", 2);
     
 
     m_bool_configs[CONFIG_ENABLE_QUEST]              = ConfigMgr::GetBoolDefault("loading.quest", true);
@@ -1487,13 +1512,17 @@ void World::LoadConfigSettings(bool reload)
     m_lexicsCutter = new LexicsCutter();
     m_lexicsCutter->ReadLetterAnalogs(fn_analogsfile);
     m_lexicsCutter->ReadInnormativeWords(fn_wordsfile);
-    m_lexicsCutter->MapInnormativeWords();
 
-    // read additional parameters
+    // read additional parameters, they are compiled into the automaton
     m_lexicsCutter->IgnoreLetterRepeat = ConfigMgr::GetBoolDefault("LexicsCutterIgnoreRepeats", true);
     m_lexicsCutter->IgnoreMiddleSpaces = ConfigMgr::GetBoolDefault("LexicsCutterIgnoreSpaces", true);
     m_lexicsCutter->CheckLetterContains = ConfigMgr::GetBoolDefault("LexicsCutterCheckContains", false);
 
+    if (m_lexicsCutter->Build())
+        sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Lexics cutter: %u words compiled into %u states", m_lexicsCutter->GetWordCount(), m_lexicsCutter->GetStateCount());
+    else
+        sLog->outError(LOG_FILTER_SERVER_LOADING, "Lexics cutter: %u words need more than %u states, falling back to the per-word scan", m_lexicsCutter->GetWordCount(), LEXICS_CUTTER_MAX_STATES);
+
 #ifndef CROSS
     // InterRealm settings
     m_bool_configs[CONFIG_INTERREALM_ENABLE] = ConfigMgr::GetBoolDefault("InterRealm.Enabled", false);
@@ -2349,6 +2378,16 @@ void World::DetectDBCLang()
 
 void World::RecordTimeDiff(const char *text, ...)
 {
+    /// Sections are also reported as tick profiler zones while a capture runs, text is a literal at every call site
+    if (sTickProfiler->IsCapturing())
+    {
+        uint64 l_Now = sTickProfiler->GetTime();
+        if (text && m_ProfilerSectionStart <= l_Now)
+            sTickProfiler->AddEvent(text, m_ProfilerSectionStart, uint32(l_Now - m_ProfilerSectionStart));
+
+        m_ProfilerSectionStart = l_Now;
+    }
+
     if (m_updateTimeCount != 1)
         return;
     if (!text)
@@ -2521,11 +2560,11 @@ void World::Update(uint32 diff)
             mail_timer = 0;
             sObjectMgr->ReturnOrDeleteOldMails(true);
         }
-
-        ///- Handle expired auctions
-        sAuctionMgr->Update();
     }
 
+    ///- Handle expired auctions, only the auctions at the front of the expiry index are looked at
+    sAuctionMgr->Update();
+
     if (m_timers[WUPDATE_REALM_STATS].Passed())
     {
         m_timers[WUPDATE_REALM_STATS].Reset();
@@ -2641,7 +2680,6 @@ void World::Update(uint32 diff)
 #endif
 
     sPetBattleSystem->Update(diff);
-    sWildBattlePetMgr->Update(diff);
 
     sLFGMgr->Update(diff);
     SetRecordDiff(RECORD_DIFF_LFG, getMSTime() - diffTime);
@@ -2752,6 +2790,7 @@ void World::Update(uint32 diff)
     ProcessCliCommands();
 
     sTimeDiffMgr->Update(diff);
+    sOpcodeStats->Update(diff);
 
     sScriptMgr->OnWorldUpdate(diff);
 }
@@ -4183,7 +4222,7 @@ void World::UpdatePhaseDefinitions()
 #endif
 }
 
-bool World::ModerateMessage(std::string l_Text)
+bool World::ModerateMessage(std::string const& l_Text)
 {
     if (!m_lexicsCutter)
         return false;
@@ -223,6 +223,11 @@ enum WorldBoolConfigs
     CONFIG_ENABLE_RESEARCH_SITE_LOAD,
     CONFIG_ENABLE_ITEM_SPEC_LOAD,
     CONFIG_MUST_HAVE_AUTHENTICATOR_ACCESS,
+    CONFIG_PATHFINDING_ASYNC_ENABLE,
+    CONFIG_OPCODE_STATS_ENABLE,
+    CONFIG_GRID_PRELOAD_ENABLE,
+    CONFIG_GRID_RECLAIM_ENABLE,
+    CONFIG_WORLD_SNAPSHOT_ENABLE,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -426,6 +431,17 @@ enum WorldIntConfigs
     CONFIG_ACCOUNT_BIND_SHOP_GROUP_MASK,
     CONFIG_ACCOUNT_BIND_ALLOWED_GROUP_MASK,
     CONFIG_ONLY_MAP,
+    CONFIG_PATHFINDING_CACHE_SIZE,
+    CONFIG_PATHFINDING_ASYNC_THREADS,
+    CONFIG_OPCODE_STATS_INTERVAL,
+    CONFIG_OPCODE_STATS_TOP_COUNT,
+    CONFIG_TICK_PROFILER_MAX_EVENTS,
+    CONFIG_GRID_PRELOAD_THREADS,
+    CONFIG_GRID_PRELOAD_INTERVAL,
+    CONFIG_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_GRID_RECLAIM_OBJECTS_PER_TICK,
+    CONFIG_AUCTION_EXPIRED_PER_TICK,
+    CONFIG_MAIL_EXPIRY_BATCH_SIZE,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -1002,7 +1018,7 @@ class World
         uint32 GetRecordDiff(RecordDiffType recordDiff) { return m_recordDiff[recordDiff]; }
 
 
-        bool ModerateMessage(std::string l_Text);
+        bool ModerateMessage(std::string const& l_Text);
 
         //////////////////////////////////////////////////////////////////////////
         /// New callback system
@@ -1079,6 +1095,7 @@ class World
         uint32 m_updateTime, m_updateTimeSum;
         uint32 m_updateTimeCount;
         uint32 m_currentTime;
+        uint64 m_ProfilerSectionStart;              ///< Start of the current RecordTimeDiff section in the tick profiler timeline
 
         uint32 m_serverDelayTimer;
         uint32 m_serverDelaySum;
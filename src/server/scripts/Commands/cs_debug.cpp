@@ -2790,7 +2790,15 @@ class debug_commandscript: public CommandScript
 
         static bool HandleDebugLoadZ(ChatHandler* handler, char const* /*args*/)
         {
-            for (auto gameobject: sObjectMgr->_gameObjectDataStore)
+            // copied first, creating the maps reads the store
+            std::vector<std::pair<uint32, GameObjectData>> gameobjects;
+            sObjectMgr->_gameObjectDataStore.ForEach([&gameobjects](uint32 guid, GameObjectData const& data)
+            {
+                if (!data.posZ)
+                    gameobjects.push_back(std::make_pair(guid, data));
+            });
+
+            for (auto gameobject: gameobjects)
             {
                 GameObjectData data = gameobject.second;
 
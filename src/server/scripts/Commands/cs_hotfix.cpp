@@ -5,6 +5,7 @@
 #include "GarrisonMgr.hpp"
 #endif /* not CROSS */
 #include "ObjectMgr.h"
+#include "LootMgr.h"
 
 /// HotFix commands
 class hotfix_commandscript : public CommandScript
@@ -101,6 +102,7 @@ class hotfix_commandscript : public CommandScript
                 sObjectMgr->LoadItemTemplates();
                 sObjectMgr->LoadItemTemplateAddon();
                 sObjectMgr->LoadItemTemplateCorrections();
+                LoadLootItemTemplates();
             }
 
             return true;
@@ -21,6 +21,9 @@
 #include "Player.h"
 #include "PointMovementGenerator.h"
 #include "PathGenerator.h"
+#include "PathCache.h"
+#include "FlowField.h"
+#include "PathfindingService.h"
 #include "MMapFactory.h"
 #include "Map.h"
 #include "TargetedMovementGenerator.h"
@@ -253,6 +256,26 @@ public:
         handler->PSendSysMessage(" %u triangles (%u vertices)", triCount, triVertCount);
         handler->PSendSysMessage(" %.2f MB of data (not including pointers)", ((float)dataSize / sizeof(unsigned char)) / 1048576);
 
+        if (PathCache const* pathCache = handler->GetSession()->GetPlayer()->GetMap()->GetPathCache())
+        {
+            handler->PSendSysMessage("Path cache stats:");
+            handler->PSendSysMessage(" %u / %u corridors cached", pathCache->GetSize(), pathCache->GetMaxSize());
+            handler->PSendSysMessage(" " UI64FMTD " hits, " UI64FMTD " misses", pathCache->GetHits(), pathCache->GetMisses());
+        }
+
+        if (FlowFieldMgr const* flowFields = handler->GetSession()->GetPlayer()->GetMap()->GetFlowFieldMgr())
+        {
+            handler->PSendSysMessage("Flow field stats:");
+            handler->PSendSysMessage(" %u fields, " UI64FMTD " builds, " UI64FMTD " corridors served", flowFields->GetFieldCount(), flowFields->GetBuildCount(), flowFields->GetHitCount());
+        }
+
+        if (sPathfindingService->IsEnabled())
+        {
+            handler->PSendSysMessage("Async pathfinding stats:");
+            handler->PSendSysMessage(" " UI64FMTD " submitted, " UI64FMTD " completed, " UI64FMTD " dropped",
+                sPathfindingService->GetSubmittedCount(), sPathfindingService->GetCompletedCount(), sPathfindingService->GetDroppedCount());
+        }
+
         return true;
     }
 
@@ -19,6 +19,13 @@ EndScriptData */
 #include "Config.h"
 #include "ObjectAccessor.h"
 #include "MapManager.h"
+#include "OpcodeStats.h"
+#include "TickProfiler.h"
+#include "GridPreloader.h"
+#include "PoolAllocator.h"
+#include "WildBattlePet.h"
+#include "SmartScriptMgr.h"
+#include "AchievementMgr.h"
 #include <regex>
 
 class server_commandscript : public CommandScript
@@ -64,18 +71,41 @@ public:
             { NULL,             0,                  false, NULL,                                    "", NULL }
         };
 
+        static ChatCommand serverOpcodesCommandTable[] =
+        {
+            { "top",            SEC_ADMINISTRATOR,  true,  &HandleServerOpcodesTopCommand,          "", NULL },
+            { "total",          SEC_ADMINISTRATOR,  true,  &HandleServerOpcodesTotalCommand,        "", NULL },
+            { "info",           SEC_ADMINISTRATOR,  true,  &HandleServerOpcodesInfoCommand,         "", NULL },
+#ifndef CROSS
+            { "sessions",       SEC_ADMINISTRATOR,  true,  &HandleServerOpcodesSessionsCommand,     "", NULL },
+#endif /* not CROSS */
+            { "dump",           SEC_ADMINISTRATOR,  true,  &HandleServerOpcodesDumpCommand,         "", NULL },
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandleServerOpcodesResetCommand,        "", NULL },
+            { NULL,             0,                  false, NULL,                                    "", NULL }
+        };
+
         static ChatCommand serverCommandTable[] =
         {
+            { "achievements",   SEC_ADMINISTRATOR,  true,  &HandleServerAchievementsCommand,        "", NULL },
             { "corpses",        SEC_GAMEMASTER,     true,  &HandleServerCorpsesCommand,             "", NULL },
             { "exit",           SEC_CONSOLE,        true,  &HandleServerExitCommand,                "", NULL },
+            { "gridpreload",    SEC_ADMINISTRATOR,  true,  &HandleServerGridPreloadCommand,         "", NULL },
             { "idlerestart",    SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverIdleRestartCommandTable },
             { "idleshutdown",   SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverIdleShutdownCommandTable },
             { "info",           SEC_PLAYER,         true,  &HandleServerInfoCommand,                "", NULL },
+#ifndef CROSS
+            { "mailexpiry",     SEC_ADMINISTRATOR,  true,  &HandleServerMailExpiryCommand,          "", NULL },
+#endif /* not CROSS */
             { "motd",           SEC_PLAYER,         true,  &HandleServerMotdCommand,                "", NULL },
+            { "opcodes",        SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverOpcodesCommandTable },
             { "plimit",         SEC_ADMINISTRATOR,  true,  &HandleServerPLimitCommand,              "", NULL },
+            { "pools",          SEC_ADMINISTRATOR,  true,  &HandleServerPoolsCommand,               "", NULL },
+            { "profile",        SEC_ADMINISTRATOR,  true,  &HandleServerProfileCommand,             "", NULL },
             { "restart",        SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverRestartCommandTable },
             { "shutdown",       SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverShutdownCommandTable },
             { "set",            SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverSetCommandTable },
+            { "smartai",        SEC_ADMINISTRATOR,  true,  &HandleServerSmartAICommand,             "", NULL },
+            { "wildpets",       SEC_ADMINISTRATOR,  true,  &HandleServerWildPetsCommand,            "", NULL },
             { NULL,             0,                  false, NULL,                                    "", NULL }
         };
 
@@ -138,6 +168,331 @@ public:
 
         return true;
     }
+    static void SendOpcodeStatsEntries(ChatHandler* p_Handler, std::vector<OpcodeStatsEntry> const& p_Entries)
+    {
+        for (OpcodeStatsEntry const& l_Entry : p_Entries)
+        {
+            p_Handler->PSendSysMessage("%s count: " UI64FMTD " total: " UI64FMTD " ms avg: " UI64FMTD " us max: %u us",
+                GetOpcodeNameForLogging(l_Entry.Opcode, WOW_CLIENT_TO_SERVER).c_str(), l_Entry.Count, l_Entry.TotalTime / IN_MILLISECONDS,
+                l_Entry.Count ? l_Entry.TotalTime / l_Entry.Count : 0, l_Entry.MaxTime);
+        }
+    }
+
+    // Slowest opcode handlers of the last interval
+    static bool HandleServerOpcodesTopCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+    {
+        std::vector<OpcodeStatsEntry> const& l_Entries = sOpcodeStats->GetLastIntervalTop();
+
+        p_Handler->PSendSysMessage("Slowest opcode handlers of the last %u seconds:", sOpcodeStats->GetInterval() / IN_MILLISECONDS);
+        SendOpcodeStatsEntries(p_Handler, l_Entries);
+        return true;
+    }
+
+    // Slowest opcode handlers since startup
+    static bool HandleServerOpcodesTotalCommand(ChatHandler* p_Handler, char const* p_Args)
+    {
+        uint32 l_Count = *p_Args ? uint32(atoi(p_Args)) : 10;
+
+        std::vector<OpcodeStatsEntry> l_Entries;
+        sOpcodeStats->GetTotalTop(l_Entries, l_Count);
+
+        p_Handler->PSendSysMessage("Slowest opcode handlers since startup:");
+        SendOpcodeStatsEntries(p_Handler, l_Entries);
+        return true;
+    }
+
+    // Latency histogram of one opcode handler, by id or name
+    static bool HandleServerOpcodesInfoCommand(ChatHandler* p_Handler, char const* p_Args)
+    {
+        if (!*p_Args)
+            return false;
+
+        char* l_End = nullptr;
+        uint32 l_Opcode = strtoul(p_Args, &l_End, 0);
+
+        if (l_End == p_Args || *l_End != '\0')
+        {
+            l_Opcode = NUM_OPCODE_HANDLERS;
+            for (uint32 l_I = 0; l_I < NUM_OPCODE_HANDLERS; ++l_I)
+            {
+                OpcodeHandler const* l_Handler = g_OpcodeTable[WOW_CLIENT_TO_SERVER][l_I];
+                if (l_Handler && l_Handler->name && !stricmp(l_Handler->name, p_Args))
+                {
+                    l_Opcode = l_I;
+                    break;
+                }
+            }
+        }
+
+        OpcodeHandlerStats const* l_Stats = l_Opcode < NUM_OPCODE_HANDLERS ? sOpcodeStats->GetHandlerStats(uint16(l_Opcode)) : nullptr;
+        if (!l_Stats)
+        {
+            p_Handler->PSendSysMessage("Unknown opcode %s", p_Args);
+            p_Handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        uint64 l_Count = l_Stats->Count.load();
+        uint64 l_TotalTime = l_Stats->TotalTime.load();
+
+        p_Handler->PSendSysMessage("%s count: " UI64FMTD " avg: " UI64FMTD " us max: %u us p50: %u us p95: %u us p99: %u us",
+            GetOpcodeNameForLogging(uint16(l_Opcode), WOW_CLIENT_TO_SERVER).c_str(), l_Count, l_Count ? l_TotalTime / l_Count : 0, l_Stats->MaxTime.load(),
+            sOpcodeStats->GetPercentile(*l_Stats, 50.0f), sOpcodeStats->GetPercentile(*l_Stats, 95.0f), sOpcodeStats->GetPercentile(*l_Stats, 99.0f));
+
+        for (uint32 l_I = 0; l_I < OPCODE_STATS_BUCKET_COUNT; ++l_I)
+        {
+            if (uint32 l_BucketCount = l_Stats->Buckets[l_I].load())
+            {
+                if (l_I + 1 < OPCODE_STATS_BUCKET_COUNT)
+                    p_Handler->PSendSysMessage("  < %u us: %u", OpcodeStats::GetBucketLimit(l_I), l_BucketCount);
+                else
+                    p_Handler->PSendSysMessage("  >= %u us: %u", OpcodeStats::GetBucketLimit(l_I - 1), l_BucketCount);
+            }
+        }
+
+        return true;
+    }
+
+#ifndef CROSS
+    // Sessions receiving the most packets per second
+    static bool HandleServerOpcodesSessionsCommand(ChatHandler* p_Handler, char const* p_Args)
+    {
+        uint32 l_Count = *p_Args ? uint32(atoi(p_Args)) : 10;
+
+        std::vector<WorldSession*> l_Sessions;
+        for (auto const& l_Pair : sWorld->GetAllSessions())
+        {
+            if (l_Pair.second->GetReceiveRate())
+                l_Sessions.push_back(l_Pair.second);
+        }
+
+        l_Count = std::min(uint32(l_Sessions.size()), l_Count);
+        std::partial_sort(l_Sessions.begin(), l_Sessions.begin() + l_Count, l_Sessions.end(), [](WorldSession const* p_Left, WorldSession const* p_Right) -> bool
+        {
+            return p_Left->GetReceiveRate() > p_Right->GetReceiveRate();
+        });
+
+        p_Handler->PSendSysMessage("Sessions receiving the most packets:");
+        for (uint32 l_I = 0; l_I < l_Count; ++l_I)
+        {
+            WorldSession* l_Session = l_Sessions[l_I];
+            p_Handler->PSendSysMessage("Account %u (%s) %u packets/s, peak %u packets/s", l_Session->GetAccountId(), l_Session->GetPlayerName(false).c_str(),
+                l_Session->GetReceiveRate(), l_Session->GetPeakReceiveRate());
+        }
+
+        return true;
+    }
+#endif /* not CROSS */
+
+    // Write the opcode handler stats in the logs directory
+    static bool HandleServerOpcodesDumpCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+    {
+        std::string l_LogsDir = ConfigMgr::GetStringDefault("LogsDir", "");
+        if (!l_LogsDir.empty() && l_LogsDir[l_LogsDir.length() - 1] != '/' && l_LogsDir[l_LogsDir.length() - 1] != '\\')
+            l_LogsDir.push_back('/');
+
+        std::string l_FileName = l_LogsDir + "OpcodeStats_" + Log::GetTimestampStr() + ".log";
+        if (!sOpcodeStats->DumpToFile(l_FileName))
+        {
+            p_Handler->PSendSysMessage("Can't write opcode stats in %s", l_FileName.c_str());
+            p_Handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        p_Handler->PSendSysMessage("Opcode stats written in %s", l_FileName.c_str());
+        return true;
+    }
+
+    // Open world grid loads served by the preloader versus loaded on the map thread
+    static bool HandleServerGridPreloadCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+    {
+        uint64 l_Synchronous = sGridPreloader->GetSynchronousLoadCount();
+        uint64 l_Prefetched  = sGridPreloader->GetPrefetchedLoadCount();
+        uint64 l_Total       = l_Synchronous + l_Prefetched;
+
+        p_Handler->PSendSysMessage("Grid preloading %s", sGridPreloader->IsEnabled() ? "enabled" : "disabled");
+        p_Handler->PSendSysMessage("Open world grid loads: " UI64FMTD " prefetched, " UI64FMTD " synchronous (%.1f%% prefetched)", l_Prefetched, l_Synchronous,
+            l_Total ? 100.0f * l_Prefetched / l_Total : 0.0f);
+        p_Handler->PSendSysMessage("Preloads: " UI64FMTD " submitted, " UI64FMTD " completed, " UI64FMTD " too late, " UI64FMTD " unused", sGridPreloader->GetSubmittedCount(),
+            sGridPreloader->GetCompletedCount(), sGridPreloader->GetLateCount(), sGridPreloader->GetWastedCount());
+        return true;
+    }
+
+    static bool HandleServerPoolsCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+    {
+        std::vector<PoolAllocatorStats> l_Stats;
+        PoolAllocator::GetAllStats(l_Stats);
+
+        for (PoolAllocatorStats const& l_Pool : l_Stats)
+        {
+            p_Handler->PSendSysMessage("%s: %u bytes blocks, " UI64FMTD " in use / " UI64FMTD " in %u slabs (%u KB), " UI64FMTD " allocations, " UI64FMTD " oversized, %u threads",
+                l_Pool.Name.c_str(), l_Pool.BlockSize, l_Pool.InUse, l_Pool.Capacity, l_Pool.SlabCount, uint32(l_Pool.Capacity * l_Pool.BlockSize / 1024),
+                l_Pool.Allocations, l_Pool.Oversized, l_Pool.ThreadCount);
+        }
+
+        return true;
+    }
+
+    static bool HandleServerWildPetsCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+    {
+        for (auto const& l_MapPools : sWildBattlePetMgr->GetPoolsByMap())
+        {
+            for (auto const& l_ZonePools : l_MapPools.second.Zones)
+            {
+                WildBattlePetZonePools const& l_Pools = l_ZonePools.second;
+
+                uint32 l_Count = l_Pools.PopulateCount;
+                uint64 l_Average = l_Count ? l_Pools.PopulateTotalTime / l_Count : 0;
+
+                p_Handler->PSendSysMessage("Map %u zone %u: %u pools, %u populates, " UI64FMTD " us average, %u us last, %u us max",
+                    l_MapPools.first, l_ZonePools.first, uint32(l_Pools.m_Templates.size()), l_Count, l_Average, uint32(l_Pools.PopulateLastTime), uint32(l_Pools.PopulateMaxTime));
+            }
+        }
+
+        return true;
+    }
+
+    /// .server achievements [reset], criteria progress rows written by the player and guild saves
+    static bool HandleServerAchievementsCommand(ChatHandler* p_Handler, char const* p_Args)
+    {
+        std::string l_Argument = p_Args;
+
+        if (l_Argument == "reset")
+        {
+            sAchievementMgr->ResetSaveStats();
+            p_Handler->PSendSysMessage("Achievement save statistics cleared");
+            return true;
+        }
+
+        if (!l_Argument.empty())
+            return false;
+
+        AchievementSaveStats l_Stats = sAchievementMgr->GetSaveStats();
+        uint64 l_Rows = l_Stats.UpsertedRows + l_Stats.DeletedRows;
+
+        p_Handler->PSendSysMessage("Achievement saves: " UI64FMTD " cycles, " UI64FMTD " with rows to write, " UI64FMTD " statements",
+            l_Stats.SaveCycles, l_Stats.WritingCycles, l_Stats.Statements);
+        p_Handler->PSendSysMessage("Criteria progress rows: " UI64FMTD " upserted, " UI64FMTD " deleted, " UI64FMTD " per writing cycle, %u max",
+            l_Stats.UpsertedRows, l_Stats.DeletedRows, l_Stats.WritingCycles ? l_Rows / l_Stats.WritingCycles : 0, l_Stats.MaxRowsPerCycle);
+        p_Handler->PSendSysMessage("Criteria updates coalesced before a save: " UI64FMTD, l_Stats.CoalescedUpdates);
+
+        return true;
+    }
+
+#ifndef CROSS
+    /// .server mailexpiry, progress of the current or last run of the daily mail expiry
+    static bool HandleServerMailExpiryCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+    {
+        MailExpiryProgress const& l_Progress = sObjectMgr->GetMailExpiryProgress();
+        if (!l_Progress.Batches && !l_Progress.Running)
+        {
+            p_Handler->PSendSysMessage("No mail expiry run since the start");
+            return true;
+        }
+
+        p_Handler->PSendSysMessage("Mail expiry %s: %u pages up to mail %u, %u deleted, %u returned, %u skipped",
+            l_Progress.Running ? "running" : "done", l_Progress.Batches, l_Progress.LastMailID, l_Progress.Deleted, l_Progress.Returned, l_Progress.Skipped);
+        p_Handler->PSendSysMessage("Page time: %u ms last, %u ms max, " UI64FMTD " ms average",
+            l_Progress.LastBatchTime, l_Progress.MaxBatchTime, l_Progress.Batches ? l_Progress.TotalBatchTime / l_Progress.Batches : 0);
+
+        return true;
+    }
+#endif /* not CROSS */
+
+    /// .server smartai [on|off|reset], without argument lists the heaviest database scripts
+    static bool HandleServerSmartAICommand(ChatHandler* p_Handler, char const* p_Args)
+    {
+        std::string l_Argument = p_Args;
+
+        if (l_Argument == "on" || l_Argument == "off")
+        {
+            sSmartScriptMgr->SetProfiling(l_Argument == "on");
+            p_Handler->PSendSysMessage("SmartAI execution time accounting %s", l_Argument == "on" ? "enabled" : "disabled");
+            return true;
+        }
+
+        if (l_Argument == "reset")
+        {
+            sSmartScriptMgr->ResetScriptTimings();
+            p_Handler->PSendSysMessage("SmartAI execution times cleared");
+            return true;
+        }
+
+        if (!l_Argument.empty())
+            return false;
+
+        if (!sSmartScriptMgr->IsProfiling())
+            p_Handler->PSendSysMessage("SmartAI execution time accounting is disabled, enable it with .server smartai on");
+
+        SmartScriptTimingMap l_Timings = sSmartScriptMgr->GetScriptTimings();
+
+        std::vector<SmartScriptTimingMap::const_iterator> l_Heaviest;
+        for (SmartScriptTimingMap::const_iterator l_Itr = l_Timings.begin(); l_Itr != l_Timings.end(); ++l_Itr)
+            l_Heaviest.push_back(l_Itr);
+
+        std::sort(l_Heaviest.begin(), l_Heaviest.end(), [](SmartScriptTimingMap::const_iterator p_A, SmartScriptTimingMap::const_iterator p_B)
+        {
+            return p_A->second.TotalTime > p_B->second.TotalTime;
+        });
+
+        if (l_Heaviest.size() > 20)
+            l_Heaviest.resize(20);
+
+        for (SmartScriptTimingMap::const_iterator l_Itr : l_Heaviest)
+        {
+            SmartScriptTiming const& l_Timing = l_Itr->second;
+
+            p_Handler->PSendSysMessage("Source type %u entryorguid %d: " UI64FMTD " runs, " UI64FMTD " us total, " UI64FMTD " us average, %u us max",
+                l_Itr->first.first, l_Itr->first.second, l_Timing.Count, l_Timing.TotalTime, l_Timing.TotalTime / l_Timing.Count, l_Timing.MaxTime);
+        }
+
+        return true;
+    }
+
+    // Capture the next world ticks into a Chrome trace file
+    static bool HandleServerProfileCommand(ChatHandler* p_Handler, char const* p_Args)
+    {
+        if (!*p_Args)
+        {
+            if (sTickProfiler->IsCapturing())
+                p_Handler->PSendSysMessage("Tick profiler capture running, %u ticks left, output %s", sTickProfiler->GetRemainingTicks(), sTickProfiler->GetFileName().c_str());
+            else
+                p_Handler->PSendSysMessage("No tick profiler capture running");
+
+            return true;
+        }
+
+        uint32 l_TickCount = uint32(atoi(p_Args));
+        if (!l_TickCount || l_TickCount > TICK_PROFILER_MAX_TICKS)
+        {
+            p_Handler->PSendSysMessage("Tick count must be between 1 and %u", TICK_PROFILER_MAX_TICKS);
+            p_Handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        std::string l_LogsDir = ConfigMgr::GetStringDefault("LogsDir", "");
+        if (!l_LogsDir.empty() && l_LogsDir[l_LogsDir.length() - 1] != '/' && l_LogsDir[l_LogsDir.length() - 1] != '\\')
+            l_LogsDir.push_back('/');
+
+        std::string l_FileName = l_LogsDir + "TickProfile_" + Log::GetTimestampStr() + ".json";
+        if (!sTickProfiler->StartCapture(l_TickCount, sWorld->getIntConfig(CONFIG_TICK_PROFILER_MAX_EVENTS), l_FileName))
+        {
+            p_Handler->PSendSysMessage("A tick profiler capture is already running");
+            p_Handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        p_Handler->PSendSysMessage("Capturing the next %u ticks into %s", l_TickCount, l_FileName.c_str());
+        return true;
+    }
+
+    static bool HandleServerOpcodesResetCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+    {
+        sOpcodeStats->Reset();
+        p_Handler->PSendSysMessage("Opcode stats reset");
+        return true;
+    }
+
     // Display the 'Message of the day' for the realm
     static bool HandleServerMotdCommand(ChatHandler* handler, char const* /*args*/)
     {
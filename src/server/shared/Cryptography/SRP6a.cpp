@@ -35,12 +35,8 @@ namespace BNet2 {
     /// Compute public b key
     void SRP6a::ComputePublicB()
     {
-        uint8_t l_Buffer[4 * SHA256_DIGEST_LENGTH];
-
-        for (uint32_t l_I = 0; l_I < (4 * SHA256_DIGEST_LENGTH); ++l_I)
-            l_Buffer[l_I] = rand() % 255;
-
-        PrivateB.SetBinary(l_Buffer, 4 * SHA256_DIGEST_LENGTH);
+        /// Computed by the login pipeline workers, rand() state is per thread (and seeded with 1) on some CRTs
+        PrivateB.SetRand(4 * SHA256_DIGEST_LENGTH * 8);
 
         BigNumber l_Result = ((K * V) + G.ModExp(PrivateB, N)) % N;
 
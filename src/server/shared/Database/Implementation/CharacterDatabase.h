@@ -119,7 +119,6 @@ enum CharacterDatabaseStatements
     CHAR_SEL_AUCTION_ITEMS,
     CHAR_INS_AUCTION,
     CHAR_DEL_AUCTION,
-    CHAR_SEL_AUCTION_BY_TIME,
     CHAR_UPD_AUCTION_BID,
     CHAR_SEL_AUCTIONS,
     CHAR_INS_MAIL,
@@ -129,8 +128,7 @@ enum CharacterDatabaseStatements
     CHAR_DEL_MAIL_ITEM,
     CHAR_DEL_INVALID_MAIL_ITEM,
     CHAR_DEL_EMPTY_EXPIRED_MAIL,
-    CHAR_SEL_EXPIRED_MAIL,
-    CHAR_SEL_EXPIRED_MAIL_ITEMS,
+    CHAR_SEL_EXPIRED_MAIL_PAGE,
     CHAR_UPD_MAIL_RETURNED,
     CHAR_UPD_MAIL_ITEM_RECEIVER,
     CHAR_UPD_ITEM_OWNER,
@@ -132,6 +132,8 @@ class Appender
 
         void setLogLevel(LogLevel);
         void write(LogMessage& message);
+        /// Called by the log worker once per batch of written messages
+        virtual void flush() { }
         static const char* getLogLevelString(LogLevel level);
         static const char* getLogFilterTypeString(LogFilterType type);
 
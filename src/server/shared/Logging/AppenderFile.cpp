@@ -42,7 +42,6 @@ void AppenderFile::_write(LogMessage& message)
     if (logfile)
     {
         fprintf(logfile, "%s%s", message.prefix.c_str(), message.text.c_str());
-        fflush(logfile);
 
         if (dynamicName)
         {
@@ -52,6 +51,13 @@ void AppenderFile::_write(LogMessage& message)
     }
 }
 
+void AppenderFile::flush()
+{
+    // dynamic name files are closed after each write
+    if (logfile)
+        fflush(logfile);
+}
+
 FILE* AppenderFile::OpenFile(std::string const &filename, std::string const &mode, bool backup)
 {
     if (mode == "w" && backup)
@@ -17,6 +17,7 @@ class AppenderFile: public Appender
         AppenderFile(uint8 _id, std::string const& _name, LogLevel level, const char* filename, const char* logDir, const char* mode, AppenderFlags flags);
         ~AppenderFile();
         FILE* OpenFile(std::string const& _name, std::string const& _mode, bool _backup);
+        void flush();
 
     private:
         void _write(LogMessage& message);
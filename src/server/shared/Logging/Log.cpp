@@ -274,9 +274,9 @@ void Log::EnableDBAppenders()
 
 void Log::vlog(LogFilterType filter, LogLevel level, char const* str, va_list argptr)
 {
-    char text[MAX_QUERY_LEN];
-    vsnprintf(text, MAX_QUERY_LEN, str, argptr);
-    write(new LogMessage(level, filter, text));
+    // Formatted straight into a preallocated slot of the worker ring, no allocation on the caller thread
+    if (worker)
+        worker->EnqueueFormatted(GetLoggerByType(filter), level, filter, str, argptr);
 }
 
 void Log::write(LogMessage* msg)
@@ -388,7 +388,19 @@ void Log::LoadFromConfig()
 
     lowestLogLevel = LOG_LEVEL_FATAL;
     AppenderId = 0;
-    worker = new LogWorker();
+
+    uint32 queueSize = ConfigMgr::GetIntDefault("Log.Async.QueueSize", 4096);
+    uint32 flushInterval = std::max(ConfigMgr::GetIntDefault("Log.Async.FlushInterval", 100), 1);
+    uint32 overflowPolicy = ConfigMgr::GetIntDefault("Log.Async.OverflowPolicy", LOG_OVERFLOW_DROP);
+    if (overflowPolicy > LOG_OVERFLOW_BLOCK)
+    {
+        fprintf(stderr, "Log::LoadFromConfig: Wrong Log.Async.OverflowPolicy %u, using 0 (drop)\n", overflowPolicy);
+        overflowPolicy = LOG_OVERFLOW_DROP;
+    }
+
+    // Created first, the lines logged while the appenders and loggers are read are kept
+    worker = new LogWorker(queueSize, flushInterval, LogOverflowPolicy(overflowPolicy));
+
     m_logsDir = ConfigMgr::GetStringDefault("LogsDir", "");
     if (!m_logsDir.empty())
         if ((m_logsDir.at(m_logsDir.length() - 1) != '/') && (m_logsDir.at(m_logsDir.length() - 1) != '\\'))
@@ -396,6 +408,9 @@ void Log::LoadFromConfig()
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
 
+    // Root logger always exists at this point, dropped lines are reported to it
+    worker->SetRootLogger(&loggers[0]);
+
     /// Init slack
     m_SlackEnable  = ConfigMgr::GetBoolDefault("Slack.Enable", false);
     m_SlackApiUrl  = ConfigMgr::GetStringDefault("Slack.ApiUrl", "");
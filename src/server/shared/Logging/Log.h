@@ -146,6 +146,9 @@ class Log
         void SetRealmID(uint32 id);
         uint32 GetRealmID() const { return realm; }
 
+        /// Lines lost because the async log queue was full
+        uint64 GetDroppedCount() const { return worker ? worker->GetDroppedCount() : 0; }
+
     private:
         void vlog(LogFilterType f, LogLevel level, char const* str, va_list argptr);
         void write(LogMessage* msg);
@@ -24,6 +24,8 @@ class LogOperation
 
         int call();
 
+        Logger* getLogger() const { return logger; }
+
     protected:
         Logger *logger;
         LogMessage *msg;
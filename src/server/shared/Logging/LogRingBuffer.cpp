@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "LogRingBuffer.h"
+
+LogRingBuffer::LogRingBuffer(uint32 p_Size)
+    : m_EnqueuePos(0), m_DequeuePos(0)
+{
+    uint32 l_Size = 2;
+    while (l_Size < p_Size && l_Size < 0x80000000)
+        l_Size <<= 1;
+
+    m_Mask    = l_Size - 1;
+    m_Records = new LogRecord[l_Size];
+
+    /// A slot is free for the producer reserving position N when its sequence is N
+    for (uint32 l_I = 0; l_I < l_Size; ++l_I)
+    {
+        m_Records[l_I].Sequence.store(l_I, std::memory_order_relaxed);
+        m_Records[l_I].Owner = NULL;
+    }
+}
+
+LogRingBuffer::~LogRingBuffer()
+{
+    delete[] m_Records;
+}
+
+LogRecord* LogRingBuffer::Reserve()
+{
+    uint32 l_Position = m_EnqueuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        LogRecord* l_Record = &m_Records[l_Position & m_Mask];
+        int32 l_Diff = int32(l_Record->Sequence.load(std::memory_order_acquire) - l_Position);
+
+        if (l_Diff == 0)
+        {
+            if (m_EnqueuePos.compare_exchange_weak(l_Position, l_Position + 1, std::memory_order_relaxed))
+            {
+                l_Record->Position = l_Position;
+                return l_Record;
+            }
+        }
+        /// The consumer has not released this slot yet, ring is full
+        else if (l_Diff < 0)
+            return NULL;
+        else
+            l_Position = m_EnqueuePos.load(std::memory_order_relaxed);
+    }
+}
+
+void LogRingBuffer::Commit(LogRecord* p_Record)
+{
+    p_Record->Sequence.store(p_Record->Position + 1, std::memory_order_release);
+}
+
+LogRecord* LogRingBuffer::Peek()
+{
+    uint32 l_Position = m_DequeuePos.load(std::memory_order_relaxed);
+    LogRecord* l_Record = &m_Records[l_Position & m_Mask];
+
+    /// Either empty or the producer of the oldest slot is still formatting it
+    if (l_Record->Sequence.load(std::memory_order_acquire) != l_Position + 1)
+        return NULL;
+
+    return l_Record;
+}
+
+void LogRingBuffer::Release(LogRecord* p_Record)
+{
+    uint32 l_Position = m_DequeuePos.load(std::memory_order_relaxed);
+
+    p_Record->Owner = NULL;
+    p_Record->Sequence.store(l_Position + m_Mask + 1, std::memory_order_release);
+    m_DequeuePos.store(l_Position + 1, std::memory_order_relaxed);
+}
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LOGRINGBUFFER_H
+#define LOGRINGBUFFER_H
+
+#include "Appender.h"
+
+class Logger;
+
+// Lines longer than this go through the heap allocated LogOperation path
+#define LOG_RECORD_TEXT_SIZE 1024
+
+/// Preallocated slot of the log ring, the text is formatted in place by the producer
+struct LogRecord
+{
+    std::atomic<uint32> Sequence;
+    uint32 Position;                    ///< Ring position reserved by the producer, only used to publish the slot
+    Logger* Owner;                      ///< NULL if the producer gave up the slot (line too long)
+    LogLevel Level;
+    LogFilterType Filter;
+    time_t Time;
+    char Text[LOG_RECORD_TEXT_SIZE];
+};
+
+/// Bounded lock-free multi producers / single consumer ring of LogRecord
+/// Producers never allocate nor lock, a full ring is reported to the caller which applies the overflow policy
+class LogRingBuffer
+{
+    public:
+        /// p_Size is rounded up to the next power of 2
+        explicit LogRingBuffer(uint32 p_Size);
+        ~LogRingBuffer();
+
+        /// Producer side, returns NULL if the ring is full
+        LogRecord* Reserve();
+        /// Producer side, hand the slot to the consumer
+        void Commit(LogRecord* p_Record);
+
+        /// Consumer side, next published record in order or NULL
+        LogRecord* Peek();
+        /// Consumer side, give the slot returned by Peek back to the producers
+        void Release(LogRecord* p_Record);
+
+        uint32 GetSize() const { return m_Mask + 1; }
+        uint32 GetPendingCount() const { return m_EnqueuePos.load(std::memory_order_relaxed) - m_DequeuePos.load(std::memory_order_relaxed); }
+
+    private:
+        LogRingBuffer(LogRingBuffer const&) = delete;
+        LogRingBuffer& operator=(LogRingBuffer const&) = delete;
+
+        LogRecord* m_Records;
+        uint32 m_Mask;
+        std::atomic<uint32> m_EnqueuePos;
+        std::atomic<uint32> m_DequeuePos;
+};
+
+#endif
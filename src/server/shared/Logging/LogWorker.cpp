@@ -7,35 +7,177 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "LogWorker.h"
+#include "Logger.h"
 
-LogWorker::LogWorker()
-    : m_queue(HIGH_WATERMARK, LOW_WATERMARK)
+#include <cstdio>
+
+LogWorker::LogWorker(uint32 p_QueueSize, uint32 p_FlushInterval, LogOverflowPolicy p_OverflowPolicy)
+    : m_Ring(p_QueueSize), m_FlushInterval(p_FlushInterval), m_OverflowPolicy(p_OverflowPolicy), m_RootLogger(nullptr),
+    m_CancelationToken(false), m_Dropped(0)
 {
-    ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1);
+    m_Thread = std::thread(&LogWorker::WorkerThread, this);
 }
 
 LogWorker::~LogWorker()
 {
-    m_queue.deactivate();
-    wait();
+    m_CancelationToken = true;
+    WakeUp();
+
+    if (m_Thread.joinable())
+        m_Thread.join();
+
+    /// Queued while the worker was writing its last batch
+    for (LogOperation* l_Operation : m_Operations)
+        delete l_Operation;
+
+    m_Operations.clear();
 }
 
 int LogWorker::enqueue(LogOperation* op)
 {
-    return m_queue.enqueue(op);
+    {
+        std::lock_guard<std::mutex> l_Guard(m_Lock);
+        m_Operations.push_back(op);
+    }
+
+    WakeUp();
+    return 0;
 }
 
-int LogWorker::svc()
+void LogWorker::EnqueueFormatted(Logger* p_Logger, LogLevel p_Level, LogFilterType p_Filter, char const* p_Format, va_list p_Args)
 {
-    while (1)
+    LogRecord* l_Record = m_Ring.Reserve();
+
+    /// Errors are never dropped nor wait for the worker, they fall back to the LogOperation queue
+    if (!l_Record && p_Level < LOG_LEVEL_ERROR)
     {
-        LogOperation* request;
-        if (m_queue.dequeue(request) == -1)
-            break;
+        if (m_OverflowPolicy == LOG_OVERFLOW_DROP)
+        {
+            ++m_Dropped;
+            return;
+        }
 
-        request->call();
-        delete request;
+        /// Logged by an appender on the worker thread, waiting would deadlock on its own ring: the line takes the LogOperation queue
+        while (!l_Record && !m_CancelationToken && std::this_thread::get_id() != m_Thread.get_id())
+        {
+            WakeUp();
+            std::this_thread::yield();
+            l_Record = m_Ring.Reserve();
+        }
     }
 
-    return 0;
+    if (l_Record)
+    {
+        va_list l_Args;
+        va_copy(l_Args, p_Args);
+        int l_Length = vsnprintf(l_Record->Text, LOG_RECORD_TEXT_SIZE, p_Format, l_Args);
+        va_end(l_Args);
+
+        if (l_Length >= 0 && l_Length < LOG_RECORD_TEXT_SIZE)
+        {
+            l_Record->Owner  = p_Logger;
+            l_Record->Level  = p_Level;
+            l_Record->Filter = p_Filter;
+            l_Record->Time   = time(NULL);
+            m_Ring.Commit(l_Record);
+
+            if (p_Level >= LOG_LEVEL_ERROR || m_Ring.GetPendingCount() > m_Ring.GetSize() / 2)
+                WakeUp();
+
+            return;
+        }
+
+        /// Line too long for a slot, publish it empty so the worker skips it
+        l_Record->Owner = NULL;
+        m_Ring.Commit(l_Record);
+    }
+
+    char l_Text[MAX_QUERY_LEN];
+    vsnprintf(l_Text, MAX_QUERY_LEN, p_Format, p_Args);
+
+    LogMessage* l_Message = new LogMessage(p_Level, p_Filter, l_Text);
+    l_Message->text.append("\n");
+    enqueue(new LogOperation(p_Logger, l_Message));
+}
+
+void LogWorker::WakeUp()
+{
+    m_Condition.notify_one();
+}
+
+void LogWorker::WorkerThread()
+{
+    std::vector<LogOperation*> l_Operations;
+    std::set<Logger*> l_TouchedLoggers;
+    uint64 l_ReportedDrops = 0;
+
+    while (true)
+    {
+        /// Read before draining, everything queued before the shutdown is still written
+        bool l_Stop = m_CancelationToken;
+
+        {
+            std::unique_lock<std::mutex> l_Guard(m_Lock);
+
+            /// Lines are batched until the flush interval elapses, errors and a half full ring wake us up earlier
+            if (!l_Stop && m_Operations.empty())
+                m_Condition.wait_for(l_Guard, std::chrono::milliseconds(m_FlushInterval));
+
+            l_Operations.swap(m_Operations);
+        }
+
+        for (LogOperation* l_Operation : l_Operations)
+        {
+            l_Operation->call();
+            l_TouchedLoggers.insert(l_Operation->getLogger());
+            delete l_Operation;
+        }
+
+        l_Operations.clear();
+
+        /// Bounded so a producer flooding the ring can't keep the files from being flushed
+        for (uint32 l_I = 0; l_I < m_Ring.GetSize(); ++l_I)
+        {
+            LogRecord* l_Record = m_Ring.Peek();
+            if (!l_Record)
+                break;
+
+            if (l_Record->Owner)
+            {
+                LogMessage l_Message(l_Record->Level, l_Record->Filter, l_Record->Text);
+                l_Message.text.append("\n");
+                l_Message.mtime = l_Record->Time;
+
+                l_Record->Owner->write(l_Message);
+                l_TouchedLoggers.insert(l_Record->Owner);
+            }
+
+            m_Ring.Release(l_Record);
+        }
+
+        uint64 l_Dropped = m_Dropped;
+        Logger* l_RootLogger = m_RootLogger;
+        if (l_Dropped != l_ReportedDrops && l_RootLogger)
+        {
+            char l_Text[128];
+            snprintf(l_Text, sizeof(l_Text), "Log: " UI64FMTD " lines dropped, log queue was full\n", l_Dropped - l_ReportedDrops);
+
+            LogMessage l_Message(LOG_LEVEL_WARN, LOG_FILTER_GENERAL, l_Text);
+            l_RootLogger->write(l_Message);
+            l_TouchedLoggers.insert(l_RootLogger);
+
+            l_ReportedDrops = l_Dropped;
+        }
+
+        for (Logger* l_Logger : l_TouchedLoggers)
+        {
+            if (l_Logger)
+                l_Logger->flush();
+        }
+
+        l_TouchedLoggers.clear();
+
+        if (l_Stop)
+            break;
+    }
 }
@@ -10,29 +10,55 @@
 #define LOGWORKER_H
 
 #include "LogOperation.h"
+#include "LogRingBuffer.h"
 
-#include <ace/Task.h>
-#include <ace/Activation_Queue.h>
+#include <condition_variable>
+#include <cstdarg>
 
-class LogWorker: protected ACE_Task_Base
+enum LogOverflowPolicy
+{
+    LOG_OVERFLOW_DROP   = 0,            ///< Lines below LOG_LEVEL_ERROR are dropped and counted when the ring is full
+    LOG_OVERFLOW_BLOCK  = 1             ///< Producers wait for the worker to free a slot
+};
+
+/// Writes the log lines on its own thread
+/// Regular lines are formatted by the caller straight into a preallocated ring slot, the worker builds
+/// the LogMessage, runs the appenders and flushes the touched files once per batch
+/// Oversized lines and prebuilt messages (char dumps) use the LogOperation queue, they may be
+/// written out of order relative to the ring lines
+class LogWorker
 {
     public:
-        LogWorker();
+        LogWorker(uint32 p_QueueSize, uint32 p_FlushInterval, LogOverflowPolicy p_OverflowPolicy);
         ~LogWorker();
 
-        typedef ACE_Message_Queue_Ex<LogOperation, ACE_MT_SYNCH> LogMessageQueueType;
+        int enqueue(LogOperation *op);
 
-        enum
-        {
-            HIGH_WATERMARK = 8 * 1024 * 1024,
-            LOW_WATERMARK  = 8 * 1024 * 1024
-        };
+        /// Format p_Format into a ring slot and queue it for p_Logger
+        void EnqueueFormatted(Logger* p_Logger, LogLevel p_Level, LogFilterType p_Filter, char const* p_Format, va_list p_Args);
 
-        int enqueue(LogOperation *op);
+        uint64 GetDroppedCount() const { return m_Dropped; }
+
+        /// Logger the dropped lines are reported to, set once the loggers are read from the config
+        void SetRootLogger(Logger* p_RootLogger) { m_RootLogger = p_RootLogger; }
 
     private:
-        virtual int svc();
-        LogMessageQueueType m_queue;
+        void WorkerThread();
+        void WakeUp();
+
+        LogRingBuffer m_Ring;
+        uint32 m_FlushInterval;
+        LogOverflowPolicy m_OverflowPolicy;
+        std::atomic<Logger*> m_RootLogger;
+
+        std::mutex m_Lock;
+        std::condition_variable m_Condition;
+        std::vector<LogOperation*> m_Operations;
+
+        std::thread m_Thread;
+        std::atomic<bool> m_CancelationToken;
+
+        std::atomic<uint64> m_Dropped;
 };
 
 #endif
@@ -73,3 +73,10 @@ void Logger::write(LogMessage& message)
         if (it->second)
             it->second->write(message);
 }
+
+void Logger::flush()
+{
+    for (AppenderMap::iterator it = appenders.begin(); it != appenders.end(); ++it)
+        if (it->second)
+            it->second->flush();
+}
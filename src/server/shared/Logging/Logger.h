@@ -27,6 +27,7 @@ class Logger
         LogLevel getLogLevel() const;
         void setLogLevel(LogLevel level);
         void write(LogMessage& message);
+        void flush();
 
     private:
         std::string name;
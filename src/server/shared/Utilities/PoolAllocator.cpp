@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "PoolAllocator.h"
+
+#include <algorithm>
+#include <new>
+
+namespace
+{
+    /// Every pool is registered at static initialization, before any thread is started
+    std::mutex& GetRegistryLock()
+    {
+        static std::mutex s_Lock;
+        return s_Lock;
+    }
+
+    std::vector<PoolAllocator*>& GetRegistry()
+    {
+        static std::vector<PoolAllocator*> s_Registry;
+        return s_Registry;
+    }
+
+    /// Enough for any member of the pooled classes
+    size_t const g_BlockAlignment = 16;
+}
+
+PoolThreadCache::~PoolThreadCache()
+{
+    if (Owner)
+        Owner->ReleaseCache(*this);
+}
+
+PoolAllocator::PoolAllocator(char const* p_Name, size_t p_BlockSize, uint32 p_BlocksPerSlab)
+    : m_Name(p_Name), m_BlockSize((std::max(p_BlockSize, sizeof(PoolBlock)) + g_BlockAlignment - 1) & ~(g_BlockAlignment - 1)),
+    m_BlocksPerSlab(std::max(p_BlocksPerSlab, uint32(1))), m_BatchSize(std::max(m_BlocksPerSlab / 4, uint32(1))),
+    m_FreeList(nullptr), m_ExitedAllocations(0), m_ExitedDeallocations(0), m_Oversized(0)
+{
+    std::lock_guard<std::mutex> l_Guard(GetRegistryLock());
+    GetRegistry().push_back(this);
+}
+
+void* PoolAllocator::Allocate(size_t p_Size)
+{
+    if (p_Size > m_BlockSize)
+    {
+        ++m_Oversized;
+        return ::operator new(p_Size);
+    }
+
+    PoolThreadCache* l_Cache = GetThreadCache();
+
+    if (!l_Cache->FreeList)
+        Refill(*l_Cache);
+
+    PoolBlock* l_Block = l_Cache->FreeList;
+    l_Cache->FreeList = l_Block->Next;
+    --l_Cache->FreeCount;
+
+    l_Cache->Allocations.store(l_Cache->Allocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return l_Block;
+}
+
+void PoolAllocator::Deallocate(void* p_Block, size_t p_Size)
+{
+    if (!p_Block)
+        return;
+
+    if (p_Size > m_BlockSize)
+    {
+        ::operator delete(p_Block);
+        return;
+    }
+
+    /// Blocks of every slab are interchangeable, a block freed by another thread than its allocator just changes cache
+    PoolThreadCache* l_Cache = GetThreadCache();
+
+    PoolBlock* l_Block = static_cast<PoolBlock*>(p_Block);
+    l_Block->Next = l_Cache->FreeList;
+    l_Cache->FreeList = l_Block;
+    ++l_Cache->FreeCount;
+
+    l_Cache->Deallocations.store(l_Cache->Deallocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    /// Keep one batch in the cache, so a thread alternating allocations and frees doesn't lock every time
+    if (l_Cache->FreeCount >= 2 * m_BatchSize)
+        Drain(*l_Cache, m_BatchSize);
+}
+
+PoolThreadCache* PoolAllocator::GetThreadCache()
+{
+    /// Created on the first call of each thread
+    PoolThreadCache* l_Cache = m_ThreadCache;
+
+    if (!l_Cache->Owner)
+    {
+        l_Cache->Owner = this;
+
+        std::lock_guard<std::mutex> l_Guard(m_Lock);
+        m_Caches.push_back(l_Cache);
+    }
+
+    return l_Cache;
+}
+
+void PoolAllocator::Refill(PoolThreadCache& p_Cache)
+{
+    std::lock_guard<std::mutex> l_Guard(m_Lock);
+
+    if (!m_FreeList)
+    {
+        char* l_Slab = static_cast<char*>(::operator new(m_BlockSize * m_BlocksPerSlab));
+        m_Slabs.push_back(l_Slab);
+
+        for (uint32 l_I = m_BlocksPerSlab; l_I > 0; --l_I)
+        {
+            PoolBlock* l_Block = reinterpret_cast<PoolBlock*>(l_Slab + (l_I - 1) * m_BlockSize);
+            l_Block->Next = m_FreeList;
+            m_FreeList = l_Block;
+        }
+    }
+
+    for (uint32 l_I = 0; l_I < m_BatchSize && m_FreeList; ++l_I)
+    {
+        PoolBlock* l_Block = m_FreeList;
+        m_FreeList = l_Block->Next;
+
+        l_Block->Next = p_Cache.FreeList;
+        p_Cache.FreeList = l_Block;
+        ++p_Cache.FreeCount;
+    }
+}
+
+void PoolAllocator::Drain(PoolThreadCache& p_Cache, uint32 p_Count)
+{
+    std::lock_guard<std::mutex> l_Guard(m_Lock);
+
+    for (uint32 l_I = 0; l_I < p_Count && p_Cache.FreeList; ++l_I)
+    {
+        PoolBlock* l_Block = p_Cache.FreeList;
+        p_Cache.FreeList = l_Block->Next;
+        --p_Cache.FreeCount;
+
+        l_Block->Next = m_FreeList;
+        m_FreeList = l_Block;
+    }
+}
+
+void PoolAllocator::ReleaseCache(PoolThreadCache& p_Cache)
+{
+    Drain(p_Cache, p_Cache.FreeCount);
+
+    std::lock_guard<std::mutex> l_Guard(m_Lock);
+
+    m_ExitedAllocations   += p_Cache.Allocations;
+    m_ExitedDeallocations += p_Cache.Deallocations;
+
+    m_Caches.erase(std::remove(m_Caches.begin(), m_Caches.end(), &p_Cache), m_Caches.end());
+}
+
+void PoolAllocator::GetStats(PoolAllocatorStats& p_Stats) const
+{
+    std::lock_guard<std::mutex> l_Guard(m_Lock);
+
+    uint64 l_Allocations   = m_ExitedAllocations;
+    uint64 l_Deallocations = m_ExitedDeallocations;
+
+    for (PoolThreadCache const* l_Cache : m_Caches)
+    {
+        l_Allocations   += l_Cache->Allocations.load(std::memory_order_relaxed);
+        l_Deallocations += l_Cache->Deallocations.load(std::memory_order_relaxed);
+    }
+
+    p_Stats.Name        = m_Name;
+    p_Stats.BlockSize   = uint32(m_BlockSize);
+    p_Stats.SlabCount   = uint32(m_Slabs.size());
+    p_Stats.Capacity    = uint64(m_Slabs.size()) * m_BlocksPerSlab;
+    p_Stats.InUse       = l_Allocations >= l_Deallocations ? l_Allocations - l_Deallocations : 0;
+    p_Stats.Allocations = l_Allocations;
+    p_Stats.Oversized   = m_Oversized;
+    p_Stats.ThreadCount = uint32(m_Caches.size());
+}
+
+void PoolAllocator::GetAllStats(std::vector<PoolAllocatorStats>& p_Stats)
+{
+    std::lock_guard<std::mutex> l_Guard(GetRegistryLock());
+
+    for (PoolAllocator const* l_Pool : GetRegistry())
+    {
+        p_Stats.push_back(PoolAllocatorStats());
+        l_Pool->GetStats(p_Stats.back());
+    }
+}
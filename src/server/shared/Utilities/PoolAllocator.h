@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _POOL_ALLOCATOR_H
+#define _POOL_ALLOCATOR_H
+
+#include "Define.h"
+
+#include <ace/TSS_T.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class PoolAllocator;
+
+/// Free block, the link lives in the block itself
+struct PoolBlock
+{
+    PoolBlock* Next;
+};
+
+/// Free blocks kept by one thread, the shared free list is only locked to refill or drain it
+struct PoolThreadCache
+{
+    PoolThreadCache() : Owner(nullptr), FreeList(nullptr), FreeCount(0), Allocations(0), Deallocations(0) { }
+    ~PoolThreadCache();
+
+    PoolAllocator* Owner;
+    PoolBlock* FreeList;
+    uint32 FreeCount;
+    std::atomic<uint64> Allocations;            ///< Only written by the owner thread, read by the stats
+    std::atomic<uint64> Deallocations;
+};
+
+struct PoolAllocatorStats
+{
+    std::string Name;
+    uint32 BlockSize;
+    uint32 SlabCount;
+    uint64 Capacity;                            ///< Blocks carved from the slabs
+    uint64 InUse;
+    uint64 Allocations;
+    uint64 Oversized;                           ///< Derived classes bigger than a block, served by the global allocator
+    uint32 ThreadCount;
+};
+
+/// Fixed size block allocator for the entity classes churned by grid loading and combat
+/// Blocks are carved from slabs which are kept for the whole process life, each thread owns a cache of free blocks
+/// so allocations of the map threads don't contend on the shared free list nor on the global allocator
+/// Pools are created at static initialization and never destroyed, thread caches can outlive the static objects
+class PoolAllocator
+{
+    friend struct PoolThreadCache;
+
+    public:
+        PoolAllocator(char const* p_Name, size_t p_BlockSize, uint32 p_BlocksPerSlab);
+
+        void* Allocate(size_t p_Size);
+        void Deallocate(void* p_Block, size_t p_Size);
+
+        void GetStats(PoolAllocatorStats& p_Stats) const;
+        static void GetAllStats(std::vector<PoolAllocatorStats>& p_Stats);
+
+    private:
+        PoolThreadCache* GetThreadCache();
+        void Refill(PoolThreadCache& p_Cache);
+        void Drain(PoolThreadCache& p_Cache, uint32 p_Count);
+        void ReleaseCache(PoolThreadCache& p_Cache);
+
+        std::string m_Name;
+        size_t m_BlockSize;
+        uint32 m_BlocksPerSlab;
+        uint32 m_BatchSize;                     ///< Blocks moved at once between a thread cache and the shared free list
+
+        mutable std::mutex m_Lock;
+        PoolBlock* m_FreeList;
+        std::vector<void*> m_Slabs;
+        std::vector<PoolThreadCache*> m_Caches;
+        uint64 m_ExitedAllocations;             ///< Counters of the caches of the exited threads
+        uint64 m_ExitedDeallocations;
+
+        std::atomic<uint64> m_Oversized;
+
+        ACE_TSS<PoolThreadCache> m_ThreadCache;
+};
+
+/// Routes the heap allocations of a class, and of its derived classes fitting in a block, to a PoolAllocator
+/// Leaves the following declarations public
+#define POOLED_OBJECT_DECLARE()                                                                         \
+    public:                                                                                             \
+        static void* operator new(size_t p_Size);                                                       \
+        static void operator delete(void* p_Block, size_t p_Size);                                      \
+        static void* operator new(size_t /*p_Size*/, void* p_Where) { return p_Where; }                 \
+        static void operator delete(void* /*p_Block*/, void* /*p_Where*/) { }
+
+/// In the translation unit of the class, p_BlockSize must cover the derived classes that should be pooled too
+#define POOLED_OBJECT_DEFINE(p_Class, p_BlockSize, p_BlocksPerSlab)                                     \
+    static PoolAllocator* s_##p_Class##Pool = new PoolAllocator(#p_Class, p_BlockSize, p_BlocksPerSlab);\
+    void* p_Class::operator new(size_t p_Size) { return s_##p_Class##Pool->Allocate(p_Size); }          \
+    void p_Class::operator delete(void* p_Block, size_t p_Size) { s_##p_Class##Pool->Deallocate(p_Block, p_Size); }
+
+#endif
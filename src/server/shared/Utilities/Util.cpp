@@ -58,6 +58,14 @@ double rand_chance(void)
     return sfmtRand->Random() * 100.0;
 }
 
+void rand_norm_batch(double* p_Out, uint32 p_Count)
+{
+    CRandomSFMT* l_Generator = sfmtRand;
+
+    for (uint32 l_I = 0; l_I < p_Count; ++l_I)
+        p_Out[l_I] = l_Generator->Random();
+}
+
 Tokenizer::Tokenizer(const std::string &src, const char sep, uint32 vectorReserve)
 {
     m_str = new char[src.length() + 1];
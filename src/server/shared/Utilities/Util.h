@@ -105,6 +105,10 @@ float frand(float min, float max);
  * With an FPU, there is usually no difference in performance between float and double. */
  double rand_chance(void);
 
+/* Fill p_Out with p_Count random doubles from 0.0 to 1.0 (exclusive), like rand_norm.
+ * The thread generator is looked up once for the whole batch, for the hot loops rolling many chances. */
+void rand_norm_batch(double* p_Out, uint32 p_Count);
+
 /* Return true if a random roll fits in the specified chance (range 0-100). */
 inline bool roll_chance_f(float chance)
 {
@@ -21,6 +21,7 @@
 #include "BattlegroundMgr.hpp"
 #include "MapManager.h"
 #include "Timer.h"
+#include "TickProfiler.h"
 #include "WorldRunnable.h"
 #include "OutdoorPvPMgr.h"
 #include "MSSignalHandler.h"
@@ -53,7 +54,9 @@ void WorldRunnable::run()
 
         uint32 diff = getMSTimeDiff(realPrevTime, realCurrTime);
 
+        sTickProfiler->BeginTick();
         sWorld->Update( diff );
+        sTickProfiler->EndTick();
         realPrevTime = realCurrTime;
 
         // diff (D0) include time of previous sleep (d0) + tick time (t0)
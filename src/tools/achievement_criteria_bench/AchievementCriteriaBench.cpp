@@ -0,0 +1,398 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/// Throughput benchmark of the achievement criteria dispatch for a max level player killing creatures
+/// Loads Achievement.db2, Criteria.db2 and CriteriaTree.db2 (or builds synthetic ones) into the DB2 structures of the
+/// server, builds the criteria trees lookups like AchievementGlobalMgr and the AchievementCriteriaIndex of the server,
+/// gives the player a progress on most of the kill criteria, then applies the same kill stream with the former dispatch
+/// (every KILL_CREATURE criteria, criteria trees walked for each) and with the one of AchievementMgr::UpdateAchievementCriteria
+/// (GetAchievementCriteriaByAsset, compiled completion, completed criteria skipped), and reports kills/s of both.
+/// Both must end with the same progress.
+
+#include "Common.h"
+#include "Util.h"
+#include "DB2FileLoader.h"
+#include "DB2fmt.h"
+#include "AchievementCriteriaIndex.h"
+
+#include <chrono>
+#include <iostream>
+
+struct BenchData
+{
+    std::vector<AchievementEntry> Achievements;
+    std::vector<CriteriaEntry> Criterias;
+    std::vector<CriteriaTreeEntry> Trees;
+
+    /// Same lookups as AchievementGlobalMgr::LoadAchievementReferenceList and LoadAchievementCriteriaList
+    SubCriteriaTreeListById SubCriteriaTrees;
+    AchievementCriteriaTreeByCriteriaId CriteriaTrees;
+    AchievementEntryByCriteriaTreeId AchievementByTree;
+    AchievementCriteriaIndex Index;
+
+    std::set<uint32> Disabled;                      ///< DisableMgr lookup, empty
+    uint32 MaxCriteriaID;
+};
+
+struct BenchConfig
+{
+    BenchConfig() : Kills(100000), CompletedPercent(80), CriteriaKillPercent(30) { }
+
+    std::string DB2Dir;
+    uint32 Kills;
+    uint32 CompletedPercent;
+    uint32 CriteriaKillPercent;
+};
+
+void Usage(char const* p_Program)
+{
+    std::cout << "Usage: " << p_Program << " [options]\n"
+        "    -d <dir>       directory of Achievement.db2, Criteria.db2 and CriteriaTree.db2, synthetic data if not set\n"
+        "    -n <count>     creatures killed (default 100000)\n"
+        "    -c <percent>   kill criteria already completed by the player (default 80)\n"
+        "    -k <percent>   kills of a creature used by a criteria, the others are trash (default 30)\n";
+}
+
+/// Only the fields read by the criteria dispatch, the strings are left empty
+bool LoadDB2(std::string const& p_Dir, BenchData& p_Data)
+{
+    DB2FileLoader l_Achievements, l_Criterias, l_Trees;
+    if (!l_Achievements.Load((p_Dir + "/Achievement.db2").c_str(), Achievementfmt)
+        || !l_Criterias.Load((p_Dir + "/Criteria.db2").c_str(), Criteriafmt)
+        || !l_Trees.Load((p_Dir + "/CriteriaTree.db2").c_str(), CriteriaTreefmt))
+        return false;
+
+    for (uint32 l_I = 0; l_I < l_Achievements.GetNumRows(); ++l_I)
+    {
+        DB2FileLoader::Record l_Record = l_Achievements.getRecord(l_I);
+
+        AchievementEntry l_Achievement = AchievementEntry();
+        l_Achievement.ID             = l_Record.getUInt(0);
+        l_Achievement.Flags          = l_Record.getUInt(9);
+        l_Achievement.SharesCriteria = l_Record.getUInt(13);
+        l_Achievement.CriteriaTree   = l_Record.getUInt(14);
+        p_Data.Achievements.push_back(l_Achievement);
+    }
+
+    for (uint32 l_I = 0; l_I < l_Criterias.GetNumRows(); ++l_I)
+    {
+        DB2FileLoader::Record l_Record = l_Criterias.getRecord(l_I);
+
+        CriteriaEntry l_Criteria = CriteriaEntry();
+        l_Criteria.ID               = l_Record.getUInt(0);
+        l_Criteria.Type             = l_Record.getUInt(1);
+        l_Criteria.raw.criteriaArg1 = l_Record.getUInt(2);
+        l_Criteria.StartEvent       = l_Record.getUInt(3);
+        l_Criteria.StartAsset       = l_Record.getUInt(4);
+        l_Criteria.StartTimer       = l_Record.getUInt(5);
+        l_Criteria.FailEvent        = l_Record.getUInt(6);
+        l_Criteria.FailAsset        = l_Record.getUInt(7);
+        l_Criteria.ModifierTreeId   = l_Record.getUInt(8);
+        l_Criteria.Flags            = l_Record.getUInt(9);
+        p_Data.Criterias.push_back(l_Criteria);
+    }
+
+    for (uint32 l_I = 0; l_I < l_Trees.GetNumRows(); ++l_I)
+    {
+        DB2FileLoader::Record l_Record = l_Trees.getRecord(l_I);
+
+        CriteriaTreeEntry l_Tree = CriteriaTreeEntry();
+        l_Tree.ID         = l_Record.getUInt(0);
+        l_Tree.CriteriaID = l_Record.getUInt(1);
+        l_Tree.Amount     = l_Record.getUInt(2);
+        l_Tree.OrderIndex = l_Record.getUInt(3);
+        l_Tree.Operator   = l_Record.getUInt(4);
+        l_Tree.Parent     = l_Record.getUInt(5);
+        l_Tree.Flags      = l_Record.getUInt(6);
+        p_Data.Trees.push_back(l_Tree);
+    }
+
+    return true;
+}
+
+/// Boss kill statistics and "kill N of them" achievements, a few thousands kill criteria like the retail data
+void BuildSynthetic(BenchData& p_Data)
+{
+    uint32 l_CriteriaId = 1;
+    uint32 l_TreeId = 1;
+
+    for (uint32 l_AchievementId = 1; l_AchievementId <= 3000; ++l_AchievementId)
+    {
+        CriteriaTreeEntry l_RootTree = CriteriaTreeEntry();
+        l_RootTree.ID = l_TreeId++;
+        p_Data.Trees.push_back(l_RootTree);
+
+        AchievementEntry l_Achievement = AchievementEntry();
+        l_Achievement.ID           = l_AchievementId;
+        l_Achievement.Flags        = urand(0, 3) ? 0 : ACHIEVEMENT_FLAG_COUNTER;
+        l_Achievement.CriteriaTree = l_RootTree.ID;
+        p_Data.Achievements.push_back(l_Achievement);
+
+        uint32 l_CriteriaCount = urand(1, 8);
+        for (uint32 l_I = 0; l_I < l_CriteriaCount; ++l_I)
+        {
+            CriteriaEntry l_Criteria = CriteriaEntry();
+            l_Criteria.ID                       = l_CriteriaId++;
+            l_Criteria.Type                     = ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE;
+            l_Criteria.kill_creature.CreatureID = urand(1, 100000);
+            p_Data.Criterias.push_back(l_Criteria);
+
+            CriteriaTreeEntry l_Tree = CriteriaTreeEntry();
+            l_Tree.ID         = l_TreeId++;
+            l_Tree.CriteriaID = l_Criteria.ID;
+            l_Tree.Amount     = urand(1, 50);
+            l_Tree.Parent     = l_RootTree.ID;
+            p_Data.Trees.push_back(l_Tree);
+        }
+    }
+}
+
+/// Same steps as AchievementGlobalMgr::LoadAchievementReferenceList and LoadAchievementCriteriaList, the DB2 stores
+/// being replaced by lookups by id of the loaded entries
+void Index(BenchData& p_Data)
+{
+    uint32 l_MaxTreeID = 0;
+    p_Data.MaxCriteriaID = 0;
+
+    for (CriteriaEntry const& l_Criteria : p_Data.Criterias)
+        p_Data.MaxCriteriaID = std::max(p_Data.MaxCriteriaID, l_Criteria.ID);
+    for (CriteriaTreeEntry const& l_Tree : p_Data.Trees)
+        l_MaxTreeID = std::max(l_MaxTreeID, l_Tree.ID);
+
+    std::vector<CriteriaEntry const*> l_CriteriaById(p_Data.MaxCriteriaID + 1, nullptr);
+    std::vector<CriteriaTreeEntry const*> l_TreeById(l_MaxTreeID + 1, nullptr);
+
+    for (CriteriaEntry const& l_Criteria : p_Data.Criterias)
+        l_CriteriaById[l_Criteria.ID] = &l_Criteria;
+    for (CriteriaTreeEntry const& l_Tree : p_Data.Trees)
+        l_TreeById[l_Tree.ID] = &l_Tree;
+
+    std::vector<AchievementEntry const*> l_AchievementByRootTree(l_MaxTreeID + 1, nullptr);
+    for (AchievementEntry const& l_Achievement : p_Data.Achievements)
+    {
+        if (l_Achievement.CriteriaTree <= l_MaxTreeID)
+            l_AchievementByRootTree[l_Achievement.CriteriaTree] = &l_Achievement;
+    }
+
+    /// Same walk to the root as _GetAchievementEntryByCriteriaTree
+    p_Data.AchievementByTree.resize(l_MaxTreeID + 1, nullptr);
+    for (CriteriaTreeEntry const& l_Tree : p_Data.Trees)
+    {
+        CriteriaTreeEntry const* l_Node = &l_Tree;
+        while (l_Node->Parent && l_Node->Parent != l_Node->ID && l_Node->Parent <= l_MaxTreeID && l_TreeById[l_Node->Parent])
+            l_Node = l_TreeById[l_Node->Parent];
+
+        p_Data.AchievementByTree[l_Tree.ID] = l_AchievementByRootTree[l_Node->ID];
+    }
+
+    p_Data.SubCriteriaTrees.resize(l_MaxTreeID + 1);
+    p_Data.CriteriaTrees.resize(p_Data.MaxCriteriaID + 1);
+
+    for (CriteriaTreeEntry const& l_Tree : p_Data.Trees)
+    {
+        if (l_Tree.Parent <= l_MaxTreeID && l_TreeById[l_Tree.Parent])
+            p_Data.SubCriteriaTrees[l_Tree.Parent].push_back(&l_Tree);
+
+        if (l_Tree.CriteriaID <= p_Data.MaxCriteriaID && l_CriteriaById[l_Tree.CriteriaID])
+            p_Data.CriteriaTrees[l_Tree.CriteriaID].push_back(&l_Tree);
+    }
+
+    for (CriteriaEntry const& l_Criteria : p_Data.Criterias)
+        p_Data.Index.AddCriteria(&l_Criteria);
+
+    p_Data.Index.Compile(p_Data.CriteriaTrees, p_Data.SubCriteriaTrees, p_Data.AchievementByTree);
+}
+
+/// Former AchievementMgr::IsCompletedCriteria, IsCompletedCriteriaForAchievement for every tree of the criteria on each call
+bool IsCompletedLegacy(BenchData const& p_Data, CriteriaEntry const* p_Criteria, std::unordered_map<uint32, uint32> const& p_Progress)
+{
+    for (CriteriaTreeEntry const* l_Tree : p_Data.CriteriaTrees[p_Criteria->ID])
+    {
+        AchievementEntry const* l_Achievement = p_Data.AchievementByTree[l_Tree->ID];
+        if (!l_Achievement || l_Achievement->CriteriaTree >= p_Data.SubCriteriaTrees.size())
+            return false;
+
+        CriteriaTreeEntry const* l_AchievementTree = nullptr;
+        for (CriteriaTreeEntry const* l_SubTree : p_Data.SubCriteriaTrees[l_Achievement->CriteriaTree])
+        {
+            if (l_SubTree->CriteriaID == p_Criteria->ID)
+            {
+                l_AchievementTree = l_SubTree;
+                break;
+            }
+        }
+
+        if (!l_AchievementTree || (l_Achievement->Flags & ACHIEVEMENT_FLAG_COUNTER))
+            return false;
+
+        std::unordered_map<uint32, uint32>::const_iterator l_Iter = p_Progress.find(p_Criteria->ID);
+        if (l_Iter == p_Progress.end())
+            return false;
+
+        uint32 l_RequiredCounter = 0;
+        if (!AchievementCriteriaIndex::GetCriteriaRequiredCounter(p_Criteria, l_AchievementTree, l_RequiredCounter) || l_Iter->second < l_RequiredCounter)
+            return false;
+    }
+
+    return true;
+}
+
+void KillLegacy(BenchData const& p_Data, uint32 p_Entry, std::unordered_map<uint32, uint32>& p_Progress)
+{
+    for (CriteriaEntry const* l_Criteria : p_Data.Index.GetAchievementCriteriaByType(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE))
+    {
+        if (p_Data.Disabled.find(l_Criteria->ID) != p_Data.Disabled.end())
+            continue;
+
+        if (IsCompletedLegacy(p_Data, l_Criteria, p_Progress))
+            continue;
+
+        if (l_Criteria->kill_creature.CreatureID != p_Entry)
+            continue;
+
+        ++p_Progress[l_Criteria->ID];
+    }
+}
+
+/// AchievementMgr::IsCompletedCriteria, no realm first is completed on the bench realm
+bool IsCompletedIndexed(BenchData const& p_Data, CriteriaEntry const* p_Criteria, std::unordered_map<uint32, uint32> const& p_Progress, std::vector<bool>& p_Completed)
+{
+    if (p_Completed[p_Criteria->ID])
+        return true;
+
+    CompiledCriteria const& l_Compiled = p_Data.Index.GetCompiledCriteria(p_Criteria);
+    if (l_Compiled.Completion == CRITERIA_COMPLETION_NEVER)
+        return false;
+
+    if (l_Compiled.Completion == CRITERIA_COMPLETION_COUNTER)
+    {
+        std::unordered_map<uint32, uint32>::const_iterator l_Iter = p_Progress.find(p_Criteria->ID);
+        if (l_Iter == p_Progress.end() || l_Iter->second < l_Compiled.RequiredCounter)
+            return false;
+    }
+
+    if (l_Compiled.RealmFirstAchievements.empty())
+        p_Completed[p_Criteria->ID] = true;
+
+    return true;
+}
+
+void KillIndexed(BenchData const& p_Data, uint32 p_Entry, std::unordered_map<uint32, uint32>& p_Progress, std::vector<bool>& p_Completed)
+{
+    for (CriteriaEntry const* l_Criteria : p_Data.Index.GetAchievementCriteriaByAsset(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, p_Entry))
+    {
+        if (p_Completed[l_Criteria->ID])
+            continue;
+
+        if (p_Data.Disabled.find(l_Criteria->ID) != p_Data.Disabled.end())
+            continue;
+
+        if (IsCompletedIndexed(p_Data, l_Criteria, p_Progress, p_Completed))
+            continue;
+
+        ++p_Progress[l_Criteria->ID];
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig l_Config;
+
+    for (int l_I = 1; l_I < argc; ++l_I)
+    {
+        std::string l_Option = argv[l_I];
+        if (l_I + 1 >= argc || l_Option.size() != 2 || l_Option[0] != '-')
+        {
+            Usage(argv[0]);
+            return 1;
+        }
+
+        char const* l_Value = argv[++l_I];
+
+        switch (l_Option[1])
+        {
+            case 'd': l_Config.DB2Dir              = l_Value;                                     break;
+            case 'n': l_Config.Kills               = std::max(atoi(l_Value), 1);                  break;
+            case 'c': l_Config.CompletedPercent    = std::min(std::max(atoi(l_Value), 0), 100);   break;
+            case 'k': l_Config.CriteriaKillPercent = std::min(std::max(atoi(l_Value), 0), 100);   break;
+            default:
+                Usage(argv[0]);
+                return 1;
+        }
+    }
+
+    init_sfmt();
+
+    BenchData l_Data;
+    if (l_Config.DB2Dir.empty())
+        BuildSynthetic(l_Data);
+    else if (!LoadDB2(l_Config.DB2Dir, l_Data))
+    {
+        std::cout << "Can't load the db2 files of " << l_Config.DB2Dir << std::endl;
+        return 1;
+    }
+
+    Index(l_Data);
+
+    AchievementCriteriaEntryList const& l_KillCriterias = l_Data.Index.GetAchievementCriteriaByType(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE);
+    if (l_KillCriterias.empty())
+    {
+        std::cout << "No kill criteria" << std::endl;
+        return 1;
+    }
+
+    /// Max level player: most kill criteria done, the others on their way
+    std::unordered_map<uint32, uint32> l_InitialProgress;
+    std::set<uint32> l_KilledEntries;
+    for (CriteriaEntry const* l_Criteria : l_KillCriterias)
+    {
+        l_KilledEntries.insert(l_Criteria->kill_creature.CreatureID);
+
+        uint32 l_Required = std::max(l_Data.Index.GetCompiledCriteria(l_Criteria).RequiredCounter, 1u);
+        if (urand(1, 100) <= l_Config.CompletedPercent)
+            l_InitialProgress[l_Criteria->ID] = l_Required;
+        else if (l_Required > 1 && urand(0, 1))
+            l_InitialProgress[l_Criteria->ID] = urand(1, l_Required - 1);
+    }
+
+    std::vector<uint32> l_Kills;
+    l_Kills.reserve(l_Config.Kills);
+    for (uint32 l_I = 0; l_I < l_Config.Kills; ++l_I)
+    {
+        if (urand(1, 100) <= l_Config.CriteriaKillPercent)
+            l_Kills.push_back(l_KillCriterias[urand(0, l_KillCriterias.size() - 1)]->kill_creature.CreatureID);
+        else
+            l_Kills.push_back(urand(200000, 300000));
+    }
+
+    std::unordered_map<uint32, uint32> l_LegacyProgress = l_InitialProgress;
+    std::chrono::steady_clock::time_point l_Start = std::chrono::steady_clock::now();
+    for (uint32 l_Entry : l_Kills)
+        KillLegacy(l_Data, l_Entry, l_LegacyProgress);
+    double l_LegacySeconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - l_Start).count(), 0.000001);
+
+    std::unordered_map<uint32, uint32> l_IndexedProgress = l_InitialProgress;
+    std::vector<bool> l_Completed(l_Data.MaxCriteriaID + 1, false);
+    l_Start = std::chrono::steady_clock::now();
+    for (uint32 l_Entry : l_Kills)
+        KillIndexed(l_Data, l_Entry, l_IndexedProgress, l_Completed);
+    double l_IndexedSeconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - l_Start).count(), 0.000001);
+
+    printf("%u achievements, %u criteria trees, %u kill criteria on %u creatures\n", uint32(l_Data.Achievements.size()), uint32(l_Data.Trees.size()),
+        uint32(l_KillCriterias.size()), uint32(l_KilledEntries.size()));
+    printf("%u kills: legacy %.0f kills/s, indexed %.0f kills/s, %.2fx\n", l_Config.Kills, l_Config.Kills / l_LegacySeconds,
+        l_Config.Kills / l_IndexedSeconds, l_LegacySeconds / l_IndexedSeconds);
+
+    if (l_LegacyProgress != l_IndexedProgress)
+    {
+        std::cout << "The indexed dispatch ended with a different progress" << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
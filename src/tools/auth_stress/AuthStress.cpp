@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/// Login storm benchmark of the authserver
+/// Each client thread opens a battle.net connection, sends the information request of a test account
+/// and answers the SRP6 proof request, then measures the time until the server verdict.
+/// The proof is random on purpose: the server computes S, the session key and M1 exactly like for a
+/// valid one, so the test accounts don't need a known password.
+
+#include "Common.h"
+#include "Packet.hpp"
+
+#include <openssl/sha.h>
+
+#include <ace/INET_Addr.h>
+#include <ace/SOCK_Connector.h>
+#include <ace/SOCK_Stream.h>
+#include <ace/Time_Value.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+
+enum LoginOutcome
+{
+    LOGIN_OUTCOME_PROOF_CHECKED,            ///< Full handshake, the server answered the proof
+    LOGIN_OUTCOME_REJECTED,                 ///< Auth complete before the proof request (unknown or banned account)
+    LOGIN_OUTCOME_NETWORK_ERROR,            ///< Connection, send or timeout error
+    LOGIN_OUTCOME_MAX
+};
+
+char const* g_OutcomeNames[LOGIN_OUTCOME_MAX] = { "proof checked", "rejected", "network error" };
+
+struct StressConfig
+{
+    StressConfig() : Host("127.0.0.1"), Port(1119), Clients(16), Logins(1000), AccountCount(1), AccountFormat("stress%u@localhost"), Timeout(10) { }
+
+    std::string Host;
+    uint16 Port;
+    uint32 Clients;
+    uint32 Logins;
+    uint32 AccountCount;
+    std::string AccountFormat;
+    uint32 Timeout;                         ///< Seconds
+};
+
+struct ClientStats
+{
+    ClientStats() { memset(Outcomes, 0, sizeof(Outcomes)); }
+
+    std::vector<uint32> Latencies;          ///< Microseconds, full handshakes only
+    uint32 Outcomes[LOGIN_OUTCOME_MAX];
+};
+
+std::atomic<uint32> g_NextLogin(0);
+
+/// FourCC as read by BNet2::Packet::ReadFourCC
+uint32 MakeFourCC(std::string const& p_Str)
+{
+    uint32 l_Value = 0;
+    for (uint32 l_I = 0; l_I < 4; ++l_I)
+        l_Value = (l_Value << 8) | (l_I < p_Str.size() ? uint8(p_Str[l_I]) : 0);
+
+    return l_Value;
+}
+
+bool SendPacket(ACE_SOCK_Stream& p_Stream, BNet2::Packet& p_Packet, ACE_Time_Value const& p_Timeout)
+{
+    p_Packet.FlushBits();
+    return p_Stream.send_n(p_Packet.GetData(), p_Packet.GetSize(), &p_Timeout) == ssize_t(p_Packet.GetSize());
+}
+
+/// Wait for the next server packet and return its opcode, the packet body isn't needed
+bool ReceiveOpcode(ACE_SOCK_Stream& p_Stream, uint32& p_Opcode, ACE_Time_Value const& p_Timeout)
+{
+    char l_Buffer[4096];
+
+    ssize_t l_Size = p_Stream.recv(l_Buffer, sizeof(l_Buffer), &p_Timeout);
+    if (l_Size <= 0)
+        return false;
+
+    /// Opcode is the 6 first bits of the packet
+    p_Opcode = BNet2::Packet(l_Buffer, uint32(l_Size)).GetOpcode();
+    return true;
+}
+
+LoginOutcome RunLogin(StressConfig const& p_Config, uint32 p_Index, std::mt19937& p_Random)
+{
+    ACE_Time_Value l_Timeout(p_Config.Timeout);
+    ACE_INET_Addr l_Address(p_Config.Port, p_Config.Host.c_str());
+    ACE_SOCK_Connector l_Connector;
+    ACE_SOCK_Stream l_Stream;
+
+    if (l_Connector.connect(l_Stream, l_Address, &l_Timeout) == -1)
+        return LOGIN_OUTCOME_NETWORK_ERROR;
+
+    char l_AccountName[256];
+    snprintf(l_AccountName, sizeof(l_AccountName), p_Config.AccountFormat.c_str(), p_Index % p_Config.AccountCount);
+
+    BNet2::Packet l_InformationRequest(BNet2::CMSG_INFORMATION_REQUEST);
+    l_InformationRequest.WriteBits(MakeFourCC("WoW"), 32);              ///< Program
+    l_InformationRequest.WriteBits(MakeFourCC("Win"), 32);              ///< Platform
+    l_InformationRequest.WriteBits(MakeFourCC("enUS"), 32);             ///< Locale
+    l_InformationRequest.WriteBits(0, 6);                               ///< Components, none to skip the build checks
+    l_InformationRequest.WriteBits(true, 1);                            ///< Have login
+    l_InformationRequest.WriteString(l_AccountName, 9, false, -3);
+
+    LoginOutcome l_Outcome = LOGIN_OUTCOME_NETWORK_ERROR;
+    uint32 l_Opcode = 0;
+
+    if (SendPacket(l_Stream, l_InformationRequest, l_Timeout) && ReceiveOpcode(l_Stream, l_Opcode, l_Timeout))
+    {
+        if (l_Opcode != OPCODE_ID(BNet2::SMSG_PROOF_REQUEST))
+            l_Outcome = LOGIN_OUTCOME_REJECTED;
+        else
+        {
+            uint8 l_Proof[4 * SHA256_DIGEST_LENGTH + SHA256_DIGEST_LENGTH + 4 * SHA256_DIGEST_LENGTH];
+            for (uint32 l_I = 0; l_I < sizeof(l_Proof); ++l_I)
+                l_Proof[l_I] = uint8(p_Random());
+
+            BNet2::Packet l_ProofResponse(BNet2::CMSG_PROOF_RESPONSE);
+            l_ProofResponse.WriteBits(1, 3);                            ///< Modules
+            l_ProofResponse.WriteBits(sizeof(l_Proof) + 1, 10);         ///< Module data size
+            l_ProofResponse.FlushBits();
+            l_ProofResponse.Write<uint8>(2);                            ///< BATTLENET2_SESSION_STATE_WAIT_PROOF_VERIFICATION
+            l_ProofResponse.AppendByteArray(l_Proof, sizeof(l_Proof));  ///< A, M1, client challenge
+
+            if (SendPacket(l_Stream, l_ProofResponse, l_Timeout) && ReceiveOpcode(l_Stream, l_Opcode, l_Timeout))
+                l_Outcome = LOGIN_OUTCOME_PROOF_CHECKED;
+        }
+    }
+
+    l_Stream.close();
+    return l_Outcome;
+}
+
+void ClientThread(StressConfig const& p_Config, ClientStats& p_Stats, uint32 p_Seed)
+{
+    std::mt19937 l_Random(p_Seed);
+
+    while (true)
+    {
+        uint32 l_Index = g_NextLogin++;
+        if (l_Index >= p_Config.Logins)
+            return;
+
+        std::chrono::steady_clock::time_point l_Start = std::chrono::steady_clock::now();
+        LoginOutcome l_Outcome = RunLogin(p_Config, l_Index, l_Random);
+        std::chrono::steady_clock::duration l_Elapsed = std::chrono::steady_clock::now() - l_Start;
+
+        ++p_Stats.Outcomes[l_Outcome];
+
+        if (l_Outcome == LOGIN_OUTCOME_PROOF_CHECKED)
+            p_Stats.Latencies.push_back(uint32(std::chrono::duration_cast<std::chrono::microseconds>(l_Elapsed).count()));
+    }
+}
+
+uint32 GetPercentile(std::vector<uint32> const& p_Sorted, float p_Percent)
+{
+    if (p_Sorted.empty())
+        return 0;
+
+    size_t l_Index = size_t(std::ceil(p_Sorted.size() * p_Percent / 100.0f));
+    return p_Sorted[std::min(l_Index, p_Sorted.size()) - (l_Index ? 1 : 0)];
+}
+
+void Usage(char const* p_Program)
+{
+    std::cout << "Usage: " << p_Program << " [options]\n"
+        "    -h <host>      authserver address (default 127.0.0.1)\n"
+        "    -p <port>      authserver battle.net port (default 1119)\n"
+        "    -c <count>     concurrent clients (default 16)\n"
+        "    -n <count>     total logins (default 1000)\n"
+        "    -a <format>    test account name format, %u is the account index (default stress%u@localhost)\n"
+        "    -k <count>     number of test accounts (default 1)\n"
+        "    -t <seconds>   network timeout (default 10)\n";
+}
+
+int main(int argc, char** argv)
+{
+    StressConfig l_Config;
+
+    for (int l_I = 1; l_I < argc; ++l_I)
+    {
+        std::string l_Option = argv[l_I];
+        if (l_I + 1 >= argc || l_Option.size() != 2 || l_Option[0] != '-')
+        {
+            Usage(argv[0]);
+            return 1;
+        }
+
+        char const* l_Value = argv[++l_I];
+
+        switch (l_Option[1])
+        {
+            case 'h': l_Config.Host          = l_Value;                               break;
+            case 'p': l_Config.Port          = uint16(atoi(l_Value));                 break;
+            case 'c': l_Config.Clients       = std::max(atoi(l_Value), 1);            break;
+            case 'n': l_Config.Logins        = std::max(atoi(l_Value), 1);            break;
+            case 'a': l_Config.AccountFormat = l_Value;                               break;
+            case 'k': l_Config.AccountCount  = std::max(atoi(l_Value), 1);            break;
+            case 't': l_Config.Timeout       = std::max(atoi(l_Value), 1);            break;
+            default:
+                Usage(argv[0]);
+                return 1;
+        }
+    }
+
+    std::cout << "Login storm: " << l_Config.Logins << " logins, " << l_Config.Clients << " clients against " << l_Config.Host << ":" << l_Config.Port << std::endl;
+
+    std::vector<ClientStats> l_Stats(l_Config.Clients);
+    std::vector<std::thread> l_Threads;
+
+    std::chrono::steady_clock::time_point l_Start = std::chrono::steady_clock::now();
+
+    for (uint32 l_I = 0; l_I < l_Config.Clients; ++l_I)
+        l_Threads.push_back(std::thread(ClientThread, std::cref(l_Config), std::ref(l_Stats[l_I]), l_I + 1));
+
+    for (std::thread& l_Thread : l_Threads)
+        l_Thread.join();
+
+    double l_Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - l_Start).count();
+
+    std::vector<uint32> l_Latencies;
+    uint32 l_Outcomes[LOGIN_OUTCOME_MAX] = { 0, 0, 0 };
+
+    for (ClientStats const& l_Client : l_Stats)
+    {
+        l_Latencies.insert(l_Latencies.end(), l_Client.Latencies.begin(), l_Client.Latencies.end());
+
+        for (uint32 l_I = 0; l_I < LOGIN_OUTCOME_MAX; ++l_I)
+            l_Outcomes[l_I] += l_Client.Outcomes[l_I];
+    }
+
+    std::sort(l_Latencies.begin(), l_Latencies.end());
+
+    for (uint32 l_I = 0; l_I < LOGIN_OUTCOME_MAX; ++l_I)
+        std::cout << "  " << g_OutcomeNames[l_I] << ": " << l_Outcomes[l_I] << std::endl;
+
+    printf("Elapsed %.2f s, %.1f logins/s (full handshakes)\n", l_Seconds, l_Outcomes[LOGIN_OUTCOME_PROOF_CHECKED] / std::max(l_Seconds, 0.001));
+    printf("Latency (ms): p50 %.2f, p95 %.2f, p99 %.2f, max %.2f\n", GetPercentile(l_Latencies, 50.0f) / 1000.0, GetPercentile(l_Latencies, 95.0f) / 1000.0,
+        GetPercentile(l_Latencies, 99.0f) / 1000.0, l_Latencies.empty() ? 0.0 : l_Latencies.back() / 1000.0);
+
+    return l_Outcomes[LOGIN_OUTCOME_NETWORK_ERROR] ? 2 : 0;
+}
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/// Throughput benchmark of the chat lexics cutter
+/// Compiles the word list and letter analogs like the worldserver does, then checks every line of a
+/// captured chat corpus (one message per line, UTF-8) several times and reports messages/s and MB/s.
+
+#include "Common.h"
+#include "ChatLexicsCutter.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+struct BenchConfig
+{
+    BenchConfig() : AnalogsFile("letter_analogs.txt"), WordsFile("innormative_words.txt"), Passes(10), IgnoreRepeats(true), IgnoreSpaces(true), CheckContains(false) { }
+
+    std::string AnalogsFile;
+    std::string WordsFile;
+    std::string CorpusFile;
+    uint32 Passes;
+    bool IgnoreRepeats;                     ///< LexicsCutterIgnoreRepeats
+    bool IgnoreSpaces;                      ///< LexicsCutterIgnoreSpaces
+    bool CheckContains;                     ///< LexicsCutterCheckContains
+};
+
+void Usage(char const* p_Program)
+{
+    std::cout << "Usage: " << p_Program << " -c <corpus> [options]\n"
+        "    -c <file>      chat corpus, one message per line\n"
+        "    -a <file>      letter analogs (default letter_analogs.txt)\n"
+        "    -w <file>      innormative words (default innormative_words.txt)\n"
+        "    -n <count>     passes over the corpus (default 10)\n"
+        "    -r <0|1>       LexicsCutterIgnoreRepeats (default 1)\n"
+        "    -s <0|1>       LexicsCutterIgnoreSpaces (default 1)\n"
+        "    -x <0|1>       LexicsCutterCheckContains (default 0)\n";
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig l_Config;
+
+    for (int l_I = 1; l_I < argc; ++l_I)
+    {
+        std::string l_Option = argv[l_I];
+        if (l_I + 1 >= argc || l_Option.size() != 2 || l_Option[0] != '-')
+        {
+            Usage(argv[0]);
+            return 1;
+        }
+
+        char const* l_Value = argv[++l_I];
+
+        switch (l_Option[1])
+        {
+            case 'c': l_Config.CorpusFile    = l_Value;                               break;
+            case 'a': l_Config.AnalogsFile   = l_Value;                               break;
+            case 'w': l_Config.WordsFile     = l_Value;                               break;
+            case 'n': l_Config.Passes        = std::max(atoi(l_Value), 1);            break;
+            case 'r': l_Config.IgnoreRepeats = atoi(l_Value) != 0;                    break;
+            case 's': l_Config.IgnoreSpaces  = atoi(l_Value) != 0;                    break;
+            case 'x': l_Config.CheckContains = atoi(l_Value) != 0;                    break;
+            default:
+                Usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (l_Config.CorpusFile.empty())
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> l_Messages;
+    uint64 l_CorpusSize = 0;
+
+    std::ifstream l_Corpus(l_Config.CorpusFile.c_str());
+    if (!l_Corpus)
+    {
+        std::cout << "Can't open " << l_Config.CorpusFile << std::endl;
+        return 1;
+    }
+
+    std::string l_Line;
+    while (std::getline(l_Corpus, l_Line))
+    {
+        if (!l_Line.empty() && l_Line[l_Line.size() - 1] == '\r')
+            l_Line.erase(l_Line.size() - 1);
+
+        l_CorpusSize += l_Line.size();
+        l_Messages.push_back(l_Line);
+    }
+
+    LexicsCutter l_Cutter;
+    l_Cutter.IgnoreLetterRepeat  = l_Config.IgnoreRepeats;
+    l_Cutter.IgnoreMiddleSpaces  = l_Config.IgnoreSpaces;
+    l_Cutter.CheckLetterContains = l_Config.CheckContains;
+
+    std::chrono::steady_clock::time_point l_BuildStart = std::chrono::steady_clock::now();
+
+    if (!l_Cutter.ReadLetterAnalogs(l_Config.AnalogsFile))
+        std::cout << "Can't open " << l_Config.AnalogsFile << ", no letter analogs" << std::endl;
+
+    if (!l_Cutter.ReadInnormativeWords(l_Config.WordsFile))
+    {
+        std::cout << "Can't open " << l_Config.WordsFile << std::endl;
+        return 1;
+    }
+
+    bool l_Compiled = l_Cutter.Build();
+
+    double l_BuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - l_BuildStart).count();
+    if (l_Compiled)
+        printf("%u words compiled into %u states in %.1f ms\n", l_Cutter.GetWordCount(), l_Cutter.GetStateCount(), l_BuildMs);
+    else
+        printf("%u words need more than %u states, per-word scan (%.1f ms)\n", l_Cutter.GetWordCount(), LEXICS_CUTTER_MAX_STATES, l_BuildMs);
+
+    uint32 l_Flagged = 0;
+    for (std::string const& l_Message : l_Messages)
+        l_Flagged += l_Cutter.CheckLexics(l_Message) ? 1 : 0;
+
+    std::chrono::steady_clock::time_point l_Start = std::chrono::steady_clock::now();
+
+    uint32 l_Checked = 0;
+    for (uint32 l_Pass = 0; l_Pass < l_Config.Passes; ++l_Pass)
+    {
+        for (std::string const& l_Message : l_Messages)
+            l_Checked += l_Cutter.CheckLexics(l_Message) ? 1 : 0;
+    }
+
+    double l_Seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - l_Start).count(), 0.000001);
+    double l_MessageCount = double(l_Messages.size()) * l_Config.Passes;
+
+    printf("%u messages (%.2f MB), %u flagged\n", uint32(l_Messages.size()), l_CorpusSize / (1024.0 * 1024.0), l_Flagged);
+    printf("%u passes in %.3f s: %.0f messages/s, %.1f MB/s, %.0f ns/message\n", l_Config.Passes, l_Seconds, l_MessageCount / l_Seconds,
+        l_CorpusSize * double(l_Config.Passes) / (1024.0 * 1024.0) / l_Seconds, l_Seconds * 1e9 / std::max(l_MessageCount, 1.0));
+
+    /// Keeps the checks from being optimized out
+    return l_Checked == l_Flagged * l_Config.Passes ? 0 : 2;
+}
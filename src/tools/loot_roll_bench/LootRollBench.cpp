@@ -0,0 +1,407 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/// Throughput benchmark of the loot template rolls
+/// Rolls every template of a *_loot_template dump (or synthetic templates) a million times through the LootRoll functions
+/// LootTemplate uses, once the former way and once the compiled way, then reports rolls/s of both and the largest gap
+/// between the drop rates they produced:
+///     former      one random number per non grouped entry, groups walk their chances from the full candidate lists
+///                 (LootRoll::RollEntries with batches of 1, LootRoll::ProcessRemaining from the first attempt)
+///     compiled    what LootTemplate::Process runs, batched random numbers and the alias tables of the groups
+///                 (LootRoll::RollEntries, LootRoll::RollGroup, which falls back to ProcessRemaining)
+/// Both go through the loot mode and world condition filters and the duplicate checks, adding an item to the loot is
+/// reduced to recording its id, and the chances are used as stored (no rates, no quest chances).
+///
+/// Dump format, one row per line, tab separated, as given by mysql -B:
+///     entry   item    ChanceOrQuestChance     lootmode    groupid     mincountOrRef   maxcount
+
+#include "Common.h"
+#include "Util.h"
+#include "LootAliasTable.h"
+#include "LootRoll.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/// Fields read by LootRoll, named like the ones of LootStoreItem
+struct BenchEntry
+{
+    BenchEntry() : itemid(0), chance(0.0f), lootmode(1), group(0), dropLimit(0), hasWorldConditions(false), Index(0) { }
+
+    uint32 itemid;
+    float chance;
+    uint16 lootmode;
+    uint8 group;
+    uint8 dropLimit;
+    bool hasWorldConditions;                    ///< The bench conditions are never met, like an inactive event
+    uint32 Index;                               ///< Position in the drop counters
+};
+
+typedef std::vector<BenchEntry> BenchEntryList;
+
+struct BenchGroup
+{
+    BenchEntryList ExplicitlyChanced;
+    BenchEntryList EqualChanced;
+    LootAliasTable ExplicitTable;
+};
+
+struct BenchTemplate
+{
+    BenchTemplate() : Entry(0) { }
+
+    uint32 Entry;
+    BenchEntryList Entries;                     ///< Not grouped
+    std::vector<BenchGroup> Groups;
+};
+
+/// Stands for the Loot being filled, duplicates are counted on it
+struct BenchLoot
+{
+    BenchLoot(std::vector<uint32>& p_Counts) : Counts(p_Counts), Dropped(0) { }
+
+    bool IsDuplicate(BenchEntry const& p_Entry) const
+    {
+        if (!p_Entry.dropLimit)
+            return false;
+
+        return std::count(Items.begin(), Items.end(), p_Entry.itemid) >= p_Entry.dropLimit;
+    }
+
+    void AddItem(BenchEntry const& p_Entry)
+    {
+        Items.push_back(p_Entry.itemid);
+        ++Counts[p_Entry.Index];
+        ++Dropped;
+    }
+
+    std::vector<uint32> Items;
+    std::vector<uint32>& Counts;
+    uint64 Dropped;
+};
+
+struct BenchConfig
+{
+    BenchConfig() : Rolls(1000000), OnlyEntry(0), MinEntries(1), LootMode(1), DropLimit(1), WorldConditions(0) { }
+
+    std::string DumpFile;
+    uint32 Rolls;
+    uint32 OnlyEntry;
+    uint32 MinEntries;
+    uint16 LootMode;
+    uint8 DropLimit;
+    uint32 WorldConditions;
+};
+
+void Usage(char const* p_Program)
+{
+    std::cout << "Usage: " << p_Program << " [options]\n"
+        "    -l <file>      loot template dump, synthetic templates if not set\n"
+        "    -n <count>     rolls per template (default 1000000)\n"
+        "    -e <entry>     only roll this template\n"
+        "    -m <count>     skip templates with less entries (default 1)\n"
+        "    -o <mode>      loot mode of the rolls (default 1, LOOT_MODE_DEFAULT)\n"
+        "    -d <limit>     copies of an item a loot may hold (default 1 like equippable items, 0 no limit)\n"
+        "    -w <percent>   share of the non grouped entries with unmet world conditions (default 0)\n";
+}
+
+/// Same split as LootTemplate::AddEntry, references are stored with the non grouped entries
+void AddEntry(BenchTemplate& p_Template, BenchEntry const& p_Entry)
+{
+    if (!p_Entry.group)
+    {
+        p_Template.Entries.push_back(p_Entry);
+        return;
+    }
+
+    if (p_Entry.group > p_Template.Groups.size())
+        p_Template.Groups.resize(p_Entry.group);
+
+    BenchGroup& l_Group = p_Template.Groups[p_Entry.group - 1];
+    if (p_Entry.chance != 0.0f)
+        l_Group.ExplicitlyChanced.push_back(p_Entry);
+    else
+        l_Group.EqualChanced.push_back(p_Entry);
+}
+
+bool LoadDump(std::string const& p_FileName, std::map<uint32, BenchTemplate>& p_Templates)
+{
+    std::ifstream l_File(p_FileName.c_str());
+    if (!l_File)
+        return false;
+
+    std::string l_Line;
+    while (std::getline(l_File, l_Line))
+    {
+        std::istringstream l_Row(l_Line);
+
+        uint32 l_Entry, l_LootMode, l_Group, l_MaxCount;
+        int32 l_Item, l_MinCountOrRef;
+        float l_Chance;
+
+        /// Header line and malformed rows
+        if (!(l_Row >> l_Entry >> l_Item >> l_Chance >> l_LootMode >> l_Group >> l_MinCountOrRef >> l_MaxCount))
+            continue;
+
+        BenchEntry l_BenchEntry;
+        l_BenchEntry.itemid   = std::abs(l_Item);
+        l_BenchEntry.chance   = std::fabs(l_Chance);
+        l_BenchEntry.lootmode = uint16(l_LootMode);
+        l_BenchEntry.group    = l_MinCountOrRef > 0 ? uint8(l_Group) : 0;
+
+        BenchTemplate& l_Template = p_Templates[l_Entry];
+        l_Template.Entry = l_Entry;
+        AddEntry(l_Template, l_BenchEntry);
+    }
+
+    return true;
+}
+
+/// Group sizes of the usual creature loot: a few grey/white drops, a greens table, a boss table, a world drops reference
+/// A second group shares items with the first one and a few entries belong to another loot mode, so the duplicate
+/// and loot mode retries of the groups are rolled too
+void BuildSynthetic(std::map<uint32, BenchTemplate>& p_Templates)
+{
+    uint32 const l_GroupSizes[] = { 4, 16, 64, 256, 1024 };
+    uint32 l_ItemId = 1;
+
+    for (uint32 l_I = 0; l_I < sizeof(l_GroupSizes) / sizeof(l_GroupSizes[0]); ++l_I)
+    {
+        BenchTemplate& l_Template = p_Templates[l_I + 1];
+        l_Template.Entry = l_I + 1;
+
+        for (uint32 l_J = 0; l_J < 8; ++l_J)
+        {
+            BenchEntry l_Entry;
+            l_Entry.itemid = l_ItemId++;
+            l_Entry.chance = frand(0.5f, 40.0f);
+            AddEntry(l_Template, l_Entry);
+        }
+
+        /// Chances summing to ~90%, the last tenth falls to the equal chanced entries
+        uint32 l_FirstGroupItem = l_ItemId;
+        for (uint32 l_J = 0; l_J < l_GroupSizes[l_I]; ++l_J)
+        {
+            BenchEntry l_Entry;
+            l_Entry.itemid   = l_ItemId++;
+            l_Entry.group    = 1;
+            l_Entry.chance   = 90.0f / l_GroupSizes[l_I] * frand(0.5f, 1.5f);
+            l_Entry.lootmode = l_J % 8 == 7 ? 2 : 1;
+            AddEntry(l_Template, l_Entry);
+        }
+
+        for (uint32 l_J = 0; l_J < 4; ++l_J)
+        {
+            BenchEntry l_Entry;
+            l_Entry.itemid = l_ItemId++;
+            l_Entry.group  = 1;
+            AddEntry(l_Template, l_Entry);
+        }
+
+        for (uint32 l_J = 0; l_J < 4; ++l_J)
+        {
+            BenchEntry l_Entry;
+            l_Entry.itemid = l_FirstGroupItem + l_J;
+            l_Entry.group  = 2;
+            l_Entry.chance = 25.0f;
+            AddEntry(l_Template, l_Entry);
+        }
+    }
+}
+
+/// Settings the dump doesn't hold, and the positions of the entries in the drop counters, returns the entry count
+uint32 PrepareTemplate(BenchTemplate& p_Template, BenchConfig const& p_Config)
+{
+    uint32 l_Index = 0;
+
+    for (BenchEntry& l_Entry : p_Template.Entries)
+    {
+        l_Entry.Index = l_Index++;
+        l_Entry.hasWorldConditions = urand(0, 99) < p_Config.WorldConditions;
+    }
+
+    for (BenchGroup& l_Group : p_Template.Groups)
+    {
+        std::vector<float> l_Chances;
+        for (BenchEntry& l_Entry : l_Group.ExplicitlyChanced)
+        {
+            l_Entry.Index     = l_Index++;
+            l_Entry.dropLimit = p_Config.DropLimit;
+            l_Chances.push_back(l_Entry.chance);
+        }
+
+        for (BenchEntry& l_Entry : l_Group.EqualChanced)
+        {
+            l_Entry.Index     = l_Index++;
+            l_Entry.dropLimit = p_Config.DropLimit;
+        }
+
+        l_Group.ExplicitTable.Build(l_Chances);
+    }
+
+    return l_Index;
+}
+
+float GetChance(BenchEntry const& p_Entry)
+{
+    return p_Entry.chance;
+}
+
+bool CanMeetWorldConditions(BenchEntry const& /*p_Entry*/)
+{
+    return false;
+}
+
+/// Former processing
+void RollFormer(BenchTemplate const& p_Template, uint16 p_LootMode, BenchLoot& p_Loot)
+{
+    LootRoll::RollEntries(p_Template.Entries.begin(), p_Template.Entries.end(), p_LootMode, GetChance, CanMeetWorldConditions,
+        [&p_Loot](BenchEntry const& p_Entry) { p_Loot.AddItem(p_Entry); }, 1);
+
+    for (BenchGroup const& l_Group : p_Template.Groups)
+    {
+        std::vector<BenchEntry const*> l_ExplicitPossibleDrops;
+        std::vector<BenchEntry const*> l_EqualPossibleDrops;
+
+        for (BenchEntry const& l_Entry : l_Group.ExplicitlyChanced)
+            l_ExplicitPossibleDrops.push_back(&l_Entry);
+
+        for (BenchEntry const& l_Entry : l_Group.EqualChanced)
+            l_EqualPossibleDrops.push_back(&l_Entry);
+
+        LootRoll::ProcessRemaining(l_ExplicitPossibleDrops, l_EqualPossibleDrops, p_LootMode,
+            uint8(l_Group.ExplicitlyChanced.size() + l_Group.EqualChanced.size()), 0,
+            [&p_Loot](BenchEntry const& p_Entry) { return p_Loot.IsDuplicate(p_Entry); },
+            [&p_Loot](BenchEntry const& p_Entry) { p_Loot.AddItem(p_Entry); });
+    }
+}
+
+/// LootTemplate::Process
+void RollCompiled(BenchTemplate const& p_Template, uint16 p_LootMode, BenchLoot& p_Loot)
+{
+    LootRoll::RollEntries(p_Template.Entries.begin(), p_Template.Entries.end(), p_LootMode, GetChance, CanMeetWorldConditions,
+        [&p_Loot](BenchEntry const& p_Entry) { p_Loot.AddItem(p_Entry); });
+
+    for (BenchGroup const& l_Group : p_Template.Groups)
+    {
+        LootRoll::RollGroup(l_Group.ExplicitlyChanced, l_Group.EqualChanced, l_Group.ExplicitTable, p_LootMode,
+            [&p_Loot](BenchEntry const& p_Entry) { return p_Loot.IsDuplicate(p_Entry); },
+            [&p_Loot](BenchEntry const& p_Entry) { p_Loot.AddItem(p_Entry); });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig l_Config;
+
+    for (int l_I = 1; l_I < argc; ++l_I)
+    {
+        std::string l_Option = argv[l_I];
+        if (l_I + 1 >= argc || l_Option.size() != 2 || l_Option[0] != '-')
+        {
+            Usage(argv[0]);
+            return 1;
+        }
+
+        char const* l_Value = argv[++l_I];
+
+        switch (l_Option[1])
+        {
+            case 'l': l_Config.DumpFile   = l_Value;                                  break;
+            case 'n': l_Config.Rolls      = std::max(atoi(l_Value), 1);               break;
+            case 'e': l_Config.OnlyEntry  = atoi(l_Value);                            break;
+            case 'm': l_Config.MinEntries = std::max(atoi(l_Value), 1);               break;
+            case 'o': l_Config.LootMode   = uint16(atoi(l_Value));                    break;
+            case 'd': l_Config.DropLimit  = uint8(atoi(l_Value));                     break;
+            case 'w': l_Config.WorldConditions = std::min(atoi(l_Value), 100);        break;
+            default:
+                Usage(argv[0]);
+                return 1;
+        }
+    }
+
+    init_sfmt();
+
+    std::map<uint32, BenchTemplate> l_Templates;
+    if (l_Config.DumpFile.empty())
+        BuildSynthetic(l_Templates);
+    else if (!LoadDump(l_Config.DumpFile, l_Templates))
+    {
+        std::cout << "Can't open " << l_Config.DumpFile << std::endl;
+        return 1;
+    }
+
+    double l_FormerTotal   = 0.0;
+    double l_CompiledTotal = 0.0;
+    double l_WorstGap      = 0.0;
+    uint32 l_Rolled        = 0;
+    uint64 l_Checksum      = 0;
+
+    printf("%8s %8s %14s %14s %8s %10s\n", "entry", "entries", "former/s", "compiled/s", "speedup", "max gap %");
+
+    for (auto& l_Iterator : l_Templates)
+    {
+        BenchTemplate& l_Template = l_Iterator.second;
+        if (l_Config.OnlyEntry && l_Template.Entry != l_Config.OnlyEntry)
+            continue;
+
+        uint32 l_EntryCount = PrepareTemplate(l_Template, l_Config);
+        if (l_EntryCount < l_Config.MinEntries)
+            continue;
+
+        std::vector<uint32> l_FormerCounts(l_EntryCount, 0);
+        std::vector<uint32> l_CompiledCounts(l_EntryCount, 0);
+        BenchLoot l_FormerLoot(l_FormerCounts);
+        BenchLoot l_CompiledLoot(l_CompiledCounts);
+
+        std::chrono::steady_clock::time_point l_Start = std::chrono::steady_clock::now();
+        for (uint32 l_I = 0; l_I < l_Config.Rolls; ++l_I)
+        {
+            l_FormerLoot.Items.clear();
+            RollFormer(l_Template, l_Config.LootMode, l_FormerLoot);
+        }
+        double l_FormerSeconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - l_Start).count(), 0.000001);
+
+        l_Start = std::chrono::steady_clock::now();
+        for (uint32 l_I = 0; l_I < l_Config.Rolls; ++l_I)
+        {
+            l_CompiledLoot.Items.clear();
+            RollCompiled(l_Template, l_Config.LootMode, l_CompiledLoot);
+        }
+        double l_CompiledSeconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - l_Start).count(), 0.000001);
+
+        l_Checksum += l_FormerLoot.Dropped + l_CompiledLoot.Dropped;
+
+        /// Both must drop each entry at the same rate, up to the sampling noise
+        double l_Gap = 0.0;
+        for (uint32 l_I = 0; l_I < l_EntryCount; ++l_I)
+            l_Gap = std::max(l_Gap, std::fabs(double(l_FormerCounts[l_I]) - double(l_CompiledCounts[l_I])) * 100.0 / l_Config.Rolls);
+
+        printf("%8u %8u %14.0f %14.0f %7.2fx %10.4f\n", l_Template.Entry, l_EntryCount, l_Config.Rolls / l_FormerSeconds,
+            l_Config.Rolls / l_CompiledSeconds, l_FormerSeconds / l_CompiledSeconds, l_Gap);
+
+        l_FormerTotal   += l_FormerSeconds;
+        l_CompiledTotal += l_CompiledSeconds;
+        l_WorstGap       = std::max(l_WorstGap, l_Gap);
+        ++l_Rolled;
+    }
+
+    if (!l_Rolled)
+    {
+        std::cout << "No template to roll" << std::endl;
+        return 1;
+    }
+
+    printf("%u templates, %u rolls each: former %.3f s, compiled %.3f s, %.2fx, worst drop rate gap %.4f%%\n", l_Rolled, l_Config.Rolls,
+        l_FormerTotal, l_CompiledTotal, l_FormerTotal / std::max(l_CompiledTotal, 0.000001), l_WorstGap);
+
+    /// Keeps the rolls from being optimized out
+    return l_Checksum ? 0 : 2;
+}
@@ -14,6 +14,14 @@
 #include <set>
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <memory>
+#include <functional>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
 
 #ifdef _WIN32
 #include "direct.h"
@@ -75,7 +83,7 @@ namespace
     }
 }
 
-HANDLE CascStorage = NULL;
+HANDLE CascStorage = NULL;                                   // storage of the main thread, see GetCascStorage
 
 typedef struct
 {
@@ -116,6 +124,8 @@ float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - l
 
 uint32 CONF_Locale = 0;
 
+uint32 CONF_threads = 4;                                    // threads converting map tiles, each opens its own storage
+
 #define LOCALES_COUNT 17
 
 char const* Locales[LOCALES_COUNT] =
@@ -167,6 +177,7 @@ void Usage(char const* prg)
         "-o set output path (max %d characters)\n"\
         "-e extract only MAP(1)/DBC(2) - standard: both(3)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "-t number of threads converting map tiles, each opens its own storage - standard: 4\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"\n", prg, MAX_PATH_LENGTH - 1, MAX_PATH_LENGTH - 1, prg);
     exit(1);
 }
@@ -181,6 +192,7 @@ void HandleArgs(int argc, char* arg[])
         // f - use float to int conversion
         // h - limit minimum height
         // b - target client build
+        // t - number of threads
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -231,6 +243,12 @@ void HandleArgs(int argc, char* arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if (c + 1 < argc && atoi(arg[c + 1]) > 0)   // all ok
+                    CONF_threads = atoi(arg[c++ + 1]);
+                else
+                    Usage(arg[0]);
+                break;
             case 'h':
                 Usage(arg[0]);
                 break;
@@ -467,24 +485,61 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per tile being converted
+struct ConvertADTData
+{
+    uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+    float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+    uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+    uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+
+    uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+    uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+    bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+    uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
+
+    int16 flight_box_max[3][3];
+    int16 flight_box_min[3][3];
+};
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+std::mutex CascStoragesLock;
+std::map<std::thread::id, HANDLE> CascStorages;
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
+// CascLib has no locking of its own, every thread converting tiles opens its own storage on first use
+HANDLE GetCascStorage()
+{
+    std::lock_guard<std::mutex> lock(CascStoragesLock);
+
+    HANDLE& storage = CascStorages[std::this_thread::get_id()];
+    if (!storage)
+    {
+        if (CascOpenStorage((std::string(input_path) + "/Data").c_str(), 0, &storage))
+            return storage;
 
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
+        printf("error opening casc storage '%s': %s\n", (std::string(input_path) + "/Data").c_str(), HumanReadableCASCError(GetLastError()));
+        storage = NULL;
+    }
+
+    return storage;
+}
+
+void CloseCascStorages()
+{
+    std::lock_guard<std::mutex> lock(CascStoragesLock);
+
+    for (std::map<std::thread::id, HANDLE>::iterator itr = CascStorages.begin(); itr != CascStorages.end(); ++itr)
+        if (itr->second && itr->second != CascStorage)
+            CascCloseStorage(itr->second);
+
+    CascStorages.clear();
+}
+
+std::atomic<uint64> StorageBytesRead(0);
 
 bool TransformToHighRes(uint16 lowResHoles, uint8 hiResHoles[8])
 {
@@ -505,9 +560,28 @@ bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/,
 {
     ChunkedFile adt;
 
-    if (!adt.loadFile(CascStorage, filename))
+    if (!adt.loadFile(GetCascStorage(), filename))
         return false;
 
+    StorageBytesRead += adt.GetDataSize();
+
+    // too large for the stack of the worker threads
+    std::unique_ptr<ConvertADTData> data(new ConvertADTData());
+    uint16 (&area_flags)[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID] = data->area_flags;
+    float (&V8)[ADT_GRID_SIZE][ADT_GRID_SIZE] = data->V8;
+    float (&V9)[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1] = data->V9;
+    uint16 (&uint16_V8)[ADT_GRID_SIZE][ADT_GRID_SIZE] = data->uint16_V8;
+    uint16 (&uint16_V9)[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1] = data->uint16_V9;
+    uint8 (&uint8_V8)[ADT_GRID_SIZE][ADT_GRID_SIZE] = data->uint8_V8;
+    uint8 (&uint8_V9)[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1] = data->uint8_V9;
+    uint16 (&liquid_entry)[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID] = data->liquid_entry;
+    uint8 (&liquid_flags)[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID] = data->liquid_flags;
+    bool (&liquid_show)[ADT_GRID_SIZE][ADT_GRID_SIZE] = data->liquid_show;
+    float (&liquid_height)[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1] = data->liquid_height;
+    uint8 (&holes)[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8] = data->holes;
+    int16 (&flight_box_max)[3][3] = data->flight_box_max;
+    int16 (&flight_box_min)[3][3] = data->flight_box_min;
+
     // Prepare map header
     map_fileheader map;
     map.mapMagic = *(uint32 const*)MAP_MAGIC;
@@ -1066,10 +1140,37 @@ void ExtractWmos(ChunkedFile& file, std::set<std::string>& wmoList)
     }
 }
 
+struct MapTile
+{
+    uint32 map;
+    uint32 x;
+    uint32 y;
+};
+
+// runs work(0) .. work(count - 1) on CONF_threads threads, the calling thread included
+// threads pull the next index themselves, nothing is queued ahead of them
+void ParallelFor(size_t count, std::function<void(size_t)> const& work)
+{
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < count; i = next++)
+            work(i);
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32 i = 1; i < CONF_threads && i < count; ++i)
+        threads.push_back(std::thread(worker));
+
+    worker();
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+}
+
 void ExtractMaps(uint32 build)
 {
     char storagePath[1024];
-    char output_filename[1024];
 
     printf("Extracting maps...\n");
 
@@ -1083,6 +1184,10 @@ void ExtractMaps(uint32 build)
     CreateDir(path);
 
     std::set<std::string> wmoList;
+    std::mutex wmoListLock;
+
+    // the tiles of every map are listed first, then converted on all threads
+    std::vector<MapTile> tiles;
 
     printf("Convert map files\n");
     for (uint32 z = 0; z < map_count; ++z)
@@ -1104,21 +1209,59 @@ void ExtractMaps(uint32 build)
                 if (!(chunk->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1))
                     continue;
 
-                sprintf(storagePath, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
-                sprintf(output_filename, "%s/maps/%04u_%02u_%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(storagePath, output_filename, y, x, build);
-
-                sprintf(storagePath, "World\\Maps\\%s\\%s_%u_%u_obj0.adt", map_ids[z].name, map_ids[z].name, x, y);
-                ChunkedFile adtObj;
-                if (adtObj.loadFile(CascStorage, storagePath, false))
-                    ExtractWmos(adtObj, wmoList);
+                MapTile tile;
+                tile.map = z;
+                tile.x = x;
+                tile.y = y;
+                tiles.push_back(tile);
             }
-
-            // draw progress bar
-            printf("Processing........................%d%%\r", (100 * (y+1)) / WDT_MAP_SIZE);
         }
     }
 
+    printf("Converting %u tiles on %u threads\n", uint32(tiles.size()), CONF_threads);
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    uint64 startBytesRead = StorageBytesRead;
+    std::atomic<uint32> converted(0);
+    std::atomic<uint32> processed(0);
+
+    ParallelFor(tiles.size(), [&](size_t index)
+    {
+        MapTile const& tile = tiles[index];
+        map_id const& map = map_ids[tile.map];
+
+        char tilePath[1024];
+        char output_filename[1024];
+
+        sprintf(tilePath, "World\\Maps\\%s\\%s_%u_%u.adt", map.name, map.name, tile.x, tile.y);
+        sprintf(output_filename, "%s/maps/%04u_%02u_%02u.map", output_path, map.id, tile.y, tile.x);
+        if (ConvertADT(tilePath, output_filename, tile.y, tile.x, build))
+            ++converted;
+
+        sprintf(tilePath, "World\\Maps\\%s\\%s_%u_%u_obj0.adt", map.name, map.name, tile.x, tile.y);
+        ChunkedFile adtObj;
+        if (adtObj.loadFile(GetCascStorage(), tilePath, false))
+        {
+            StorageBytesRead += adtObj.GetDataSize();
+
+            std::lock_guard<std::mutex> lock(wmoListLock);
+            ExtractWmos(adtObj, wmoList);
+        }
+
+        // draw progress bar
+        uint32 done = ++processed;
+        if (done * 100 / tiles.size() != (done - 1) * 100 / tiles.size())
+            printf("Processing........................%u%%\r", uint32(done * 100 / tiles.size()));
+    });
+
+    double elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count() / 1000.0;
+    if (elapsed <= 0.0)
+        elapsed = 0.001;
+
+    double megabytes = (StorageBytesRead - startBytesRead) / (1024.0 * 1024.0);
+    printf("\n%u tiles converted in %.1f s (%.1f tiles/s), %.1f MB read from storage (%.1f MB/s) on %u threads\n",
+        uint32(converted), elapsed, converted / elapsed, megabytes, megabytes / elapsed, CONF_threads);
+
     if (!wmoList.empty())
     {
         if (FILE* wmoListFile = fopen("wmo_list.txt", "w"))
@@ -1207,6 +1350,9 @@ bool OpenCascStorage()
             return false;
         }
         printf("opened casc storage '%s'\n", (std::string(input_path) + "/Data").c_str());
+
+        std::lock_guard<std::mutex> lock(CascStoragesLock);
+        CascStorages[std::this_thread::get_id()] = CascStorage;
         return true;
     }
     catch (...)
@@ -1275,6 +1421,7 @@ int main(int argc, char * arg[])
         ExtractMaps(build);
     }
 
+    CloseCascStorages();
     CascCloseStorage(CascStorage);
     return 0;
 }
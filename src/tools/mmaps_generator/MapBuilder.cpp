@@ -10,9 +10,12 @@
 
 #include "PathCommon.h"
 #include "MapBuilder.h"
+#include "Timer.h"
 
 #include "MapTree.h"
+#include "VMapManager2.h"
 #include "ModelInstance.h"
+#include "VMapDefinitions.h"
 
 #include "DetourNavMeshBuilder.h"
 #include "DetourNavMesh.h"
@@ -37,7 +40,7 @@ namespace MMAP
 {
     MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
         bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-        bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
+        bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath, bool incremental) :
         m_terrainBuilder     (NULL),
         m_debugOutput        (debugOutput),
         m_offMeshFilePath    (offMeshFilePath),
@@ -47,7 +50,9 @@ namespace MMAP
         m_maxWalkableAngle   (maxWalkableAngle),
         m_bigBaseUnit        (bigBaseUnit),
         m_rcContext          (NULL),
-        _cancelationToken    (false)
+        _cancelationToken    (false),
+        m_pendingTiles       (0),
+        m_incremental        (incremental)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
@@ -65,6 +70,12 @@ namespace MMAP
             delete (*it).m_tiles;
         }
 
+        for (std::map<uint32, MapBuildState*>::iterator it = m_mapStates.begin(); it != m_mapStates.end(); ++it)
+        {
+            dtFreeNavMesh(it->second->m_navMesh);
+            delete it->second;
+        }
+
         delete m_terrainBuilder;
         delete m_rcContext;
     }
@@ -156,54 +167,378 @@ namespace MMAP
     {
         while (1)
         {
-            uint32 mapId = 0;
+            TileBuildTask* task = NULL;
 
-            _queue.WaitAndPop(mapId);
+            _queue.WaitAndPop(task);
 
-            if (_cancelationToken)
+            if (_cancelationToken || !task)
                 return;
 
-            buildMap(mapId);
+            processTile(*task);
+            delete task;
         }
     }
 
     void MapBuilder::buildAllMaps(int threads)
     {
-        for (int i = 0; i < threads; ++i)
-        {
-            _workerThreads.push_back(std::thread(&MapBuilder::WorkerThread, this));
-        }
-
         m_tiles.sort([](MapTiles a, MapTiles b)
         {
             return a.m_tiles->size() > b.m_tiles->size();
         });
 
+        std::vector<uint32> mapIDs;
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapId = it->m_mapId;
             if (!shouldSkipMap(mapId))
+                mapIDs.push_back(mapId);
+        }
+
+        buildMaps(mapIDs, threads);
+    }
+
+    void MapBuilder::buildMaps(std::vector<uint32> const& mapIDs, int threads)
+    {
+        if (m_incremental)
+            loadTileHashes();
+
+        // navmeshes are created up front, tiles of the largest maps are queued first
+        std::vector<TileBuildTask*> tasks;
+        for (uint32 mapID : mapIDs)
+            prepareMap(mapID, tasks);
+
+        m_pendingTiles = tasks.size();
+        printf("%u tiles to build.\n\n", uint32(tasks.size()));
+
+        if (threads > 0)
+        {
+            for (int i = 0; i < threads; ++i)
+                _workerThreads.push_back(std::thread(&MapBuilder::WorkerThread, this));
+
+            for (TileBuildTask* task : tasks)
+                _queue.Push(task);
+
+            {
+                std::unique_lock<std::mutex> lock(m_pendingLock);
+                while (m_pendingTiles)
+                    m_pendingCondition.wait(lock);
+            }
+
+            _cancelationToken = true;
+
+            _queue.Cancel();
+
+            for (auto& thread : _workerThreads)
+                thread.join();
+
+            _workerThreads.clear();
+            _cancelationToken = false;
+        }
+        else
+        {
+            for (TileBuildTask* task : tasks)
+            {
+                processTile(*task);
+                delete task;
+            }
+        }
+
+        if (m_incremental)
+            saveTileHashes();
+
+        std::sort(m_tileTimes.begin(), m_tileTimes.end(), [](TileBuildTime const& a, TileBuildTime const& b)
+        {
+            return a.m_time > b.m_time;
+        });
+
+        if (!m_tileTimes.empty())
+            printf("\nSlowest tiles:\n");
+
+        for (uint32 i = 0; i < m_tileTimes.size() && i < 10; ++i)
+            printf("[Map %04u] [%02u,%02u]: %u ms\n", m_tileTimes[i].m_mapId, m_tileTimes[i].m_tileX, m_tileTimes[i].m_tileY, m_tileTimes[i].m_time);
+
+        m_tileTimes.clear();
+    }
+
+    /**************************************************************************/
+    uint32 MapBuilder::prepareMap(uint32 mapID, std::vector<TileBuildTask*>& tasks)
+    {
+        std::set<uint32>* tiles = getTileList(mapID);
+
+        // make sure we process maps which don't have tiles
+        if (!tiles->size())
+        {
+            // convert coord bounds to grid bounds
+            uint32 minX, minY, maxX, maxY;
+            getGridBounds(mapID, minX, minY, maxX, maxY);
+
+            // add all tiles within bounds to tile list.
+            for (uint32 i = minX; i <= maxX; ++i)
+                for (uint32 j = minY; j <= maxY; ++j)
+                    tiles->insert(StaticMapTree::packTileID(i, j));
+        }
+
+        if (tiles->empty())
+            return 0;
+
+        std::vector<TileBuildTask*> mapTasks;
+        for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
+        {
+            uint32 tileX, tileY;
+
+            // unpack tile coords
+            StaticMapTree::unpackTileID((*it), tileX, tileY);
+
+            uint64 inputHash = 0;
+            if (m_incremental)
             {
-                if (threads > 0)
-                    _queue.Push(mapId);
-                else
-                    buildMap(mapId);
+                // the tile is built again only if what it is built from changed
+                inputHash = getTileInputHash(mapID, tileX, tileY);
+
+                // and its output is still there
+                std::map<uint64, TileHashEntry>::const_iterator itr = m_tileHashes.find((uint64(mapID) << 32) | *it);
+                if (itr != m_tileHashes.end() && itr->second.m_hash == inputHash && (itr->second.m_empty || shouldSkipTile(mapID, tileX, tileY)))
+                    continue;
             }
+            else if (shouldSkipTile(mapID, tileX, tileY))
+                continue;
+
+            mapTasks.push_back(new TileBuildTask(mapID, tileX, tileY, inputHash));
         }
 
-        while (!_queue.Empty())
+        printf("[Map %04u] We have %u tiles, %u to build.\n", mapID, (unsigned int)tiles->size(), uint32(mapTasks.size()));
+
+        if (mapTasks.empty())
+            return 0;
+
+        // build navMesh
+        dtNavMesh* navMesh = NULL;
+        buildNavMesh(mapID, navMesh);
+        if (!navMesh)
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            printf("[Map %04u] Failed creating navmesh!\n", mapID);
+
+            for (TileBuildTask* task : mapTasks)
+                delete task;
+
+            return 0;
         }
 
-        _cancelationToken = true;
+        MapBuildState*& state = m_mapStates[mapID];
+        if (!state)
+            state = new MapBuildState();
+
+        state->m_navMesh = navMesh;
+        state->m_pendingTiles = mapTasks.size();
 
-        _queue.Cancel();
+        tasks.insert(tasks.end(), mapTasks.begin(), mapTasks.end());
+        return mapTasks.size();
+    }
 
-        for (auto& thread : _workerThreads)
+    /**************************************************************************/
+    void MapBuilder::processTile(TileBuildTask const& task)
+    {
+        // only read while the workers run
+        MapBuildState* state = m_mapStates.find(task.m_mapId)->second;
+
+        uint32 start = getMSTime();
+        TileBuildResult result = buildTile(task.m_mapId, task.m_tileX, task.m_tileY, state->m_navMesh);
+        uint32 buildTime = GetMSTimeDiffToNow(start);
+
+        if (result == TILE_BUILD_FAILED)
+            printf("[Map %04u] [%02u,%02u]: Failed in %u ms\n", task.m_mapId, task.m_tileX, task.m_tileY, buildTime);
+        else
+            printf("[Map %04u] [%02u,%02u]: Built in %u ms\n", task.m_mapId, task.m_tileX, task.m_tileY, buildTime);
+
+        {
+            std::lock_guard<std::mutex> lock(m_tileTimesLock);
+
+            TileBuildTime tileTime;
+            tileTime.m_mapId = task.m_mapId;
+            tileTime.m_tileX = task.m_tileX;
+            tileTime.m_tileY = task.m_tileY;
+            tileTime.m_time = buildTime;
+            m_tileTimes.push_back(tileTime);
+        }
+
+        // a failed tile keeps its previous hash, or none, so the next run builds it again
+        if (m_incremental && result != TILE_BUILD_FAILED)
+        {
+            std::lock_guard<std::mutex> lock(m_tileHashesLock);
+            TileHashEntry& entry = m_tileHashes[(uint64(task.m_mapId) << 32) | StaticMapTree::packTileID(task.m_tileX, task.m_tileY)];
+            entry.m_hash = task.m_inputHash;
+            entry.m_empty = result == TILE_BUILD_EMPTY;
+        }
+
+        // last tile of the map
+        if (--state->m_pendingTiles == 0)
         {
-            thread.join();
+            dtFreeNavMesh(state->m_navMesh);
+            state->m_navMesh = NULL;
+
+            printf("[Map %04u] Complete!\n", task.m_mapId);
         }
+
+        std::lock_guard<std::mutex> lock(m_pendingLock);
+        if (--m_pendingTiles == 0)
+            m_pendingCondition.notify_all();
+    }
+
+    /**************************************************************************/
+    // FNV-1a
+    static uint64 const FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+    static void hashBytes(uint64& hash, void const* data, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<uint8 const*>(data)[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    static void hashFile(uint64& hash, std::string const& fileName)
+    {
+        hashBytes(hash, fileName.c_str(), fileName.size());
+
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (!file)
+            return;
+
+        char buffer[65536];
+        size_t count;
+        while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+            hashBytes(hash, buffer, count);
+
+        fclose(file);
+    }
+
+    uint64 MapBuilder::getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        // over the build settings and the content of the input files
+        uint64 hash = FNV_OFFSET_BASIS;
+
+        uint32 version[2] = { MMAP_VERSION, DT_NAVMESH_VERSION };
+        bool usesLiquids = m_terrainBuilder->usesLiquids();
+        hashBytes(hash, version, sizeof(version));
+        hashBytes(hash, &m_maxWalkableAngle, sizeof(m_maxWalkableAngle));
+        hashBytes(hash, &m_bigBaseUnit, sizeof(m_bigBaseUnit));
+        hashBytes(hash, &usesLiquids, sizeof(usesLiquids));
+
+        // terrain of the tile and the borders of its neighbours, see TerrainBuilder::loadMap
+        int const neighbours[5][2] = { { 0, 0 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+        for (uint32 i = 0; i < 5; ++i)
+        {
+            char fileName[255];
+            sprintf(fileName, "maps/%04u_%02u_%02u.map", mapID, tileY + neighbours[i][1], tileX + neighbours[i][0]);
+            hashFile(hash, fileName);
+        }
+
+        // model spawns, see TerrainBuilder::loadVMap which is called with swapped coordinates
+        hashFile(hash, "vmaps/" + VMapManager2::getMapFileName(mapID));
+        hashFile(hash, "vmaps/" + StaticMapTree::getTileFileName(mapID, tileY, tileX));
+
+        // and the models they reference
+        std::vector<std::string> modelNames;
+        getTileModelNames(mapID, tileY, tileX, modelNames);
+        std::sort(modelNames.begin(), modelNames.end());
+        modelNames.erase(std::unique(modelNames.begin(), modelNames.end()), modelNames.end());
+
+        for (std::string const& name : modelNames)
+        {
+            uint64 modelHash = getModelHash(name);
+            hashBytes(hash, &modelHash, sizeof(modelHash));
+        }
+
+        if (m_offMeshFilePath)
+            hashFile(hash, m_offMeshFilePath);
+
+        return hash;
+    }
+
+    uint64 MapBuilder::getModelHash(std::string const& name)
+    {
+        // only called while the tiles are queued, before the workers start
+        std::map<std::string, uint64>::const_iterator itr = m_modelHashes.find(name);
+        if (itr != m_modelHashes.end())
+            return itr->second;
+
+        uint64 hash = FNV_OFFSET_BASIS;
+        hashFile(hash, "vmaps/" + name);
+
+        m_modelHashes[name] = hash;
+        return hash;
+    }
+
+    void MapBuilder::getTileModelNames(uint32 mapID, uint32 tileX, uint32 tileY, std::vector<std::string>& names)
+    {
+        // spawns of the tile
+        StaticMapTree::getTileModelNames("vmaps", mapID, tileX, tileY, names);
+
+        // maps which aren't tiled have a single global model spawn, stored in the tree file
+        std::string treeFile = "vmaps/" + VMapManager2::getMapFileName(mapID);
+        FILE* file = fopen(treeFile.c_str(), "rb");
+        if (!file)
+            return;
+
+        char chunk[8];
+        char tiled = 0;
+        BIH tree;
+        VMAP::ModelSpawn spawn;
+        if (VMAP::readChunk(file, chunk, VMAP::VMAP_MAGIC, 8) && fread(&tiled, sizeof(char), 1, file) == 1 && !tiled &&
+            VMAP::readChunk(file, chunk, "NODE", 4) && tree.readFromFile(file) && VMAP::readChunk(file, chunk, "GOBJ", 4) &&
+            VMAP::ModelSpawn::readFromFile(file, spawn))
+            names.push_back(spawn.name);
+
+        fclose(file);
+    }
+
+    void MapBuilder::loadTileHashes()
+    {
+        FILE* file = fopen("mmaps/tilehashes.txt", "r");
+        if (!file)
+            return;
+
+        // mapId tileX tileY hash [empty], files written before the empty flag have 4 columns
+        char line[128];
+        while (fgets(line, sizeof(line), file))
+        {
+            unsigned int mapID, tileX, tileY, empty = 0;
+            unsigned long long hash;
+            if (sscanf(line, "%u %u %u %llx %u", &mapID, &tileX, &tileY, &hash, &empty) < 4)
+                continue;
+
+            TileHashEntry& entry = m_tileHashes[(uint64(mapID) << 32) | StaticMapTree::packTileID(tileX, tileY)];
+            entry.m_hash = hash;
+            entry.m_empty = empty != 0;
+        }
+
+        fclose(file);
+    }
+
+    void MapBuilder::saveTileHashes()
+    {
+        FILE* file = fopen("mmaps/tilehashes.txt", "w");
+        if (!file)
+        {
+            perror("Failed to open mmaps/tilehashes.txt for writing!");
+            return;
+        }
+
+        for (std::map<uint64, TileHashEntry>::const_iterator itr = m_tileHashes.begin(); itr != m_tileHashes.end(); ++itr)
+        {
+            uint32 tileX, tileY;
+            StaticMapTree::unpackTileID(uint32(itr->first), tileX, tileY);
+            fprintf(file, "%u %u %u %llx %u\n", uint32(itr->first >> 32), tileX, tileY, (unsigned long long)itr->second.m_hash, itr->second.m_empty ? 1 : 0);
+        }
+
+        fclose(file);
+    }
+
+    void MapBuilder::removeNavMeshTile(dtNavMesh* navMesh, dtTileRef tileRef)
+    {
+        std::lock_guard<std::mutex> lock(m_navMeshLock);
+        navMesh->removeTile(tileRef, NULL, NULL);
     }
 
     /**************************************************************************/
@@ -350,61 +685,13 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMap(uint32 mapID)
+    void MapBuilder::buildMap(uint32 mapID, int threads)
     {
-#ifndef __APPLE__
-        //printf("[Thread %u] Building map %03u:\n", uint32(ACE_Thread::self()), mapID);
-#endif
-
-        std::set<uint32>* tiles = getTileList(mapID);
-
-        // make sure we process maps which don't have tiles
-        if (!tiles->size())
-        {
-            // convert coord bounds to grid bounds
-            uint32 minX, minY, maxX, maxY;
-            getGridBounds(mapID, minX, minY, maxX, maxY);
-
-            // add all tiles within bounds to tile list.
-            for (uint32 i = minX; i <= maxX; ++i)
-                for (uint32 j = minY; j <= maxY; ++j)
-                    tiles->insert(StaticMapTree::packTileID(i, j));
-        }
-
-        if (!tiles->empty())
-        {
-            // build navMesh
-            dtNavMesh* navMesh = NULL;
-            buildNavMesh(mapID, navMesh);
-            if (!navMesh)
-            {
-                printf("[Map %04i] Failed creating navmesh!\n", mapID);
-                return;
-            }
-
-            // now start building mmtiles for each tile
-            printf("[Map %04i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
-            for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
-            {
-                uint32 tileX, tileY;
-
-                // unpack tile coords
-                StaticMapTree::unpackTileID((*it), tileX, tileY);
-
-                if (shouldSkipTile(mapID, tileX, tileY))
-                    continue;
-
-                buildTile(mapID, tileX, tileY, navMesh);
-            }
-
-            dtFreeNavMesh(navMesh);
-        }
-
-        printf("[Map %04u] Complete!\n", mapID);
+        buildMaps(std::vector<uint32>(1, mapID), threads);
     }
 
     /**************************************************************************/
-    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    TileBuildResult MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
         printf("[Map %04i] Building tile [%02u,%02u]\n", mapID, tileX, tileY);
 
@@ -418,7 +705,7 @@ namespace MMAP
 
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
-            return;
+            return TILE_BUILD_EMPTY;
 
         // remove unused vertices
         TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
@@ -430,7 +717,7 @@ namespace MMAP
         allVerts.append(meshData.solidVerts);
 
         if (!allVerts.size())
-            return;
+            return TILE_BUILD_EMPTY;
 
         // get bounds of current tile
         float bmin[3], bmax[3];
@@ -439,7 +726,7 @@ namespace MMAP
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        return buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
     }
 
     /**************************************************************************/
@@ -518,7 +805,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
+    TileBuildResult MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
         dtNavMesh* navMesh)
     {
@@ -713,7 +1000,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return TILE_BUILD_FAILED;
         }
         rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
 
@@ -724,7 +1011,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return TILE_BUILD_FAILED;
         }
         rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
 
@@ -778,6 +1065,8 @@ namespace MMAP
         unsigned char* navData = NULL;
         int navDataSize = 0;
 
+        TileBuildResult result = TILE_BUILD_FAILED;
+
         do
         {
             // these values are checked within dtCreateNavMeshData - handle them here
@@ -799,6 +1088,7 @@ namespace MMAP
 
                 // message is an annoyance
                 //printf("%sNo vertices to build tile!              \n", tileString.c_str());
+                result = TILE_BUILD_EMPTY;
                 break;
             }
             if (!params.polyCount || !params.polys ||
@@ -808,6 +1098,7 @@ namespace MMAP
                 // keep in mind that we do output those into debug info
                 // drop tiles with only exact count - some tiles may have geometry while having less tiles
                 printf("%s No polygons to build on tile!              \n", tileString.c_str());
+                result = TILE_BUILD_EMPTY;
                 break;
             }
             if (!params.detailMeshes || !params.detailVerts || !params.detailTris)
@@ -827,7 +1118,11 @@ namespace MMAP
             printf("%s Adding tile to navmesh...\n", tileString.c_str());
             // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
             // is removed via removeTile()
-            dtStatus dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
+            dtStatus dtResult;
+            {
+                std::lock_guard<std::mutex> lock(m_navMeshLock);
+                dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
+            }
             if (!tileRef || dtResult != DT_SUCCESS)
             {
                 printf("%s Failed adding tile to navmesh!           \n", tileString.c_str());
@@ -843,7 +1138,7 @@ namespace MMAP
                 char message[1024];
                 sprintf(message, "[Map %04u] Failed to open %s for writing!\n", mapID, fileName);
                 perror(message);
-                navMesh->removeTile(tileRef, NULL, NULL);
+                removeNavMeshTile(navMesh, tileRef);
                 break;
             }
 
@@ -853,14 +1148,19 @@ namespace MMAP
             MmapTileHeader header;
             header.usesLiquids = m_terrainBuilder->usesLiquids();
             header.size = uint32(navDataSize);
-            fwrite(&header, sizeof(MmapTileHeader), 1, file);
+            bool written = fwrite(&header, sizeof(MmapTileHeader), 1, file) == 1;
 
             // write data
-            fwrite(navData, sizeof(unsigned char), navDataSize, file);
-            fclose(file);
+            written = fwrite(navData, sizeof(unsigned char), navDataSize, file) == size_t(navDataSize) && written;
+            written = fclose(file) == 0 && written;
+
+            if (written)
+                result = TILE_BUILD_WRITTEN;
+            else
+                printf("%s Failed writing %s!           \n", tileString.c_str(), fileName);
 
             // now that tile is written to disk, we can unload it
-            navMesh->removeTile(tileRef, NULL, NULL);
+            removeNavMeshTile(navMesh, tileRef);
         }
         while (0);
 
@@ -877,6 +1177,8 @@ namespace MMAP
             iv.generateObjFile(mapID, tileX, tileY, meshData);
             iv.writeIV(mapID, tileX, tileY);
         }
+
+        return result;
     }
 
     /**************************************************************************/
@@ -15,6 +15,8 @@
 #include <list>
 #include <atomic>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "TerrainBuilder.h"
 #include "IntermediateValues.h"
@@ -45,6 +47,51 @@ namespace MMAP
 
     typedef std::list<MapTiles> TileList;
 
+    enum TileBuildResult
+    {
+        TILE_BUILD_WRITTEN,                 // .mmtile written
+        TILE_BUILD_EMPTY,                   // nothing to walk on, no file is written
+        TILE_BUILD_FAILED
+    };
+
+    // incremental mode: what the last successful build of a tile was made from
+    struct TileHashEntry
+    {
+        TileHashEntry() : m_hash(0), m_empty(false) {}
+
+        uint64 m_hash;
+        bool m_empty;                       // built without output, there is no .mmtile to check
+    };
+
+    // one navmesh tile to build, work item of the worker threads
+    struct TileBuildTask
+    {
+        TileBuildTask(uint32 mapId, uint32 tileX, uint32 tileY, uint64 inputHash) :
+            m_mapId(mapId), m_tileX(tileX), m_tileY(tileY), m_inputHash(inputHash) {}
+
+        uint32 m_mapId;
+        uint32 m_tileX;
+        uint32 m_tileY;
+        uint64 m_inputHash;
+    };
+
+    // navmesh shared by the tiles of a map, freed with its last tile
+    struct MapBuildState
+    {
+        MapBuildState() : m_navMesh(NULL), m_pendingTiles(0) {}
+
+        dtNavMesh* m_navMesh;
+        std::atomic<uint32> m_pendingTiles;
+    };
+
+    struct TileBuildTime
+    {
+        uint32 m_mapId;
+        uint32 m_tileX;
+        uint32 m_tileY;
+        uint32 m_time;
+    };
+
     struct Tile
     {
         Tile() : chf(NULL), solid(NULL), cset(NULL), pmesh(NULL), dmesh(NULL) {}
@@ -73,12 +120,13 @@ namespace MMAP
                 bool skipBattlegrounds   = false,
                 bool debugOutput         = false,
                 bool bigBaseUnit         = false,
-                const char* offMeshFilePath = NULL);
+                const char* offMeshFilePath = NULL,
+                bool incremental         = false);
 
             ~MapBuilder();
 
             // builds all mmap tiles for the specified map id (ignores skip settings)
-            void buildMap(uint32 mapID);
+            void buildMap(uint32 mapID, int threads = 0);
             void buildMeshFromFile(char* name);
 
             // builds an mmap tile for the specified map and its mesh
@@ -87,19 +135,35 @@ namespace MMAP
             // builds list of maps, then builds all of mmap tiles (based on the skip settings)
             void buildAllMaps(int threads);
 
+            // builds the tiles of all the given maps, tiles of every map are spread over the threads
+            void buildMaps(std::vector<uint32> const& mapIDs, int threads);
+
             void WorkerThread();
 
         private:
+            // creates the navmesh of a map and queues its tiles, returns the number of tiles queued
+            uint32 prepareMap(uint32 mapID, std::vector<TileBuildTask*>& tasks);
+            void processTile(TileBuildTask const& task);
+
+            // incremental mode: hash of the files and settings a tile is built from
+            uint64 getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY);
+            uint64 getModelHash(std::string const& name);
+            void getTileModelNames(uint32 mapID, uint32 tileX, uint32 tileY, std::vector<std::string>& names);
+            void loadTileHashes();
+            void saveTileHashes();
+
+            void removeNavMeshTile(dtNavMesh* navMesh, dtTileRef tileRef);
+
             // detect maps and tiles
             void discoverTiles();
             std::set<uint32>* getTileList(uint32 mapID);
 
             void buildNavMesh(uint32 mapID, dtNavMesh* &navMesh);
 
-            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+            TileBuildResult buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
 
             // move map building
-            void buildMoveMapTile(uint32 mapID,
+            TileBuildResult buildMoveMapTile(uint32 mapID,
                 uint32 tileX,
                 uint32 tileY,
                 MeshData &meshData,
@@ -133,8 +197,23 @@ namespace MMAP
             rcContext* m_rcContext;
 
             std::vector<std::thread> _workerThreads;
-            ProducerConsumerQueue<uint32> _queue;
+            ProducerConsumerQueue<TileBuildTask*> _queue;
             std::atomic<bool> _cancelationToken;
+
+            std::map<uint32, MapBuildState*> m_mapStates;
+            std::mutex m_navMeshLock;               // dtNavMesh::addTile and removeTile aren't thread safe
+
+            std::mutex m_pendingLock;
+            std::condition_variable m_pendingCondition;
+            uint32 m_pendingTiles;
+
+            bool m_incremental;
+            std::map<uint64, TileHashEntry> m_tileHashes;   // (mapId << 32 | packed tile id) -> last successful build
+            std::mutex m_tileHashesLock;
+            std::map<std::string, uint64> m_modelHashes;    // model file -> content hash, models are shared by many tiles
+
+            std::vector<TileBuildTime> m_tileTimes;
+            std::mutex m_tileTimesLock;
     };
 }
 
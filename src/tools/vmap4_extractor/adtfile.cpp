@@ -67,9 +67,7 @@ char* GetExtension(char* FileName)
     return NULL;
 }
 
-extern HANDLE CascStorage;
-
-ADTFile::ADTFile(char* filename) : ADT(CascStorage, filename, false), nWMO(0), nMDX(0)
+ADTFile::ADTFile(char* filename) : ADT(GetCascStorage(), filename, false), nWMO(0), nMDX(0)
 {
     Adtfilename.append(filename);
 }
@@ -155,12 +153,15 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
             if (size)
             {
                 nMDX = (int)size / 36;
+
+                std::lock_guard<std::mutex> lock(DirFileLock);
                 for (int i=0; i<nMDX; ++i)
                 {
                     uint32 id;
                     ADT.read(&id, 4);
                     ModelInstance inst(ADT, ModelInstanceNames[id].c_str(), map_num, tileX, tileY, dirfile);
                 }
+                fflush(dirfile);
 
                 ModelInstanceNames.clear();
             }
@@ -170,12 +171,15 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
             if (size)
             {
                 nWMO = (int)size / 64;
+
+                std::lock_guard<std::mutex> lock(DirFileLock);
                 for (int i=0; i<nWMO; ++i)
                 {
                     uint32 id;
                     ADT.read(&id, 4);
                     WMOInstance inst(ADT, WmoInstanceNames[id].c_str(), map_num, tileX, tileY, dirfile);
                 }
+                fflush(dirfile);
 
                 WmoInstanceNames.clear();
             }
@@ -32,29 +32,27 @@ bool ExtractSingleModel(std::string& fname)
     output += "/";
     output += name;
 
-    if (FileExists(output.c_str()))
-        return true;
-
-    Model mdl(originalName);
-    if (!mdl.open())
-        return false;
+    return ExtractOnce(output, [&]() -> bool
+    {
+        Model mdl(originalName);
+        if (!mdl.open())
+            return false;
 
-    return mdl.ConvertToVMAPModel(output.c_str());
+        return mdl.ConvertToVMAPModel(output.c_str());
+    });
 }
 
-extern HANDLE CascStorage;
-
 void ExtractGameobjectModels()
 {
     printf("Extracting GameObject models...");
-    DBCFile dbc(CascStorage, "DBFilesClient\\GameObjectDisplayInfo.dbc");
+    DBCFile dbc(GetCascStorage(), "DBFilesClient\\GameObjectDisplayInfo.dbc");
     if(!dbc.open())
     {
         printf("Fatal error: Invalid GameObjectDisplayInfo.dbc file format!\n");
         exit(1);
     }
 
-    DBCFile fileData(CascStorage, "DBFilesClient\\FileData.dbc");
+    DBCFile fileData(GetCascStorage(), "DBFilesClient\\FileData.dbc");
     if (!fileData.open())
     {
         printf("Fatal error: Invalid FileData.dbc file format!\n");
@@ -14,8 +14,6 @@
 #include <algorithm>
 #include <cstdio>
 
-extern HANDLE CascStorage;
-
 Model::Model(std::string &filename) : filename(filename), vertices(0), indices(0)
 {
     memset(&header, 0, sizeof(header));
@@ -23,7 +21,7 @@ Model::Model(std::string &filename) : filename(filename), vertices(0), indices(0
 
 bool Model::open()
 {
-    MPQFile f(CascStorage, filename.c_str());
+    MPQFile f(GetCascStorage(), filename.c_str());
 
     if (f.isEof())
     {
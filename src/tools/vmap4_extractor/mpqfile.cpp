@@ -2,6 +2,8 @@
 #include <deque>
 #include <cstdio>
 
+std::atomic<uint64> StorageBytesRead(0);
+
 MPQFile::MPQFile(HANDLE mpq, const char* filename, bool warnNoExist /*= true*/) :
     eof(false),
     buffer(0),
@@ -47,6 +49,7 @@ MPQFile::MPQFile(HANDLE mpq, const char* filename, bool warnNoExist /*= true*/)
     }
 
     CascCloseFile(file);
+    StorageBytesRead += size;
 }
 
 size_t MPQFile::read(void* dest, size_t bytes)
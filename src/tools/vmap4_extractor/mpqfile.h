@@ -12,6 +12,7 @@
 #include <iostream>
 #include <deque>
 #include <cstdint>
+#include <atomic>
 #include "CascLib.h"
 
 typedef int64_t            int64;
@@ -29,6 +30,13 @@ typedef uint8_t            uint8;
 int GetLastError();
 #endif
 
+// CASC storage of the calling thread, CascLib handles must not be used by several threads at once
+HANDLE GetCascStorage();
+void CloseCascStorages();
+
+// bytes read from the storage by all threads, for the throughput summary
+extern std::atomic<uint64> StorageBytesRead;
+
 class MPQFile
 {
     //MPQHANDLE handle;
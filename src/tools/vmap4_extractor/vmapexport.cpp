@@ -8,6 +8,7 @@
 
 #define _CRT_SECURE_NO_DEPRECATE
 #include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <vector>
 #include <list>
@@ -26,6 +27,10 @@
 
 #include <map>
 #include <fstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 
 //From Extractor
 #include "adtfile.h"
@@ -43,8 +48,6 @@
 
 //-----------------------------------------------------------------------------
 
-HANDLE CascStorage = NULL;
-
 typedef struct
 {
     char name[64];
@@ -57,6 +60,7 @@ uint32 map_count;
 char output_path[128] = ".";
 char input_path[1024] = ".";
 bool preciseVectorData = false;
+uint32 threadCount = 4;
 
 // Constants
 
@@ -64,18 +68,103 @@ bool preciseVectorData = false;
 const char* szWorkDirWmo = "./Buildings";
 const char* szRawVMAPMagic = "VMAP043";
 
-bool OpenCascStorage()
+std::mutex DirFileLock;
+
+std::mutex CascStoragesLock;
+std::map<std::thread::id, HANDLE> CascStorages;
+
+// each extraction thread opens its own storage on first use, CascLib has no locking of its own
+HANDLE GetCascStorage()
 {
-    if (!CascOpenStorage("./Data", 0, &CascStorage))
+    std::lock_guard<std::mutex> lock(CascStoragesLock);
+
+    HANDLE& storage = CascStorages[std::this_thread::get_id()];
+    if (!storage && !CascOpenStorage("./Data", 0, &storage))
     {
         printf("Error %d\n", GetLastError());
-        return false;
+        storage = NULL;
     }
 
+    return storage;
+}
+
+void CloseCascStorages()
+{
+    std::lock_guard<std::mutex> lock(CascStoragesLock);
+
+    for (std::map<std::thread::id, HANDLE>::iterator itr = CascStorages.begin(); itr != CascStorages.end(); ++itr)
+        if (itr->second)
+            CascCloseStorage(itr->second);
+
+    CascStorages.clear();
+}
+
+bool OpenCascStorage()
+{
+    if (!GetCascStorage())
+        return false;
+
     printf("\n");
     return true;
 }
 
+void ParallelFor(size_t count, std::function<void(size_t)> const& work)
+{
+    // threads pull the next index themselves, nothing is queued ahead of them
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < count; i = next++)
+            work(i);
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32 i = 1; i < threadCount && i < count; ++i)
+        threads.push_back(std::thread(worker));
+
+    worker();
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+}
+
+enum ExtractState
+{
+    EXTRACT_PENDING,
+    EXTRACT_DONE,
+    EXTRACT_FAILED
+};
+
+std::mutex ExtractedFilesLock;
+std::condition_variable ExtractedFilesCondition;
+std::map<std::string, ExtractState> ExtractedFiles;
+
+bool ExtractOnce(std::string const& outputFile, std::function<bool()> const& extract)
+{
+    {
+        std::unique_lock<std::mutex> lock(ExtractedFilesLock);
+
+        std::map<std::string, ExtractState>::iterator itr = ExtractedFiles.find(outputFile);
+        if (itr != ExtractedFiles.end())
+        {
+            ExtractedFilesCondition.wait(lock, [itr]() { return itr->second != EXTRACT_PENDING; });
+            return itr->second == EXTRACT_DONE;
+        }
+
+        ExtractedFiles[outputFile] = EXTRACT_PENDING;
+    }
+
+    bool result = FileExists(outputFile.c_str()) || extract();
+
+    {
+        std::lock_guard<std::mutex> lock(ExtractedFilesLock);
+        ExtractedFiles[outputFile] = result ? EXTRACT_DONE : EXTRACT_FAILED;
+    }
+
+    ExtractedFilesCondition.notify_all();
+    return result;
+}
+
 // Local testing functions
 
 bool FileExists(const char* file)
@@ -102,7 +191,7 @@ void ReadLiquidTypeTableDBC()
 {
     printf("Read LiquidType.dbc file...");
 
-    DBCFile dbc(CascStorage, "DBFilesClient\\LiquidType.dbc");
+    DBCFile dbc(GetCascStorage(), "DBFilesClient\\LiquidType.dbc");
     if(!dbc.open())
     {
         printf("Fatal error: Invalid LiquidType.dbc file format!\n");
@@ -131,7 +220,7 @@ bool ExtractWmo()
         return false;
     }
 
-    std::set<std::string> wmos;
+    std::set<std::string> uniqueWmos;
     for (;;)
     {
         std::string str;
@@ -139,11 +228,20 @@ bool ExtractWmo()
         if (str.empty())
             break;
 
-        wmos.insert(std::move(str));
+        uniqueWmos.insert(std::move(str));
     }
 
-    for (std::string str : wmos)
-        success &= ExtractSingleWmo(str);
+    std::vector<std::string> wmos(uniqueWmos.begin(), uniqueWmos.end());
+    std::atomic<bool> allExtracted(true);
+
+    ParallelFor(wmos.size(), [&](size_t i)
+    {
+        std::string str = wmos[i];
+        if (!ExtractSingleWmo(str))
+            allExtracted = false;
+    });
+
+    success = allExtracted;
 
     if (success)
         printf("\nExtract wmo complete (No (fatal) errors)\n");
@@ -160,9 +258,6 @@ bool ExtractSingleWmo(std::string& fname)
     sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
     FixNameCase(szLocalFile,strlen(szLocalFile));
 
-    if (FileExists(szLocalFile))
-        return true;
-
     int p = 0;
     // Select root wmo files
     char const* rchr = strrchr(plain_name, '_');
@@ -181,62 +276,68 @@ bool ExtractSingleWmo(std::string& fname)
     if (p == 3)
         return true;
 
-    bool file_ok = true;
-    std::cout << "Extracting " << fname << std::endl;
-    WMORoot froot(fname);
-    if(!froot.open())
-    {
-        printf("Couldn't open RootWmo!!!\n");
-        return true;
-    }
-    FILE *output = fopen(szLocalFile,"wb");
-    if(!output)
+    return ExtractOnce(szLocalFile, [&]() -> bool
     {
-        printf("couldn't open %s for writing!\n", szLocalFile);
-        return false;
-    }
-    froot.ConvertToVMAPRootWmo(output);
-    int Wmo_nVertices = 0;
-    //printf("root has %d groups\n", froot->nGroups);
-    if (froot.nGroups !=0)
-    {
-        for (uint32 i = 0; i < froot.nGroups; ++i)
+        bool file_ok = true;
+        printf("Extracting %s\n", fname.c_str());
+        WMORoot froot(fname);
+        if(!froot.open())
+        {
+            printf("Couldn't open RootWmo!!!\n");
+            return true;
+        }
+        FILE *output = fopen(szLocalFile,"wb");
+        if(!output)
         {
-            char temp[1024];
-            strncpy(temp, fname.c_str(), 1024);
-            temp[fname.length()-4] = 0;
-            char groupFileName[1024];
-            sprintf(groupFileName, "%s_%03u.wmo", temp, i);
-            //printf("Trying to open groupfile %s\n",groupFileName);
-
-            std::string s = groupFileName;
-            WMOGroup fgroup(s);
-            if(!fgroup.open())
+            printf("couldn't open %s for writing!\n", szLocalFile);
+            return false;
+        }
+        froot.ConvertToVMAPRootWmo(output);
+        int Wmo_nVertices = 0;
+        //printf("root has %d groups\n", froot->nGroups);
+        if (froot.nGroups !=0)
+        {
+            for (uint32 i = 0; i < froot.nGroups; ++i)
             {
-                printf("Could not open all Group file for: %s\n", plain_name);
-                file_ok = false;
-                break;
-            }
+                char temp[1024];
+                strncpy(temp, fname.c_str(), 1024);
+                temp[fname.length()-4] = 0;
+                char groupFileName[1024];
+                sprintf(groupFileName, "%s_%03u.wmo", temp, i);
+                //printf("Trying to open groupfile %s\n",groupFileName);
+
+                std::string s = groupFileName;
+                WMOGroup fgroup(s);
+                if(!fgroup.open())
+                {
+                    printf("Could not open all Group file for: %s\n", plain_name);
+                    file_ok = false;
+                    break;
+                }
 
-            Wmo_nVertices += fgroup.ConvertToVMAPGroupWmo(output, &froot, preciseVectorData);
+                Wmo_nVertices += fgroup.ConvertToVMAPGroupWmo(output, &froot, preciseVectorData);
+            }
         }
-    }
 
-    fseek(output, 8, SEEK_SET); // store the correct no of vertices
-    fwrite(&Wmo_nVertices,sizeof(int),1,output);
-    fclose(output);
+        fseek(output, 8, SEEK_SET); // store the correct no of vertices
+        fwrite(&Wmo_nVertices,sizeof(int),1,output);
+        fclose(output);
 
-    // Delete the extracted file in the case of an error
-    if (!file_ok)
-        remove(szLocalFile);
-    return true;
+        // Delete the extracted file in the case of an error
+        if (!file_ok)
+            remove(szLocalFile);
+        return true;
+    });
 }
 
-void ParsMapFiles()
+uint32 ParsMapFiles()
 {
     char fn[512];
     //char id_filename[64];
     char id[10];
+
+    // global wmos of each map first, then the tiles of all maps on the extraction threads
+    std::vector<unsigned int> maps;
     for (unsigned int i=0; i<map_count; ++i)
     {
         sprintf(id, "%04u", map_ids[i].id);
@@ -244,24 +345,41 @@ void ParsMapFiles()
         WDTFile WDT(fn,map_ids[i].name);
         if(WDT.init(id, map_ids[i].id))
         {
-            printf("Processing Map %u\n[", map_ids[i].id);
-            for (int x=0; x<64; ++x)
-            {
-                for (int y=0; y<64; ++y)
-                {
-                    if (ADTFile *ADT = WDT.GetMap(x,y))
-                    {
-                        //sprintf(id_filename,"%02u %02u %03u",x,y,map_ids[i].id);//!!!!!!!!!
-                        ADT->init(map_ids[i].id, x, y);
-                        delete ADT;
-                    }
-                }
-                printf("#");
-                fflush(stdout);
-            }
-            printf("]\n");
+            printf("Processing Map %u\n", map_ids[i].id);
+            maps.push_back(i);
         }
     }
+
+    size_t tileCount = maps.size() * 64 * 64;
+    std::atomic<uint32> processed(0);
+    std::atomic<uint32> extracted(0);
+    std::mutex progressLock;
+    uint32 printedMarks = 0;
+
+    printf("Extracting tiles of %u maps on %u threads\n[", uint32(maps.size()), threadCount);
+    ParallelFor(tileCount, [&](size_t index)
+    {
+        map_id const& map = map_ids[maps[index / (64 * 64)]];
+        int x = int(index / 64 % 64);
+        int y = int(index % 64);
+
+        char adtName[512];
+        sprintf(adtName, "World\\Maps\\%s\\%s_%d_%d_obj0.adt", map.name, map.name, x, y);
+
+        ADTFile ADT(adtName);
+        if (ADT.init(map.id, x, y))
+            ++extracted;
+
+        uint32 marks = uint32(uint64(++processed) * 64 / tileCount);
+
+        std::lock_guard<std::mutex> lock(progressLock);
+        for (; printedMarks < marks; ++printedMarks)
+            printf("#");
+        fflush(stdout);
+    });
+    printf("]\n");
+
+    return extracted;
 }
 
 void getGamePath()
@@ -310,6 +428,18 @@ bool processArgv(int argc, char ** argv, const char *versionString)
         {
             preciseVectorData = true;
         }
+        else if(strcmp("-t",argv[i]) == 0)
+        {
+            if((i+1)<argc && atoi(argv[i + 1]) > 0)
+            {
+                threadCount = atoi(argv[i + 1]);
+                ++i;
+            }
+            else
+            {
+                result = false;
+            }
+        }
         else
         {
             result = false;
@@ -320,10 +450,11 @@ bool processArgv(int argc, char ** argv, const char *versionString)
     if (!result)
     {
         printf("Extract %s.\n",versionString);
-        printf("%s [-?][-s][-l][-d <path>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-d <path>][-t <threads>]\n", argv[0]);
         printf("   -s : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d <path>: Path to the vector data source folder.\n");
+        printf("   -t <threads>: Number of extraction threads, each opens its own storage (default 4).\n");
         printf("   -? : This message.\n");
     }
 
@@ -367,6 +498,8 @@ int main(int argc, char ** argv)
     }
 
     printf("Extract %s. Beginning work ....\n\n", versionString);
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    uint32 tiles = 0;
     //xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
     // Create the working directory
     if (mkdir(szWorkDirWmo
@@ -396,7 +529,7 @@ int main(int argc, char ** argv)
     //map.dbc
     if (success)
     {
-        DBCFile * dbc = new DBCFile(CascStorage, "DBFilesClient\\Map.dbc");
+        DBCFile * dbc = new DBCFile(GetCascStorage(), "DBFilesClient\\Map.dbc");
         if (!dbc->open())
         {
             delete dbc;
@@ -426,11 +559,19 @@ int main(int argc, char ** argv)
         }
 
         delete dbc;
-        ParsMapFiles();
+        tiles = ParsMapFiles();
         delete [] map_ids;
     }
 
-    CascCloseStorage(CascStorage);
+    CloseCascStorages();
+
+    double elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count() / 1000.0;
+    if (elapsed <= 0.0)
+        elapsed = 0.001;
+
+    double megabytes = StorageBytesRead / (1024.0 * 1024.0);
+    printf("\n%u tiles in %.1f s (%.1f tiles/s), %.1f MB read from storage (%.1f MB/s) on %u threads\n",
+        tiles, elapsed, tiles / elapsed, megabytes, megabytes / elapsed, threadCount);
 
     printf("\n");
     if (!success)
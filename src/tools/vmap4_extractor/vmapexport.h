@@ -10,6 +10,8 @@
 #define VMAPEXPORT_H
 
 #include <string>
+#include <functional>
+#include <mutex>
 
 enum ModelFlags
 {
@@ -21,9 +23,18 @@ enum ModelFlags
 extern const char * szWorkDirWmo;
 extern const char * szRawVMAPMagic;                         // vmap magic string for extracted raw vmap data
 
+extern std::mutex DirFileLock;                              // dir_bin records of concurrent tiles must not interleave
+
 bool FileExists(const char * file);
 void strToLower(char* str);
 
+// runs work(0) .. work(count - 1) on the extraction threads (-t), returns when all are done
+void ParallelFor(size_t count, std::function<void(size_t)> const& work);
+
+// models and wmos are shared by many tiles: the first thread asking for outputFile extracts it,
+// the others wait for its result instead of writing the same file concurrently
+bool ExtractOnce(std::string const& outputFile, std::function<bool()> const& extract);
+
 bool ExtractSingleWmo(std::string& fname);
 bool ExtractSingleModel(std::string& fname);
 
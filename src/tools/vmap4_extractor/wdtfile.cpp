@@ -20,9 +20,7 @@ char * wdtGetPlainName(char * FileName)
     return FileName;
 }
 
-extern HANDLE CascStorage;
-
-WDTFile::WDTFile(char* file_name, char* file_name1):WDT(CascStorage, file_name), gnWMO(0)
+WDTFile::WDTFile(char* file_name, char* file_name1):WDT(GetCascStorage(), file_name), gnWMO(0)
 {
     filename.append(file_name1,strlen(file_name1));
 }
@@ -85,12 +83,14 @@ bool WDTFile::init(char* /*map_id*/, unsigned int mapID)
             {
                 gnWMO = (int)size / 64;
 
+                std::lock_guard<std::mutex> lock(DirFileLock);
                 for (int i = 0; i < gnWMO; ++i)
                 {
                     int id;
                     WDT.read(&id, 4);
                     WMOInstance inst(WDT, gWmoInstansName[id].c_str(), mapID, 65, 65, dirfile);
                 }
+                fflush(dirfile);
             }
         }
         WDT.seek((int)nextpos);
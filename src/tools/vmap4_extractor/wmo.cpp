@@ -29,11 +29,9 @@ WMORoot::WMORoot(std::string &filename)
     memset(bbcorn2, 0, sizeof(bbcorn2));
 }
 
-extern HANDLE CascStorage;
-
 bool WMORoot::open()
 {
-    MPQFile f(CascStorage, filename.c_str());
+    MPQFile f(GetCascStorage(), filename.c_str());
     if(f.isEof ())
     {
         printf("No such file.\n");
@@ -141,7 +139,7 @@ WMOGroup::WMOGroup(const std::string &filename) :
 
 bool WMOGroup::open()
 {
-    MPQFile f(CascStorage, filename.c_str());
+    MPQFile f(GetCascStorage(), filename.c_str());
     if(f.isEof ())
     {
         printf("No such file.\n");